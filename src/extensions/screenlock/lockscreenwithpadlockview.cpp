@@ -55,7 +55,9 @@ LockScreenWithPadlockView::LockScreenWithPadlockView(MWidgetController* controll
     // Connect the notification signals for the unlock screen notification sink
     QObject *notificationManager = ScreenLockExtension::instance()->notificationManagerInterface()->qObject();
     connect(notificationManager, SIGNAL(notificationUpdated(const Notification &)), notificationSink, SLOT(addNotification(const Notification &)));
+    connect(notificationManager, SIGNAL(notificationsUpdated(const QList<Notification> &)), notificationSink, SLOT(addNotifications(const QList<Notification> &)));
     connect(notificationManager, SIGNAL(notificationRemoved(uint)), notificationSink, SLOT(removeNotification(uint)));
+    connect(notificationManager, SIGNAL(notificationsRemoved(const QList<uint> &)), notificationSink, SLOT(removeNotifications(const QList<uint> &)));
     connect(notificationArea, SIGNAL(needToShow(bool)), this, SLOT(showHideNotifications(bool)), Qt::DirectConnection);
 
     layout->addItem(lockLandArea);
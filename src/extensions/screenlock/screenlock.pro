@@ -71,6 +71,7 @@ HEADERS += ../../systemui/contextframeworkcontext.h \
            ../../systemui/statusindicatormenu/notificationarea.h \
            ../../systemui/statusindicatormenu/notificationareamodel.h \
            ../../systemui/notifications/notificationareasink.h \
+           ../../systemui/notifications/notificationsinkdispatcher.h \
            ../../systemui/notifications/widgetnotificationsink.h \
            
 SOURCES += ../../systemui/contextframeworkcontext.cpp \
@@ -80,6 +81,7 @@ SOURCES += ../../systemui/contextframeworkcontext.cpp \
            ../../systemui/statusarea/statusarea.cpp \
            ../../systemui/statusindicatormenu/notificationarea.cpp \
            ../../systemui/notifications/notificationareasink.cpp \
+           ../../systemui/notifications/notificationsinkdispatcher.cpp \
            ../../systemui/notifications/widgetnotificationsink.cpp \
 
 MODEL_HEADERS += ../../systemui/statusarea/clockmodel.h \
@@ -78,6 +78,13 @@ public:
         return QString("timestamp");
     }
 
+    /*!
+     * Returns the keyname of the priority parameter
+     */
+    static QString priorityKey() {
+        return QString("priority");
+    }
+
     /*!
      * Creates a NotificationParameter with the given event type.
      *
@@ -147,6 +154,16 @@ public:
     static NotificationParameter createTimestampParameter(uint timestamp) {
         return NotificationParameter(timestampKey(), QVariant(timestamp));
     }
+
+    /*!
+     * Creates a NotificationParameter with the given priority.
+     *
+     * \param priority the priority of the notification
+     * \return the related NotificationParameter
+     */
+    static NotificationParameter createPriorityParameter(int priority) {
+        return NotificationParameter(priorityKey(), QVariant(priority));
+    }
 };
 
 #endif // GENERICNOTIFICATIONPARAMETERFACTORY_H
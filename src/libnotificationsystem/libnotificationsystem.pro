@@ -32,6 +32,7 @@ HEADERS += \
     notification.h \
     genericnotificationparameterfactory.h \
     notificationwidgetparameterfactory.h \
+    feedbackparameterfactory.h \
     notificationmanagerinterface.h \
     metatypedeclarations.h
 
@@ -21,25 +21,34 @@
 #include "notification.h"
 #include "notificationwidgetparameterfactory.h"
 #include "genericnotificationparameterfactory.h"
+#include "feedbackparameterfactory.h"
+
+NotificationSharedData::NotificationSharedData() :
+    notificationId(0),
+    groupId(0),
+    userId(0),
+    type(Notification::ApplicationEvent),
+    timeout(0),
+    flags(Notification::PersistentFlag),
+    priority(0)
+{
+}
 
 Notification::Notification() :
-    notificationId_(0),
-    groupId_(0),
-    userId_(0),
-    parameters_(),
-    type_(ApplicationEvent),
-    timeout_(0)
+    d(new NotificationSharedData)
 {
 }
 
 Notification::Notification(uint notificationId, uint groupId, uint userId, const NotificationParameters &parameters, NotificationType type, int timeout) :
-    notificationId_(notificationId),
-    groupId_(groupId),
-    userId_(userId),
-    parameters_(parameters),
-    type_(type),
-    timeout_(timeout)
+    d(new NotificationSharedData)
 {
+    d->notificationId = notificationId;
+    d->groupId = groupId;
+    d->userId = userId;
+    d->parameters = parameters;
+    d->type = type;
+    d->timeout = timeout;
+    resolveHeader();
 }
 
 Notification::~Notification()
@@ -48,79 +57,125 @@ Notification::~Notification()
 
 uint Notification::notificationId() const
 {
-    return notificationId_;
+    return d->notificationId;
 }
 
 uint Notification::groupId() const
 {
-    return groupId_;
+    return d->groupId;
 }
 
 uint Notification::userId() const
 {
-    return userId_;
+    return d->userId;
 }
 
 const NotificationParameters &Notification::parameters() const
 {
-    return parameters_;
+    return d->parameters;
 }
 
 void Notification::setParameters(const NotificationParameters &parameters)
 {
-    parameters_ = parameters;
+    d->parameters = parameters;
+    resolveHeader();
 }
 
 void Notification::updateParameters(const NotificationParameters &parameters)
 {
-    parameters_.update(parameters);
+    d->parameters.update(parameters);
+    resolveHeader();
 }
 
 Notification::NotificationType Notification::type() const
 {
-    return type_;
+    return d->type;
 }
 
 int Notification::timeout() const
 {
-    return timeout_;
+    return d->timeout;
+}
+
+bool Notification::isPersistent() const
+{
+    return (d->flags & PersistentFlag) != 0;
+}
+
+bool Notification::hasText() const
+{
+    return (d->flags & HasTextFlag) != 0;
+}
+
+int Notification::priority() const
+{
+    return d->priority;
+}
+
+QString Notification::feedbackId() const
+{
+    return d->feedbackId;
+}
+
+void Notification::resolveHeader()
+{
+    d->flags = 0;
+
+    QVariant persistent = d->parameters.value(GenericNotificationParameterFactory::persistentKey());
+    if (!persistent.isValid() || persistent.toBool()) {
+        d->flags |= PersistentFlag;
+    }
+
+    // A generic text is shown only if it can be looked up from a catalogue
+    if (!d->parameters.value(NotificationWidgetParameterFactory::summaryKey()).toString().isEmpty() ||
+        !d->parameters.value(NotificationWidgetParameterFactory::bodyKey()).toString().isEmpty() ||
+        (!d->parameters.value(NotificationWidgetParameterFactory::genericTextIdKey()).toString().isEmpty() &&
+         !d->parameters.value(NotificationWidgetParameterFactory::genericTextCatalogueKey()).toString().isEmpty())) {
+        d->flags |= HasTextFlag;
+    }
+
+    d->priority = d->parameters.value(GenericNotificationParameterFactory::priorityKey()).toInt();
+    d->feedbackId = d->parameters.value(FeedbackParameterFactory::feedbackIdKey()).toString();
 }
 
 QDataStream &operator<<(QDataStream &datastream, const Notification &notification)
 {
-    datastream << notification.notificationId_;
-    datastream << qint32(notification.type_);
-    datastream << notification.groupId_;
-    datastream << notification.userId_;
-    datastream << notification.timeout_;
-    datastream << notification.parameters_;
+    datastream << notification.d->notificationId;
+    datastream << qint32(notification.d->type);
+    datastream << notification.d->groupId;
+    datastream << notification.d->userId;
+    datastream << notification.d->timeout;
+    datastream << notification.d->parameters;
     return datastream;
 }
 
 QDataStream &operator>>(QDataStream &datastream, Notification &notification)
 {
-    datastream >> notification.notificationId_;
+    datastream >> notification.d->notificationId;
 
     qint32 s;
     datastream >> s;
-    notification.type_ = static_cast<Notification::NotificationType>(s);
+    notification.d->type = static_cast<Notification::NotificationType>(s);
+
+    datastream >> notification.d->groupId;
+    datastream >> notification.d->userId;
+    datastream >> notification.d->timeout;
+    datastream >> notification.d->parameters;
 
-    datastream >> notification.groupId_;
-    datastream >> notification.userId_;
-    datastream >> notification.timeout_;
-    datastream >> notification.parameters_;
+    // The header is not stored since it can be resolved from the parameters
+    notification.resolveHeader();
     return datastream;
 }
 
 QDBusArgument &operator<<(QDBusArgument &argument, const Notification &notification)
 {
     argument.beginStructure();
-    argument << notification.notificationId_;
-    argument << qint32(notification.type_);
-    argument << notification.groupId_;
-    argument << notification.userId_;
-    argument << notification.timeout_;
-    argument << notification.parameters_;
+    argument << notification.d->notificationId;
+    argument << qint32(notification.d->type);
+    argument << notification.d->groupId;
+    argument << notification.d->userId;
+    argument << notification.d->timeout;
+    argument << notification.d->parameters;
     argument.endStructure();
 
     return argument;
@@ -129,17 +184,19 @@ QDBusArgument &operator<<(QDBusArgument &argument, const Notification &notificat
 const QDBusArgument &operator>>(const QDBusArgument &argument, Notification &notification)
 {
     argument.beginStructure();
-    argument >> notification.notificationId_;
+    argument >> notification.d->notificationId;
 
     qint32 s;
     argument >> s;
-    notification.type_ = static_cast<Notification::NotificationType>(s);
+    notification.d->type = static_cast<Notification::NotificationType>(s);
 
-    argument >> notification.groupId_;
-    argument >> notification.userId_;
-    argument >> notification.timeout_;
-    argument >> notification.parameters_;
+    argument >> notification.d->groupId;
+    argument >> notification.d->userId;
+    argument >> notification.d->timeout;
+    argument >> notification.d->parameters;
     argument.endStructure();
 
+    // The header is not transferred since it can be resolved from the parameters
+    notification.resolveHeader();
     return argument;
 }
@@ -23,14 +23,24 @@
 
 #include "notificationparameters.h"
 #include <QVariant>
+#include <QSharedData>
 
 class QDataStream;
 class QDBusArgument;
+class NotificationSharedData;
 
 /*!
  * \brief A class for storing notification information.
  *
  * The information can also be serialized in and out of a QDataStream.
+ *
+ * The parameters that the sinks need for every notification, like the
+ * persistence, the presence of text, the priority and the feedback ID, are resolved once whenever
+ * the parameters are set and stored in a compact header so that they can be
+ * read without looking them up from the parameters.
+ *
+ * Notification is implicitly shared: copying a notification only increments
+ * a reference count and the data is copied when one of the copies is modified.
  */
 class Notification
 {
@@ -123,6 +133,35 @@ public:
      */
     int timeout() const;
 
+    /*!
+     * Returns whether this notification should be kept over a reboot.
+     * Notifications are persistent unless the persistent parameter is false.
+     *
+     * \return \c true if the notification is persistent, \c false otherwise
+     */
+    bool isPersistent() const;
+
+    /*!
+     * Returns whether this notification has a summary, a body or a generic text to be shown.
+     *
+     * \return \c true if the notification has text to be shown, \c false otherwise
+     */
+    bool hasText() const;
+
+    /*!
+     * Returns the priority of this notification.
+     *
+     * \return the value of the priority parameter or 0 if it is not set
+     */
+    int priority() const;
+
+    /*!
+     * Returns the ID of the feedback to be played for this notification.
+     *
+     * \return the value of the feedbackId parameter or an empty string if it is not set
+     */
+    QString feedbackId() const;
+
     friend QDataStream &operator<<(QDataStream &, const Notification &);
     friend QDataStream &operator>>(QDataStream &, Notification &);
 
@@ -130,18 +169,53 @@ public:
     friend const QDBusArgument &operator>>(const QDBusArgument &, Notification &);
 
 private:
+    //! Flags resolved from the parameters
+    enum HeaderFlag {
+        PersistentFlag = 0x1,
+        HasTextFlag = 0x2
+    };
+
+    //! Resolves the header from the parameters. Must be called whenever the parameters change.
+    void resolveHeader();
+
+    //! The data of the notification
+    QSharedDataPointer<NotificationSharedData> d;
+
+    friend class NotificationSharedData;
+};
+
+Q_DECLARE_TYPEINFO(Notification, Q_MOVABLE_TYPE);
+
+/*!
+ * The data of a Notification. Shared by the copies of a notification until
+ * one of them is modified.
+ */
+class NotificationSharedData : public QSharedData
+{
+public:
+    /*!
+     * Constructor. Initializes the values to defaults.
+     */
+    NotificationSharedData();
+
     //! The ID of the notification to be presented
-    uint notificationId_;
+    uint notificationId;
     //! The ID of the notification group
-    uint groupId_;
+    uint groupId;
     //! The user ID associated with this notification
-    uint userId_;
+    uint userId;
     //! The parameters for the notification to be presented
-    NotificationParameters parameters_;
+    NotificationParameters parameters;
     //! The type of the notification to be presented
-    NotificationType type_;
+    Notification::NotificationType type;
     //! The number of milliseconds to present the notification for
-    int timeout_;
+    int timeout;
+    //! The header flags resolved from the parameters
+    quint8 flags;
+    //! The priority resolved from the parameters
+    qint32 priority;
+    //! The feedback ID resolved from the parameters
+    QString feedbackId;
 };
 
 Q_DECLARE_METATYPE(Notification)
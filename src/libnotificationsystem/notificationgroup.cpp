@@ -22,18 +22,23 @@
 #include "notificationwidgetparameterfactory.h"
 #include "genericnotificationparameterfactory.h"
 
+NotificationGroupSharedData::NotificationGroupSharedData() :
+    groupId(0),
+    userId(0)
+{
+}
+
 NotificationGroup::NotificationGroup() :
-    groupId_(0),
-    userId_(0),
-    parameters_()
+    d(new NotificationGroupSharedData)
 {
 }
 
 NotificationGroup::NotificationGroup(uint groupId, uint userId, const NotificationParameters &parameters) :
-    groupId_(groupId),
-    userId_(userId),
-    parameters_(parameters)
+    d(new NotificationGroupSharedData)
 {
+    d->groupId = groupId;
+    d->userId = userId;
+    d->parameters = parameters;
 }
 
 NotificationGroup::~NotificationGroup()
@@ -42,51 +47,51 @@ NotificationGroup::~NotificationGroup()
 
 uint NotificationGroup::groupId() const
 {
-    return groupId_;
+    return d->groupId;
 }
 
 uint NotificationGroup::userId() const
 {
-    return userId_;
+    return d->userId;
 }
 
 const NotificationParameters &NotificationGroup::parameters() const
 {
-    return parameters_;
+    return d->parameters;
 }
 
 void NotificationGroup::setParameters(const NotificationParameters &parameters)
 {
-    parameters_ = parameters;
+    d->parameters = parameters;
 }
 
 void NotificationGroup::updateParameters(const NotificationParameters &parameters)
 {
-    parameters_.update(parameters);
+    d->parameters.update(parameters);
 }
 
 QDataStream &operator<<(QDataStream &datastream, const NotificationGroup &notificationGroup)
 {
-    datastream << notificationGroup.groupId_;
-    datastream << notificationGroup.userId_;
-    datastream << notificationGroup.parameters_;
+    datastream << notificationGroup.d->groupId;
+    datastream << notificationGroup.d->userId;
+    datastream << notificationGroup.d->parameters;
     return datastream;
 }
 
 QDataStream &operator>>(QDataStream &datastream, NotificationGroup &notificationGroup)
 {
-    datastream >> notificationGroup.groupId_;
-    datastream >> notificationGroup.userId_;
-    datastream >> notificationGroup.parameters_;
+    datastream >> notificationGroup.d->groupId;
+    datastream >> notificationGroup.d->userId;
+    datastream >> notificationGroup.d->parameters;
     return datastream;
 }
 
 QDBusArgument &operator<<(QDBusArgument &argument, const NotificationGroup &group)
 {
     argument.beginStructure();
-    argument << group.groupId_;
-    argument << group.userId_;
-    argument << group.parameters_;
+    argument << group.d->groupId;
+    argument << group.d->userId;
+    argument << group.d->parameters;
     argument.endStructure();
 
     return argument;
@@ -95,9 +100,9 @@ QDBusArgument &operator<<(QDBusArgument &argument, const NotificationGroup &grou
 const QDBusArgument &operator>>(const QDBusArgument &argument, NotificationGroup &group)
 {
     argument.beginStructure();
-    argument >> group.groupId_;
-    argument >> group.userId_;
-    argument >> group.parameters_;
+    argument >> group.d->groupId;
+    argument >> group.d->userId;
+    argument >> group.d->parameters;
     argument.endStructure();
 
     return argument;
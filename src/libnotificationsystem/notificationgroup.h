@@ -23,14 +23,19 @@
 
 #include "notificationparameters.h"
 #include <QVariant>
+#include <QSharedData>
 
 class QDataStream;
 class QDBusArgument;
+class NotificationGroupSharedData;
 
 /*!
  * \brief A class for storing notification group information.
  *
  * The information can also be serialized in and out of a QDataStream.
+ *
+ * NotificationGroup is implicitly shared: copying a group only increments a
+ * reference count and the data is copied when one of the copies is modified.
  */
 class NotificationGroup
 {
@@ -98,12 +103,30 @@ public:
     friend const QDBusArgument &operator>>(const QDBusArgument &, NotificationGroup &);
 
 private:
+    //! The data of the notification group
+    QSharedDataPointer<NotificationGroupSharedData> d;
+};
+
+Q_DECLARE_TYPEINFO(NotificationGroup, Q_MOVABLE_TYPE);
+
+/*!
+ * The data of a NotificationGroup. Shared by the copies of a group until one
+ * of them is modified.
+ */
+class NotificationGroupSharedData : public QSharedData
+{
+public:
+    /*!
+     * Constructor. Initializes the values to defaults.
+     */
+    NotificationGroupSharedData();
+
     //! The ID of the notification group
-    uint groupId_;
+    uint groupId;
     //! The user ID associated with this notification group
-    uint userId_;
+    uint userId;
     //! The parameters for the notification group to be presented
-    NotificationParameters parameters_;
+    NotificationParameters parameters;
 };
 
 Q_DECLARE_METATYPE(NotificationGroup)
@@ -21,6 +21,7 @@
 #define NOTIFICATIONMANAGERINTERFACE_H
 
 #include <QString>
+#include <QPair>
 #include "notificationparameters.h"
 #include "notification.h"
 #include "notificationgroup.h"
@@ -61,6 +62,62 @@ public:
      */
     virtual bool updateNotification(uint notificationUserId, uint notificationId, const NotificationParameters &parameters = NotificationParameters()) = 0;
 
+    /*!
+     * Adds a number of notifications in one go. The notifications are added
+     * in a single transaction: the changes are written to the persistent
+     * storage once and the sinks are informed about the new notifications at
+     * once after all of them have been added.
+     *
+     * A notification with an invalid group ID is not added. In this case 0 is
+     * returned in its place.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param notifications a list of notification group IDs and parameters for the notifications
+     * \return a list of notification IDs in the same order as \a notifications
+     */
+    virtual QList<uint> addNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications) = 0;
+
+    /*!
+     * Updates a number of notifications in one go. The notifications are
+     * updated in a single transaction.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param notifications a list of notification IDs and parameters for the notifications
+     * \return true if all updates succeeded, false otherwise
+     */
+    virtual bool updateNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications) = 0;
+
+    /*!
+     * Removes a number of notifications in one go. The notifications are
+     * removed in a single transaction.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param notificationIds the IDs of the notifications to be removed
+     * \return true if all removals succeeded, false otherwise
+     */
+    virtual bool removeNotifications(uint notificationUserId, const QList<uint> &notificationIds) = 0;
+
+    /*!
+     * Adds a notification with the given identifier or updates the
+     * notification of the user that already has the identifier.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param groupId the notification group where a new notification is added. Not used when an existing notification is updated.
+     * \param identifier the user supplied identifier of the notification
+     * \param parameters Parameters for the notification
+     * \return the ID of the added or updated notification, or 0 if the notification could not be added or updated
+     */
+    virtual uint addOrUpdateNotification(uint notificationUserId, uint groupId, const QString &identifier, const NotificationParameters &parameters = NotificationParameters()) = 0;
+
+    /*!
+     * Removes the notifications of the user that have the given identifier.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param identifier the user supplied identifier of the notifications
+     * \return true if notifications with the identifier were found and removed, false otherwise
+     */
+    virtual bool removeNotificationsWithIdentifier(uint notificationUserId, const QString &identifier) = 0;
+
     /*!
      * Adds a new notification group. Later on notifications can be added to
      * this group.
@@ -91,6 +148,26 @@ public:
      */
     virtual bool removeGroup(uint notificationUserId, uint groupId) = 0;
 
+    /*!
+     * Adds a notification group with the given identifier or updates the
+     * group of the user that already has the identifier.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param identifier the user supplied identifier of the notification group
+     * \param parameters Parameters for the notification group
+     * \return the ID of the added or updated notification group, or 0 if the group could not be updated
+     */
+    virtual uint addOrUpdateGroup(uint notificationUserId, const QString &identifier, const NotificationParameters &parameters = NotificationParameters()) = 0;
+
+    /*!
+     * Removes the notification groups of the user that have the given identifier.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param identifier the user supplied identifier of the notification groups
+     * \return true if groups with the identifier were found and removed, false otherwise
+     */
+    virtual bool removeGroupsWithIdentifier(uint notificationUserId, const QString &identifier) = 0;
+
     //! Returns copy of groups known to manager
     virtual QList<NotificationGroup> groups() const = 0;
 
@@ -154,6 +231,95 @@ public:
      */
     virtual uint notificationCountInGroup(uint notificationUserId, uint groupId) = 0;
 
+    /*!
+     * Returns a page of the notifications of a user that match the given
+     * criteria, in ascending notification ID order. Empty strings and zeros
+     * in the criteria match all notifications.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param eventType only notifications with this event type are returned
+     * \param groupId only notifications in this group are returned
+     * \param identifier only notifications with this identifier are returned
+     * \param sinceTimestamp only notifications with a timestamp later than this are returned
+     * \param lastId the ID of the last notification of the previous page. Only notifications with a higher ID are returned.
+     * \param limit the maximum number of notifications to return. 0 returns all of them.
+     * \return list of notifications that match the criteria
+     */
+    virtual QList<Notification> queryNotifications(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit) = 0;
+
+    /*!
+     * Returns the number of notifications of a user that match the given
+     * criteria. The criteria are the same as in \c queryNotifications.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param eventType only notifications with this event type are counted
+     * \param groupId only notifications in this group are counted
+     * \param identifier only notifications with this identifier are counted
+     * \param sinceTimestamp only notifications with a timestamp later than this are counted
+     * \return the number of notifications that match the criteria
+     */
+    virtual uint queryNotificationCount(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp) = 0;
+
+    /*!
+     * Returns a page of the notification groups of a user that match the
+     * given criteria, in ascending group ID order. Empty strings and zeros
+     * in the criteria match all groups.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param eventType only groups with this event type are returned
+     * \param identifier only groups with this identifier are returned
+     * \param sinceTimestamp only groups with a timestamp later than this are returned
+     * \param lastId the ID of the last group of the previous page. Only groups with a higher ID are returned.
+     * \param limit the maximum number of groups to return. 0 returns all of them.
+     * \return list of notification groups that match the criteria
+     */
+    virtual QList<NotificationGroup> queryGroups(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit) = 0;
+
+    /*!
+     * Returns the number of notification groups of a user that match the
+     * given criteria. The criteria are the same as in \c queryGroups.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param eventType only groups with this event type are counted
+     * \param identifier only groups with this identifier are counted
+     * \param sinceTimestamp only groups with a timestamp later than this are counted
+     * \return the number of notification groups that match the criteria
+     */
+    virtual uint queryGroupCount(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp) = 0;
+
+    /*!
+     * Returns the change sequence number of the latest change made to the
+     * notifications and groups. The sequence number increases with every
+     * change, so it can be used as a cursor for fetching the changes made
+     * after it.
+     *
+     * \return the sequence number of the latest change
+     */
+    virtual quint64 changeSequence() const = 0;
+
+    /*!
+     * Returns whether the changes made after the given change sequence
+     * number are still known. If they are not, for example because the
+     * sequence number is too old or was handed out before the manager was
+     * restarted, all groups and notifications have to be fetched instead.
+     *
+     * \param sequence the change sequence number
+     * \return \c true if the changes made after the sequence number are known, \c false otherwise
+     */
+    virtual bool changesKnownSince(quint64 sequence) const = 0;
+
+    //! Returns the groups that have been added or updated after the given change sequence number
+    virtual QList<NotificationGroup> groupsChangedSince(quint64 sequence) const = 0;
+
+    //! Returns the notifications that have been added or updated after the given change sequence number
+    virtual QList<Notification> notificationsChangedSince(quint64 sequence) const = 0;
+
+    //! Returns the IDs of the groups that have been removed after the given change sequence number
+    virtual QList<uint> groupIdsRemovedSince(quint64 sequence) const = 0;
+
+    //! Returns the IDs of the notifications that have been removed after the given change sequence number
+    virtual QList<uint> notificationIdsRemovedSince(quint64 sequence) const = 0;
+
     /*!
      * Returns the qObject that implements the manager for signal connections.
      *
@@ -18,10 +18,55 @@
 ****************************************************************************/
 
 #include <QDBusArgument>
+#include <QDataStream>
+#include <QtAlgorithms>
 
 #include "notificationparameters.h"
 #include "notificationparameter.h"
 
+//! The number of well-known parameter names
+static const int WELL_KNOWN_KEY_COUNT = 19;
+
+/*!
+ * Returns the registry of well-known parameter names. The names are in
+ * ascending order so that the index of a name, its key ID, can be found with
+ * a binary search.
+ */
+static const QString *wellKnownKeys()
+{
+    static const QString keys[WELL_KNOWN_KEY_COUNT] = {
+        QString("action"),
+        QString("body"),
+        QString("class"),
+        QString("count"),
+        QString("eventType"),
+        QString("feedbackId"),
+        QString("genericTextCatalogue"),
+        QString("genericTextId"),
+        QString("iconId"),
+        QString("identifier"),
+        QString("imageId"),
+        QString("persistent"),
+        QString("previewIconId"),
+        QString("priority"),
+        QString("statusAreaIconId"),
+        QString("summary"),
+        QString("timestamp"),
+        QString("unseen"),
+        QString("userRemovable")
+    };
+    return keys;
+}
+
+//! Returns the key ID of a parameter name or -1 if the name is not a well-known one
+static int wellKnownKeyId(const QString &key)
+{
+    const QString *keys = wellKnownKeys();
+    const QString *end = keys + WELL_KNOWN_KEY_COUNT;
+    const QString *i = qBinaryFind(keys, end, key);
+    return i != end ? i - keys : -1;
+}
+
 NotificationParameters::NotificationParameters()
 {
 }
@@ -32,52 +77,201 @@ NotificationParameters::~NotificationParameters()
 
 void NotificationParameters::add(const QString &parameter, const QVariant &value)
 {
-    parameterValues.insert(parameter, value);
+    int keyId = wellKnownKeyId(parameter);
+    if (keyId >= 0) {
+        int position = knownValuePosition(values.knownValues, keyId);
+        if (position < values.knownValues.count() && values.knownValues.at(position).keyId == keyId) {
+            values.knownValues[position].value = value;
+        } else {
+            KnownValue knownValue = { keyId, value };
+            values.knownValues.insert(position, knownValue);
+        }
+    } else {
+        values.customValues.insert(parameter, value);
+    }
 }
 
 void NotificationParameters::add(const NotificationParameter &parameter)
 {
-    parameterValues.insert(parameter.name(), parameter.value());
+    add(parameter.name(), parameter.value());
 }
 
 void NotificationParameters::update(const NotificationParameters &parameters)
 {
-    foreach (const QString &key, parameters.parameterValues.keys()) {
-        parameterValues[key] = parameters.parameterValues[key];
+    mergeKnownValues(values.knownValues, parameters.values.knownValues);
+
+    const QHash<QString, QVariant> &customValues = parameters.values.customValues;
+    for (QHash<QString, QVariant>::const_iterator i = customValues.constBegin(); i != customValues.constEnd(); ++i) {
+        values.customValues.insert(i.key(), i.value());
     }
 }
 
+void NotificationParameters::setDefaults(const NotificationParameters &defaults)
+{
+    this->defaults = defaults.values;
+}
+
+NotificationParameters NotificationParameters::overrides() const
+{
+    NotificationParameters parameters;
+    parameters.values = values;
+    return parameters;
+}
+
 QVariant NotificationParameters::value(const QString &parameter) const
 {
-    return parameterValues.value(parameter);
+    int keyId = wellKnownKeyId(parameter);
+    if (keyId >= 0) {
+        int index = knownValueIndex(values.knownValues, keyId);
+        if (index >= 0) {
+            return values.knownValues.at(index).value;
+        }
+
+        index = knownValueIndex(defaults.knownValues, keyId);
+        return index >= 0 ? defaults.knownValues.at(index).value : QVariant();
+    }
+
+    QHash<QString, QVariant>::const_iterator i = values.customValues.constFind(parameter);
+    if (i != values.customValues.constEnd()) {
+        return *i;
+    }
+
+    return defaults.customValues.value(parameter);
+}
+
+QList<QString> NotificationParameters::keys() const
+{
+    QList<QString> parameterKeys;
+
+    // Both vectors are sorted by the key ID so the keys of the parameters with well-known names can be merged in one pass
+    const QString *names = wellKnownKeys();
+    const QVector<KnownValue> &knownValues = values.knownValues;
+    const QVector<KnownValue> &knownDefaults = defaults.knownValues;
+    int i = 0;
+    int j = 0;
+    while (i < knownValues.count() || j < knownDefaults.count()) {
+        if (j == knownDefaults.count() || (i < knownValues.count() && knownValues.at(i).keyId <= knownDefaults.at(j).keyId)) {
+            if (j < knownDefaults.count() && knownValues.at(i).keyId == knownDefaults.at(j).keyId) {
+                ++j;
+            }
+            parameterKeys.append(names[knownValues.at(i++).keyId]);
+        } else {
+            parameterKeys.append(names[knownDefaults.at(j++).keyId]);
+        }
+    }
+
+    parameterKeys.append(values.customValues.keys());
+    for (QHash<QString, QVariant>::const_iterator k = defaults.customValues.constBegin(); k != defaults.customValues.constEnd(); ++k) {
+        if (!values.customValues.contains(k.key())) {
+            parameterKeys.append(k.key());
+        }
+    }
+    return parameterKeys;
 }
 
 int NotificationParameters::count() const
 {
-    return parameterValues.count();
+    if (defaults.knownValues.isEmpty() && defaults.customValues.isEmpty()) {
+        return values.knownValues.count() + values.customValues.count();
+    }
+
+    return keys().count();
+}
+
+int NotificationParameters::knownValuePosition(const QVector<KnownValue> &knownValues, int keyId)
+{
+    int begin = 0;
+    int end = knownValues.count();
+    while (begin < end) {
+        int middle = (begin + end) / 2;
+        if (knownValues.at(middle).keyId < keyId) {
+            begin = middle + 1;
+        } else {
+            end = middle;
+        }
+    }
+    return begin;
+}
+
+int NotificationParameters::knownValueIndex(const QVector<KnownValue> &knownValues, int keyId)
+{
+    int position = knownValuePosition(knownValues, keyId);
+    return position < knownValues.count() && knownValues.at(position).keyId == keyId ? position : -1;
+}
+
+void NotificationParameters::mergeKnownValues(QVector<KnownValue> &target, const QVector<KnownValue> &source)
+{
+    if (source.isEmpty()) {
+        return;
+    }
+
+    if (target.isEmpty()) {
+        // Nothing to merge: share the source
+        target = source;
+        return;
+    }
+
+    QVector<KnownValue> merged;
+    merged.reserve(target.count() + source.count());
+    int i = 0;
+    int j = 0;
+    while (i < target.count() || j < source.count()) {
+        if (j == source.count() || (i < target.count() && target.at(i).keyId < source.at(j).keyId)) {
+            merged.append(target.at(i++));
+        } else {
+            if (i < target.count() && target.at(i).keyId == source.at(j).keyId) {
+                ++i;
+            }
+            merged.append(source.at(j++));
+        }
+    }
+    target = merged;
 }
 
 QDataStream &operator<<(QDataStream &datastream, const NotificationParameters &parameters)
 {
-    return datastream << parameters.parameterValues;
+    // The parameters are written in the format of QHash<QString, QVariant>
+    const NotificationParameters::Values &values = parameters.values;
+    datastream << quint32(values.knownValues.count() + values.customValues.count());
+
+    const QString *names = wellKnownKeys();
+    foreach (const NotificationParameters::KnownValue &knownValue, values.knownValues) {
+        datastream << names[knownValue.keyId] << knownValue.value;
+    }
+
+    for (QHash<QString, QVariant>::const_iterator i = values.customValues.constBegin(); i != values.customValues.constEnd(); ++i) {
+        datastream << i.key() << i.value();
+    }
+    return datastream;
 }
 
 QDataStream &operator>>(QDataStream &datastream, NotificationParameters &parameters)
 {
-    return datastream >> parameters.parameterValues;
+    parameters.values = NotificationParameters::Values();
+
+    quint32 count;
+    datastream >> count;
+    for (quint32 i = 0; i < count && datastream.status() == QDataStream::Ok; ++i) {
+        QString key;
+        QVariant value;
+        datastream >> key >> value;
+        parameters.add(key, value);
+    }
+
+    if (datastream.status() != QDataStream::Ok) {
+        parameters.values = NotificationParameters::Values();
+    }
+    return datastream;
 }
 
 QDBusArgument &operator<<(QDBusArgument &argument, const NotificationParameters &parameters)
 {
-    QHashIterator<QString, QVariant> i(parameters.parameterValues);
-
+    // The receiver doesn't know the defaults so they are sent along with the parameters
     argument.beginMap(QMetaType::QString, qMetaTypeId<QDBusVariant>());
-    while (i.hasNext()) {
-        i.next();
-
+    foreach (const QString &key, parameters.keys()) {
         argument.beginMapEntry();
-        argument << i.key();
-        argument << QDBusVariant(i.value());
+        argument << key;
+        argument << QDBusVariant(parameters.value(key));
         argument.endMapEntry();
     }
     argument.endMap();
@@ -96,7 +290,7 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, NotificationParam
         argument >> value;
         argument.endMapEntry ();
 
-        parameters.parameterValues[key] = value.variant();
+        parameters.add(key, value.variant());
     }
     argument.endMap();
     return argument;
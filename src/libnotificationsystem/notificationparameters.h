@@ -21,6 +21,7 @@
 #define NOTIFICATIONPARAMETERS_H
 
 #include <QHash>
+#include <QVector>
 #include <QVariant>
 
 class QDataStream;
@@ -30,6 +31,12 @@ class NotificationParameter;
 /*!
  * Notification parameters is a class for providing parameters for classes that
  * can present notifications.
+ *
+ * The parameters with well-known names, like the ones created by the
+ * parameter factories, are stored in a small vector sorted by the index of the
+ * name in a fixed registry of names instead of a hash. This avoids storing and
+ * hashing the same names for every notification. Parameters with other names
+ * are stored in a hash.
  */
 class NotificationParameters
 {
@@ -68,7 +75,26 @@ public:
     void update(const NotificationParameters &parameters);
 
     /*!
-     * Returns the value of a parameter.
+     * Sets the default parameters. The value of a default parameter is
+     * used when the parameter has not been added to these parameters.
+     * The defaults are implicitly shared, so setting the same defaults to
+     * several parameters doesn't copy them. The defaults of \a defaults
+     * are not used.
+     *
+     * \param defaults the default parameters
+     */
+    void setDefaults(const NotificationParameters &defaults);
+
+    /*!
+     * Returns the parameters added to these parameters without the defaults.
+     *
+     * \return the parameters that override the defaults
+     */
+    NotificationParameters overrides() const;
+
+    /*!
+     * Returns the value of a parameter. If the parameter has not been
+     * added the default value of the parameter is returned.
      *
      * \param parameter the name of the parameter
      * \return the value of the parameter
@@ -76,7 +102,16 @@ public:
     QVariant value(const QString &parameter) const;
 
     /*!
-     * Returns the number of parameters stored in this container.
+     * Returns the names of all parameters stored in this container,
+     * including the defaults.
+     *
+     * \return the names of the parameters
+     */
+    QList<QString> keys() const;
+
+    /*!
+     * Returns the number of parameters stored in this container,
+     * including the defaults.
      *
      * \return the number of parameters stored
      */
@@ -89,12 +124,44 @@ public:
     friend const QDBusArgument &operator>>(const QDBusArgument &, NotificationParameters &);
 
 private:
-    //! The mapping between the name of each parameter and its value
-    QHash<QString, QVariant> parameterValues;
+    //! A parameter with a well-known name
+    struct KnownValue {
+        //! The index of the name of the parameter in the registry of well-known names
+        int keyId;
+        //! The value of the parameter
+        QVariant value;
+    };
+
+    //! The values of a set of parameters
+    struct Values {
+        //! The parameters with well-known names sorted by the key ID
+        QVector<KnownValue> knownValues;
+        //! The mapping between the name of each other parameter and its value
+        QHash<QString, QVariant> customValues;
+    };
+
+    /*!
+     * Returns the position of the first parameter with a key ID equal to or
+     * greater than \a keyId in \a knownValues.
+     */
+    static int knownValuePosition(const QVector<KnownValue> &knownValues, int keyId);
+
+    //! Returns the index of the parameter with the given key ID in \a knownValues or -1 if there is none
+    static int knownValueIndex(const QVector<KnownValue> &knownValues, int keyId);
+
+    //! Merges the parameters in \a source to \a target. The values in \a source replace the values in \a target.
+    static void mergeKnownValues(QVector<KnownValue> &target, const QVector<KnownValue> &source);
+
+    //! The parameters added to these parameters
+    Values values;
+
+    //! The values of the parameters that have not been added. Shared between the parameters that have the same defaults.
+    Values defaults;
 };
 
 /*!
- * Serializes the given NotificationParameters to a QDataStream
+ * Serializes the given NotificationParameters to a QDataStream. The
+ * defaults are not serialized.
  *
  * \param datastream QDataStream to write to
  * \param parameters NotificationParameters object to serialize
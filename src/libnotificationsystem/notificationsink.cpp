@@ -25,6 +25,20 @@ NotificationSink::NotificationSink(QObject *parent) :
 {
 }
 
+void NotificationSink::addNotifications(const QList<Notification> &notifications)
+{
+    foreach (const Notification &notification, notifications) {
+        addNotification(notification);
+    }
+}
+
+void NotificationSink::removeNotifications(const QList<uint> &notificationIds)
+{
+    foreach (uint notificationId, notificationIds) {
+        removeNotification(notificationId);
+    }
+}
+
 void NotificationSink::addGroup(uint groupId, const NotificationParameters &parameters)
 {
     Q_UNUSED(groupId)
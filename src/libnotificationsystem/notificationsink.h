@@ -58,6 +58,16 @@ public slots:
      */
     virtual void addNotification(const Notification &notification) = 0;
 
+    /*!
+     * Adds a number of notifications to be presented. The default
+     * implementation calls addNotification() for each notification. Sinks
+     * that can present several notifications more efficiently at once may
+     * override this.
+     *
+     * \param notifications the data of the notifications
+     */
+    virtual void addNotifications(const QList<Notification> &notifications);
+
     /*!
      * Removes a notification.
      *
@@ -65,6 +75,15 @@ public slots:
      */
     virtual void removeNotification(uint notificationId) = 0;
 
+    /*!
+     * Removes a number of notifications. The default implementation calls
+     * removeNotification() for each notification. Sinks that can remove
+     * several notifications more efficiently at once may override this.
+     *
+     * \param notificationIds the IDs of the notifications to be removed
+     */
+    virtual void removeNotifications(const QList<uint> &notificationIds);
+
     /*!
      * Creates a notification group.
      *
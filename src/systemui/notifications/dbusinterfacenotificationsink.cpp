@@ -19,88 +19,228 @@
 #include "dbusinterfacenotificationsink.h"
 #include "dbusinterfacenotificationsinkadaptor.h"
 #include "dbusinterfacenotificationsinkproxy.h"
+#include "dbusinterfacenotificationsinkqueue.h"
+#include "notificationsinkfilter.h"
 #include "notificationmanagerinterface.h"
 
+//! The maximum number of calls to an external sink waiting for a reply at a time
+static const int MAX_PENDING_CALLS = 32;
+
+//! The maximum number of calls queued for an external sink that is not replying
+static const int MAX_QUEUE_DEPTH = 1000;
+
 DBusInterfaceNotificationSink::DBusInterfaceNotificationSink(NotificationManagerInterface *interface) :
         notificationManager(interface)
 {
     new DBusInterfaceNotificationSinkAdaptor(this);
+
+    serviceWatcher.setConnection(QDBusConnection::sessionBus());
+    serviceWatcher.setWatchMode(QDBusServiceWatcher::WatchForUnregistration);
+    connect(&serviceWatcher, SIGNAL(serviceUnregistered(QString)), this, SLOT(unregisterSinks(QString)));
 }
 
 DBusInterfaceNotificationSink::~DBusInterfaceNotificationSink()
 {
 }
 
-void DBusInterfaceNotificationSink::registerSink(const QString &service, const QString &path)
+DBusInterfaceNotificationSinkQueue *DBusInterfaceNotificationSink::createQueue(const QString &service, const QString &path, const NotificationSinkFilter &filter)
 {
     ProxyAddress proxy(service, path);
     DBusInterface proxyInterface(new DBusInterfaceNotificationSinkProxy(service, path, QDBusConnection::sessionBus()));
-    proxies.insert(proxy, proxyInterface);
+    SinkQueue sinkQueue(new DBusInterfaceNotificationSinkQueue(proxyInterface, notificationManager, MAX_PENDING_CALLS, MAX_QUEUE_DEPTH, filter));
+    connect(sinkQueue.data(), SIGNAL(resyncNeeded(quint64)), this, SLOT(resynchronize(quint64)));
+    queues.insert(proxy, sinkQueue);
+    if (!serviceWatcher.watchedServices().contains(service)) {
+        serviceWatcher.addWatchedService(service);
+    }
     QDBusConnection::sessionBus().connect(service, path, DBusInterfaceNotificationSinkProxy::staticInterfaceName(), "notificationRemovalRequested", this, SIGNAL(notificationRemovalRequested(uint)));
     QDBusConnection::sessionBus().connect(service, path, DBusInterfaceNotificationSinkProxy::staticInterfaceName(), "notificationGroupClearingRequested", this, SIGNAL(notificationGroupClearingRequested(uint)));
-    sendCurrentNotifications(proxyInterface);
+    return sinkQueue.data();
+}
+
+void DBusInterfaceNotificationSink::registerSink(const QString &service, const QString &path)
+{
+    DBusInterfaceNotificationSinkQueue *sinkQueue = createQueue(service, path, NotificationSinkFilter());
+    sinkQueue->beginSync(0);
+    sendCurrentNotifications(sinkQueue);
+    sinkQueue->endSync();
+}
+
+void DBusInterfaceNotificationSink::registerSinkWithFilter(const QString &service, const QString &path, const QStringList &eventTypes, uint notificationUserId, const QString &notificationClass, bool groups)
+{
+    DBusInterfaceNotificationSinkQueue *sinkQueue = createQueue(service, path, NotificationSinkFilter(eventTypes, notificationUserId, notificationClass, groups));
+    sinkQueue->beginSync(0);
+    sendCurrentNotifications(sinkQueue);
+    sinkQueue->endSync();
+}
+
+quint64 DBusInterfaceNotificationSink::registerSinkWithCursor(const QString &service, const QString &path, quint64 cursor, bool &fullResync)
+{
+    DBusInterfaceNotificationSinkQueue *sinkQueue = createQueue(service, path, NotificationSinkFilter());
+    fullResync = !synchronize(cursor, sinkQueue);
+
+    if (sinkQueue->queueDepth() > 0) {
+        // The rest of the changes are sent after the reply once the sink has replied to the calls already sent
+        return fullResync ? 0 : cursor;
+    }
+    // The calls already sent reach the sink before the reply
+    return notificationManager != NULL ? notificationManager->changeSequence() : 0;
+}
+
+quint64 DBusInterfaceNotificationSink::cursor(const QString &service, const QString &path) const
+{
+    DBusInterfaceNotificationSinkQueue *sinkQueue = queue(service, path);
+    return sinkQueue != NULL ? sinkQueue->cursor() : 0;
 }
 
 void DBusInterfaceNotificationSink::unregisterSink(const QString &service, const QString &path)
 {
-    proxies.remove(ProxyAddress(service, path));
+    queues.remove(ProxyAddress(service, path));
+
+    foreach (const ProxyAddress &address, queues.keys()) {
+        if (address.first == service) {
+            return;
+        }
+    }
+    serviceWatcher.removeWatchedService(service);
+}
+
+void DBusInterfaceNotificationSink::unregisterSinks(const QString &service)
+{
+    foreach (const ProxyAddress &address, queues.keys()) {
+        if (address.first == service) {
+            queues.remove(address);
+        }
+    }
+    serviceWatcher.removeWatchedService(service);
+}
+
+DBusInterfaceNotificationSinkQueue *DBusInterfaceNotificationSink::queue(const QString &service, const QString &path) const
+{
+    return queues.value(ProxyAddress(service, path)).data();
+}
+
+int DBusInterfaceNotificationSink::queueDepth(const QString &service, const QString &path) const
+{
+    DBusInterfaceNotificationSinkQueue *sinkQueue = queue(service, path);
+    return sinkQueue != NULL ? sinkQueue->queueDepth() : 0;
+}
+
+int DBusInterfaceNotificationSink::peakQueueDepth(const QString &service, const QString &path) const
+{
+    DBusInterfaceNotificationSinkQueue *sinkQueue = queue(service, path);
+    return sinkQueue != NULL ? sinkQueue->peakQueueDepth() : 0;
+}
+
+int DBusInterfaceNotificationSink::pendingCallCount(const QString &service, const QString &path) const
+{
+    DBusInterfaceNotificationSinkQueue *sinkQueue = queue(service, path);
+    return sinkQueue != NULL ? sinkQueue->pendingCallCount() : 0;
+}
+
+uint DBusInterfaceNotificationSink::dropCount(const QString &service, const QString &path) const
+{
+    DBusInterfaceNotificationSinkQueue *sinkQueue = queue(service, path);
+    return sinkQueue != NULL ? sinkQueue->dropCount() : 0;
+}
+
+void DBusInterfaceNotificationSink::resynchronize(quint64 sequence)
+{
+    DBusInterfaceNotificationSinkQueue *sinkQueue = qobject_cast<DBusInterfaceNotificationSinkQueue *>(sender());
+    if (sinkQueue != NULL) {
+        synchronize(sequence, sinkQueue);
+    }
+}
+
+bool DBusInterfaceNotificationSink::synchronize(quint64 cursor, DBusInterfaceNotificationSinkQueue *sinkQueue) const
+{
+    sinkQueue->beginSync(cursor);
+    bool changesSent = sendChangesSince(cursor, sinkQueue);
+    if (!changesSent) {
+        // The sink is sent everything, so it is not synchronized to any change until that has been delivered
+        sinkQueue->beginSync(0);
+        sendCurrentNotifications(sinkQueue);
+    }
+    sinkQueue->endSync();
+    return changesSent;
 }
 
 void DBusInterfaceNotificationSink::addNotification(const Notification &notification)
 {
     if (notification.type() != Notification::SystemEvent) {
         // Do not handle system events at all
-        foreach (QSharedPointer<DBusInterfaceNotificationSinkProxy> proxy, proxies) {
-            proxy->addNotification(notification);
+        foreach (const SinkQueue &sinkQueue, queues) {
+            sinkQueue->addNotification(notification);
         }
     }
 }
 
 void DBusInterfaceNotificationSink::removeNotification(uint notificationId)
 {
-    foreach (QSharedPointer<DBusInterfaceNotificationSinkProxy> proxy, proxies) {
-        proxy->removeNotification(notificationId);
+    foreach (const SinkQueue &sinkQueue, queues) {
+        sinkQueue->removeNotification(notificationId);
     }
 }
 
 void DBusInterfaceNotificationSink::addGroup(uint groupId, const NotificationParameters &parameters)
 {
-    foreach (QSharedPointer<DBusInterfaceNotificationSinkProxy> proxy, proxies) {
-        proxy->addGroup(groupId, parameters);
+    foreach (const SinkQueue &sinkQueue, queues) {
+        sinkQueue->addGroup(groupId, parameters);
     }
 }
 
 void DBusInterfaceNotificationSink::removeGroup(uint groupId)
 {
-    foreach (QSharedPointer<DBusInterfaceNotificationSinkProxy> proxy, proxies) {
-        proxy->removeGroup(groupId);
+    foreach (const SinkQueue &sinkQueue, queues) {
+        sinkQueue->removeGroup(groupId);
     }
 }
 
-void DBusInterfaceNotificationSink::sendGroupsToProxy(const QList<NotificationGroup> &groups, const DBusInterface &proxy) const
+void DBusInterfaceNotificationSink::sendGroupsToSink(const QList<NotificationGroup> &groups, DBusInterfaceNotificationSinkQueue *sinkQueue) const
 {
     foreach(const NotificationGroup &group, groups) {
-        proxy->addGroup(group.groupId(), group.parameters());
+        sinkQueue->addGroup(group.groupId(), group.parameters());
     }
 }
 
-void DBusInterfaceNotificationSink::sendNotificationsToProxy(const QList<Notification> &notifications, const DBusInterface &proxy) const
+void DBusInterfaceNotificationSink::sendNotificationsToSink(const QList<Notification> &notifications, DBusInterfaceNotificationSinkQueue *sinkQueue) const
 {
     foreach(const Notification &notification, notifications) {
         if (notification.type() != Notification::SystemEvent) {
             // Do not handle system events at all
-            proxy->addNotification(notification);
+            sinkQueue->addNotification(notification);
         }
     }
 }
 
-void DBusInterfaceNotificationSink::sendCurrentNotifications(const DBusInterface &proxyInterface) const
+void DBusInterfaceNotificationSink::sendCurrentNotifications(DBusInterfaceNotificationSinkQueue *sinkQueue) const
 {
     if (notificationManager != NULL) {
         QList<NotificationGroup> groups = notificationManager->groups();
-        sendGroupsToProxy(groups, proxyInterface);
+        sendGroupsToSink(groups, sinkQueue);
 
         QList<Notification> notifications = notificationManager->notifications();
-        sendNotificationsToProxy(notifications, proxyInterface);
+        sendNotificationsToSink(notifications, sinkQueue);
     }
 }
+
+bool DBusInterfaceNotificationSink::sendChangesSince(quint64 cursor, DBusInterfaceNotificationSinkQueue *sinkQueue) const
+{
+    if (notificationManager == NULL || !notificationManager->changesKnownSince(cursor)) {
+        return false;
+    }
+
+    // Notifications are removed before their groups and added after them
+    foreach (uint notificationId, notificationManager->notificationIdsRemovedSince(cursor)) {
+        sinkQueue->removeNotification(notificationId);
+    }
+
+    foreach (uint groupId, notificationManager->groupIdsRemovedSince(cursor)) {
+        sinkQueue->removeGroup(groupId);
+    }
+
+    sendGroupsToSink(notificationManager->groupsChangedSince(cursor), sinkQueue);
+    sendNotificationsToSink(notificationManager->notificationsChangedSince(cursor), sinkQueue);
+
+    return true;
+}
@@ -21,14 +21,27 @@
 #define DBUSINTERFACENOTIFICATIONSINK_H_
 
 #include <QSharedPointer>
+#include <QDBusServiceWatcher>
+#include <QStringList>
 #include "notificationsink.h"
 #include "notificationgroup.h"
 
 class DBusInterfaceNotificationSinkProxy;
+class DBusInterfaceNotificationSinkQueue;
+class NotificationSinkFilter;
 class NotificationManagerInterface;
 
 /*!
  * A notification sink that handles communication with external sinks.
+ *
+ * The changes are sent to each external sink through an outgoing queue of
+ * its own, so a sink that is slow to reply does not delay the others and
+ * does not make the calls to it pile up without bound. External sinks are
+ * unregistered automatically when their D-Bus service goes away.
+ *
+ * An external sink may register with a filter that selects the notifications
+ * and groups it wants. The filter is applied before anything is sent, so the
+ * notifications a sink does not want cause no D-Bus traffic to it.
  */
 class DBusInterfaceNotificationSink : public NotificationSink
 {
@@ -54,6 +67,45 @@ public:
      */
     void registerSink(const QString &service, const QString &path);
 
+    /*!
+     * Registers an external sink at the given path. The sink is sent only
+     * the notifications that match the given filter.
+     *
+     * \param service D-Bus service name for the sink
+     * \param path D-Bus path name for the sink
+     * \param eventTypes the event types of the wanted notifications. May contain the wildcards \c *, \c ? and \c [...]. An empty list matches every event type.
+     * \param notificationUserId the user ID of the wanted notifications or 0 for every user ID
+     * \param notificationClass the class of the wanted notifications or an empty string for every class. System notifications are never sent to external sinks, so the \c system class matches no notifications.
+     * \param groups whether the sink wants notification groups
+     */
+    void registerSinkWithFilter(const QString &service, const QString &path, const QStringList &eventTypes, uint notificationUserId, const QString &notificationClass, bool groups);
+
+    /*!
+     * Registers an external sink at the given path and sends it the changes
+     * made after the given cursor. If the changes made after the cursor are
+     * no longer known all groups and notifications are sent instead. In that
+     * case the sink should drop the groups and notifications it did not
+     * receive during the registration.
+     *
+     * \param service D-Bus service name for the sink
+     * \param path D-Bus path name for the sink
+     * \param cursor the cursor the sink was synchronized to when it was last registered
+     * \param fullResync set to \c true if all groups and notifications were sent, \c false if only the changes were sent
+     * \return the cursor the sink is synchronized to once it has received the calls sent before the reply
+     */
+    quint64 registerSinkWithCursor(const QString &service, const QString &path, quint64 cursor, bool &fullResync);
+
+    /*!
+     * Returns the cursor an external sink is synchronized to. A sink that has
+     * received all groups and notifications sent before this call can pass
+     * the cursor to registerSinkWithCursor() when it registers again.
+     *
+     * \param service D-Bus service name for the sink
+     * \param path D-Bus path name for the sink
+     * \return the cursor of the sink or 0 if the sink is not registered
+     */
+    quint64 cursor(const QString &service, const QString &path) const;
+
     /*!
      * Unregisters an external sink at the given path.
      *
@@ -62,13 +114,53 @@ public:
      */
     void unregisterSink(const QString &service, const QString &path);
 
+    /*!
+     * Returns the number of calls queued for an external sink.
+     *
+     * \param service D-Bus service name for the sink
+     * \param path D-Bus path name for the sink
+     * \return the number of queued calls or 0 if the sink is not registered
+     */
+    int queueDepth(const QString &service, const QString &path) const;
+
+    /*!
+     * Returns the highest number of calls that have been queued for an
+     * external sink at a time.
+     *
+     * \param service D-Bus service name for the sink
+     * \param path D-Bus path name for the sink
+     * \return the highest number of queued calls or 0 if the sink is not registered
+     */
+    int peakQueueDepth(const QString &service, const QString &path) const;
+
+    /*!
+     * Returns the number of calls to an external sink waiting for a reply.
+     *
+     * \param service D-Bus service name for the sink
+     * \param path D-Bus path name for the sink
+     * \return the number of calls waiting for a reply or 0 if the sink is not registered
+     */
+    int pendingCallCount(const QString &service, const QString &path) const;
+
+    /*!
+     * Returns the number of times the calls queued for an external sink have
+     * been dropped because the sink did not keep up.
+     *
+     * \param service D-Bus service name for the sink
+     * \param path D-Bus path name for the sink
+     * \return the number of times the queued calls were dropped or 0 if the sink is not registered
+     */
+    uint dropCount(const QString &service, const QString &path) const;
+
 private:
     //! Service name, service path pair that identifies the proxy
     typedef QPair<QString, QString> ProxyAddress;
     //! DBus proxy interface
     typedef QSharedPointer<DBusInterfaceNotificationSinkProxy> DBusInterface;
-    //! Key is proxy address and value pointer to proxy
-    typedef QHash<ProxyAddress,  DBusInterface> ProxyContainer;
+    //! Outgoing queue of an external sink
+    typedef QSharedPointer<DBusInterfaceNotificationSinkQueue> SinkQueue;
+    //! Key is proxy address and value the outgoing queue of the proxy
+    typedef QHash<ProxyAddress, SinkQueue> QueueContainer;
 
 private slots:
     //! \reimp
@@ -77,33 +169,81 @@ private slots:
     virtual void addNotification(const Notification &notification);
     virtual void removeNotification(uint notificationId);
     //! \reimp_end
+
+    /*!
+     * Sends the changes an external sink has missed because its queued
+     * calls were dropped. Called by the outgoing queue of the sink.
+     * \param sequence the change sequence number up to which the changes have been delivered to the sink
+     */
+    void resynchronize(quint64 sequence);
+
+    /*!
+     * Unregisters the external sinks of a D-Bus service.
+     * \param service D-Bus service name for the sinks
+     */
+    void unregisterSinks(const QString &service);
     /*!
      * Fetches copy of all groups and notifications from notification manager and
-     * sends them to proxy.
-     * \param proxy proxy that receives the notifications
+     * sends them to a sink.
+     * \param sinkQueue the outgoing queue of the sink that receives the notifications
      */
-    virtual void sendCurrentNotifications(const DBusInterface &proxy) const;
+    virtual void sendCurrentNotifications(DBusInterfaceNotificationSinkQueue *sinkQueue) const;
 
     /*!
-     * Send groups to specified proxy
+     * Send groups to specified sink
      * \param groups groups to send
-     * \param proxyInterface specifies the DBusProxy
+     * \param sinkQueue the outgoing queue of the sink
      */
-    void sendGroupsToProxy(const QList<NotificationGroup> &groups, const DBusInterface &proxyInterface) const;
+    void sendGroupsToSink(const QList<NotificationGroup> &groups, DBusInterfaceNotificationSinkQueue *sinkQueue) const;
 
     /*!
-     * Send notifications to specified proxy
+     * Send notifications to specified sink
      * \param notifications notifications that will be sent
-     * \param proxyInterface specifies the DBusProxy
+     * \param sinkQueue the outgoing queue of the sink
      */
-    void sendNotificationsToProxy(const QList<Notification> &notifications, const DBusInterface &proxyInterface) const;
+    void sendNotificationsToSink(const QList<Notification> &notifications, DBusInterfaceNotificationSinkQueue *sinkQueue) const;
 
 private:
     /*!
-     * Proxies for the registered external sinks.
-     * Maps a D-Bus service and path pair to a sink proxy
+     * Creates a proxy and an outgoing queue for an external sink and connects
+     * to its signals. Replaces the proxy previously registered at the same path.
+     * \param service D-Bus service name for the sink
+     * \param path D-Bus path name for the sink
+     * \param filter the filter selecting the notifications and groups the sink wants
+     * \return the outgoing queue for the sink
+     */
+    DBusInterfaceNotificationSinkQueue *createQueue(const QString &service, const QString &path, const NotificationSinkFilter &filter);
+
+    //! Returns the outgoing queue of an external sink or NULL if the sink is not registered
+    DBusInterfaceNotificationSinkQueue *queue(const QString &service, const QString &path) const;
+
+    /*!
+     * Sends the groups and notifications changed after the given cursor to
+     * a sink. Removed groups and notifications are sent as removals.
+     * \param cursor the cursor the sink is synchronized to
+     * \param sinkQueue the outgoing queue of the sink
+     * \return \c true if the changes were sent, \c false if the changes made after the cursor are not known
      */
-    ProxyContainer proxies;
+    bool sendChangesSince(quint64 cursor, DBusInterfaceNotificationSinkQueue *sinkQueue) const;
+
+    /*!
+     * Queues the changes made after the given cursor for a sink, or all
+     * groups and notifications if the changes are not known, and sends them
+     * as far as the sink is not waiting for too many replies.
+     * \param cursor the cursor the sink is synchronized to
+     * \param sinkQueue the outgoing queue of the sink
+     * \return \c true if only the changes were queued, \c false if everything was queued
+     */
+    bool synchronize(quint64 cursor, DBusInterfaceNotificationSinkQueue *sinkQueue) const;
+
+    /*!
+     * Outgoing queues for the registered external sinks.
+     * Maps a D-Bus service and path pair to the queue of a sink proxy
+     */
+    QueueContainer queues;
+
+    //! Watches the D-Bus services of the registered external sinks for disappearing
+    QDBusServiceWatcher serviceWatcher;
 
     //! Notification manger that is handling the notifications
     const NotificationManagerInterface *notificationManager;
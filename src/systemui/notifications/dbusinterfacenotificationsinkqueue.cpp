@@ -0,0 +1,312 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include "dbusinterfacenotificationsinkqueue.h"
+#include "dbusinterfacenotificationsinkproxy.h"
+#include "notificationmanagerinterface.h"
+#include <QDBusPendingCallWatcher>
+
+DBusInterfaceNotificationSinkQueue::DBusInterfaceNotificationSinkQueue(const QSharedPointer<DBusInterfaceNotificationSinkProxy> &proxy, const NotificationManagerInterface *notificationManager, int maxPendingCalls, int maxQueueDepth, const NotificationSinkFilter &filter) :
+    proxy_(proxy),
+    notificationManager(notificationManager),
+    filter(filter),
+    maxPendingCalls(maxPendingCalls),
+    maxQueueDepth(maxQueueDepth),
+    firstUnsentCall(0),
+    queueDepth_(0),
+    unsentSyncCalls(0),
+    peakQueueDepth_(0),
+    pendingCallCount_(0),
+    dropCount_(0),
+    deliveredSequence(0),
+    resyncPending(false),
+    flushScheduled(false),
+    syncing(false)
+{
+    deliveredSequence = currentSequence();
+}
+
+DBusInterfaceNotificationSinkQueue::~DBusInterfaceNotificationSinkQueue()
+{
+}
+
+const QSharedPointer<DBusInterfaceNotificationSinkProxy> &DBusInterfaceNotificationSinkQueue::proxy() const
+{
+    return proxy_;
+}
+
+void DBusInterfaceNotificationSinkQueue::addNotification(const Notification &notification)
+{
+    Call call;
+    call.id = notification.notificationId();
+    if (accept(notification)) {
+        call.type = Call::AddNotification;
+        call.notification = notification;
+    } else if (release(call.id)) {
+        // The notification no longer matches the filter
+        call.type = Call::RemoveNotification;
+    } else {
+        return;
+    }
+    enqueue(call, false);
+}
+
+void DBusInterfaceNotificationSinkQueue::removeNotification(uint notificationId)
+{
+    if (release(notificationId)) {
+        Call call;
+        call.type = Call::RemoveNotification;
+        call.id = notificationId;
+        enqueue(call, false);
+    }
+}
+
+void DBusInterfaceNotificationSinkQueue::addGroup(uint groupId, const NotificationParameters &parameters)
+{
+    if (filter.acceptsGroups()) {
+        Call call;
+        call.type = Call::AddGroup;
+        call.id = groupId;
+        call.parameters = parameters;
+        enqueue(call, true);
+    }
+}
+
+void DBusInterfaceNotificationSinkQueue::removeGroup(uint groupId)
+{
+    if (filter.acceptsGroups()) {
+        Call call;
+        call.type = Call::RemoveGroup;
+        call.id = groupId;
+        enqueue(call, true);
+    }
+}
+
+void DBusInterfaceNotificationSinkQueue::beginSync(quint64 sequence)
+{
+    syncing = true;
+    deliveredSequence = sequence;
+}
+
+void DBusInterfaceNotificationSinkQueue::endSync()
+{
+    syncing = false;
+    flush();
+}
+
+bool DBusInterfaceNotificationSinkQueue::accept(const Notification &notification)
+{
+    if (filter.matchesAllNotifications()) {
+        return true;
+    }
+
+    if (filter.matches(notification)) {
+        sentNotificationIds.insert(notification.notificationId());
+        return true;
+    }
+    return false;
+}
+
+bool DBusInterfaceNotificationSinkQueue::release(uint notificationId)
+{
+    return filter.matchesAllNotifications() || sentNotificationIds.remove(notificationId);
+}
+
+int DBusInterfaceNotificationSinkQueue::queueDepth() const
+{
+    return queueDepth_;
+}
+
+int DBusInterfaceNotificationSinkQueue::peakQueueDepth() const
+{
+    return peakQueueDepth_;
+}
+
+int DBusInterfaceNotificationSinkQueue::pendingCallCount() const
+{
+    return pendingCallCount_;
+}
+
+uint DBusInterfaceNotificationSinkQueue::dropCount() const
+{
+    return dropCount_;
+}
+
+quint64 DBusInterfaceNotificationSinkQueue::cursor() const
+{
+    if (queueDepth_ == 0 && pendingCallCount_ == 0 && !resyncPending) {
+        // Every change the sink has been informed about has been delivered
+        return currentSequence();
+    }
+    return deliveredSequence;
+}
+
+quint64 DBusInterfaceNotificationSinkQueue::currentSequence() const
+{
+    return notificationManager != NULL ? notificationManager->changeSequence() : 0;
+}
+
+void DBusInterfaceNotificationSinkQueue::enqueue(const Call &call, bool group)
+{
+    if (resyncPending) {
+        // The resync sends the latest state of everything changed in the meantime
+        return;
+    }
+
+    Call queuedCall(call);
+    queuedCall.sync = syncing;
+    bool add = call.type == Call::AddNotification || call.type == Call::AddGroup;
+    CallKey key(group, call.id);
+    QHash<CallKey, int>::iterator i = unsentAddCalls.find(key);
+    if (i != unsentAddCalls.end()) {
+        Call &supersededCall = calls[*i];
+        if (supersededCall.sync) {
+            unsentSyncCalls--;
+        }
+
+        if (add) {
+            // Only the latest contents are sent
+            supersededCall = queuedCall;
+            if (queuedCall.sync) {
+                unsentSyncCalls++;
+            }
+            return;
+        }
+
+        // An update followed by a removal is not sent at all
+        supersededCall.type = Call::Superseded;
+        supersededCall.notification = Notification();
+        supersededCall.parameters = NotificationParameters();
+        unsentAddCalls.erase(i);
+        queueDepth_--;
+    }
+
+    if (add) {
+        unsentAddCalls.insert(key, calls.count());
+    }
+    calls.append(queuedCall);
+    queueDepth_++;
+    if (queuedCall.sync) {
+        unsentSyncCalls++;
+    }
+    peakQueueDepth_ = qMax(peakQueueDepth_, queueDepth_);
+
+    if (pendingCallCount_ >= maxPendingCalls && queueDepth_ - unsentSyncCalls > maxQueueDepth) {
+        // The sink is not keeping up: stop queueing until it has replied to the calls already made
+        drop();
+    } else if (!flushScheduled && !syncing) {
+        flushScheduled = true;
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+    }
+}
+
+void DBusInterfaceNotificationSinkQueue::flush()
+{
+    flushScheduled = false;
+
+    while (firstUnsentCall < calls.count() && pendingCallCount_ < maxPendingCalls) {
+        const Call call = calls.at(firstUnsentCall++);
+        if (call.type != Call::Superseded) {
+            if (call.type == Call::AddNotification || call.type == Call::AddGroup) {
+                unsentAddCalls.remove(CallKey(call.type == Call::AddGroup, call.id));
+            }
+            queueDepth_--;
+            if (call.sync) {
+                unsentSyncCalls--;
+            }
+            send(call);
+        }
+    }
+
+    if (firstUnsentCall == calls.count()) {
+        calls.clear();
+        firstUnsentCall = 0;
+    }
+
+    checkDelivered();
+}
+
+void DBusInterfaceNotificationSinkQueue::send(const Call &call)
+{
+    switch (call.type) {
+    case Call::AddNotification:
+        watch(proxy_->addNotification(call.notification));
+        break;
+    case Call::RemoveNotification:
+        watch(proxy_->removeNotification(call.id));
+        break;
+    case Call::AddGroup:
+        watch(proxy_->addGroup(call.id, call.parameters));
+        break;
+    case Call::RemoveGroup:
+        watch(proxy_->removeGroup(call.id));
+        break;
+    default:
+        break;
+    }
+}
+
+void DBusInterfaceNotificationSinkQueue::watch(const QDBusPendingCall &call)
+{
+    if (!call.isFinished()) {
+        pendingCallCount_++;
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+        connect(watcher, SIGNAL(finished(QDBusPendingCallWatcher *)), this, SLOT(callFinished(QDBusPendingCallWatcher *)));
+    }
+}
+
+void DBusInterfaceNotificationSinkQueue::callFinished(QDBusPendingCallWatcher *watcher)
+{
+    pendingCallCount_--;
+    watcher->deleteLater();
+
+    if (watcher->isError() && !resyncPending) {
+        // The change may not have reached the sink
+        drop();
+    }
+
+    flush();
+}
+
+void DBusInterfaceNotificationSinkQueue::drop()
+{
+    calls.clear();
+    firstUnsentCall = 0;
+    unsentAddCalls.clear();
+    queueDepth_ = 0;
+    unsentSyncCalls = 0;
+    dropCount_++;
+    resyncPending = true;
+}
+
+void DBusInterfaceNotificationSinkQueue::checkDelivered()
+{
+    if (pendingCallCount_ > 0 || queueDepth_ > 0) {
+        return;
+    }
+
+    if (resyncPending) {
+        // The resync queues the missed changes and the delivered change sequence number is kept until they have been delivered
+        resyncPending = false;
+        emit resyncNeeded(deliveredSequence);
+    } else {
+        // Every change made so far has been delivered
+        deliveredSequence = currentSequence();
+    }
+}
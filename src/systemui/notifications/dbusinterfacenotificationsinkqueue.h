@@ -0,0 +1,264 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef DBUSINTERFACENOTIFICATIONSINKQUEUE_H_
+#define DBUSINTERFACENOTIFICATIONSINKQUEUE_H_
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QList>
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include "notification.h"
+#include "notificationsinkfilter.h"
+
+class DBusInterfaceNotificationSinkProxy;
+class NotificationManagerInterface;
+class QDBusPendingCall;
+class QDBusPendingCallWatcher;
+
+/*!
+ * An outgoing queue of the calls to an external notification sink.
+ *
+ * The changes are queued and sent to the sink on the next event loop
+ * iteration, so a burst of changes is sent in one go. A notification or a
+ * group that is updated again before its previous update has been sent is
+ * sent only once with its latest contents, and updates that are followed by
+ * a removal are not sent at all.
+ *
+ * At most a given number of calls are waiting for a reply from the sink at a
+ * time. The rest of the calls stay in the queue until the sink has replied.
+ * If the queue grows too long while the sink is not replying the queued
+ * calls are dropped and no further calls are queued. Once the sink has
+ * replied to all calls, or the calls have timed out, resyncNeeded() is
+ * emitted so that the sink can be sent the changes it has missed.
+ *
+ * The calls that bring the sink up to date when it registers or is
+ * resynchronized are queued between beginSync() and endSync(). They wait for
+ * replies like any other call but do not count towards the maximum queue
+ * depth, since there is one for every notification the sink is sent.
+ *
+ * Only the notifications that match the filter of the sink are queued. A
+ * notification that no longer matches the filter after an update is removed
+ * from the sink, and the removals of the notifications the sink has not been
+ * sent are not sent either.
+ */
+class DBusInterfaceNotificationSinkQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * Creates an outgoing queue for an external sink.
+     *
+     * \param proxy the proxy of the sink
+     * \param notificationManager manager that keeps track of the changes sent to the sink. May be NULL.
+     * \param maxPendingCalls the maximum number of calls waiting for a reply at a time
+     * \param maxQueueDepth the maximum number of queued calls while the maximum number of calls are waiting for a reply
+     * \param filter the filter selecting the notifications and groups the sink wants
+     */
+    DBusInterfaceNotificationSinkQueue(const QSharedPointer<DBusInterfaceNotificationSinkProxy> &proxy, const NotificationManagerInterface *notificationManager, int maxPendingCalls, int maxQueueDepth, const NotificationSinkFilter &filter = NotificationSinkFilter());
+
+    /*!
+     * Destroys the DBusInterfaceNotificationSinkQueue. Queued calls are not sent.
+     */
+    virtual ~DBusInterfaceNotificationSinkQueue();
+
+    //! Returns the proxy of the sink
+    const QSharedPointer<DBusInterfaceNotificationSinkProxy> &proxy() const;
+
+    //! Queues a call to add or update a notification
+    void addNotification(const Notification &notification);
+
+    //! Queues a call to remove a notification
+    void removeNotification(uint notificationId);
+
+    //! Queues a call to add or update a notification group
+    void addGroup(uint groupId, const NotificationParameters &parameters);
+
+    //! Queues a call to remove a notification group
+    void removeGroup(uint groupId);
+
+    /*!
+     * Starts queueing the calls that bring the sink up to date. Until they
+     * have been delivered the sink is considered to be synchronized to the
+     * given change sequence number.
+     *
+     * \param sequence the change sequence number the sink is synchronized to before the calls
+     */
+    void beginSync(quint64 sequence);
+
+    //! Sends the calls queued since beginSync() right away until the maximum number of calls are waiting for a reply
+    void endSync();
+
+    //! Returns the number of calls in the queue
+    int queueDepth() const;
+
+    //! Returns the highest number of calls that have been in the queue at a time
+    int peakQueueDepth() const;
+
+    //! Returns the number of calls waiting for a reply from the sink
+    int pendingCallCount() const;
+
+    //! Returns the number of times the queued calls have been dropped
+    uint dropCount() const;
+
+    /*!
+     * Returns the change sequence number up to which the changes have been
+     * delivered to the sink. A sink that registers again with this cursor
+     * will not miss any changes.
+     *
+     * \return the cursor of the sink
+     */
+    quint64 cursor() const;
+
+public slots:
+    /*!
+     * Sends the queued calls until the maximum number of calls are waiting
+     * for a reply. Called automatically on the next event loop iteration
+     * after a call has been queued.
+     */
+    void flush();
+
+signals:
+    /*!
+     * Sent when the queued calls have been dropped and the sink has replied
+     * to all calls made before that. The sink should be sent the changes
+     * made after the given change sequence number.
+     *
+     * \param sequence the change sequence number up to which the changes have been delivered to the sink
+     */
+    void resyncNeeded(quint64 sequence);
+
+private slots:
+    //! Keeps track of the calls waiting for a reply
+    void callFinished(QDBusPendingCallWatcher *watcher);
+
+private:
+    //! A queued call
+    struct Call {
+        //! The type of a queued call
+        enum Type {
+            AddNotification,
+            RemoveNotification,
+            AddGroup,
+            RemoveGroup,
+            //! A call superseded by a later one
+            Superseded
+        };
+
+        Type type;
+        //! The ID of the notification or group
+        uint id;
+        //! The notification to add
+        Notification notification;
+        //! The parameters of the group to add
+        NotificationParameters parameters;
+        //! Whether the call was queued between beginSync() and endSync()
+        bool sync;
+    };
+
+    //! Identifies the notification or group of a call. The first member tells whether the call is for a group.
+    typedef QPair<bool, uint> CallKey;
+
+    //! Queues a call. An add call replaces the previous add call for the same notification or group if it has not been sent yet.
+    void enqueue(const Call &call, bool group);
+
+    //! Returns whether the sink wants a notification. Keeps track of the notifications the sink has been sent.
+    bool accept(const Notification &notification);
+
+    //! Returns whether the sink has been sent a notification and forgets the notification
+    bool release(uint notificationId);
+
+    //! Makes a queued call
+    void send(const Call &call);
+
+    //! Keeps track of a call made to the sink until it is answered
+    void watch(const QDBusPendingCall &call);
+
+    //! Drops the queued calls
+    void drop();
+
+    //! Updates the delivered change sequence number or requests a resync if the sink has received all sent calls
+    void checkDelivered();
+
+    //! Returns the sequence number of the latest change
+    quint64 currentSequence() const;
+
+    //! The proxy of the sink
+    QSharedPointer<DBusInterfaceNotificationSinkProxy> proxy_;
+
+    //! Manager that keeps track of the changes
+    const NotificationManagerInterface *notificationManager;
+
+    //! Selects the notifications and groups the sink wants
+    NotificationSinkFilter filter;
+
+    //! The IDs of the notifications the sink has been sent. Not kept when the sink wants every notification.
+    QSet<uint> sentNotificationIds;
+
+    //! The maximum number of calls waiting for a reply at a time
+    int maxPendingCalls;
+
+    //! The maximum number of queued calls while the maximum number of calls are waiting for a reply
+    int maxQueueDepth;
+
+    //! The queued calls. The calls before the first unsent call have been sent.
+    QList<Call> calls;
+
+    //! The index of the first unsent call
+    int firstUnsentCall;
+
+    //! The indexes of the unsent add calls keyed by the notification or group they are for
+    QHash<CallKey, int> unsentAddCalls;
+
+    //! The number of unsent calls that have not been superseded
+    int queueDepth_;
+
+    //! The number of unsent calls in queueDepth_ that were queued between beginSync() and endSync()
+    int unsentSyncCalls;
+
+    //! The highest number of calls in the queue at a time
+    int peakQueueDepth_;
+
+    //! The number of calls waiting for a reply
+    int pendingCallCount_;
+
+    //! The number of times the queued calls have been dropped
+    uint dropCount_;
+
+    //! The change sequence number up to which the changes have been delivered to the sink
+    quint64 deliveredSequence;
+
+    //! Whether the queued calls have been dropped and the sink needs to be sent the changes it missed
+    bool resyncPending;
+
+    //! Whether a flush has been scheduled
+    bool flushScheduled;
+
+    //! Whether the calls are queued between beginSync() and endSync()
+    bool syncing;
+
+#ifdef UNIT_TEST
+    friend class Ut_DBusInterfaceNotificationSink;
+#endif
+};
+
+#endif /* DBUSINTERFACENOTIFICATIONSINKQUEUE_H_ */
@@ -23,10 +23,6 @@
 #include "notificationwidgetparameterfactory.h"
 #include "genericnotificationparameterfactory.h"
 
-Q_DECLARE_METATYPE(MNotificationProxy)
-Q_DECLARE_METATYPE(MNotificationWithIdentifierProxy)
-Q_DECLARE_METATYPE(MNotificationGroupProxy)
-Q_DECLARE_METATYPE(MNotificationGroupWithIdentifierProxy)
 Q_DECLARE_METATYPE(QList<MNotificationProxy>)
 Q_DECLARE_METATYPE(QList<MNotificationWithIdentifierProxy>)
 Q_DECLARE_METATYPE(QList<MNotificationGroupProxy>)
@@ -36,6 +32,8 @@ Q_DECLARE_METATYPE(MNotificationProxyWithParameters)
 Q_DECLARE_METATYPE(QList<MNotificationProxyWithParameters>)
 Q_DECLARE_METATYPE(MNotificationGroupProxyWithParameters)
 Q_DECLARE_METATYPE(QList<MNotificationGroupProxyWithParameters>)
+Q_DECLARE_METATYPE(MNotificationBatchItemProxy)
+Q_DECLARE_METATYPE(QList<MNotificationBatchItemProxy>)
 
 DBusInterfaceNotificationSource::DBusInterfaceNotificationSource(NotificationManagerInterface &interface)
     : NotificationSource(interface)
@@ -53,11 +51,17 @@ DBusInterfaceNotificationSource::DBusInterfaceNotificationSource(NotificationMan
     qDBusRegisterMetaType<QList<MNotificationGroupProxy> >();
     qDBusRegisterMetaType<MNotificationGroupWithIdentifierProxy>();
     qDBusRegisterMetaType<QList<MNotificationGroupWithIdentifierProxy> >();
+    qDBusRegisterMetaType<MNotificationListProxy>();
+    qDBusRegisterMetaType<MNotificationWithIdentifierListProxy>();
+    qDBusRegisterMetaType<MNotificationGroupListProxy>();
+    qDBusRegisterMetaType<MNotificationGroupWithIdentifierListProxy>();
     qDBusRegisterMetaType<QList<NotificationParameters> >();
     qDBusRegisterMetaType<MNotificationProxyWithParameters>();
     qDBusRegisterMetaType<QList<MNotificationProxyWithParameters> >();
     qDBusRegisterMetaType<MNotificationGroupProxyWithParameters>();
     qDBusRegisterMetaType<QList<MNotificationGroupProxyWithParameters> >();
+    qDBusRegisterMetaType<MNotificationBatchItemProxy>();
+    qDBusRegisterMetaType<QList<MNotificationBatchItemProxy> >();
 
     new DBusInterfaceNotificationSourceAdaptor(this);
 }
@@ -142,48 +146,24 @@ QList<uint> DBusInterfaceNotificationSource::notificationIdList(uint notificatio
     return manager.notificationIdList(notificationUserId);
 }
 
-QList<MNotificationProxy> DBusInterfaceNotificationSource::notificationList(uint notificationUserId)
+MNotificationListProxy DBusInterfaceNotificationSource::notificationList(uint notificationUserId)
 {
-    QList<MNotificationProxy> userNotifications;
-
-    foreach (const Notification &notification, manager.notificationList(notificationUserId)) {
-        userNotifications.append(MNotificationProxy(notification));
-    }
-
-    return userNotifications;
+    return MNotificationListProxy(manager.notificationList(notificationUserId));
 }
 
-QList<MNotificationWithIdentifierProxy> DBusInterfaceNotificationSource::notificationListWithIdentifiers(uint notificationUserId)
+MNotificationWithIdentifierListProxy DBusInterfaceNotificationSource::notificationListWithIdentifiers(uint notificationUserId)
 {
-    QList<MNotificationWithIdentifierProxy> userNotifications;
-
-    foreach (const Notification &notification, manager.notificationListWithIdentifiers(notificationUserId)) {
-        userNotifications.append(MNotificationWithIdentifierProxy(notification));
-    }
-
-    return userNotifications;
+    return MNotificationWithIdentifierListProxy(manager.notificationListWithIdentifiers(notificationUserId));
 }
 
-QList<MNotificationGroupProxy> DBusInterfaceNotificationSource::notificationGroupList(uint notificationUserId)
+MNotificationGroupListProxy DBusInterfaceNotificationSource::notificationGroupList(uint notificationUserId)
 {
-    QList<MNotificationGroupProxy> userGroups;
-
-    foreach (const NotificationGroup &group, manager.notificationGroupList(notificationUserId)) {
-        userGroups.append(MNotificationGroupProxy(group));
-    }
-
-    return userGroups;
+    return MNotificationGroupListProxy(manager.notificationGroupList(notificationUserId));
 }
 
-QList<MNotificationGroupWithIdentifierProxy> DBusInterfaceNotificationSource::notificationGroupListWithIdentifiers(uint notificationUserId)
+MNotificationGroupWithIdentifierListProxy DBusInterfaceNotificationSource::notificationGroupListWithIdentifiers(uint notificationUserId)
 {
-    QList<MNotificationGroupWithIdentifierProxy> userGroups;
-
-    foreach (const NotificationGroup &group, manager.notificationGroupListWithIdentifiers(notificationUserId)) {
-        userGroups.append(MNotificationGroupWithIdentifierProxy(group));
-    }
-
-    return userGroups;
+    return MNotificationGroupWithIdentifierListProxy(manager.notificationGroupListWithIdentifiers(notificationUserId));
 }
 
 uint DBusInterfaceNotificationSource::notificationCountInGroup(uint notificationUserId, uint groupId)
@@ -232,3 +212,78 @@ QList<MNotificationGroupProxyWithParameters> DBusInterfaceNotificationSource::no
 
     return userGroups;
 }
+
+QList<MNotificationProxyWithParameters> DBusInterfaceNotificationSource::queryNotifications(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit)
+{
+    QList<MNotificationProxyWithParameters> userNotifications;
+
+    foreach (const Notification &notification, manager.queryNotifications(notificationUserId, eventType, groupId, identifier, sinceTimestamp, lastId, limit)) {
+        userNotifications.append(MNotificationProxyWithParameters(notification));
+    }
+
+    return userNotifications;
+}
+
+uint DBusInterfaceNotificationSource::queryNotificationCount(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp)
+{
+    return manager.queryNotificationCount(notificationUserId, eventType, groupId, identifier, sinceTimestamp);
+}
+
+QList<MNotificationGroupProxyWithParameters> DBusInterfaceNotificationSource::queryGroups(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit)
+{
+    QList<MNotificationGroupProxyWithParameters> userGroups;
+
+    foreach (const NotificationGroup &group, manager.queryGroups(notificationUserId, eventType, identifier, sinceTimestamp, lastId, limit)) {
+        userGroups.append(MNotificationGroupProxyWithParameters(group));
+    }
+
+    return userGroups;
+}
+
+uint DBusInterfaceNotificationSource::queryGroupCount(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp)
+{
+    return manager.queryGroupCount(notificationUserId, eventType, identifier, sinceTimestamp);
+}
+
+QList<uint> DBusInterfaceNotificationSource::addNotifications(uint notificationUserId, const QList<MNotificationBatchItemProxy> &notifications)
+{
+    QList<QPair<uint, NotificationParameters> > items;
+    foreach (const MNotificationBatchItemProxy &notification, notifications) {
+        items.append(qMakePair(notification.id, notification.parameters));
+    }
+    return manager.addNotifications(notificationUserId, items);
+}
+
+bool DBusInterfaceNotificationSource::updateNotifications(uint notificationUserId, const QList<MNotificationBatchItemProxy> &notifications)
+{
+    QList<QPair<uint, NotificationParameters> > items;
+    foreach (const MNotificationBatchItemProxy &notification, notifications) {
+        items.append(qMakePair(notification.id, notification.parameters));
+    }
+    return manager.updateNotifications(notificationUserId, items);
+}
+
+bool DBusInterfaceNotificationSource::removeNotifications(uint notificationUserId, const QList<uint> &notificationIds)
+{
+    return manager.removeNotifications(notificationUserId, notificationIds);
+}
+
+uint DBusInterfaceNotificationSource::addOrUpdateNotification(uint notificationUserId, uint groupId, const QString &identifier, const NotificationParameters &parameters)
+{
+    return manager.addOrUpdateNotification(notificationUserId, groupId, identifier, parameters);
+}
+
+bool DBusInterfaceNotificationSource::removeNotificationsWithIdentifier(uint notificationUserId, const QString &identifier)
+{
+    return manager.removeNotificationsWithIdentifier(notificationUserId, identifier);
+}
+
+uint DBusInterfaceNotificationSource::addOrUpdateGroup(uint notificationUserId, const QString &identifier, const NotificationParameters &parameters)
+{
+    return manager.addOrUpdateGroup(notificationUserId, identifier, parameters);
+}
+
+bool DBusInterfaceNotificationSource::removeGroupsWithIdentifier(uint notificationUserId, const QString &identifier)
+{
+    return manager.removeGroupsWithIdentifier(notificationUserId, identifier);
+}
@@ -278,7 +278,7 @@ public:
      *
      * \deprecated This method is deprecated, you should use notificationListWithNotificationParameters(uint notificationUserId) instead
      */
-    QList<MNotificationProxy> Q_DECL_DEPRECATED notificationList(uint notificationUserId);
+    MNotificationListProxy Q_DECL_DEPRECATED notificationList(uint notificationUserId);
 
     /*!
      * Returns list of notifications with associated identifiers by user id
@@ -288,7 +288,7 @@ public:
      *
      * \deprecated This method is deprecated, you should use notificationListWithNotificationParameters(uint notificationUserId) instead
      */
-    QList<MNotificationWithIdentifierProxy> Q_DECL_DEPRECATED notificationListWithIdentifiers(uint notificationUserId);
+    MNotificationWithIdentifierListProxy Q_DECL_DEPRECATED notificationListWithIdentifiers(uint notificationUserId);
 
     /*!
      * Returns list of notification groups by user id
@@ -298,7 +298,7 @@ public:
      *
      * \deprecated This method is deprecated, you should use notificationGroupListAsNotificationParameters(uint notificationUserId) instead
      */
-    QList<MNotificationGroupProxy> Q_DECL_DEPRECATED notificationGroupList(uint notificationUserId);
+    MNotificationGroupListProxy Q_DECL_DEPRECATED notificationGroupList(uint notificationUserId);
 
     /*!
      * Returns list of notification groups with associated identifiers by user id
@@ -308,7 +308,7 @@ public:
      *
      * \deprecated This method is deprecated, you should use notificationGroupListAsNotificationParameters(uint notificationUserId) instead
      */
-    QList<MNotificationGroupWithIdentifierProxy> Q_DECL_DEPRECATED notificationGroupListWithIdentifiers(uint notificationUserId);
+    MNotificationGroupWithIdentifierListProxy Q_DECL_DEPRECATED notificationGroupListWithIdentifiers(uint notificationUserId);
 
     /*!
      * Returns amount of notifications in a given group
@@ -389,6 +389,134 @@ public:
      * \return list of notification groups that belong to notificationUserId
      */
     QList<MNotificationGroupProxyWithParameters> notificationGroupListWithNotificationParameters(uint notificationUserId);
+
+    /*!
+     * Returns a page of the notifications of a user that match the given
+     * criteria, in ascending notification ID order. Empty strings and zeros
+     * in the criteria match all notifications.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param eventType only notifications with this event type are returned
+     * \param groupId only notifications in this group are returned
+     * \param identifier only notifications with this identifier are returned
+     * \param sinceTimestamp only notifications with a timestamp later than this are returned
+     * \param lastId the ID of the last notification of the previous page. Only notifications with a higher ID are returned.
+     * \param limit the maximum number of notifications to return. 0 returns all of them.
+     * \return list of notifications that match the criteria
+     */
+    QList<MNotificationProxyWithParameters> queryNotifications(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit);
+
+    /*!
+     * Returns the number of notifications of a user that match the given
+     * criteria without transferring the notifications.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param eventType only notifications with this event type are counted
+     * \param groupId only notifications in this group are counted
+     * \param identifier only notifications with this identifier are counted
+     * \param sinceTimestamp only notifications with a timestamp later than this are counted
+     * \return the number of notifications that match the criteria
+     */
+    uint queryNotificationCount(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp);
+
+    /*!
+     * Returns a page of the notification groups of a user that match the
+     * given criteria, in ascending group ID order. Empty strings and zeros
+     * in the criteria match all groups.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param eventType only groups with this event type are returned
+     * \param identifier only groups with this identifier are returned
+     * \param sinceTimestamp only groups with a timestamp later than this are returned
+     * \param lastId the ID of the last group of the previous page. Only groups with a higher ID are returned.
+     * \param limit the maximum number of groups to return. 0 returns all of them.
+     * \return list of notification groups that match the criteria
+     */
+    QList<MNotificationGroupProxyWithParameters> queryGroups(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit);
+
+    /*!
+     * Returns the number of notification groups of a user that match the
+     * given criteria without transferring the groups.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param eventType only groups with this event type are counted
+     * \param identifier only groups with this identifier are counted
+     * \param sinceTimestamp only groups with a timestamp later than this are counted
+     * \return the number of notification groups that match the criteria
+     */
+    uint queryGroupCount(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp);
+
+    /*!
+     * Adds a number of new notifications in a single call.
+     *
+     * The notifications are added in a single transaction so the changes
+     * are written to the persistent storage once and the sinks are informed
+     * about all new notifications at once.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param notifications a list of group IDs and parameters of the notifications to add
+     * \return the IDs of the new notifications in the same order as \a notifications. 0 for the notifications that could not be added.
+     */
+    QList<uint> addNotifications(uint notificationUserId, const QList<MNotificationBatchItemProxy> &notifications);
+
+    /*!
+     * Updates a number of existing notifications in a single call.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param notifications a list of notification IDs and parameters of the notifications to update
+     * \return true if all updates succeeded, false otherwise
+     */
+    bool updateNotifications(uint notificationUserId, const QList<MNotificationBatchItemProxy> &notifications);
+
+    /*!
+     * Removes a number of notifications in a single call.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param notificationIds the IDs of the notifications to be removed
+     * \return true if all removals succeeded, false otherwise
+     */
+    bool removeNotifications(uint notificationUserId, const QList<uint> &notificationIds);
+
+    /*!
+     * Adds a notification with the given identifier or updates the existing
+     * notification of the user with the same identifier.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param groupId the notification group where a new notification is added. Not used when an existing notification is updated.
+     * \param identifier the user supplied identifier of the notification
+     * \param parameters Parameters for the notification
+     * \return the ID of the added or updated notification, or 0 on failure
+     */
+    uint addOrUpdateNotification(uint notificationUserId, uint groupId, const QString &identifier, const NotificationParameters &parameters);
+
+    /*!
+     * Removes the notifications of the user that have the given identifier.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param identifier the user supplied identifier of the notifications
+     * \return true if notifications were found and removed, false otherwise
+     */
+    bool removeNotificationsWithIdentifier(uint notificationUserId, const QString &identifier);
+
+    /*!
+     * Adds a notification group with the given identifier or updates the
+     * existing group of the user with the same identifier.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param identifier the user supplied identifier of the notification group
+     * \param parameters Parameters for the notification group
+     * \return the ID of the added or updated notification group, or 0 on failure
+     */
+    uint addOrUpdateGroup(uint notificationUserId, const QString &identifier, const NotificationParameters &parameters);
+
+    /*!
+     * Removes the notification groups of the user that have the given identifier.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param identifier the user supplied identifier of the notification groups
+     * \return true if groups were found and removed, false otherwise
+     */
+    bool removeGroupsWithIdentifier(uint notificationUserId, const QString &identifier);
 };
 
 #endif // DBUSINTERFACENOTIFICATIONSOURCE_H
@@ -20,27 +20,50 @@
 #include "eventtypestore.h"
 #include <QFileInfo>
 #include <QDir>
+#include <QFile>
+#include <QDateTime>
+#include <QSettings>
+#include <QtAlgorithms>
 
 const QString EventTypeStore::FILE_EXTENSION = ".conf";
 const uint EventTypeStore::FILE_MAX_SIZE = 32768;
+const int EventTypeStore::UPDATE_DELAY = 500;
 
-EventTypeStore::EventTypeStore(const QString &eventTypesPath, uint maxStoredEventTypes) :
+EventTypeStore::EventTypeStore(const QString &eventTypesPath, uint maxStoredEventTypes, const QString &tableFileName) :
     eventTypesPath(eventTypesPath),
-    maxStoredEventTypes(maxStoredEventTypes)
+    maxStoredEventTypes(maxStoredEventTypes),
+    tableFileName(tableFileName),
+    eventTypeCache(qMax(maxStoredEventTypes, 1u)),
+    hitCount(0),
+    missCount(0),
+    evictionCount(0)
 {
     if (!this->eventTypesPath.endsWith('/')) {
         this->eventTypesPath.append('/');
     }
 
+    // Changes arriving close to each other, like the files of a package being installed, are handled as a single batch
+    updateTimer.setSingleShot(true);
+    updateTimer.setInterval(UPDATE_DELAY);
+    connect(&updateTimer, SIGNAL(timeout()), this, SLOT(updateEventTypeFileList()));
+
     // Watch for changes in event type files
     eventTypePathWatcher.addPath(this->eventTypesPath);
-    connect(&eventTypePathWatcher, SIGNAL(directoryChanged(QString)), this, SLOT(updateEventTypeFileList()));
-    connect(&eventTypePathWatcher, SIGNAL(fileChanged(QString)), this, SLOT(updateEventTypeFile(QString)));
+    connect(&eventTypePathWatcher, SIGNAL(directoryChanged(QString)), this, SLOT(scheduleUpdate()));
+    connect(&eventTypePathWatcher, SIGNAL(fileChanged(QString)), this, SLOT(scheduleUpdate()));
     updateEventTypeFileList();
 }
 
+void EventTypeStore::scheduleUpdate()
+{
+    // Restarting the timer postpones the update until the changes have settled
+    updateTimer.start();
+}
+
 void EventTypeStore::updateEventTypeFileList()
 {
+    updateTimer.stop();
+
     QDir eventTypesDir(eventTypesPath);
 
     if(eventTypesDir.exists()) {
@@ -48,58 +71,49 @@ void EventTypeStore::updateEventTypeFileList()
 
         QSet<QString> files = eventTypesDir.entryList(filter, QDir::Files).toSet();
         QSet<QString> removedFiles = eventTypeFiles - files;
+        QSet<QString> addedFiles = files - eventTypeFiles;
+
+        // Event types may have been installed
+        missingEventTypes.clear();
+
+        eventTypeFiles = files;
+        QStringList modifiedEventTypes = updateTable();
 
         foreach(const QString &removedEventType, removedFiles) {
             QString eventType = QFileInfo(removedEventType).completeBaseName();
             QString eventFilePath = eventTypesPath + removedEventType;
             eventTypePathWatcher.removePath(eventFilePath);
-            eventTypesMap.remove(eventType);
+            eventTypeCache.remove(eventType);
             emit eventTypeUninstalled(eventType);
         }
 
-        eventTypeFiles = files;
-
-        // add event type files to watcher
-        foreach(QString file, eventTypeFiles){
-            QString eventTypeFilePath = eventTypesPath + file;
-            if (!eventTypePathWatcher.files().contains(eventTypeFilePath)) {
-                eventTypePathWatcher.addPath(eventTypeFilePath);
+        // A file replaced by renaming another file over it keeps its name but loses its watch, so every file not being watched is watched again
+        QSet<QString> watchedPaths = eventTypePathWatcher.files().toSet();
+        foreach(const QString &file, files) {
+            QString eventFilePath = eventTypesPath + file;
+            if (!watchedPaths.contains(eventFilePath)) {
+                eventTypePathWatcher.addPath(eventFilePath);
             }
         }
-    }
-}
 
-void EventTypeStore::updateEventTypeFile(const QString &path)
-{
-    QFileInfo fileInfo(path);
-    if (fileInfo.exists()) {
-       QString eventType = fileInfo.completeBaseName();
-       loadSettings(eventType);
-       emit eventTypeModified(eventType);
+        if (!modifiedEventTypes.isEmpty()) {
+            emit eventTypesModified(modifiedEventTypes);
+        }
     }
 }
 
 bool EventTypeStore::eventTypeExists(const QString &eventType) const
 {
-    bool eventTypeFound = false;
-
-    if (!eventTypesMap.contains(eventType)) {
-        // If the event type has not been loaded yet load it
-        const_cast<EventTypeStore *>(this)->loadSettings(eventType);
-    }
-
-    if (eventTypesMap.contains(eventType)) {
-        const_cast<EventTypeStore*>(this)->eventTypeAccessed(eventType);
-        eventTypeFound = true;
-    }
-
-    return eventTypeFound;
+    return eventTypeParameters(eventType) != NULL;
 }
 
 QList<QString> EventTypeStore::allKeys(const QString &eventType) const
 {
-    if (eventTypeExists(eventType)) {
-        return eventTypesMap.value(eventType)->allKeys();
+    const EventTypeTable::Parameters *parameters = eventTypeParameters(eventType);
+    if (parameters != NULL) {
+        QList<QString> keys = parameters->keys();
+        qSort(keys);
+        return keys;
     }
 
     return QList<QString>();
@@ -107,41 +121,130 @@ QList<QString> EventTypeStore::allKeys(const QString &eventType) const
 
 bool EventTypeStore::contains(const QString &eventType, const QString &key) const
 {
-    if (eventTypeExists(eventType)) {
-        return eventTypesMap.value(eventType)->contains(key);
-    }
-
-    return false;
+    const EventTypeTable::Parameters *parameters = eventTypeParameters(eventType);
+    return parameters != NULL && parameters->contains(key);
 }
 
 QString EventTypeStore::value(const QString &eventType, const QString &key) const
 {
-    if (contains(eventType, key)) {
-        return eventTypesMap.value(eventType)->value(key).toString();
+    const EventTypeTable::Parameters *parameters = eventTypeParameters(eventType);
+    return parameters != NULL ? parameters->value(key) : QString();
+}
+
+uint EventTypeStore::cacheHits() const
+{
+    return hitCount;
+}
+
+uint EventTypeStore::cacheMisses() const
+{
+    return missCount;
+}
+
+uint EventTypeStore::cacheEvictions() const
+{
+    return evictionCount;
+}
+
+const EventTypeTable::Parameters *EventTypeStore::eventTypeParameters(const QString &eventType) const
+{
+    // Looking up an object from the cache marks it as the most recently used one
+    EventTypeTable::Parameters *parameters = eventTypeCache.object(eventType);
+    if (parameters != NULL || missingEventTypes.contains(eventType)) {
+        hitCount++;
+        return parameters;
     }
 
-    return QString();
+    missCount++;
+    if (!table.contains(eventType)) {
+        // Keep the set of missing event types bounded even if nonexistent event types are used constantly
+        if (missingEventTypes.count() >= eventTypeCache.maxCost()) {
+            missingEventTypes.clear();
+        }
+        missingEventTypes.insert(eventType);
+        return NULL;
+    }
+
+    if (eventTypeCache.count() >= eventTypeCache.maxCost()) {
+        // Inserting to a full cache evicts the least recently used event type
+        evictionCount++;
+    }
+
+    parameters = new EventTypeTable::Parameters(table.parameters(eventType));
+    eventTypeCache.insert(eventType, parameters);
+    return parameters;
 }
 
-void EventTypeStore::loadSettings(const QString &eventType)
+QStringList EventTypeStore::updateTable()
 {
-    QFileInfo file(QString(eventTypesPath).append(eventType).append(FILE_EXTENSION));
-    if (file.exists() && file.size() != 0 && file.size() <= FILE_MAX_SIZE) {
-        QSharedPointer<QSettings> eventTypeSettings(new QSettings(file.filePath(), QSettings::IniFormat));
-        if (eventTypeSettings->status() == QSettings::NoError) {
-            eventTypesMap.insert(eventType, eventTypeSettings);
+    EventTypeTable::Sources sources;
+    foreach (const QString &file, eventTypeFiles) {
+        QFileInfo fileInfo(eventTypesPath + file);
+        if (fileInfo.exists() && fileInfo.size() != 0 && fileInfo.size() <= FILE_MAX_SIZE) {
+            sources.insert(file, qMakePair(fileInfo.lastModified().toTime_t(), uint(fileInfo.size())));
+        }
+    }
+
+    if (sources == tableSources) {
+        return QStringList();
+    }
+
+    // The event types decoded from the previous table may have changed
+    eventTypeCache.clear();
+    missingEventTypes.clear();
+
+    // A table compiled earlier can be used for the configuration files that have not changed since
+    if (tableSources.isEmpty() && !tableFileName.isEmpty() && table.open(tableFileName)) {
+        tableSources = table.sources();
+        if (tableSources == sources) {
+            return QStringList();
         }
     }
+
+    QStringList modifiedEventTypes;
+    QByteArray tableData = compileTable(sources, modifiedEventTypes);
+    tableSources = sources;
+
+    if (!tableFileName.isEmpty()) {
+        // Write the table to a new file first so that the table being used is never partially written
+        QFile newTableFile(tableFileName + ".new");
+        if (newTableFile.open(QIODevice::WriteOnly) && newTableFile.write(tableData) == tableData.size()) {
+            newTableFile.close();
+            QFile::remove(tableFileName);
+            if (newTableFile.rename(tableFileName) && table.open(tableFileName)) {
+                return modifiedEventTypes;
+            }
+        }
+    }
+
+    // The table can't be stored so it is used from memory
+    table.load(tableData);
+    return modifiedEventTypes;
 }
 
-void EventTypeStore::eventTypeAccessed(const QString &eventType)
+QByteArray EventTypeStore::compileTable(const EventTypeTable::Sources &sources, QStringList &modifiedEventTypes) const
 {
-    // Mark the event type as recently used by moving it to the beginning of the usage list
-    eventTypeUsage.removeAll(eventType);
-    eventTypeUsage.insert(0, eventType);
+    QMap<QString, EventTypeTable::Parameters> eventTypes;
+    for (EventTypeTable::Sources::const_iterator i = sources.constBegin(); i != sources.constEnd(); ++i) {
+        QString eventType = QFileInfo(i.key()).completeBaseName();
+
+        // Only the configuration files whose modification time or size has changed are read again
+        EventTypeTable::Sources::const_iterator previous = tableSources.constFind(i.key());
+        if (previous != tableSources.constEnd() && previous.value() == i.value() && table.contains(eventType)) {
+            eventTypes.insert(eventType, table.parameters(eventType));
+            continue;
+        }
 
-    // If there are too many event types in memory get rid of the extra ones
-    while (eventTypeUsage.count() > (int)maxStoredEventTypes) {
-        eventTypesMap.remove(eventTypeUsage.takeLast());
+        modifiedEventTypes.append(eventType);
+        QSettings settings(eventTypesPath + i.key(), QSettings::IniFormat);
+        if (settings.status() == QSettings::NoError) {
+            EventTypeTable::Parameters parameters;
+            foreach (const QString &key, settings.allKeys()) {
+                parameters.insert(key, settings.value(key).toString());
+            }
+            eventTypes.insert(eventType, parameters);
+        }
     }
+
+    return EventTypeTable::serialize(eventTypes, sources);
 }
@@ -20,13 +20,15 @@
 #ifndef EVENTTYPESTORE_H_
 #define EVENTTYPESTORE_H_
 
+#include "eventtypetable.h"
+
 #include <QString>
 #include <QMap>
 #include <QSet>
-#include <QSettings>
-#include <QSharedPointer>
+#include <QCache>
 #include <QStringList>
 #include <QFileSystemWatcher>
+#include <QTimer>
 
 
 /*!
@@ -38,6 +40,15 @@
  * time in case a huge number of event types are defined by a misbehaving
  * package.
  *
+ * The configuration files are compiled into an EventTypeTable which is
+ * written to a file and memory mapped. The table is compiled again only when
+ * the modification time or size of a configuration file changes, so the
+ * configuration files are normally not parsed at all.
+ *
+ * Changes in the event types directory are collected for a short while and
+ * handled as a single batch, so installing a package with several event types
+ * reads only the changed configuration files once and emits a single
+ * eventTypesModified() signal.
  */
 class EventTypeStore : public QObject
 {
@@ -50,8 +61,9 @@ public:
      *
      * \param eventTypesPath The path where the different event types are defined
      * \param maxStoredEventTypes The maximum number of event types to keep in memory
+     * \param tableFileName The file where the compiled event type table is stored. If empty the table is compiled on every start.
      */
-    explicit EventTypeStore(const QString &eventTypesPath, uint maxStoredEventTypes = 100);
+    explicit EventTypeStore(const QString &eventTypesPath, uint maxStoredEventTypes = 100, const QString &tableFileName = QString());
 
     /*!
      * Tests if the \a eventType exists in the system.
@@ -91,26 +103,40 @@ public:
      */
     QString value(const QString &eventType, const QString &key) const;
 
-private slots:
     /*!
-     * Updates the list of available event type files
+     * Returns the number of lookups that were answered from memory. This
+     * includes the lookups of event types that are known not to exist.
      */
-    void updateEventTypeFileList();
+    uint cacheHits() const;
 
     /*!
-     * Updates the event type representing the given file
-     *
-     * Only updates the event type if file is modified. Removing an event type file is handled
-     * by updateEventTypeFileList() slot
+     * Returns the number of lookups that had to read the event type from
+     * the compiled event type table.
+     */
+    uint cacheMisses() const;
+
+    /*!
+     * Returns the number of event types that have been dropped from memory
+     * to make room for more recently used event types.
      */
-    void updateEventTypeFile(const QString &path);
+    uint cacheEvictions() const;
+
+private slots:
+    //! Schedules the event types directory to be checked for changes once the changes have settled
+    void scheduleUpdate();
+
+    /*!
+     * Updates the list of available event type files and the event types
+     * whose configuration files have been added or modified
+     */
+    void updateEventTypeFileList();
 
 signals:
     /*!
-     * A signal sent whenever an event type has been modified
-     * \param eventType the event type that was modified
+     * A signal sent whenever event types have been installed or modified
+     * \param eventTypes the event types that were installed or modified
      */
-    void eventTypeModified(const QString &eventType);
+    void eventTypesModified(const QStringList &eventTypes);
 
     /*!
      * A signal sent whenever an event type has been uninstalled
@@ -125,29 +151,74 @@ private:
     //! The maximum size of the event configuration file
     static const uint FILE_MAX_SIZE;
 
+    //! The time in milliseconds to wait for further changes before updating the event types
+    static const int UPDATE_DELAY;
+
     //! The path where the event type configuration files are stored
     QString eventTypesPath;
 
     //! The maximum number of event types to keep in memory
     uint maxStoredEventTypes;
 
-    //! Map for storing event types and corresponding QSettings object
-    mutable QMap<QString, QSharedPointer<QSettings> > eventTypesMap;
+    //! The file where the compiled event type table is stored
+    QString tableFileName;
+
+    //! The compiled event types
+    EventTypeTable table;
 
-    //! List for keeping track of which event types have been most recently used
-    mutable QStringList eventTypeUsage;
+    //! The configuration files the table was compiled from
+    EventTypeTable::Sources tableSources;
 
-    //! Load the data into our internal map
-    void loadSettings(const QString &eventType);
+    //! The parameters of the most recently used event types decoded from the table. Evicts the least recently used event type in constant time.
+    mutable QCache<QString, EventTypeTable::Parameters> eventTypeCache;
 
-    //! Marks the event type to be used recently
-    void eventTypeAccessed(const QString &eventType);
+    //! Event types recently looked up that don't exist. Cleared whenever the event types directory changes.
+    mutable QSet<QString> missingEventTypes;
+
+    //! The number of lookups answered from memory
+    mutable uint hitCount;
+
+    //! The number of lookups that read the event type table
+    mutable uint missCount;
+
+    //! The number of event types dropped from memory
+    mutable uint evictionCount;
+
+    /*!
+     * Returns the parameters of an event type, decoding them from the table
+     * if the event type is not in memory. Marks the event type as recently used.
+     *
+     * \param eventType the event type
+     * \return the parameters of the event type, or NULL if the event type doesn't exist
+     */
+    const EventTypeTable::Parameters *eventTypeParameters(const QString &eventType) const;
+
+    /*!
+     * Compiles the event type table again if the configuration files have
+     * changed since it was compiled.
+     *
+     * \return the event types whose configuration files were read again
+     */
+    QStringList updateTable();
+
+    /*!
+     * Compiles the event type table from the given configuration files.
+     * Reuses the parameters in the current table for the files that have
+     * not changed since it was compiled.
+     *
+     * \param sources the configuration files
+     * \param modifiedEventTypes the event types whose configuration files were read are appended to this list
+     */
+    QByteArray compileTable(const EventTypeTable::Sources &sources, QStringList &modifiedEventTypes) const;
 
     //! File system watcher to notice changes in installed event types
     QFileSystemWatcher eventTypePathWatcher;
 
     //! List of available event type files
     QSet<QString> eventTypeFiles;
+
+    //! Timer for collecting the changes in the event types directory into a batch
+    QTimer updateTimer;
 };
 
 #endif /* EVENTTYPESTORE_H_ */
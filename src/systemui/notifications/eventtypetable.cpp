@@ -0,0 +1,358 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include "eventtypetable.h"
+#include <QFile>
+#include <QDataStream>
+#include <QVector>
+#include <QStringList>
+#include <QtEndian>
+#include <QtAlgorithms>
+#include <cstring>
+
+const quint32 EventTypeTable::Magic = 0x4d455454;
+const quint32 EventTypeTable::Version = 1;
+
+//! Size of the file header: magic, version, the counts of strings, buckets, event types, parameters and configuration files and a reserved field
+static const qint64 FILE_HEADER_SIZE = 32;
+
+//! Size of an event type entry: name, index of the first parameter and number of parameters
+static const qint64 EVENT_TYPE_ENTRY_SIZE = 12;
+
+//! Size of a parameter entry: name and value
+static const qint64 PARAMETER_ENTRY_SIZE = 8;
+
+//! Size of a configuration file entry: name, modification time and size
+static const qint64 SOURCE_ENTRY_SIZE = 12;
+
+//! Hash bucket value denoting an empty bucket
+static const quint32 NO_STRING = 0xffffffff;
+
+EventTypeTable::EventTypeTable() :
+    file(NULL),
+    mappedData(NULL),
+    data(NULL),
+    size(0),
+    stringCount(0),
+    bucketCount(0),
+    eventTypeCount(0),
+    parameterCount(0),
+    sourceCount(0),
+    stringOffsetsOffset(0),
+    bucketsOffset(0),
+    eventTypesOffset(0),
+    parametersOffset(0),
+    sourcesOffset(0),
+    stringDataOffset(0)
+{
+}
+
+EventTypeTable::~EventTypeTable()
+{
+    close();
+}
+
+bool EventTypeTable::open(const QString &fileName)
+{
+    close();
+
+    file = new QFile(fileName);
+    if (!file->open(QIODevice::ReadOnly)) {
+        close();
+        return false;
+    }
+
+    qint64 fileSize = file->size();
+    mappedData = fileSize > 0 ? file->map(0, fileSize) : NULL;
+    if (mappedData != NULL) {
+        if (parse(mappedData, fileSize)) {
+            return true;
+        }
+        close();
+        return false;
+    }
+
+    // The file can't be mapped: read the whole file instead
+    return load(file->readAll());
+}
+
+bool EventTypeTable::load(const QByteArray &tableData)
+{
+    close();
+
+    loadedData = tableData;
+    if (parse(reinterpret_cast<const uchar *>(loadedData.constData()), loadedData.size())) {
+        return true;
+    }
+
+    close();
+    return false;
+}
+
+void EventTypeTable::close()
+{
+    if (file != NULL) {
+        if (mappedData != NULL) {
+            file->unmap(mappedData);
+        }
+        delete file;
+    }
+    file = NULL;
+    mappedData = NULL;
+    loadedData.clear();
+    data = NULL;
+    size = 0;
+    stringCount = 0;
+    bucketCount = 0;
+    eventTypeCount = 0;
+    parameterCount = 0;
+    sourceCount = 0;
+}
+
+bool EventTypeTable::parse(const uchar *tableData, qint64 tableSize)
+{
+    if (tableSize < FILE_HEADER_SIZE || qFromBigEndian<quint32>(tableData) != Magic || qFromBigEndian<quint32>(tableData + 4) != Version) {
+        return false;
+    }
+
+    quint32 strings = qFromBigEndian<quint32>(tableData + 8);
+    quint32 buckets = qFromBigEndian<quint32>(tableData + 12);
+    quint32 eventTypes = qFromBigEndian<quint32>(tableData + 16);
+    quint32 parameterTotal = qFromBigEndian<quint32>(tableData + 20);
+    quint32 files = qFromBigEndian<quint32>(tableData + 24);
+
+    // The hash table must have empty buckets so that looking up a missing string terminates
+    if (buckets <= strings || (buckets & (buckets - 1)) != 0) {
+        return false;
+    }
+
+    qint64 offsets = FILE_HEADER_SIZE;
+    qint64 hashTable = offsets + (qint64(strings) + 1) * 4;
+    qint64 eventTypeEntries = hashTable + qint64(buckets) * 4;
+    qint64 parameterEntries = eventTypeEntries + qint64(eventTypes) * EVENT_TYPE_ENTRY_SIZE;
+    qint64 sourceEntries = parameterEntries + qint64(parameterTotal) * PARAMETER_ENTRY_SIZE;
+    qint64 pool = sourceEntries + qint64(files) * SOURCE_ENTRY_SIZE;
+    if (pool > tableSize) {
+        return false;
+    }
+
+    // The last entry of the string offset table is the size of the string data
+    if (pool + qFromBigEndian<quint32>(tableData + offsets + qint64(strings) * 4) > tableSize) {
+        return false;
+    }
+
+    data = tableData;
+    size = tableSize;
+    stringCount = strings;
+    bucketCount = buckets;
+    eventTypeCount = eventTypes;
+    parameterCount = parameterTotal;
+    sourceCount = files;
+    stringOffsetsOffset = offsets;
+    bucketsOffset = hashTable;
+    eventTypesOffset = eventTypeEntries;
+    parametersOffset = parameterEntries;
+    sourcesOffset = sourceEntries;
+    stringDataOffset = pool;
+    return true;
+}
+
+EventTypeTable::Sources EventTypeTable::sources() const
+{
+    Sources tableSources;
+    for (quint32 i = 0; i < sourceCount; ++i) {
+        const uchar *entry = data + sourcesOffset + i * SOURCE_ENTRY_SIZE;
+        tableSources.insert(string(qFromBigEndian<quint32>(entry)), qMakePair(qFromBigEndian<quint32>(entry + 4), qFromBigEndian<quint32>(entry + 8)));
+    }
+    return tableSources;
+}
+
+bool EventTypeTable::contains(const QString &eventType) const
+{
+    return eventTypeIndex(eventType) >= 0;
+}
+
+EventTypeTable::Parameters EventTypeTable::parameters(const QString &eventType) const
+{
+    Parameters eventTypeParameters;
+
+    qint64 index = eventTypeIndex(eventType);
+    if (index >= 0) {
+        const uchar *entry = data + eventTypesOffset + index * EVENT_TYPE_ENTRY_SIZE;
+        quint32 first = qFromBigEndian<quint32>(entry + 4);
+        quint32 count = qFromBigEndian<quint32>(entry + 8);
+        if (first <= parameterCount && count <= parameterCount - first) {
+            for (quint32 i = first; i < first + count; ++i) {
+                const uchar *parameter = data + parametersOffset + i * PARAMETER_ENTRY_SIZE;
+                eventTypeParameters.insert(string(qFromBigEndian<quint32>(parameter)), string(qFromBigEndian<quint32>(parameter + 4)));
+            }
+        }
+    }
+
+    return eventTypeParameters;
+}
+
+qint64 EventTypeTable::stringIndex(const QByteArray &string) const
+{
+    if (bucketCount == 0) {
+        return -1;
+    }
+
+    quint32 mask = bucketCount - 1;
+    quint32 bucket = qHash(string) & mask;
+    for (quint32 probe = 0; probe < bucketCount; ++probe) {
+        quint32 index = qFromBigEndian<quint32>(data + bucketsOffset + bucket * 4);
+        if (index == NO_STRING) {
+            break;
+        }
+
+        quint32 length = 0;
+        const char *candidate = stringData(index, &length);
+        if (candidate != NULL && length == quint32(string.size()) && memcmp(candidate, string.constData(), length) == 0) {
+            return index;
+        }
+
+        bucket = (bucket + 1) & mask;
+    }
+
+    return -1;
+}
+
+qint64 EventTypeTable::eventTypeIndex(const QString &eventType) const
+{
+    qint64 name = stringIndex(eventType.toUtf8());
+    if (name < 0) {
+        return -1;
+    }
+
+    // The event types are sorted by the index of their name
+    qint64 low = 0;
+    qint64 high = qint64(eventTypeCount) - 1;
+    while (low <= high) {
+        qint64 middle = (low + high) / 2;
+        qint64 middleName = qFromBigEndian<quint32>(data + eventTypesOffset + middle * EVENT_TYPE_ENTRY_SIZE);
+        if (middleName < name) {
+            low = middle + 1;
+        } else if (middleName > name) {
+            high = middle - 1;
+        } else {
+            return middle;
+        }
+    }
+
+    return -1;
+}
+
+const char *EventTypeTable::stringData(quint32 index, quint32 *length) const
+{
+    if (index >= stringCount) {
+        return NULL;
+    }
+
+    const uchar *offsets = data + stringOffsetsOffset + index * 4;
+    quint32 begin = qFromBigEndian<quint32>(offsets);
+    quint32 end = qFromBigEndian<quint32>(offsets + 4);
+    if (begin > end || stringDataOffset + end > size) {
+        return NULL;
+    }
+
+    *length = end - begin;
+    return reinterpret_cast<const char *>(data + stringDataOffset + begin);
+}
+
+QString EventTypeTable::string(quint32 index) const
+{
+    quint32 length = 0;
+    const char *utf8 = stringData(index, &length);
+    return utf8 != NULL ? QString::fromUtf8(utf8, length) : QString();
+}
+
+QByteArray EventTypeTable::serialize(const QMap<QString, Parameters> &eventTypes, const Sources &sources)
+{
+    // Collect the strings in sorted order so that the event types and parameters sorted by name are also sorted by string index
+    QMap<QString, quint32> stringIndexes;
+    for (QMap<QString, Parameters>::const_iterator i = eventTypes.constBegin(); i != eventTypes.constEnd(); ++i) {
+        stringIndexes.insert(i.key(), 0);
+        for (Parameters::const_iterator parameter = i->constBegin(); parameter != i->constEnd(); ++parameter) {
+            stringIndexes.insert(parameter.key(), 0);
+            stringIndexes.insert(parameter.value(), 0);
+        }
+    }
+    for (Sources::const_iterator i = sources.constBegin(); i != sources.constEnd(); ++i) {
+        stringIndexes.insert(i.key(), 0);
+    }
+
+    // Keep the load factor of the hash table at most one half
+    quint32 buckets = 2;
+    while (buckets < quint32(stringIndexes.count()) * 2) {
+        buckets *= 2;
+    }
+
+    QVector<quint32> hashTable(buckets, NO_STRING);
+    QByteArray pool;
+    QList<quint32> stringOffsets;
+    quint32 index = 0;
+    for (QMap<QString, quint32>::iterator i = stringIndexes.begin(); i != stringIndexes.end(); ++i, ++index) {
+        *i = index;
+
+        QByteArray utf8 = i.key().toUtf8();
+        stringOffsets.append(pool.size());
+        pool.append(utf8);
+
+        quint32 bucket = qHash(utf8) & (buckets - 1);
+        while (hashTable.at(bucket) != NO_STRING) {
+            bucket = (bucket + 1) & (buckets - 1);
+        }
+        hashTable[bucket] = index;
+    }
+    stringOffsets.append(pool.size());
+
+    QByteArray eventTypeEntries;
+    QDataStream eventTypeStream(&eventTypeEntries, QIODevice::WriteOnly);
+    QByteArray parameterEntries;
+    QDataStream parameterStream(&parameterEntries, QIODevice::WriteOnly);
+    quint32 parameterTotal = 0;
+    for (QMap<QString, Parameters>::const_iterator i = eventTypes.constBegin(); i != eventTypes.constEnd(); ++i) {
+        QStringList keys = i->keys();
+        qSort(keys);
+
+        eventTypeStream << stringIndexes.value(i.key()) << parameterTotal << quint32(keys.count());
+        foreach (const QString &key, keys) {
+            parameterStream << stringIndexes.value(key) << stringIndexes.value(i->value(key));
+        }
+        parameterTotal += keys.count();
+    }
+
+    QByteArray table;
+    QDataStream stream(&table, QIODevice::WriteOnly);
+    stream << Magic << Version << quint32(stringIndexes.count()) << buckets << quint32(eventTypes.count()) << parameterTotal << quint32(sources.count()) << quint32(0);
+    foreach (quint32 offset, stringOffsets) {
+        stream << offset;
+    }
+    foreach (quint32 bucket, hashTable) {
+        stream << bucket;
+    }
+    stream.writeRawData(eventTypeEntries.constData(), eventTypeEntries.size());
+    stream.writeRawData(parameterEntries.constData(), parameterEntries.size());
+    for (Sources::const_iterator i = sources.constBegin(); i != sources.constEnd(); ++i) {
+        stream << stringIndexes.value(i.key()) << quint32(i->first) << quint32(i->second);
+    }
+    stream.writeRawData(pool.constData(), pool.size());
+    return table;
+}
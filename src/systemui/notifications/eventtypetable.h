@@ -0,0 +1,199 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef EVENTTYPETABLE_H_
+#define EVENTTYPETABLE_H_
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QMap>
+#include <QPair>
+
+class QFile;
+
+/*!
+ * A read-only table of event type parameters compiled from the event type
+ * configuration files.
+ *
+ * The table is stored in a versioned binary format designed to be memory
+ * mapped. All integers are stored in big endian byte order.
+ *
+ * - A file header: magic number, format version and the number of strings,
+ *   hash buckets, event types, parameters and configuration files
+ * - The offsets of the strings in the string pool
+ * - A hash table of the strings using open addressing: each bucket contains
+ *   the index of a string or an empty marker
+ * - The event types sorted by the index of their name: name, index of the first parameter and number of parameters
+ * - The parameters of the event types sorted by the index of their name: name and value
+ * - The configuration files the table was compiled from: name, modification time and size
+ * - The string pool: the UTF-8 encoded strings. Every string (event type
+ *   names, parameter names and values) is stored only once.
+ *
+ * Finding an event type or a parameter doesn't require parsing: the name is
+ * looked up from the hash table and the entry is then found with a binary search.
+ */
+class EventTypeTable
+{
+public:
+    //! The parameters of an event type keyed by the parameter name
+    typedef QHash<QString, QString> Parameters;
+
+    //! The modification times and sizes of the configuration files keyed by the file name
+    typedef QMap<QString, QPair<uint, uint> > Sources;
+
+    //! The magic number identifying an event type table
+    static const quint32 Magic;
+
+    //! The version of the format written by serialize()
+    static const quint32 Version;
+
+    /*!
+     * Creates an empty table.
+     */
+    EventTypeTable();
+
+    /*!
+     * Destroys the EventTypeTable. Unmaps the table file.
+     */
+    virtual ~EventTypeTable();
+
+    /*!
+     * Maps the given table file into memory.
+     *
+     * \param fileName the name of the table file
+     * \return \c true if the file could be opened and contains a valid table, \c false otherwise
+     */
+    bool open(const QString &fileName);
+
+    /*!
+     * Uses the given serialized table.
+     *
+     * \param data the serialized table
+     * \return \c true if the data contains a valid table, \c false otherwise
+     */
+    bool load(const QByteArray &data);
+
+    /*!
+     * Closes the table. The table is empty afterwards.
+     */
+    void close();
+
+    /*!
+     * Returns the configuration files the table was compiled from.
+     *
+     * \return the modification times and sizes of the configuration files
+     */
+    Sources sources() const;
+
+    /*!
+     * Tests whether the table contains an event type.
+     *
+     * \param eventType the event type
+     * \return \c true if the event type is in the table, \c false otherwise
+     */
+    bool contains(const QString &eventType) const;
+
+    /*!
+     * Decodes the parameters of an event type.
+     *
+     * \param eventType the event type
+     * \return the parameters of the event type. Empty if the event type is not in the table.
+     */
+    Parameters parameters(const QString &eventType) const;
+
+    /*!
+     * Serializes the given event types into a table.
+     *
+     * \param eventTypes the parameters of the event types keyed by the event type
+     * \param sources the configuration files the event types were read from
+     * \return the serialized table
+     */
+    static QByteArray serialize(const QMap<QString, Parameters> &eventTypes, const Sources &sources);
+
+private:
+    //! Sets up the table from the serialized data. Returns \c false if the data is not a valid table.
+    bool parse(const uchar *data, qint64 size);
+
+    //! Returns the index of the given UTF-8 encoded string in the string pool, or -1 if the string is not in the pool
+    qint64 stringIndex(const QByteArray &string) const;
+
+    //! Returns the index of the event type with the given name, or -1 if the event type is not in the table
+    qint64 eventTypeIndex(const QString &eventType) const;
+
+    //! Returns the string at the given index of the string pool
+    QString string(quint32 index) const;
+
+    //! Returns a pointer to the UTF-8 data of the string at the given index and stores its length to \a length. Returns NULL for invalid indexes.
+    const char *stringData(quint32 index, quint32 *length) const;
+
+    //! The file the table is mapped from
+    QFile *file;
+
+    //! The mapped table file, or NULL if the file is not mapped
+    uchar *mappedData;
+
+    //! Table data given to load(), kept so that the data stays valid
+    QByteArray loadedData;
+
+    //! The table data
+    const uchar *data;
+
+    //! The size of the table data in bytes
+    qint64 size;
+
+    //! The number of strings in the string pool
+    quint32 stringCount;
+
+    //! The number of buckets in the string hash table. Always a power of two.
+    quint32 bucketCount;
+
+    //! The number of event types in the table
+    quint32 eventTypeCount;
+
+    //! The number of parameters of all event types
+    quint32 parameterCount;
+
+    //! The number of configuration files the table was compiled from
+    quint32 sourceCount;
+
+    //! Offset of the string offset table
+    qint64 stringOffsetsOffset;
+
+    //! Offset of the string hash table
+    qint64 bucketsOffset;
+
+    //! Offset of the event type entries
+    qint64 eventTypesOffset;
+
+    //! Offset of the parameter entries
+    qint64 parametersOffset;
+
+    //! Offset of the configuration file entries
+    qint64 sourcesOffset;
+
+    //! Offset of the UTF-8 string data
+    qint64 stringDataOffset;
+
+#ifdef UNIT_TEST
+    friend class Ut_EventTypeTable;
+#endif
+};
+
+#endif /* EVENTTYPETABLE_H_ */
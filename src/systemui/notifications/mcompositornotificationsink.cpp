@@ -86,7 +86,7 @@ void MCompositorNotificationSink::createWindowIfNecessary()
 
 void MCompositorNotificationSink::addNotification(const Notification &notification)
 {
-    if (!canAddNotification(notification) || !containsText(notification)) {
+    if (!canAddNotification(notification) || !notification.hasText()) {
         return;
     }
 
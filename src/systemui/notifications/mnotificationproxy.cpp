@@ -26,6 +26,15 @@
 
 #include "mnotificationproxy.h"
 
+//! The keys of the parameters serialized as MNotification fields. Created once so that marshalling a list doesn't create them for every item.
+static const QString EVENT_TYPE_KEY = GenericNotificationParameterFactory::eventTypeKey();
+static const QString SUMMARY_KEY = NotificationWidgetParameterFactory::summaryKey();
+static const QString BODY_KEY = NotificationWidgetParameterFactory::bodyKey();
+static const QString IMAGE_ID_KEY = NotificationWidgetParameterFactory::imageIdKey();
+static const QString ACTION_KEY = NotificationWidgetParameterFactory::actionKey();
+static const QString COUNT_KEY = GenericNotificationParameterFactory::countKey();
+static const QString IDENTIFIER_KEY = GenericNotificationParameterFactory::identifierKey();
+
 MNotificationProxy::MNotificationProxy() :
     notificationId(0),
     groupId(0),
@@ -318,3 +327,219 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, MNotificationGrou
     argument.endStructure();
     return argument;
 }
+
+MNotificationBatchItemProxy::MNotificationBatchItemProxy()
+:   id(0),
+    parameters(NotificationParameters())
+{
+}
+
+MNotificationBatchItemProxy::MNotificationBatchItemProxy(uint id, const NotificationParameters &parameters)
+:   id(id),
+    parameters(parameters)
+{
+}
+
+QDBusArgument &operator<<(QDBusArgument &argument, const MNotificationBatchItemProxy &item)
+{
+    argument.beginStructure();
+    argument << item.id;
+    argument << item.parameters;
+    argument.endStructure();
+    return argument;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &argument, MNotificationBatchItemProxy &item)
+{
+    argument.beginStructure();
+    argument >> item.id;
+    argument >> item.parameters;
+    argument.endStructure();
+    return argument;
+}
+
+//! Writes the MNotification and MNotificationGroup fields that are common to both straight from the parameters
+static void marshallFields(QDBusArgument &argument, const NotificationParameters &parameters)
+{
+    argument << parameters.value(EVENT_TYPE_KEY).toString();
+    argument << parameters.value(SUMMARY_KEY).toString();
+    argument << parameters.value(BODY_KEY).toString();
+    argument << parameters.value(IMAGE_ID_KEY).toString();
+    argument << parameters.value(ACTION_KEY).toString();
+    argument << parameters.value(COUNT_KEY).toUInt();
+}
+
+//! Returns notification parameters containing the fields of a demarshalled MNotification or MNotificationGroup
+template<class Proxy> static NotificationParameters parametersOf(const Proxy &proxy)
+{
+    NotificationParameters parameters;
+    parameters.add(EVENT_TYPE_KEY, proxy.eventType);
+    parameters.add(SUMMARY_KEY, proxy.summary);
+    parameters.add(BODY_KEY, proxy.body);
+    parameters.add(IMAGE_ID_KEY, proxy.imageId);
+    parameters.add(ACTION_KEY, proxy.action);
+    parameters.add(COUNT_KEY, proxy.count);
+    return parameters;
+}
+
+MNotificationListProxy::MNotificationListProxy()
+{
+}
+
+MNotificationListProxy::MNotificationListProxy(const QList<Notification> &notifications) :
+    notifications(notifications)
+{
+}
+
+QDBusArgument &operator<<(QDBusArgument &argument, const MNotificationListProxy &list)
+{
+    argument.beginArray(qMetaTypeId<MNotificationProxy>());
+    foreach (const Notification &notification, list.notifications) {
+        argument.beginStructure();
+        argument << notification.notificationId();
+        argument << notification.groupId();
+        marshallFields(argument, notification.parameters());
+        argument.endStructure();
+    }
+    argument.endArray();
+
+    return argument;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &argument, MNotificationListProxy &list)
+{
+    list.notifications.clear();
+
+    argument.beginArray();
+    while (!argument.atEnd()) {
+        MNotificationProxy notification;
+        argument >> notification;
+        list.notifications.append(Notification(notification.notificationId, notification.groupId, 0, parametersOf(notification), Notification::ApplicationEvent, 0));
+    }
+    argument.endArray();
+
+    return argument;
+}
+
+MNotificationWithIdentifierListProxy::MNotificationWithIdentifierListProxy()
+{
+}
+
+MNotificationWithIdentifierListProxy::MNotificationWithIdentifierListProxy(const QList<Notification> &notifications) :
+    MNotificationListProxy(notifications)
+{
+}
+
+QDBusArgument &operator<<(QDBusArgument &argument, const MNotificationWithIdentifierListProxy &list)
+{
+    argument.beginArray(qMetaTypeId<MNotificationWithIdentifierProxy>());
+    foreach (const Notification &notification, list.notifications) {
+        const NotificationParameters &parameters = notification.parameters();
+        argument.beginStructure();
+        argument << notification.notificationId();
+        argument << notification.groupId();
+        marshallFields(argument, parameters);
+        argument << parameters.value(IDENTIFIER_KEY).toString();
+        argument.endStructure();
+    }
+    argument.endArray();
+
+    return argument;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &argument, MNotificationWithIdentifierListProxy &list)
+{
+    list.notifications.clear();
+
+    argument.beginArray();
+    while (!argument.atEnd()) {
+        MNotificationWithIdentifierProxy notification;
+        argument >> notification;
+        NotificationParameters parameters = parametersOf(notification);
+        parameters.add(IDENTIFIER_KEY, notification.identifier);
+        list.notifications.append(Notification(notification.notificationId, notification.groupId, 0, parameters, Notification::ApplicationEvent, 0));
+    }
+    argument.endArray();
+
+    return argument;
+}
+
+MNotificationGroupListProxy::MNotificationGroupListProxy()
+{
+}
+
+MNotificationGroupListProxy::MNotificationGroupListProxy(const QList<NotificationGroup> &groups) :
+    groups(groups)
+{
+}
+
+QDBusArgument &operator<<(QDBusArgument &argument, const MNotificationGroupListProxy &list)
+{
+    argument.beginArray(qMetaTypeId<MNotificationGroupProxy>());
+    foreach (const NotificationGroup &group, list.groups) {
+        argument.beginStructure();
+        argument << group.groupId();
+        marshallFields(argument, group.parameters());
+        argument.endStructure();
+    }
+    argument.endArray();
+
+    return argument;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &argument, MNotificationGroupListProxy &list)
+{
+    list.groups.clear();
+
+    argument.beginArray();
+    while (!argument.atEnd()) {
+        MNotificationGroupProxy group;
+        argument >> group;
+        list.groups.append(NotificationGroup(group.groupId, 0, parametersOf(group)));
+    }
+    argument.endArray();
+
+    return argument;
+}
+
+MNotificationGroupWithIdentifierListProxy::MNotificationGroupWithIdentifierListProxy()
+{
+}
+
+MNotificationGroupWithIdentifierListProxy::MNotificationGroupWithIdentifierListProxy(const QList<NotificationGroup> &groups) :
+    MNotificationGroupListProxy(groups)
+{
+}
+
+QDBusArgument &operator<<(QDBusArgument &argument, const MNotificationGroupWithIdentifierListProxy &list)
+{
+    argument.beginArray(qMetaTypeId<MNotificationGroupWithIdentifierProxy>());
+    foreach (const NotificationGroup &group, list.groups) {
+        const NotificationParameters &parameters = group.parameters();
+        argument.beginStructure();
+        argument << group.groupId();
+        marshallFields(argument, parameters);
+        argument << parameters.value(IDENTIFIER_KEY).toString();
+        argument.endStructure();
+    }
+    argument.endArray();
+
+    return argument;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &argument, MNotificationGroupWithIdentifierListProxy &list)
+{
+    list.groups.clear();
+
+    argument.beginArray();
+    while (!argument.atEnd()) {
+        MNotificationGroupWithIdentifierProxy group;
+        argument >> group;
+        NotificationParameters parameters = parametersOf(group);
+        parameters.add(IDENTIFIER_KEY, group.groupIdentifier);
+        list.groups.append(NotificationGroup(group.groupId, 0, parameters));
+    }
+    argument.endArray();
+
+    return argument;
+}
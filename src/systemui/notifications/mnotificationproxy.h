@@ -20,8 +20,9 @@
 #ifndef PROXYMNOTIFICATION_H_
 #define PROXYMNOTIFICATION_H_
 
-class Notification;
-class NotificationGroup;
+#include "notification.h"
+#include "notificationgroup.h"
+
 class DBusArgument;
 
 /*!
@@ -231,4 +232,156 @@ public:
 
 QDBusArgument &operator<<(QDBusArgument &, const MNotificationGroupProxyWithParameters &);
 const QDBusArgument &operator>>(const QDBusArgument &, MNotificationGroupProxyWithParameters &);
+
+/*!
+ * \brief A proxy class for serializing an item of a batch notification operation
+ *
+ * When notifications are added in a batch the ID is the ID of the group to
+ * add the notification to. When notifications are updated in a batch the ID
+ * is the ID of the notification to update.
+ */
+class MNotificationBatchItemProxy
+{
+public:
+    /*!
+     * Empty constructor. Initializes the values to defaults.
+     */
+    MNotificationBatchItemProxy();
+
+    /*!
+     * Constructor.
+     *
+     * \param id the group or notification ID of the item
+     * \param parameters the notification parameters of the item
+     */
+    MNotificationBatchItemProxy(uint id, const NotificationParameters &parameters);
+
+    // Group or notification id of the item
+    uint id;
+    // Parameters of the item.
+    NotificationParameters parameters;
+};
+
+QDBusArgument &operator<<(QDBusArgument &, const MNotificationBatchItemProxy &);
+const QDBusArgument &operator>>(const QDBusArgument &, MNotificationBatchItemProxy &);
+
+/*!
+ * \brief A proxy class for serializing a list of Notifications as a list of MNotifications
+ *
+ * MNotificationListProxy serializes to DBus argument the same way as a list
+ * of MNotificationProxy objects. The fields are written straight from the
+ * parameters of the notifications while marshalling, so no MNotificationProxy
+ * is created for the notifications. The notifications are implicitly shared
+ * so creating the list proxy doesn't copy any notification data.
+ */
+class MNotificationListProxy
+{
+public:
+    /*!
+     * Empty constructor. Initializes an empty list.
+     */
+    MNotificationListProxy();
+
+    /*!
+     * Constructor.
+     *
+     * \param notifications the notifications to serialize
+     */
+    MNotificationListProxy(const QList<Notification> &notifications);
+
+    //! The notifications to serialize
+    QList<Notification> notifications;
+};
+
+QDBusArgument &operator<<(QDBusArgument &, const MNotificationListProxy &);
+const QDBusArgument &operator>>(const QDBusArgument &, MNotificationListProxy &);
+
+/*!
+ * \brief A proxy class for serializing a list of Notifications as a list of MNotifications with identifiers
+ *
+ * MNotificationWithIdentifierListProxy serializes to DBus argument the same
+ * way as a list of MNotificationWithIdentifierProxy objects.
+ */
+class MNotificationWithIdentifierListProxy : public MNotificationListProxy
+{
+public:
+    /*!
+     * Empty constructor. Initializes an empty list.
+     */
+    MNotificationWithIdentifierListProxy();
+
+    /*!
+     * Constructor.
+     *
+     * \param notifications the notifications to serialize
+     */
+    MNotificationWithIdentifierListProxy(const QList<Notification> &notifications);
+};
+
+QDBusArgument &operator<<(QDBusArgument &, const MNotificationWithIdentifierListProxy &);
+const QDBusArgument &operator>>(const QDBusArgument &, MNotificationWithIdentifierListProxy &);
+
+/*!
+ * \brief A proxy class for serializing a list of NotificationGroups as a list of MNotificationGroups
+ *
+ * MNotificationGroupListProxy serializes to DBus argument the same way as a
+ * list of MNotificationGroupProxy objects. The fields are written straight
+ * from the parameters of the groups while marshalling.
+ */
+class MNotificationGroupListProxy
+{
+public:
+    /*!
+     * Empty constructor. Initializes an empty list.
+     */
+    MNotificationGroupListProxy();
+
+    /*!
+     * Constructor.
+     *
+     * \param groups the notification groups to serialize
+     */
+    MNotificationGroupListProxy(const QList<NotificationGroup> &groups);
+
+    //! The notification groups to serialize
+    QList<NotificationGroup> groups;
+};
+
+QDBusArgument &operator<<(QDBusArgument &, const MNotificationGroupListProxy &);
+const QDBusArgument &operator>>(const QDBusArgument &, MNotificationGroupListProxy &);
+
+/*!
+ * \brief A proxy class for serializing a list of NotificationGroups as a list of MNotificationGroups with identifiers
+ *
+ * MNotificationGroupWithIdentifierListProxy serializes to DBus argument the
+ * same way as a list of MNotificationGroupWithIdentifierProxy objects.
+ */
+class MNotificationGroupWithIdentifierListProxy : public MNotificationGroupListProxy
+{
+public:
+    /*!
+     * Empty constructor. Initializes an empty list.
+     */
+    MNotificationGroupWithIdentifierListProxy();
+
+    /*!
+     * Constructor.
+     *
+     * \param groups the notification groups to serialize
+     */
+    MNotificationGroupWithIdentifierListProxy(const QList<NotificationGroup> &groups);
+};
+
+QDBusArgument &operator<<(QDBusArgument &, const MNotificationGroupWithIdentifierListProxy &);
+const QDBusArgument &operator>>(const QDBusArgument &, MNotificationGroupWithIdentifierListProxy &);
+
+// The list proxies refer to the meta types of their items when marshalling
+Q_DECLARE_METATYPE(MNotificationProxy)
+Q_DECLARE_METATYPE(MNotificationWithIdentifierProxy)
+Q_DECLARE_METATYPE(MNotificationGroupProxy)
+Q_DECLARE_METATYPE(MNotificationGroupWithIdentifierProxy)
+Q_DECLARE_METATYPE(MNotificationListProxy)
+Q_DECLARE_METATYPE(MNotificationWithIdentifierListProxy)
+Q_DECLARE_METATYPE(MNotificationGroupListProxy)
+Q_DECLARE_METATYPE(MNotificationGroupWithIdentifierListProxy)
 #endif
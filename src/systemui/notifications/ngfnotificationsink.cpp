@@ -18,7 +18,6 @@
 ****************************************************************************/
 
 #include "ngfnotificationsink.h"
-#include "feedbackparameterfactory.h"
 #include "ngfadapter.h"
 
 NGFNotificationSink::NGFNotificationSink(QObject *parent) : NotificationSink(parent)
@@ -31,16 +30,10 @@ NGFNotificationSink::~NGFNotificationSink()
     delete adapter;
 }
 
-QString NGFNotificationSink::determineFeedbackId(const NotificationParameters &parameters)
-{
-    QString feedbackId = parameters.value(FeedbackParameterFactory::feedbackIdKey()).toString();
-    return feedbackId;
-}
-
 void NGFNotificationSink::addNotification(const Notification &notification)
 {
     if (canAddNotification(notification) && !idToEventId.contains(notification.notificationId())) {
-        QString feedbackId = determineFeedbackId(notification.parameters());
+        QString feedbackId = notification.feedbackId();
         if (!feedbackId.isEmpty()) {
             uint eventId = adapter->play(feedbackId);
             if (eventId > 0) {
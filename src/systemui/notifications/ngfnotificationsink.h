@@ -45,13 +45,6 @@ public:
     virtual ~NGFNotificationSink();
 
 private:
-    /*!
-     * Determines feedback id of a notification based on the given notification parameters.
-     * \param parameters Notification parameters to determine the feedback id from.
-     * \return Logical feedback id as a string
-     */
-    QString determineFeedbackId(const NotificationParameters &parameters);
-
     /*!
      * The NGF Adapter
      */
@@ -23,7 +23,8 @@
 #include <MBanner>
 #include <MRemoteAction>
 
-NotificationAreaSink::NotificationAreaSink() : WidgetNotificationSink()
+NotificationAreaSink::NotificationAreaSink() : WidgetNotificationSink(),
+    collectingBanners(false)
 {
     connect(this, SIGNAL(privacySettingChanged(bool)), this, SLOT(applyPrivacySetting(bool)));
 }
@@ -48,10 +49,7 @@ void NotificationAreaSink::updateCurrentNotifications(NotificationManagerInterfa
         addGroup(group.groupId(), group.parameters());
     }
 
-    QList <Notification> notifications = notificationManagerInterface.notifications();
-    foreach(Notification notification, notifications) {
-        addNotification(notification);
-    }
+    addNotifications(notificationManagerInterface.notifications());
 }
 
 void NotificationAreaSink::setupInfoBanner(MBanner *infoBanner, const NotificationParameters &parameters)
@@ -180,12 +178,8 @@ void NotificationAreaSink::addNotificationToGroup(const Notification &notificati
             infoBanner = createGroupBanner(groupId, notificationGroupParameters.value(groupId));
         }
 
-        if (infoBanner != NULL && infoBanner->parentItem() == NULL) {
-            // Add the group to the notification area if this is the first notification to the group
-            emit addNotification(*infoBanner);
-        } else {
-            emit notificationAddedToGroup(*infoBanner);
-        }
+        // Add the group to the notification area if this is the first notification to the group
+        addBannerToTop(infoBanner, infoBanner->parentItem() != NULL);
         increaseNotificationCountOfGroup(notification);
     }
 }
@@ -202,6 +196,18 @@ void NotificationAreaSink::addStandAloneNotification(const Notification &notific
         setupInfoBanner(infoBanner, notification.parameters());
         notificationIdToMBanner.insert(notification.notificationId(), infoBanner);
         // Add to the notification area
+        addBannerToTop(infoBanner, false);
+    }
+}
+
+void NotificationAreaSink::addBannerToTop(MBanner *infoBanner, bool bannerInNotificationArea)
+{
+    if (collectingBanners) {
+        collectedBanners.removeOne(infoBanner);
+        collectedBanners.append(infoBanner);
+    } else if (bannerInNotificationArea) {
+        emit notificationAddedToGroup(*infoBanner);
+    } else {
         emit addNotification(*infoBanner);
     }
 }
@@ -218,6 +224,27 @@ void NotificationAreaSink::addNotification(const Notification &notification)
     }
 }
 
+void NotificationAreaSink::addNotifications(const QList<Notification> &notifications)
+{
+    if (notifications.count() == 1) {
+        addNotification(notifications.first());
+        return;
+    }
+
+    // Collect the banners and add them to the notification area at once so that it is laid out only once
+    collectingBanners = true;
+    foreach (const Notification &notification, notifications) {
+        addNotification(notification);
+    }
+    collectingBanners = false;
+
+    if (!collectedBanners.isEmpty()) {
+        QList<MBanner *> banners = collectedBanners;
+        collectedBanners.clear();
+        emit addNotifications(banners);
+    }
+}
+
 void NotificationAreaSink::removeNotification(uint notificationId)
 {
     if (notificationIdToMBanner.contains(notificationId)) {
@@ -51,6 +51,7 @@ private slots:
     virtual void addGroup(uint groupId, const NotificationParameters &parameters);
     virtual void removeGroup(uint groupId);
     virtual void addNotification(const Notification &notification);
+    virtual void addNotifications(const QList<Notification> &notifications);
     virtual void removeNotification(uint notificationId);
     //! \reimp_end
 
@@ -69,6 +70,15 @@ signals:
      */
     void addNotification(MBanner &notification);
 
+    /*!
+     * Adds several notifications to a notification area at once. The
+     * notifications may already be in the notification area, in which
+     * case they are moved. The last notification goes topmost.
+     *
+     * \param notifications the MBanners to be added
+     */
+    void addNotifications(const QList<MBanner *> &notifications);
+
     /*!
      * Removes a notification from a notification area.
      *
@@ -110,6 +120,15 @@ private:
     //! A mapping between notification id and group id. Many to one relationship may exist here.
     QHash<uint, uint> notificationIdToGroupId;
 
+    //! Whether the banners are collected to be added to the notification area at once
+    bool collectingBanners;
+
+    //! The banners collected to be added to the notification area at once, the topmost last
+    QList<MBanner *> collectedBanners;
+
+    //! Adds a banner to the top of the notification area or collects it to be added there later
+    void addBannerToTop(MBanner *infoBanner, bool bannerInNotificationArea);
+
     //! Removes the banner for this group id but does not remove the group
     void removeGroupBanner(uint groupId);
 
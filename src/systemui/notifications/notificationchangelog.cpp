@@ -0,0 +1,99 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include "notificationchangelog.h"
+#include <QSet>
+#include <QtAlgorithms>
+
+NotificationChangeLog::NotificationChangeLog(quint64 sequence, int capacity) :
+    sequence_(sequence),
+    changes(qMax(capacity, 1)),
+    first(0),
+    count(0)
+{
+}
+
+NotificationChangeLog::~NotificationChangeLog()
+{
+}
+
+quint64 NotificationChangeLog::sequence() const
+{
+    return sequence_;
+}
+
+void NotificationChangeLog::recordNotificationChange(uint notificationId)
+{
+    record(notificationId, false);
+}
+
+void NotificationChangeLog::recordGroupChange(uint groupId)
+{
+    record(groupId, true);
+}
+
+void NotificationChangeLog::record(uint id, bool group)
+{
+    int capacity = changes.size();
+    Change &change = changes[(first + count) % capacity];
+    change.id = id;
+    change.group = group;
+
+    if (count < capacity) {
+        count++;
+    } else {
+        // The oldest change was overwritten
+        first = (first + 1) % capacity;
+    }
+    sequence_++;
+}
+
+bool NotificationChangeLog::contains(quint64 sequence) const
+{
+    return sequence <= sequence_ && sequence_ - sequence <= quint64(count);
+}
+
+QList<uint> NotificationChangeLog::notificationIdsChangedSince(quint64 sequence) const
+{
+    return idsChangedSince(sequence, false);
+}
+
+QList<uint> NotificationChangeLog::groupIdsChangedSince(quint64 sequence) const
+{
+    return idsChangedSince(sequence, true);
+}
+
+QList<uint> NotificationChangeLog::idsChangedSince(quint64 sequence, bool group) const
+{
+    QSet<uint> ids;
+    if (contains(sequence)) {
+        // The sequence numbers of the changes are consecutive, so the changes made after the sequence number are the last ones
+        int capacity = changes.size();
+        for (int i = count - int(sequence_ - sequence); i < count; ++i) {
+            const Change &change = changes.at((first + i) % capacity);
+            if (change.group == group) {
+                ids.insert(change.id);
+            }
+        }
+    }
+
+    QList<uint> list = ids.toList();
+    qSort(list);
+    return list;
+}
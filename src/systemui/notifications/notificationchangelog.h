@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef NOTIFICATIONCHANGELOG_H_
+#define NOTIFICATIONCHANGELOG_H_
+
+#include <QVector>
+#include <QList>
+
+/*!
+ * A bounded log of the changes made to notifications and notification groups.
+ *
+ * Every change gets the next change sequence number. The log keeps the IDs of
+ * the notifications and groups that were added, updated or removed by the
+ * latest changes, so that a party that has seen all changes up to a sequence
+ * number can be told which notifications and groups have changed since. When
+ * the log is full the oldest change is dropped for each new one, after which
+ * the changes made before it can no longer be told apart.
+ *
+ * The log is kept in a fixed size ring buffer, so recording a change never
+ * allocates memory.
+ */
+class NotificationChangeLog
+{
+public:
+    /*!
+     * Creates a new NotificationChangeLog with no changes.
+     *
+     * \param sequence the sequence number the log starts from. The first change gets the next sequence number.
+     * \param capacity the maximum number of changes kept in the log
+     */
+    NotificationChangeLog(quint64 sequence, int capacity);
+
+    /*!
+     * Destroys the NotificationChangeLog.
+     */
+    virtual ~NotificationChangeLog();
+
+    /*!
+     * Returns the sequence number of the latest change, or the sequence number
+     * the log was started from if no changes have been made.
+     *
+     * \return the sequence number of the latest change
+     */
+    quint64 sequence() const;
+
+    /*!
+     * Records a change to a notification.
+     *
+     * \param notificationId the ID of the notification that was added, updated or removed
+     */
+    void recordNotificationChange(uint notificationId);
+
+    /*!
+     * Records a change to a notification group.
+     *
+     * \param groupId the ID of the group that was added, updated or removed
+     */
+    void recordGroupChange(uint groupId);
+
+    /*!
+     * Returns whether all changes made after the given sequence number are
+     * in the log. This is not the case for sequence numbers older than the
+     * oldest change in the log or newer than the latest change.
+     *
+     * \param sequence the sequence number
+     * \return \c true if the changes made after the sequence number are in the log, \c false otherwise
+     */
+    bool contains(quint64 sequence) const;
+
+    /*!
+     * Returns the IDs of the notifications changed after the given sequence
+     * number in ascending order. Each ID is returned once no matter how many
+     * times the notification was changed.
+     *
+     * \param sequence the sequence number. Must be contained in the log.
+     * \return the IDs of the changed notifications
+     */
+    QList<uint> notificationIdsChangedSince(quint64 sequence) const;
+
+    /*!
+     * Returns the IDs of the notification groups changed after the given
+     * sequence number in ascending order.
+     *
+     * \param sequence the sequence number. Must be contained in the log.
+     * \return the IDs of the changed groups
+     */
+    QList<uint> groupIdsChangedSince(quint64 sequence) const;
+
+private:
+    //! A change to a notification or a notification group
+    struct Change {
+        //! The ID of the changed notification or group
+        uint id;
+        //! Whether the change was made to a group
+        bool group;
+    };
+
+    //! Records a change and drops the oldest change if the log is full
+    void record(uint id, bool group);
+
+    //! Returns the IDs of the notifications or groups changed after the given sequence number
+    QList<uint> idsChangedSince(quint64 sequence, bool group) const;
+
+    //! The sequence number of the latest change
+    quint64 sequence_;
+
+    //! Ring buffer of the changes
+    QVector<Change> changes;
+
+    //! The index of the oldest change in the ring buffer
+    int first;
+
+    //! The number of changes in the ring buffer
+    int count;
+
+#ifdef UNIT_TEST
+    friend class Ut_NotificationChangeLog;
+#endif
+};
+
+#endif /* NOTIFICATIONCHANGELOG_H_ */
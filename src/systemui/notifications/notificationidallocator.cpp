@@ -0,0 +1,74 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include "notificationidallocator.h"
+#include <QSet>
+#include <climits>
+
+NotificationIdAllocator::NotificationIdAllocator() :
+    highWaterMark_(0)
+{
+}
+
+NotificationIdAllocator::~NotificationIdAllocator()
+{
+}
+
+uint NotificationIdAllocator::allocate()
+{
+    if (!releasedIds.isEmpty()) {
+        return releasedIds.dequeue();
+    }
+
+    if (highWaterMark_ == UINT_MAX) {
+        // All IDs are in use
+        return 0;
+    }
+
+    return ++highWaterMark_;
+}
+
+void NotificationIdAllocator::release(uint id)
+{
+    if (id != 0 && id <= highWaterMark_) {
+        releasedIds.enqueue(id);
+    }
+}
+
+uint NotificationIdAllocator::highWaterMark() const
+{
+    return highWaterMark_;
+}
+
+void NotificationIdAllocator::restore(uint highWaterMark, const QList<uint> &usedIds)
+{
+    highWaterMark_ = highWaterMark;
+    foreach (uint id, usedIds) {
+        highWaterMark_ = qMax(highWaterMark_, id);
+    }
+
+    // Since released IDs are reused before new ones are taken the high-water mark stays close to the number of IDs in use, so this is cheap
+    QSet<uint> used = usedIds.toSet();
+    releasedIds.clear();
+    for (uint id = 1; id != 0 && id <= highWaterMark_; ++id) {
+        if (!used.contains(id)) {
+            releasedIds.enqueue(id);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef NOTIFICATIONIDALLOCATOR_H_
+#define NOTIFICATIONIDALLOCATOR_H_
+
+#include <QQueue>
+#include <QList>
+
+/*!
+ * Allocates unique notification or notification group IDs in constant time.
+ *
+ * IDs are allocated from a queue of released IDs. When there are no released
+ * IDs a new ID is taken above the high-water mark, which is the highest ID
+ * ever allocated. Released IDs are reused in the order they were released so
+ * that an ID that was just released is reused as late as possible.
+ *
+ * ID 0 is never allocated since it denotes "no ID".
+ */
+class NotificationIdAllocator
+{
+public:
+    /*!
+     * Creates a new NotificationIdAllocator with no allocated IDs.
+     */
+    NotificationIdAllocator();
+
+    /*!
+     * Destroys the NotificationIdAllocator.
+     */
+    virtual ~NotificationIdAllocator();
+
+    /*!
+     * Allocates an ID.
+     *
+     * \return the allocated ID or 0 if all IDs are in use
+     */
+    uint allocate();
+
+    /*!
+     * Releases an allocated ID so that it can be allocated again.
+     *
+     * \param id the ID to release
+     */
+    void release(uint id);
+
+    /*!
+     * Returns the highest ID ever allocated.
+     *
+     * \return the high-water mark
+     */
+    uint highWaterMark() const;
+
+    /*!
+     * Restores the state of the allocator. All IDs up to the given high-water
+     * mark or the highest used ID, whichever is higher, that are not in use
+     * become available for allocation.
+     *
+     * \param highWaterMark the highest ID ever allocated
+     * \param usedIds the IDs that are in use
+     */
+    void restore(uint highWaterMark, const QList<uint> &usedIds);
+
+private:
+    //! The highest ID ever allocated
+    uint highWaterMark_;
+
+    //! IDs at or below the high-water mark that are available for allocation
+    QQueue<uint> releasedIds;
+
+#ifdef UNIT_TEST
+    friend class Ut_NotificationIdAllocator;
+#endif
+};
+
+#endif /* NOTIFICATIONIDALLOCATOR_H_ */
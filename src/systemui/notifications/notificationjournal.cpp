@@ -0,0 +1,230 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include "notificationjournal.h"
+#include <QFile>
+#include <QDataStream>
+
+NotificationJournal::NotificationJournal(const QString &fileName) :
+    fileName(fileName),
+    records(0)
+{
+}
+
+NotificationJournal::~NotificationJournal()
+{
+}
+
+void NotificationJournal::appendNotification(const Notification &notification)
+{
+    appendRecords(notificationRecord(notification), 1);
+}
+
+void NotificationJournal::appendNotificationRemoval(uint notificationId)
+{
+    appendRecords(notificationRemovalRecord(notificationId), 1);
+}
+
+void NotificationJournal::appendGroup(const NotificationGroup &group)
+{
+    appendRecords(groupRecord(group), 1);
+}
+
+void NotificationJournal::appendGroupRemoval(uint groupId)
+{
+    appendRecords(groupRemovalRecord(groupId), 1);
+}
+
+void NotificationJournal::appendLastUsedUserId(quint32 userId)
+{
+    appendRecords(lastUsedUserIdRecord(userId), 1);
+}
+
+void NotificationJournal::appendIdHighWaterMarks(quint32 notificationIdHighWaterMark, quint32 groupIdHighWaterMark)
+{
+    appendRecords(idHighWaterMarksRecord(notificationIdHighWaterMark, groupIdHighWaterMark), 1);
+}
+
+void NotificationJournal::appendRecords(const QByteArray &data, uint count)
+{
+    QFile file(fileName);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        QDataStream stream;
+        stream.setDevice(&file);
+        stream.writeRawData(data.constData(), data.size());
+        file.close();
+        records += count;
+    }
+}
+
+QByteArray NotificationJournal::notificationRecord(const Notification &notification)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(NotificationUpdatedRecord) << notification;
+    return record;
+}
+
+QByteArray NotificationJournal::notificationRemovalRecord(uint notificationId)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(NotificationRemovedRecord) << notificationId;
+    return record;
+}
+
+QByteArray NotificationJournal::groupRecord(const NotificationGroup &group)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(GroupUpdatedRecord) << group;
+    return record;
+}
+
+QByteArray NotificationJournal::groupRemovalRecord(uint groupId)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(GroupRemovedRecord) << groupId;
+    return record;
+}
+
+QByteArray NotificationJournal::lastUsedUserIdRecord(quint32 userId)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(LastUsedUserIdRecord) << userId;
+    return record;
+}
+
+QByteArray NotificationJournal::idHighWaterMarksRecord(quint32 notificationIdHighWaterMark, quint32 groupIdHighWaterMark)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(IdHighWaterMarksRecord) << notificationIdHighWaterMark << groupIdHighWaterMark;
+    return record;
+}
+
+uint NotificationJournal::replay(QHash<uint, Notification> &notifications, QHash<uint, NotificationGroup> &groups, quint32 &lastUsedUserId, quint32 *notificationIdHighWaterMark, quint32 *groupIdHighWaterMark, QSet<uint> *removedNotificationIds)
+{
+    records = 0;
+
+    // The highest IDs ever allocated are at least the highest IDs appearing in the journal
+    quint32 highestNotificationId = 0;
+    quint32 highestGroupId = 0;
+
+    QFile file(fileName);
+    if (file.open(QIODevice::ReadOnly)) {
+        QDataStream stream;
+        stream.setDevice(&file);
+
+        while (!stream.atEnd()) {
+            quint8 type;
+            stream >> type;
+
+            Notification notification;
+            NotificationGroup group;
+            uint id = 0;
+            quint32 userId = 0;
+            quint32 notificationIdMark = 0;
+            quint32 groupIdMark = 0;
+            switch (type) {
+            case NotificationUpdatedRecord:
+                stream >> notification;
+                break;
+            case GroupUpdatedRecord:
+                stream >> group;
+                break;
+            case NotificationRemovedRecord:
+            case GroupRemovedRecord:
+                stream >> id;
+                break;
+            case LastUsedUserIdRecord:
+                stream >> userId;
+                break;
+            case IdHighWaterMarksRecord:
+                stream >> notificationIdMark >> groupIdMark;
+                break;
+            default:
+                // Unknown record: the rest of the journal can't be interpreted
+                stream.setStatus(QDataStream::ReadCorruptData);
+                break;
+            }
+
+            if (stream.status() != QDataStream::Ok) {
+                // A record that was only partially written (for example due to a crash) ends the journal
+                break;
+            }
+
+            switch (type) {
+            case NotificationUpdatedRecord:
+                notifications.insert(notification.notificationId(), notification);
+                if (removedNotificationIds != NULL) {
+                    removedNotificationIds->remove(notification.notificationId());
+                }
+                highestNotificationId = qMax(highestNotificationId, notification.notificationId());
+                break;
+            case NotificationRemovedRecord:
+                notifications.remove(id);
+                if (removedNotificationIds != NULL) {
+                    removedNotificationIds->insert(id);
+                }
+                highestNotificationId = qMax(highestNotificationId, id);
+                break;
+            case GroupUpdatedRecord:
+                groups.insert(group.groupId(), group);
+                highestGroupId = qMax(highestGroupId, group.groupId());
+                break;
+            case GroupRemovedRecord:
+                groups.remove(id);
+                highestGroupId = qMax(highestGroupId, id);
+                break;
+            case LastUsedUserIdRecord:
+                lastUsedUserId = userId;
+                break;
+            case IdHighWaterMarksRecord:
+                highestNotificationId = qMax(highestNotificationId, notificationIdMark);
+                highestGroupId = qMax(highestGroupId, groupIdMark);
+                break;
+            }
+            records++;
+        }
+        file.close();
+    }
+
+    if (notificationIdHighWaterMark != NULL) {
+        *notificationIdHighWaterMark = qMax(*notificationIdHighWaterMark, highestNotificationId);
+    }
+    if (groupIdHighWaterMark != NULL) {
+        *groupIdHighWaterMark = qMax(*groupIdHighWaterMark, highestGroupId);
+    }
+
+    return records;
+}
+
+uint NotificationJournal::recordCount() const
+{
+    return records;
+}
+
+void NotificationJournal::clear()
+{
+    QFile::remove(fileName);
+    records = 0;
+}
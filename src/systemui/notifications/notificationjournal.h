@@ -0,0 +1,173 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef NOTIFICATIONJOURNAL_H_
+#define NOTIFICATIONJOURNAL_H_
+
+#include "notification.h"
+#include "notificationgroup.h"
+
+#include <QString>
+#include <QHash>
+#include <QSet>
+
+/*!
+ * An append-only log of the mutations made to the notification store.
+ *
+ * Every change to a notification or a notification group is appended to the
+ * journal as a single record instead of rewriting the whole store. Each record
+ * contains the complete new state of the changed item (or just its ID in case of
+ * a removal) so replaying the journal on top of a snapshot of the store is
+ * idempotent: replaying a record that is already reflected in the snapshot
+ * does no harm. This allows the owner of the journal to compact it by writing
+ * a new snapshot and then clearing the journal.
+ */
+class NotificationJournal
+{
+public:
+    //! The types of records stored in the journal
+    enum RecordType {
+        NotificationUpdatedRecord = 1,
+        NotificationRemovedRecord,
+        GroupUpdatedRecord,
+        GroupRemovedRecord,
+        LastUsedUserIdRecord,
+        IdHighWaterMarksRecord
+    };
+
+    /*!
+     * Creates a new journal stored in the given file.
+     *
+     * \param fileName the name of the file the journal is stored in
+     */
+    NotificationJournal(const QString &fileName);
+
+    /*!
+     * Destroys the NotificationJournal.
+     */
+    virtual ~NotificationJournal();
+
+    /*!
+     * Appends a record about an added or updated notification to the journal.
+     *
+     * \param notification the new state of the notification
+     */
+    void appendNotification(const Notification &notification);
+
+    /*!
+     * Appends a record about a removed notification to the journal.
+     *
+     * \param notificationId the ID of the removed notification
+     */
+    void appendNotificationRemoval(uint notificationId);
+
+    /*!
+     * Appends a record about an added or updated notification group to the journal.
+     *
+     * \param group the new state of the notification group
+     */
+    void appendGroup(const NotificationGroup &group);
+
+    /*!
+     * Appends a record about a removed notification group to the journal.
+     *
+     * \param groupId the ID of the removed notification group
+     */
+    void appendGroupRemoval(uint groupId);
+
+    /*!
+     * Appends a record about the last used notification user ID to the journal.
+     *
+     * \param userId the last used notification user ID
+     */
+    void appendLastUsedUserId(quint32 userId);
+
+    /*!
+     * Appends a record about the highest notification and group IDs ever allocated to the journal.
+     *
+     * \param notificationIdHighWaterMark the highest notification ID ever allocated
+     * \param groupIdHighWaterMark the highest notification group ID ever allocated
+     */
+    void appendIdHighWaterMarks(quint32 notificationIdHighWaterMark, quint32 groupIdHighWaterMark);
+
+    /*!
+     * Appends a number of serialized records to the journal in one go.
+     *
+     * \param data the serialized records
+     * \param count the number of records in \a data
+     */
+    void appendRecords(const QByteArray &data, uint count);
+
+    //! Returns a serialized record about an added or updated notification
+    static QByteArray notificationRecord(const Notification &notification);
+
+    //! Returns a serialized record about a removed notification
+    static QByteArray notificationRemovalRecord(uint notificationId);
+
+    //! Returns a serialized record about an added or updated notification group
+    static QByteArray groupRecord(const NotificationGroup &group);
+
+    //! Returns a serialized record about a removed notification group
+    static QByteArray groupRemovalRecord(uint groupId);
+
+    //! Returns a serialized record about the last used notification user ID
+    static QByteArray lastUsedUserIdRecord(quint32 userId);
+
+    //! Returns a serialized record about the highest notification and group IDs ever allocated
+    static QByteArray idHighWaterMarksRecord(quint32 notificationIdHighWaterMark, quint32 groupIdHighWaterMark);
+
+    /*!
+     * Replays the records in the journal on top of the given containers.
+     *
+     * \param notifications the notifications to apply the notification records to
+     * \param groups the notification groups to apply the group records to
+     * \param lastUsedUserId the last used user ID to apply the user ID records to
+     * \param notificationIdHighWaterMark if not \c NULL, raised to the highest notification ID appearing in the journal
+     * \param groupIdHighWaterMark if not \c NULL, raised to the highest notification group ID appearing in the journal
+     * \param removedNotificationIds if not \c NULL, receives the IDs of the notifications the journal leaves removed
+     * \return the number of records replayed
+     */
+    uint replay(QHash<uint, Notification> &notifications, QHash<uint, NotificationGroup> &groups, quint32 &lastUsedUserId, quint32 *notificationIdHighWaterMark = NULL, quint32 *groupIdHighWaterMark = NULL, QSet<uint> *removedNotificationIds = NULL);
+
+    /*!
+     * Returns the number of records in the journal.
+     *
+     * \return the number of records in the journal
+     */
+    uint recordCount() const;
+
+    /*!
+     * Removes all records from the journal. This should be called after the
+     * state the journal describes has been written to a snapshot.
+     */
+    void clear();
+
+private:
+    //! The name of the file the journal is stored in
+    QString fileName;
+
+    //! The number of records in the journal
+    uint records;
+
+#ifdef UNIT_TEST
+    friend class Ut_NotificationJournal;
+#endif
+};
+
+#endif /* NOTIFICATIONJOURNAL_H_ */
@@ -27,11 +27,20 @@
 #include "contextframeworkcontext.h"
 #include "genericnotificationparameterfactory.h"
 #include "notificationwidgetparameterfactory.h"
+#include "notificationpersistenceworker.h"
+#include "notificationsnapshot.h"
+#include "notificationidallocator.h"
+#include "notificationwaitqueue.h"
+#include "notificationchangelog.h"
 #include <QDBusConnection>
+#include <QCoreApplication>
 #include <QDir>
 #include <QDateTime>
 #include <mfiledatastore.h>
 #include <QFile>
+#include <QTimer>
+#include <QtAlgorithms>
+#include <QMap>
 
 //! Directory in which the persistent data files are located
 static const QString PERSISTENT_DATA_PATH = QDir::homePath() + QString("/.config/sysuid/notificationmanager/");
@@ -45,37 +54,191 @@ static const QString STATE_DATA_FILE_NAME = PERSISTENT_DATA_PATH + QString("stat
 //! Name of the file where persistent notifications are stored
 static const QString NOTIFICATIONS_FILE_NAME = PERSISTENT_DATA_PATH + QString("notifications.data");
 
+//! Name of the file where changes made after the last snapshot of the persistent data are stored
+static const QString JOURNAL_FILE_NAME = PERSISTENT_DATA_PATH + QString("journal.data");
+
+//! Name of the file where the compiled event type configuration is stored
+static const QString EVENT_TYPE_TABLE_FILE_NAME = PERSISTENT_DATA_PATH + QString("eventtypes.data");
+
+//! The minimum number of journal records after which the persistent data is compacted
+static const uint JOURNAL_COMPACTION_THRESHOLD = 256;
+
+//! Time in milliseconds changes are kept in memory so that subsequent changes to the same item can be coalesced
+static const int PERSISTENCE_COALESCING_WINDOW = 100;
+
+//! The number of notification user IDs reserved in the persistent storage at a time
+static const uint NOTIFICATION_USER_ID_BLOCK_SIZE = 1000;
+
+//! The number of changes to notifications and groups kept in the change log
+static const int CHANGE_LOG_SIZE = 1000;
+
 //! System notifications are identified with 'system' string literal
 static const QString SYSTEM_EVENT_ID = "system";
 
+//! The largest priority parameter value that is told apart in the wait queue. Larger values are treated as this.
+static const int MAX_RELAY_PRIORITY = 0x7fff;
+
 //! Name of the file to determine whether the system was booted or whether it had crashed
 static const QString BOOT_FILE = "/sysuid_boot";
 
+//! Returns the event type of a notification or a notification group with the given parameters
+static QString eventTypeOf(const NotificationParameters &parameters)
+{
+    return parameters.value(GenericNotificationParameterFactory::eventTypeKey()).toString();
+}
+
+//! Returns the user supplied identifier in the given parameters
+static QString identifierOf(const NotificationParameters &parameters)
+{
+    return parameters.value(GenericNotificationParameterFactory::identifierKey()).toString();
+}
+
+//! Returns the timestamp in the given parameters
+static uint timestampOf(const NotificationParameters &parameters)
+{
+    return parameters.value(GenericNotificationParameterFactory::timestampKey()).toUInt();
+}
+
+//! Adds an ID to a secondary index, keeping the IDs of each key in ascending order
+template<class Key> static void insertToIndex(QHash<Key, QList<uint> > &index, const Key &key, uint id)
+{
+    // New IDs are usually the highest ones so they are appended without moving the others
+    QList<uint> &ids = index[key];
+    QList<uint>::iterator i = qLowerBound(ids.begin(), ids.end(), id);
+    if (i == ids.end() || *i != id) {
+        ids.insert(i, id);
+    }
+}
+
+//! Removes an ID from a secondary index, dropping the key when it no longer refers to any ID
+template<class Key> static void removeFromIndex(QHash<Key, QList<uint> > &index, const Key &key, uint id)
+{
+    typename QHash<Key, QList<uint> >::iterator i = index.find(key);
+    if (i != index.end()) {
+        QList<uint>::iterator ii = qBinaryFind(i->begin(), i->end(), id);
+        if (ii != i->end()) {
+            i->erase(ii);
+        }
+        if (i->isEmpty()) {
+            index.erase(i);
+        }
+    }
+}
+
+//! Removes an ID from a timestamp index, dropping the user when it no longer has any IDs
+static void removeFromTimestampIndex(QHash<uint, QMultiMap<uint, uint> > &index, uint userId, uint timestamp, uint id)
+{
+    QHash<uint, QMultiMap<uint, uint> >::iterator ui = index.find(userId);
+    if (ui != index.end()) {
+        ui->remove(timestamp, id);
+        if (ui->isEmpty()) {
+            index.erase(ui);
+        }
+    }
+}
+
+//! Returns the highest of the given IDs or 0 if there are none
+static uint highestId(const QList<uint> &ids)
+{
+    uint highest = 0;
+    foreach (uint id, ids) {
+        highest = qMax(highest, id);
+    }
+    return highest;
+}
+
+//! Returns the smaller of two secondary index entries
+static const QList<uint> &smallerOf(const QList<uint> &ids, const QList<uint> &otherIds)
+{
+    return otherIds.count() < ids.count() ? otherIds : ids;
+}
+
+/*!
+ * Returns the IDs of a user newer than the given timestamp in ascending order
+ * if there are fewer of them than candidates. Otherwise returns the candidates.
+ * Collecting the newer IDs stops as soon as there are as many as candidates.
+ */
+static QList<uint> newerOf(const QList<uint> &candidates, const QHash<uint, QMultiMap<uint, uint> > &timestampIndex, uint notificationUserId, uint sinceTimestamp)
+{
+    QList<uint> newerIds;
+    QHash<uint, QMultiMap<uint, uint> >::const_iterator ti = timestampIndex.constFind(notificationUserId);
+    if (ti != timestampIndex.constEnd()) {
+        for (QMultiMap<uint, uint>::const_iterator i = ti->upperBound(sinceTimestamp); i != ti->constEnd() && newerIds.count() < candidates.count(); ++i) {
+            newerIds.append(i.value());
+        }
+    }
+    if (newerIds.count() < candidates.count()) {
+        qSort(newerIds);
+        return newerIds;
+    }
+    return candidates;
+}
+
+//! Returns whether the given notification matches the query criteria. Empty strings and zeros match everything.
+static bool matchesQuery(const Notification &notification, uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp)
+{
+    const NotificationParameters &parameters = notification.parameters();
+    return notification.userId() == notificationUserId &&
+           (groupId == 0 || notification.groupId() == groupId) &&
+           (eventType.isEmpty() || eventTypeOf(parameters) == eventType) &&
+           (identifier.isEmpty() || identifierOf(parameters) == identifier) &&
+           (sinceTimestamp == 0 || timestampOf(parameters) > sinceTimestamp);
+}
+
+//! Returns whether the given notification group matches the query criteria. Empty strings and zeros match everything.
+static bool matchesQuery(const NotificationGroup &group, uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp)
+{
+    const NotificationParameters &parameters = group.parameters();
+    return group.userId() == notificationUserId &&
+           (eventType.isEmpty() || eventTypeOf(parameters) == eventType) &&
+           (identifier.isEmpty() || identifierOf(parameters) == identifier) &&
+           (sinceTimestamp == 0 || timestampOf(parameters) > sinceTimestamp);
+}
+
 NotificationManager::NotificationManager(int relayInterval, uint maxWaitQueueSize) :
+    waitQueue(new NotificationWaitQueue),
     maxWaitQueueSize(maxWaitQueueSize),
     notificationInProgress(false),
     notificationIdInProgress(0),
     relayInterval(relayInterval),
     context(new ContextFrameworkContext),
     lastUsedNotificationUserId(0),
+    reservedNotificationUserId(0),
+    notificationIdAllocator(new NotificationIdAllocator),
+    groupIdAllocator(new NotificationIdAllocator),
+    persistenceWorker(new NotificationPersistenceWorker(JOURNAL_FILE_NAME, STATE_DATA_FILE_NAME, NOTIFICATIONS_FILE_NAME, PERSISTENCE_COALESCING_WINDOW)),
+    // The change sequence numbers of each run start from the start time so that a sequence number handed out by a previous run is never found in the change log
+    changeLog(new NotificationChangeLog(quint64(QDateTime::currentDateTime().toTime_t()) << 32, CHANGE_LOG_SIZE)),
+    compactionScheduled(false),
+    transactionDepth(0),
     subsequentStart(false)
 {
+    qRegisterMetaType<QList<uint> >();
+
     dBusSource = new DBusInterfaceNotificationSource(*this);
     dBusSink = new DBusInterfaceNotificationSink(this);
 
     connect(this, SIGNAL(groupUpdated(uint, const NotificationParameters &)), dBusSink, SLOT(addGroup(uint, const NotificationParameters &)));
     connect(this, SIGNAL(groupRemoved(uint)), dBusSink, SLOT(removeGroup(uint)));
     connect(this, SIGNAL(notificationRemoved(uint)), dBusSink, SLOT(removeNotification(uint)));
-    connect(this, SIGNAL(notificationRestored(const Notification &)), dBusSink, SLOT(addNotification(const Notification &)));
+    connect(this, SIGNAL(notificationsRemoved(const QList<uint> &)), dBusSink, SLOT(removeNotifications(const QList<uint> &)));
+    connect(this, SIGNAL(notificationsRestored(const QList<Notification> &)), dBusSink, SLOT(addNotifications(const QList<Notification> &)));
     connect(this, SIGNAL(notificationUpdated(const Notification &)), dBusSink, SLOT(addNotification(const Notification &)));
+    connect(this, SIGNAL(notificationsUpdated(const QList<Notification> &)), dBusSink, SLOT(addNotifications(const QList<Notification> &)));
     connect(dBusSink, SIGNAL(notificationRemovalRequested(uint)), this, SLOT(removeNotification(uint)));
     connect(dBusSink, SIGNAL(notificationGroupClearingRequested(uint)), this, SLOT(removeNotificationsInGroup(uint)));
     connect(this, SIGNAL(queuedGroupRemove(uint)), this, SLOT(doRemoveGroup(uint)), Qt::QueuedConnection);
     connect(this, SIGNAL(queuedNotificationRemove(uint)), this, SLOT(removeNotification(uint)), Qt::QueuedConnection);
+    connect(this, SIGNAL(queuedNotificationsRemove(const QList<uint> &)), this, SLOT(doRemoveNotifications(const QList<uint> &)), Qt::QueuedConnection);
 
     waitQueueTimer.setSingleShot(true);
     connect(&waitQueueTimer, SIGNAL(timeout()), this, SLOT(relayNextNotification()));
 
+    // Make sure pending changes end up in the persistent storage even if the manager is never destroyed
+    if (QCoreApplication::instance() != NULL) {
+        connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), this, SLOT(flushPersistentData()));
+    }
+
     initializeEventTypeStore();
 
     // Connect to D-Bus and register the DBus source as an object
@@ -88,7 +251,7 @@ void NotificationManager::initializeStore()
 {
     // Non-persistent notifications are pruned during reboot by saving notifications after restoring only persistent notifications
     restoreData();
-    saveNotifications();
+    compactStore();
 }
 
 NotificationManager::~NotificationManager()
@@ -96,6 +259,13 @@ NotificationManager::~NotificationManager()
     delete dBusSource;
     delete dBusSink;
     delete context;
+    delete notificationIdAllocator;
+    delete waitQueue;
+    delete groupIdAllocator;
+    delete changeLog;
+
+    // Destroying the worker writes all pending changes
+    delete persistenceWorker;
 }
 
 bool NotificationManager::ensurePersistentDataPath()
@@ -108,41 +278,32 @@ bool NotificationManager::ensurePersistentDataPath()
     return true;
 }
 
-void NotificationManager::saveStateData()
+void NotificationManager::compactStore()
 {
-    if (ensurePersistentDataPath()) {
-        QFile file(STATE_DATA_FILE_NAME);
-        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-            QDataStream stream;
-            stream.setDevice(&file);
+    compactionScheduled = false;
 
-            stream << lastUsedNotificationUserId;
+    if (ensurePersistentDataPath()) {
+        // The containers are implicitly shared so handing them over to the worker doesn't copy the data
+        persistenceWorker->saveSnapshot(reservedNotificationUserId, groupContainer, notificationContainer);
 
-            foreach(const NotificationGroup & group, groupContainer) {
-                stream << group;
-            }
-            file.close();
+        // The snapshot only tells the highest IDs in use, so the highest IDs ever allocated are journaled if they are higher
+        if (notificationIdAllocator->highWaterMark() > highestId(notificationContainer.keys()) || groupIdAllocator->highWaterMark() > highestId(groupContainer.keys())) {
+            persistenceWorker->saveIdHighWaterMarks(notificationIdAllocator->highWaterMark(), groupIdAllocator->highWaterMark());
         }
     }
 }
 
-void NotificationManager::saveNotifications()
+void NotificationManager::flushPersistentData()
 {
-    if (ensurePersistentDataPath()) {
-        if (notificationContainer.size()) {
-            QFile file(NOTIFICATIONS_FILE_NAME);
-            if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-                QDataStream stream;
-                stream.setDevice(&file);
-
-                foreach(const Notification &notification, notificationContainer) {
-                    stream << notification;
-                }
-                file.close();
-            }
-        } else {
-            QFile::remove(NOTIFICATIONS_FILE_NAME);
-        }
+    persistenceWorker->flush();
+}
+
+void NotificationManager::scheduleCompactionIfNeeded()
+{
+    if (transactionDepth == 0 && !compactionScheduled && persistenceWorker->journalRecordCount() > qMax(JOURNAL_COMPACTION_THRESHOLD, uint(notificationContainer.size() + groupContainer.size()))) {
+        // Compact when the application is idle instead of in the middle of a notification operation
+        compactionScheduled = true;
+        QTimer::singleShot(0, this, SLOT(compactStore()));
     }
 }
 
@@ -150,7 +311,89 @@ void NotificationManager::restoreData()
 {
     if (ensurePersistentDataPath()) {
         restoreState();
-        restoreNotifications();
+
+        // The notifications in the snapshot are decoded only when they are restored
+        NotificationSnapshot snapshot;
+        snapshot.open(NOTIFICATIONS_FILE_NAME);
+
+        // Apply the changes made after the snapshot was written
+        quint32 notificationIdHighWaterMark = 0;
+        quint32 groupIdHighWaterMark = 0;
+        QSet<uint> removedNotificationIds;
+        persistenceWorker->replayJournal(notificationContainer, groupContainer, lastUsedNotificationUserId, &notificationIdHighWaterMark, &groupIdHighWaterMark, &removedNotificationIds);
+
+        // The storage contains the end of the last reserved block of user IDs: the rest of the block may have been handed out before a crash so it is skipped
+        reservedNotificationUserId = lastUsedNotificationUserId;
+
+        // The journal contains the complete state of the notifications it changed so the snapshot is only needed for the rest
+        QMap<uint, int> snapshotIndexes;
+        for (int i = 0; i < snapshot.count(); ++i) {
+            uint notificationId = snapshot.notificationId(i);
+            if (!notificationContainer.contains(notificationId) && !removedNotificationIds.contains(notificationId)) {
+                snapshotIndexes.insert(notificationId, i);
+            }
+        }
+
+        // Make sure the restored IDs are not allocated again
+        notificationIdAllocator->restore(notificationIdHighWaterMark, notificationContainer.keys() + snapshotIndexes.keys());
+        groupIdAllocator->restore(groupIdHighWaterMark, groupContainer.keys());
+
+        QList<uint> groupIds = groupContainer.keys();
+        qSort(groupIds);
+        foreach (uint groupId, groupIds) {
+            NotificationGroup &group = groupContainer[groupId];
+
+            // Update the group from the event type parameters to make sure changes in the event type definition are taken into effect
+            group.setParameters(appendEventTypeParameters(group.parameters()));
+
+            indexGroup(group);
+            changeLog->recordGroupChange(groupId);
+
+            // Let the sinks know about the group
+            emit groupUpdated(group.groupId(), group.parameters());
+        }
+
+        // Startup status must be initialized always
+        bool restoreAllNotifications = isSubsequentStart();
+
+        QList<uint> notificationIds = notificationContainer.keys() + snapshotIndexes.keys();
+        qSort(notificationIds);
+        QList<Notification> restoredNotifications;
+        foreach (uint notificationId, notificationIds) {
+            QHash<uint, Notification>::iterator ni = notificationContainer.find(notificationId);
+            bool persistent;
+            if (ni != notificationContainer.end()) {
+                // Update the notification from the event type parameters to make sure changes in the event type definition are taken into effect
+                ni->setParameters(appendEventTypeParameters(ni->parameters()));
+                persistent = ni->isPersistent();
+            } else {
+                // The persistence of a notification in the snapshot can be determined without decoding the notification
+                int index = snapshotIndexes.value(notificationId);
+                persistent = isPersistent(snapshot.persistent(index), snapshot.eventType(index));
+            }
+
+            // When starting on boot add only the persistent notifications
+            if (restoreAllNotifications || persistent) {
+                if (ni == notificationContainer.end()) {
+                    ni = notificationContainer.insert(notificationId, snapshot.notification(snapshotIndexes.value(notificationId)));
+                    ni->setParameters(appendEventTypeParameters(ni->parameters()));
+                }
+
+                indexNotification(*ni);
+                changeLog->recordNotificationChange(notificationId);
+                restoredNotifications.append(*ni);
+            } else {
+                if (ni != notificationContainer.end()) {
+                    notificationContainer.erase(ni);
+                }
+                notificationIdAllocator->release(notificationId);
+            }
+        }
+
+        // Let the sinks know about all the notifications at once
+        if (!restoredNotifications.isEmpty()) {
+            emit notificationsRestored(restoredNotifications);
+        }
     }
 }
 
@@ -168,46 +411,12 @@ void NotificationManager::restoreState()
         while (!stream.atEnd()) {
             // Restore each notification group
             stream >> group;
-
-            // Update the group from the event type parameters to make sure changes in the event type definition are taken into effect
-            group.updateParameters(appendEventTypeParameters(group.parameters()));
-
-            // Let the sinks know about the group
             groupContainer.insert(group.groupId(), group);
-            emit groupUpdated(group.groupId(), group.parameters());
         }
         stateFile.close();
     }
 }
 
-void NotificationManager::restoreNotifications()
-{
-    // Startup status must be initialized always
-    bool restoreAllNotifications = isSubsequentStart();
-    QFile notificationFile(NOTIFICATIONS_FILE_NAME);
-    if (notificationFile.open(QIODevice::ReadOnly)) {
-        QDataStream stream;
-        stream.setDevice(&notificationFile);
-
-        Notification notification;
-        while (!stream.atEnd()) {
-            // Restore each notification
-            stream >> notification;
-
-            // When starting on boot add only the persistent notifications
-            if (restoreAllNotifications || isPersistent(notification.parameters())) {
-                // Update the notification from the event type parameters to make sure changes in the event type definition are taken into effect
-                notification.updateParameters(appendEventTypeParameters(notification.parameters()));
-
-                // Let the sinks know about the notification
-                notificationContainer.insert(notification.notificationId(), notification);
-                emit notificationRestored(notification);
-            }
-        }
-        notificationFile.close();
-    }
-}
-
 bool NotificationManager::isSubsequentStart()
 {
     if (!subsequentStart) {
@@ -226,44 +435,54 @@ void NotificationManager::initializeEventTypeStore()
     if (notificationEventTypeStore) {
         return;
     }
-    notificationEventTypeStore = QSharedPointer<EventTypeStore> (new EventTypeStore(NOTIFICATIONS_EVENT_TYPES, MAX_EVENT_TYPE_CONF_FILES));
+    notificationEventTypeStore = QSharedPointer<EventTypeStore> (new EventTypeStore(NOTIFICATIONS_EVENT_TYPES, MAX_EVENT_TYPE_CONF_FILES, EVENT_TYPE_TABLE_FILE_NAME));
 
     connect(notificationEventTypeStore.data(), SIGNAL(eventTypeUninstalled(QString)), this, SLOT(removeNotificationsAndGroupsWithEventType(QString)));
-    connect(notificationEventTypeStore.data(), SIGNAL(eventTypeModified(QString)), this, SLOT(updateNotificationsAndGroupsWithEventType(QString)));
+    connect(notificationEventTypeStore.data(), SIGNAL(eventTypesModified(QStringList)), this, SLOT(updateNotificationsAndGroupsWithEventTypes(QStringList)));
 }
 
 void NotificationManager::removeNotificationsAndGroupsWithEventType(const QString &eventType)
 {
-    foreach(const Notification &notification, notificationContainer) {
-        if (notification.parameters().value(GenericNotificationParameterFactory::eventTypeKey()).toString() == eventType) {
-            removeNotification(notification.notificationId());
-        }
+    eventTypeParameterCache.remove(eventType);
+
+    beginTransaction();
+    foreach (uint notificationId, notificationIdsByEventType.value(eventType)) {
+        removeNotification(notificationId);
     }
 
-    foreach(const NotificationGroup &group, groupContainer) {
-        if (group.parameters().value(GenericNotificationParameterFactory::eventTypeKey()).toString() == eventType) {
-            doRemoveGroup(group.groupId());
-        }
+    foreach (uint groupId, groupIdsByEventType.value(eventType)) {
+        doRemoveGroup(groupId);
     }
+    commitTransaction();
 }
 
 void NotificationManager::updateNotificationsAndGroupsWithEventType(const QString &eventType)
 {
-    foreach(Notification notification, notificationContainer) {
-        if(notification.parameters().value(GenericNotificationParameterFactory::eventTypeKey()).toString() == eventType) {
-            notification.updateParameters(appendEventTypeParameters(notification.parameters()));
-            updateNotification(notification.userId(), notification.notificationId(), notification.parameters());
-        }
+    // Read the changed event type parameters again
+    eventTypeParameterCache.remove(eventType);
+
+    foreach (uint notificationId, notificationIdsByEventType.value(eventType)) {
+        QHash<uint, Notification>::iterator ni = notificationContainer.find(notificationId);
+        ni->setParameters(appendEventTypeParameters(ni->parameters()));
+        updateNotification(ni->userId(), notificationId, NotificationParameters(ni->parameters()));
     }
 
-    foreach(NotificationGroup group, groupContainer) {
-        if(group.parameters().value(GenericNotificationParameterFactory::eventTypeKey()).toString() == eventType) {
-            group.updateParameters(appendEventTypeParameters(group.parameters()));
-            updateGroup(group.userId(), group.groupId(), group.parameters());
-        }
+    foreach (uint groupId, groupIdsByEventType.value(eventType)) {
+        QHash<uint, NotificationGroup>::iterator gi = groupContainer.find(groupId);
+        gi->setParameters(appendEventTypeParameters(gi->parameters()));
+        updateGroup(gi->userId(), groupId, NotificationParameters(gi->parameters()));
     }
 }
 
+void NotificationManager::updateNotificationsAndGroupsWithEventTypes(const QStringList &eventTypes)
+{
+    beginTransaction();
+    foreach (const QString &eventType, eventTypes) {
+        updateNotificationsAndGroupsWithEventType(eventType);
+    }
+    commitTransaction();
+}
+
 uint NotificationManager::addNotification(uint notificationUserId, const NotificationParameters &parameters, uint groupId)
 {
     if (groupId == 0 || groupContainer.contains(groupId)) {
@@ -280,8 +499,10 @@ uint NotificationManager::addNotification(uint notificationUserId, const Notific
 
         // Mark the notification used
         notificationContainer.insert(notificationId, notification);
+        indexNotification(notification);
 
-        saveNotifications();
+        persistenceWorker->saveNotification(notification);
+        scheduleCompactionIfNeeded();
 
         submitNotification(notification);
 
@@ -302,16 +523,22 @@ bool NotificationManager::updateNotification(uint notificationUserId, uint notif
     if (ni != notificationContainer.end()) {
         NotificationParameters fullParameters(parameters);
         fullParameters.add(GenericNotificationParameterFactory::timestampKey(), timestamp(parameters));
+
+        // The event type may change so the notification is reindexed
+        unindexNotification(*ni);
         (*ni).updateParameters(fullParameters);
+        indexNotification(*ni);
 
-        saveNotifications();
+        persistenceWorker->saveNotification(*ni);
+        scheduleCompactionIfNeeded();
 
-        int waitQueueIndex = findNotificationFromWaitQueue(notificationId);
-        if (waitQueueIndex >= 0) {
-            waitQueue[waitQueueIndex].updateParameters(fullParameters);
-        } else {
+        if (!waitQueue->updateParameters(notificationId, fullParameters)) {
             // Inform the sinks about the update
-            emit notificationUpdated(notificationContainer.value(notificationId));
+            relayNotificationUpdate(*ni);
+            relayNotificationAlert(*ni);
+        } else if (unalertedNotificationIds.contains(notificationId)) {
+            // The notification was relayed with a transaction and only waits for its turn to alert
+            relayNotificationUpdate(*ni);
         }
 
         updateGroupTimestampFromNotifications((*ni).groupId());
@@ -338,17 +565,18 @@ bool NotificationManager::removeNotification(uint notificationId)
     if (notificationContainer.contains(notificationId)) {
         // Mark the notification unused
         const Notification removedNotification = notificationContainer.take(notificationId);
+        unindexNotification(removedNotification);
+        notificationIdAllocator->release(notificationId);
 
-        saveNotifications();
+        persistenceWorker->removeNotification(notificationId);
+        scheduleCompactionIfNeeded();
 
-        int waitQueueIndex = findNotificationFromWaitQueue(notificationId);
-        if (waitQueueIndex >= 0) {
-            waitQueue.removeAt(waitQueueIndex);
-        } else {
+        bool queued = waitQueue->remove(notificationId);
+        if (!queued || unalertedNotificationIds.remove(notificationId)) {
             // Inform the sinks about the removal
-            emit notificationRemoved(notificationId);
+            relayNotificationRemoval(notificationId);
 
-            if (notificationInProgress && notificationId == notificationIdInProgress) {
+            if (!queued && notificationInProgress && notificationId == notificationIdInProgress) {
                 // The notification being removed is currently displayed
                 // cancel the notification relay timeout and relay the next
                 // notification
@@ -367,22 +595,93 @@ bool NotificationManager::removeNotification(uint notificationId)
 
 bool NotificationManager::removeNotificationsInGroup(uint groupId)
 {
-    QList<uint> notificationIds;
-
-    foreach(const Notification & notification, notificationContainer.values()) {
-        if (notification.groupId() == groupId) {
-            notificationIds.append(notification.notificationId());
-        }
-    }
+    QList<uint> notificationIds = notificationIdsByGroupId.value(groupId);
 
     bool result = !notificationIds.isEmpty();
+    beginTransaction();
     foreach(uint notificationId, notificationIds) {
         result &= removeNotification(notificationId);
     }
+    commitTransaction();
+
+    return result;
+}
+
+QList<uint> NotificationManager::addNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications)
+{
+    QList<uint> notificationIds;
+
+    beginTransaction();
+    for (int i = 0; i < notifications.count(); ++i) {
+        notificationIds.append(addNotification(notificationUserId, notifications.at(i).second, notifications.at(i).first));
+    }
+    commitTransaction();
+
+    return notificationIds;
+}
+
+bool NotificationManager::updateNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications)
+{
+    bool result = true;
+
+    beginTransaction();
+    for (int i = 0; i < notifications.count(); ++i) {
+        result &= updateNotification(notificationUserId, notifications.at(i).first, notifications.at(i).second);
+    }
+    commitTransaction();
 
     return result;
 }
 
+bool NotificationManager::removeNotifications(uint notificationUserId, const QList<uint> &notificationIds)
+{
+    Q_UNUSED(notificationUserId);
+
+    QList<uint> existingNotificationIds;
+    foreach (uint notificationId, notificationIds) {
+        if (notificationContainer.contains(notificationId)) {
+            existingNotificationIds.append(notificationId);
+        }
+    }
+
+    if (!existingNotificationIds.isEmpty()) {
+        emit queuedNotificationsRemove(existingNotificationIds);
+    }
+    return !notificationIds.isEmpty() && existingNotificationIds.count() == notificationIds.count();
+}
+
+uint NotificationManager::addOrUpdateNotification(uint notificationUserId, uint groupId, const QString &identifier, const NotificationParameters &parameters)
+{
+    // Without an identifier the notification is always added and not identified
+    NotificationParameters identifiedParameters(parameters);
+    if (!identifier.isEmpty()) {
+        identifiedParameters.add(GenericNotificationParameterFactory::identifierKey(), identifier);
+
+        QList<uint> notificationIds = notificationIdsByIdentifier.value(qMakePair(notificationUserId, identifier));
+        if (!notificationIds.isEmpty()) {
+            uint notificationId = notificationIds.first();
+            return updateNotification(notificationUserId, notificationId, identifiedParameters) ? notificationId : 0;
+        }
+    }
+
+    return addNotification(notificationUserId, identifiedParameters, groupId);
+}
+
+bool NotificationManager::removeNotificationsWithIdentifier(uint notificationUserId, const QString &identifier)
+{
+    QList<uint> notificationIds = notificationIdsByIdentifier.value(qMakePair(notificationUserId, identifier));
+    return !notificationIds.isEmpty() && removeNotifications(notificationUserId, notificationIds);
+}
+
+void NotificationManager::doRemoveNotifications(const QList<uint> &notificationIds)
+{
+    beginTransaction();
+    foreach (uint notificationId, notificationIds) {
+        removeNotification(notificationId);
+    }
+    commitTransaction();
+}
+
 uint NotificationManager::addGroup(uint notificationUserId, const NotificationParameters &parameters)
 {
     NotificationParameters fullParameters(appendEventTypeParameters(parameters));
@@ -390,8 +689,11 @@ uint NotificationManager::addGroup(uint notificationUserId, const NotificationPa
     uint groupID = nextAvailableGroupID();
     NotificationGroup group(groupID, notificationUserId, fullParameters);
     groupContainer.insert(groupID, group);
+    indexGroup(group);
+    changeLog->recordGroupChange(groupID);
 
-    saveStateData();
+    persistenceWorker->saveGroup(group);
+    scheduleCompactionIfNeeded();
 
     emit groupUpdated(groupID, fullParameters);
 
@@ -405,9 +707,13 @@ bool NotificationManager::updateGroup(uint notificationUserId, uint groupId, con
     QHash<uint, NotificationGroup>::iterator gi = groupContainer.find(groupId);
 
     if (gi != groupContainer.end()) {
+        unindexGroup(*gi);
         gi->updateParameters(parameters);
+        indexGroup(*gi);
+        changeLog->recordGroupChange(groupId);
 
-        saveStateData();
+        persistenceWorker->saveGroup(*gi);
+        scheduleCompactionIfNeeded();
 
         emit groupUpdated(groupId, gi->parameters());
 
@@ -428,62 +734,119 @@ bool NotificationManager::removeGroup(uint notificationUserId, uint groupId)
     return false;
 }
 
-void NotificationManager::doRemoveGroup(uint groupId)
+uint NotificationManager::addOrUpdateGroup(uint notificationUserId, const QString &identifier, const NotificationParameters &parameters)
 {
-    if (groupContainer.remove(groupId)) {
-        foreach(const Notification & notification, notificationContainer) {
-            if (notification.groupId() == groupId) {
-                removeNotification(notification.notificationId());
-            }
+    // Without an identifier the group is always added and not identified
+    NotificationParameters identifiedParameters(parameters);
+    if (!identifier.isEmpty()) {
+        identifiedParameters.add(GenericNotificationParameterFactory::identifierKey(), identifier);
+
+        QList<uint> groupIds = groupIdsByIdentifier.value(qMakePair(notificationUserId, identifier));
+        if (!groupIds.isEmpty()) {
+            uint groupId = groupIds.first();
+            return updateGroup(notificationUserId, groupId, identifiedParameters) ? groupId : 0;
         }
+    }
+
+    return addGroup(notificationUserId, identifiedParameters);
+}
 
-        saveStateData();
+bool NotificationManager::removeGroupsWithIdentifier(uint notificationUserId, const QString &identifier)
+{
+    QList<uint> groupIds = groupIdsByIdentifier.value(qMakePair(notificationUserId, identifier));
 
-        emit groupRemoved(groupId);
+    bool result = !groupIds.isEmpty();
+    foreach (uint groupId, groupIds) {
+        result &= removeGroup(notificationUserId, groupId);
+    }
+
+    return result;
+}
+
+void NotificationManager::doRemoveGroup(uint groupId)
+{
+    QHash<uint, NotificationGroup>::iterator gi = groupContainer.find(groupId);
+    if (gi != groupContainer.end()) {
+        unindexGroup(*gi);
+        groupContainer.erase(gi);
+        groupIdAllocator->release(groupId);
+        changeLog->recordGroupChange(groupId);
+
+        beginTransaction();
+        foreach (uint notificationId, notificationIdsByGroupId.value(groupId)) {
+            removeNotification(notificationId);
+        }
+
+        persistenceWorker->removeGroup(groupId);
+        relayGroupRemoval(groupId);
+        commitTransaction();
     }
 }
 
 NotificationParameters NotificationManager::appendEventTypeParameters(const NotificationParameters &parameters) const
 {
-    NotificationParameters fullParameters(parameters);
+    NotificationParameters defaults(eventTypeParameters(eventTypeOf(parameters)));
+    NotificationParameters overrides(parameters.overrides());
+
+    // The event type parameters take precedence over the parameters supplied with the notification
+    NotificationParameters fullParameters;
+    foreach (const QString &key, overrides.keys()) {
+        if (!defaults.value(key).isValid()) {
+            fullParameters.add(key, overrides.value(key));
+        }
+    }
+    fullParameters.setDefaults(defaults);
+
+    return fullParameters;
+}
+
+NotificationParameters NotificationManager::eventTypeParameters(const QString &eventType) const
+{
+    QHash<QString, NotificationParameters>::const_iterator i = eventTypeParameterCache.constFind(eventType);
+    if (i != eventTypeParameterCache.constEnd()) {
+        return *i;
+    }
 
-    QString eventType = parameters.value(GenericNotificationParameterFactory::eventTypeKey()).toString();
+    NotificationParameters parameters;
     foreach (const QString &key, notificationEventTypeStore->allKeys(eventType)) {
-        fullParameters.add(key, notificationEventTypeStore->value(eventType, key));
+        parameters.add(key, notificationEventTypeStore->value(eventType, key));
     }
 
-    return fullParameters;
+    // Unknown event types are not cached so that arbitrary event types can't grow the cache
+    if (parameters.count() > 0) {
+        eventTypeParameterCache.insert(eventType, parameters);
+    }
+
+    return parameters;
 }
 
 uint NotificationManager::notificationUserId()
 {
     lastUsedNotificationUserId++;
-    saveStateData();
+    if (lastUsedNotificationUserId > reservedNotificationUserId) {
+        // Reserve a block of user IDs so that the persistent storage is only written once per block
+        reservedNotificationUserId = lastUsedNotificationUserId + NOTIFICATION_USER_ID_BLOCK_SIZE - 1;
+        persistenceWorker->saveLastUsedUserId(reservedNotificationUserId);
+
+        // The block must be on disk before any of its IDs is handed out or they could be handed out again after a crash
+        persistenceWorker->flush();
+        scheduleCompactionIfNeeded();
+    }
 
     return lastUsedNotificationUserId;
 }
 
 QList<uint> NotificationManager::notificationIdList(uint notificationUserId)
 {
-    QList<uint> listOfNotificationIds;
-
-    foreach(const Notification & notification, notificationContainer) {
-        if (notification.userId() == notificationUserId) {
-            listOfNotificationIds.append(notification.notificationId());
-        }
-    }
-
-    return listOfNotificationIds;
+    return notificationIdsByUserId.value(notificationUserId);
 }
 
 QList<Notification> NotificationManager::notificationList(uint notificationUserId)
 {
     QList<Notification> userNotifications;
 
-    foreach (const Notification &notification, notificationContainer) {
-        if (notification.userId() == notificationUserId) {
-            userNotifications.append(notification);
-        }
+    foreach (uint notificationId, notificationIdsByUserId.value(notificationUserId)) {
+        userNotifications.append(notificationContainer.value(notificationId));
     }
 
     return userNotifications;
@@ -493,10 +856,8 @@ QList<Notification> NotificationManager::notificationListWithIdentifiers(uint no
 {
     QList<Notification> userNotificationsWithIdentifiers;
 
-    foreach (const Notification &notification, notificationContainer) {
-        if (notification.userId() == notificationUserId) {
-            userNotificationsWithIdentifiers.append(notification);
-        }
+    foreach (uint notificationId, notificationIdsByUserId.value(notificationUserId)) {
+        userNotificationsWithIdentifiers.append(notificationContainer.value(notificationId));
     }
 
     return userNotificationsWithIdentifiers;
@@ -506,10 +867,8 @@ QList<NotificationGroup> NotificationManager::notificationGroupList(uint notific
 {
     QList<NotificationGroup> userGroups;
 
-    foreach (const NotificationGroup &group, groupContainer) {
-        if (group.userId() == notificationUserId) {
-            userGroups.append(group);
-        }
+    foreach (uint groupId, groupIdsByUserId.value(notificationUserId)) {
+        userGroups.append(groupContainer.value(groupId));
     }
 
     return userGroups;
@@ -519,66 +878,153 @@ QList<NotificationGroup> NotificationManager::notificationGroupListWithIdentifie
 {
     QList<NotificationGroup> userGroups;
 
-    foreach (const NotificationGroup &group, groupContainer) {
-        if (group.userId() == notificationUserId) {
-            userGroups.append(group);
-        }
+    foreach (uint groupId, groupIdsByUserId.value(notificationUserId)) {
+        userGroups.append(groupContainer.value(groupId));
     }
 
     return userGroups;
 }
 
-void NotificationManager::relayNextNotification()
+QList<Notification> NotificationManager::queryNotifications(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit)
 {
-    notificationInProgress = false;
-    if (!waitQueue.isEmpty()) {
-        submitNotification(waitQueue.takeFirst());
+    QList<Notification> userNotifications;
+
+    // The candidates are in ascending ID order so the page starts right after the last ID of the previous page
+    const QList<uint> candidates = candidateNotificationIds(notificationUserId, eventType, groupId, identifier, sinceTimestamp);
+    for (QList<uint>::const_iterator i = qUpperBound(candidates.constBegin(), candidates.constEnd(), lastId); i != candidates.constEnd(); ++i) {
+        const Notification notification = notificationContainer.value(*i);
+        if (matchesQuery(notification, notificationUserId, eventType, groupId, identifier, sinceTimestamp)) {
+            userNotifications.append(notification);
+            if (uint(userNotifications.count()) == limit) {
+                break;
+            }
+        }
     }
+
+    return userNotifications;
 }
 
-Notification::NotificationType NotificationManager::determineType(const NotificationParameters &parameters)
+uint NotificationManager::queryNotificationCount(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp)
 {
-    QString classStr;
+    const QList<uint> notificationIds = candidateNotificationIds(notificationUserId, eventType, groupId, identifier, sinceTimestamp);
+    if (eventType.isEmpty() && groupId == 0 && identifier.isEmpty() && sinceTimestamp == 0) {
+        // All notifications of the user match
+        return notificationIds.count();
+    }
 
-    QVariant classVariant = parameters.value(GenericNotificationParameterFactory::classKey());
-    if (classVariant.isValid()) {
-        classStr = classVariant.toString();
-    } else {
-        QVariant eventTypeVariant = parameters.value(GenericNotificationParameterFactory::eventTypeKey());
-        if (eventTypeVariant.isValid()) {
-            QString eventType = eventTypeVariant.toString();
-            if (notificationEventTypeStore->contains(eventType, GenericNotificationParameterFactory::classKey())) {
-                classStr = notificationEventTypeStore->value(eventType, GenericNotificationParameterFactory::classKey());
+    uint count = 0;
+    foreach (uint notificationId, notificationIds) {
+        if (matchesQuery(notificationContainer.value(notificationId), notificationUserId, eventType, groupId, identifier, sinceTimestamp)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+QList<NotificationGroup> NotificationManager::queryGroups(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit)
+{
+    QList<NotificationGroup> userGroups;
+
+    // The candidates are in ascending ID order so the page starts right after the last ID of the previous page
+    const QList<uint> candidates = candidateGroupIds(notificationUserId, eventType, identifier, sinceTimestamp);
+    for (QList<uint>::const_iterator i = qUpperBound(candidates.constBegin(), candidates.constEnd(), lastId); i != candidates.constEnd(); ++i) {
+        const NotificationGroup group = groupContainer.value(*i);
+        if (matchesQuery(group, notificationUserId, eventType, identifier, sinceTimestamp)) {
+            userGroups.append(group);
+            if (uint(userGroups.count()) == limit) {
+                break;
             }
         }
     }
 
-    return classStr == SYSTEM_EVENT_ID ? Notification::SystemEvent : Notification::ApplicationEvent;
+    return userGroups;
 }
 
-int NotificationManager::insertPosition(const Notification &notification)
+uint NotificationManager::queryGroupCount(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp)
 {
-    int pos = 0;
-    const NotificationParameters parameters = notification.parameters();
-    if(parameters.value("class") != QString("system")) {
-        return waitQueue.size();
-    } else {
-        for(pos = 0; pos < waitQueue.count(); ++pos) {
-            if (waitQueue.at(pos).parameters().value("class") == QString("system")) {
-                continue;
-            } else {
-                return pos;
-            }
+    const QList<uint> groupIds = candidateGroupIds(notificationUserId, eventType, identifier, sinceTimestamp);
+    if (eventType.isEmpty() && identifier.isEmpty() && sinceTimestamp == 0) {
+        // All groups of the user match
+        return groupIds.count();
+    }
+
+    uint count = 0;
+    foreach (uint groupId, groupIds) {
+        if (matchesQuery(groupContainer.value(groupId), notificationUserId, eventType, identifier, sinceTimestamp)) {
+            count++;
         }
-        return pos;
     }
+    return count;
+}
+
+QList<uint> NotificationManager::candidateNotificationIds(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp) const
+{
+    // The identifier index is per user so it is never larger than the user index
+    QList<uint> candidates = identifier.isEmpty() ? notificationIdsByUserId.value(notificationUserId) : notificationIdsByIdentifier.value(qMakePair(notificationUserId, identifier));
+    if (groupId != 0) {
+        candidates = smallerOf(candidates, notificationIdsByGroupId.value(groupId));
+    }
+    if (!eventType.isEmpty()) {
+        candidates = smallerOf(candidates, notificationIdsByEventType.value(eventType));
+    }
+    if (sinceTimestamp != 0 && !candidates.isEmpty()) {
+        candidates = newerOf(candidates, notificationIdsByTimestamp, notificationUserId, sinceTimestamp);
+    }
+
+    return candidates;
+}
+
+QList<uint> NotificationManager::candidateGroupIds(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp) const
+{
+    QList<uint> candidates = identifier.isEmpty() ? groupIdsByUserId.value(notificationUserId) : groupIdsByIdentifier.value(qMakePair(notificationUserId, identifier));
+    if (!eventType.isEmpty()) {
+        candidates = smallerOf(candidates, groupIdsByEventType.value(eventType));
+    }
+    if (sinceTimestamp != 0 && !candidates.isEmpty()) {
+        candidates = newerOf(candidates, groupIdsByTimestamp, notificationUserId, sinceTimestamp);
+    }
+
+    return candidates;
+}
+
+void NotificationManager::relayNextNotification()
+{
+    notificationInProgress = false;
+    // During a transaction the next notification is relayed when the transaction is committed
+    if (transactionDepth == 0 && !waitQueue->isEmpty()) {
+        submitNotification(waitQueue->dequeue());
+    }
+}
+
+Notification::NotificationType NotificationManager::determineType(const NotificationParameters &parameters)
+{
+    // The class defined by the event type is already available through the event type parameters
+    return parameters.value(GenericNotificationParameterFactory::classKey()).toString() == SYSTEM_EVENT_ID ? Notification::SystemEvent : Notification::ApplicationEvent;
+}
+
+int NotificationManager::relayPriority(const Notification &notification) const
+{
+    // System notifications go first, then the notifications with the highest priority parameter within the class
+    int classRank = notification.type() == Notification::SystemEvent ? 0 : 1;
+    int priority = qBound(-MAX_RELAY_PRIORITY, notification.priority(), MAX_RELAY_PRIORITY);
+    return classRank * (2 * MAX_RELAY_PRIORITY + 1) + MAX_RELAY_PRIORITY - priority;
 }
 
 void NotificationManager::submitNotification(const Notification &notification)
 {
-    if (!notificationInProgress) {
-        // Inform about the new notification
-        emit notificationUpdated(notification);
+    if (transactionDepth > 0) {
+        // The notifications submitted in a transaction are relayed together when it is committed, but they alert the user one at a time
+        relayNotificationUpdate(notification);
+        if ((uint)waitQueue->size() < maxWaitQueueSize) {
+            waitQueue->enqueue(notification, relayPriority(notification));
+            unalertedNotificationIds.insert(notification.notificationId());
+        }
+    } else if (!notificationInProgress) {
+        // Inform about the new notification unless it was relayed with a transaction already
+        if (!unalertedNotificationIds.remove(notification.notificationId())) {
+            relayNotificationUpdate(notification);
+        }
+        relayNotificationAlert(notification);
 
         if (relayInterval != 0) {
             notificationInProgress = true;
@@ -589,40 +1035,141 @@ void NotificationManager::submitNotification(const Notification &notification)
         }
     } else {
         // Store new notification in the notification wait queue
-        if ((uint)waitQueue.size() < maxWaitQueueSize) {
-            waitQueue.insert(insertPosition(notification), notification);
+        if ((uint)waitQueue->size() < maxWaitQueueSize) {
+            waitQueue->enqueue(notification, relayPriority(notification));
         }
     }
 }
 
-int NotificationManager::findNotificationFromWaitQueue(uint notificationId)
+void NotificationManager::relayNotificationUpdate(const Notification &notification)
 {
-    for (int i = 0; i < waitQueue.count(); ++i) {
-        if (waitQueue[i].notificationId() == notificationId) {
-            return i;
+    // Notifications are logged when the sinks are informed, so notifications in the wait queue are not in the change log yet
+    changeLog->recordNotificationChange(notification.notificationId());
+
+    if (transactionDepth > 0) {
+        // The sinks get the latest state of the notification when the transaction is committed
+        uint notificationId = notification.notificationId();
+        if (!transactionUpdatedNotificationIdSet.contains(notificationId)) {
+            transactionUpdatedNotificationIdSet.insert(notificationId);
+            transactionUpdatedNotificationIds.append(notificationId);
         }
+    } else {
+        emit notificationUpdated(notification);
     }
-    return -1;
 }
 
-uint NotificationManager::nextAvailableNotificationID()
+void NotificationManager::relayNotificationAlert(const Notification &notification)
 {
-    unsigned int i = 1;
-    // Try to find an unused ID but only do it up to 2^32-1 times
-    while (i != 0 && notificationContainer.contains(i)) {
-        ++i;
+    if (transactionDepth > 0) {
+        // The sinks are informed after the notifications of the transaction have been relayed
+        if (!transactionAlertedNotificationIds.contains(notification.notificationId())) {
+            transactionAlertedNotificationIds.append(notification.notificationId());
+        }
+    } else {
+        emit notificationAlerted(notification);
     }
-    return i;
 }
 
-uint NotificationManager::nextAvailableGroupID()
+void NotificationManager::relayNotificationRemoval(uint notificationId)
 {
-    unsigned int i = 1;
-    // Try to find an unused ID but only do it up to 2^32-1 times
-    while (i != 0 && groupContainer.contains(i)) {
-        ++i;
+    changeLog->recordNotificationChange(notificationId);
+
+    if (transactionDepth > 0) {
+        transactionRemovedNotificationIds.append(notificationId);
+    } else {
+        emit notificationRemoved(notificationId);
     }
-    return i;
+}
+
+void NotificationManager::relayGroupRemoval(uint groupId)
+{
+    if (transactionDepth > 0) {
+        transactionRemovedGroupIds.append(groupId);
+    } else {
+        emit groupRemoved(groupId);
+    }
+}
+
+void NotificationManager::beginTransaction()
+{
+    transactionDepth++;
+}
+
+void NotificationManager::commitTransaction()
+{
+    if (--transactionDepth > 0) {
+        return;
+    }
+
+    // The removals are relayed first so that a notification ID reused during the transaction refers to the new notification
+    QList<uint> removedNotificationIds = transactionRemovedNotificationIds;
+    transactionRemovedNotificationIds.clear();
+    if (removedNotificationIds.count() == 1) {
+        emit notificationRemoved(removedNotificationIds.first());
+    } else if (!removedNotificationIds.isEmpty()) {
+        emit notificationsRemoved(removedNotificationIds);
+    }
+
+    // The groups are removed after their notifications
+    QList<uint> removedGroupIds = transactionRemovedGroupIds;
+    transactionRemovedGroupIds.clear();
+    foreach (uint groupId, removedGroupIds) {
+        emit groupRemoved(groupId);
+    }
+
+    // Notifications removed during the transaction are no longer relayed
+    QList<Notification> updatedNotifications;
+    foreach (uint notificationId, transactionUpdatedNotificationIds) {
+        QHash<uint, Notification>::const_iterator ni = notificationContainer.constFind(notificationId);
+        if (ni != notificationContainer.constEnd()) {
+            updatedNotifications.append(*ni);
+        }
+    }
+    transactionUpdatedNotificationIds.clear();
+    transactionUpdatedNotificationIdSet.clear();
+
+    if (updatedNotifications.count() == 1) {
+        emit notificationUpdated(updatedNotifications.first());
+    } else if (!updatedNotifications.isEmpty()) {
+        emit notificationsUpdated(updatedNotifications);
+    }
+
+    // The updated notifications alert the user with their latest contents
+    QList<uint> alertedNotificationIds = transactionAlertedNotificationIds;
+    transactionAlertedNotificationIds.clear();
+    foreach (uint notificationId, alertedNotificationIds) {
+        QHash<uint, Notification>::const_iterator ni = notificationContainer.constFind(notificationId);
+        if (ni != notificationContainer.constEnd()) {
+            emit notificationAlerted(*ni);
+        }
+    }
+
+    // The notifications added in the transaction alert the user one at a time in priority order
+    while (!notificationInProgress && !waitQueue->isEmpty()) {
+        submitNotification(waitQueue->dequeue());
+    }
+
+    // Each group timestamp is updated once no matter how many of its notifications changed
+    QList<uint> groupIds = transactionTimestampGroupIds.toList();
+    qSort(groupIds);
+    transactionTimestampGroupIds.clear();
+    foreach (uint groupId, groupIds) {
+        updateGroupTimestampFromNotifications(groupId);
+    }
+
+    // Write all changes made during the transaction in one go
+    persistenceWorker->writeQueuedOperations();
+    scheduleCompactionIfNeeded();
+}
+
+uint NotificationManager::nextAvailableNotificationID()
+{
+    return notificationIdAllocator->allocate();
+}
+
+uint NotificationManager::nextAvailableGroupID()
+{
+    return groupIdAllocator->allocate();
 }
 
 QList<Notification> NotificationManager::notifications() const
@@ -635,6 +1182,63 @@ QList<NotificationGroup> NotificationManager::groups() const
     return groupContainer.values();
 }
 
+quint64 NotificationManager::changeSequence() const
+{
+    return changeLog->sequence();
+}
+
+bool NotificationManager::changesKnownSince(quint64 sequence) const
+{
+    return changeLog->contains(sequence);
+}
+
+QList<NotificationGroup> NotificationManager::groupsChangedSince(quint64 sequence) const
+{
+    QList<NotificationGroup> groups;
+    foreach (uint groupId, changeLog->groupIdsChangedSince(sequence)) {
+        QHash<uint, NotificationGroup>::const_iterator gi = groupContainer.constFind(groupId);
+        if (gi != groupContainer.constEnd()) {
+            groups.append(*gi);
+        }
+    }
+    return groups;
+}
+
+QList<Notification> NotificationManager::notificationsChangedSince(quint64 sequence) const
+{
+    QList<Notification> notifications;
+    foreach (uint notificationId, changeLog->notificationIdsChangedSince(sequence)) {
+        QHash<uint, Notification>::const_iterator ni = notificationContainer.constFind(notificationId);
+        if (ni != notificationContainer.constEnd()) {
+            notifications.append(*ni);
+        }
+    }
+    return notifications;
+}
+
+QList<uint> NotificationManager::groupIdsRemovedSince(quint64 sequence) const
+{
+    // A removed ID that has been reused since refers to a changed group instead
+    QList<uint> groupIds;
+    foreach (uint groupId, changeLog->groupIdsChangedSince(sequence)) {
+        if (!groupContainer.contains(groupId)) {
+            groupIds.append(groupId);
+        }
+    }
+    return groupIds;
+}
+
+QList<uint> NotificationManager::notificationIdsRemovedSince(quint64 sequence) const
+{
+    QList<uint> notificationIds;
+    foreach (uint notificationId, changeLog->notificationIdsChangedSince(sequence)) {
+        if (!notificationContainer.contains(notificationId)) {
+            notificationIds.append(notificationId);
+        }
+    }
+    return notificationIds;
+}
+
 QObject *NotificationManager::qObject()
 {
     return this;
@@ -643,28 +1247,23 @@ QObject *NotificationManager::qObject()
 uint NotificationManager::notificationCountInGroup(uint notificationUserId, uint groupId)
 {
     uint amount = 0;
-    foreach(const Notification & notification, notificationContainer.values()) {
-        if (notification.groupId() == groupId && notification.userId() == notificationUserId) {
+    foreach (uint notificationId, notificationIdsByGroupId.value(groupId)) {
+        if (notificationContainer.value(notificationId).userId() == notificationUserId) {
             amount++;
         }
     }
     return amount;
 }
 
-bool NotificationManager::isPersistent(const NotificationParameters &parameters)
+bool NotificationManager::isPersistent(const QVariant &persistentVariant, const QString &eventType)
 {
     bool isPersistent = true;
 
-    QVariant persistentVariant = parameters.value(GenericNotificationParameterFactory::persistentKey());
     if (persistentVariant.isValid()) {
         isPersistent = persistentVariant.toBool();
-    } else {
-        QVariant eventTypeVariant = parameters.value(GenericNotificationParameterFactory::eventTypeKey());
-        if (eventTypeVariant.isValid()) {
-            QString eventType = eventTypeVariant.toString();
-            if (notificationEventTypeStore->contains(eventType, GenericNotificationParameterFactory::persistentKey())) {
-                isPersistent = QVariant(notificationEventTypeStore->value(eventType, GenericNotificationParameterFactory::persistentKey())).toBool();
-            }
+    } else if (!eventType.isEmpty()) {
+        if (notificationEventTypeStore->contains(eventType, GenericNotificationParameterFactory::persistentKey())) {
+            isPersistent = QVariant(notificationEventTypeStore->value(eventType, GenericNotificationParameterFactory::persistentKey())).toBool();
         }
     }
 
@@ -679,28 +1278,99 @@ uint NotificationManager::timestamp(const NotificationParameters &parameters)
 
 void NotificationManager::updateGroupTimestampFromNotifications(uint groupId)
 {
-    if (groupId != 0 && groupContainer.contains(groupId)) {
-        NotificationGroup group = groupContainer.value(groupId);
-        NotificationParameters groupParameters = group.parameters();
-        uint oldGroupTimestamp = groupParameters.value(GenericNotificationParameterFactory::timestampKey()).toUInt();
+    if (transactionDepth > 0) {
+        if (groupId != 0) {
+            transactionTimestampGroupIds.insert(groupId);
+        }
+        return;
+    }
+
+    QHash<uint, NotificationGroup>::const_iterator gi = groupContainer.constFind(groupId);
+    if (groupId != 0 && gi != groupContainer.constEnd()) {
+        uint oldGroupTimestamp = timestampOf(gi->parameters());
 
-        // Check the latest notification timestamp of the group's notifications
+        // The latest notification timestamp of the group is the last one in the group's timestamp index
         uint newGroupTimestamp = 0;
-        QHash<uint, Notification>::const_iterator notificationIterator;
-        for (notificationIterator = notificationContainer.begin(); notificationIterator != notificationContainer.end(); notificationIterator++) {
-            if ((*notificationIterator).groupId() == groupId) {
-                uint notificationTimestamp = (*notificationIterator).parameters().value(GenericNotificationParameterFactory::timestampKey()).toUInt();
-                if (newGroupTimestamp < notificationTimestamp) {
-                    newGroupTimestamp = notificationTimestamp;
-                }
-            }
+        QHash<uint, QMap<uint, uint> >::const_iterator ti = notificationTimestampsByGroupId.constFind(groupId);
+        if (ti != notificationTimestampsByGroupId.constEnd()) {
+            QMap<uint, uint>::const_iterator latest = ti->constEnd();
+            --latest;
+            newGroupTimestamp = latest.key();
         }
 
         if (oldGroupTimestamp != newGroupTimestamp) {
             // Update the group timestamp
+            NotificationParameters groupParameters;
             groupParameters.add(GenericNotificationParameterFactory::timestampKey(), newGroupTimestamp);
-            group.updateParameters(groupParameters);
-            updateGroup(group.userId(), group.groupId(), group.parameters());
+            updateGroup(gi->userId(), groupId, groupParameters);
         }
     }
 }
+
+void NotificationManager::indexNotification(const Notification &notification)
+{
+    uint notificationId = notification.notificationId();
+    insertToIndex(notificationIdsByUserId, notification.userId(), notificationId);
+    insertToIndex(notificationIdsByGroupId, notification.groupId(), notificationId);
+    insertToIndex(notificationIdsByEventType, eventTypeOf(notification.parameters()), notificationId);
+    notificationIdsByTimestamp[notification.userId()].insert(timestampOf(notification.parameters()), notificationId);
+
+    QString identifier = identifierOf(notification.parameters());
+    if (!identifier.isEmpty()) {
+        insertToIndex(notificationIdsByIdentifier, qMakePair(notification.userId(), identifier), notificationId);
+    }
+
+    if (notification.groupId() != 0) {
+        notificationTimestampsByGroupId[notification.groupId()][timestampOf(notification.parameters())]++;
+    }
+}
+
+void NotificationManager::unindexNotification(const Notification &notification)
+{
+    uint notificationId = notification.notificationId();
+    removeFromIndex(notificationIdsByUserId, notification.userId(), notificationId);
+    removeFromIndex(notificationIdsByGroupId, notification.groupId(), notificationId);
+    removeFromIndex(notificationIdsByEventType, eventTypeOf(notification.parameters()), notificationId);
+
+    removeFromTimestampIndex(notificationIdsByTimestamp, notification.userId(), timestampOf(notification.parameters()), notificationId);
+
+    QString identifier = identifierOf(notification.parameters());
+    if (!identifier.isEmpty()) {
+        removeFromIndex(notificationIdsByIdentifier, qMakePair(notification.userId(), identifier), notificationId);
+    }
+
+    QHash<uint, QMap<uint, uint> >::iterator ti = notificationTimestampsByGroupId.find(notification.groupId());
+    if (ti != notificationTimestampsByGroupId.end()) {
+        QMap<uint, uint>::iterator count = ti->find(timestampOf(notification.parameters()));
+        if (count != ti->end() && --count.value() == 0) {
+            ti->erase(count);
+            if (ti->isEmpty()) {
+                notificationTimestampsByGroupId.erase(ti);
+            }
+        }
+    }
+}
+
+void NotificationManager::indexGroup(const NotificationGroup &group)
+{
+    insertToIndex(groupIdsByUserId, group.userId(), group.groupId());
+    insertToIndex(groupIdsByEventType, eventTypeOf(group.parameters()), group.groupId());
+    groupIdsByTimestamp[group.userId()].insert(timestampOf(group.parameters()), group.groupId());
+
+    QString identifier = identifierOf(group.parameters());
+    if (!identifier.isEmpty()) {
+        insertToIndex(groupIdsByIdentifier, qMakePair(group.userId(), identifier), group.groupId());
+    }
+}
+
+void NotificationManager::unindexGroup(const NotificationGroup &group)
+{
+    removeFromIndex(groupIdsByUserId, group.userId(), group.groupId());
+    removeFromIndex(groupIdsByEventType, eventTypeOf(group.parameters()), group.groupId());
+    removeFromTimestampIndex(groupIdsByTimestamp, group.userId(), timestampOf(group.parameters()), group.groupId());
+
+    QString identifier = identifierOf(group.parameters());
+    if (!identifier.isEmpty()) {
+        removeFromIndex(groupIdsByIdentifier, qMakePair(group.userId(), identifier), group.groupId());
+    }
+}
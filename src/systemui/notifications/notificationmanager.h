@@ -28,6 +28,10 @@
 #include <QObject>
 #include <QHash>
 #include <QSet>
+#include <QMap>
+#include <QPair>
+#include <QList>
+#include <QStringList>
 #include <QTimer>
 #include <QSharedPointer>
 #include <QBuffer>
@@ -35,6 +39,10 @@
 class ApplicationContext;
 class DBusInterfaceNotificationSource;
 class DBusInterfaceNotificationSink;
+class NotificationPersistenceWorker;
+class NotificationIdAllocator;
+class NotificationWaitQueue;
+class NotificationChangeLog;
 
 /*!
  * The NotificationManager allows a program to display a notification,
@@ -81,6 +89,12 @@ public:
     //! \reimp
     QList<Notification> notifications() const;
     QList<NotificationGroup> groups() const;
+    quint64 changeSequence() const;
+    bool changesKnownSince(quint64 sequence) const;
+    QList<NotificationGroup> groupsChangedSince(quint64 sequence) const;
+    QList<Notification> notificationsChangedSince(quint64 sequence) const;
+    QList<uint> groupIdsRemovedSince(quint64 sequence) const;
+    QList<uint> notificationIdsRemovedSince(quint64 sequence) const;
     virtual QObject *qObject();
     //! \reimp_end
 
@@ -89,9 +103,16 @@ public slots:
     uint addNotification(uint notificationUserId, const NotificationParameters &parameters = NotificationParameters(), uint groupId = 0);
     bool updateNotification(uint notificationUserId, uint notificationId, const NotificationParameters &parameters = NotificationParameters());
     bool removeNotification(uint notificationUserId, uint notificationId);
+    QList<uint> addNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications);
+    bool updateNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications);
+    bool removeNotifications(uint notificationUserId, const QList<uint> &notificationIds);
+    uint addOrUpdateNotification(uint notificationUserId, uint groupId, const QString &identifier, const NotificationParameters &parameters = NotificationParameters());
+    bool removeNotificationsWithIdentifier(uint notificationUserId, const QString &identifier);
     uint addGroup(uint notificationUserId, const NotificationParameters &parameters = NotificationParameters());
     bool updateGroup(uint notificationUserId, uint groupId, const NotificationParameters &parameters = NotificationParameters());
     bool removeGroup(uint notificationUserId, uint groupId);
+    uint addOrUpdateGroup(uint notificationUserId, const QString &identifier, const NotificationParameters &parameters = NotificationParameters());
+    bool removeGroupsWithIdentifier(uint notificationUserId, const QString &identifier);
     uint notificationUserId();
     QList<uint> notificationIdList(uint notificationUserId);
     QList<Notification> notificationList(uint notificationUserId);
@@ -99,6 +120,10 @@ public slots:
     QList<NotificationGroup> notificationGroupList(uint notificationUserId);
     QList<NotificationGroup> notificationGroupListWithIdentifiers(uint notificationUserId);
     uint notificationCountInGroup(uint notificationUserId, uint groupId);
+    QList<Notification> queryNotifications(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit);
+    uint queryNotificationCount(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp);
+    QList<NotificationGroup> queryGroups(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit);
+    uint queryGroupCount(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp);
     //! \reimp_end
 
     /*!
@@ -135,6 +160,21 @@ public slots:
      */
     void updateNotificationsAndGroupsWithEventType(const QString &eventType);
 
+    /*!
+     * Update event type data of all notifications and groups with any of
+     * the specified event types in a single transaction
+     *
+     * \param eventTypes the event types of the notifications and groups to update
+     */
+    void updateNotificationsAndGroupsWithEventTypes(const QStringList &eventTypes);
+
+    /*!
+     * Writes all pending changes to the persistent storage and waits until
+     * they have been written. Called automatically when the manager is
+     * destroyed and when the application is about to quit.
+     */
+    void flushPersistentData();
+
 signals:
     /*!
      * A signal for notifying that the contents of a notification
@@ -144,12 +184,39 @@ signals:
      */
     void notificationUpdated(const Notification &notification);
 
+    /*!
+     * A signal for notifying that the contents of several notifications
+     * have changed at once. Emitted instead of notificationUpdated() when a
+     * transaction changes more than one notification.
+     * \param notifications the data of the notifications
+     */
+    void notificationsUpdated(const QList<Notification> &notifications);
+
+    /*!
+     * A signal for notifying that a notification should alert the user, for
+     * example with feedback or a banner. Emitted along with notificationUpdated()
+     * when a notification is relayed, and at the turn of a notification added in
+     * a transaction: such notifications are relayed to notificationsUpdated()
+     * with the rest of the transaction but alert the user one at a time through
+     * the wait queue and the relay interval.
+     * \param notification the data of the notification
+     */
+    void notificationAlerted(const Notification &notification);
+
     /*!
      * A signal for notifying that a certain notification has been removed.
      * \param notificationId the ID of the notification to be removed
      */
     void notificationRemoved(uint notificationId);
 
+    /*!
+     * A signal for notifying that several notifications have been removed
+     * at once. Emitted instead of notificationRemoved() when a transaction
+     * removes more than one notification.
+     * \param notificationIds the IDs of the removed notifications
+     */
+    void notificationsRemoved(const QList<uint> &notificationIds);
+
     /*!
      * A signal for notifying that the contents of a notification group has changed.
      * The group can be a new group or a pre-existing group.
@@ -165,11 +232,12 @@ signals:
     void groupRemoved(uint groupId);
 
     /*!
-     * A signal for notifying that a pre-existing notification has been
-     * restored from the persistent storage.
-     * \param notification the data of the notification
+     * A signal for notifying that pre-existing notifications have been
+     * restored from the persistent storage. Emitted once with all the
+     * restored notifications so that the sinks can build their state in one go.
+     * \param notifications the restored notifications in notification ID order
      */
-    void notificationRestored(const Notification &notification);
+    void notificationsRestored(const QList<Notification> &notifications);
 
     /*!
      * Signal used to queue group removal request
@@ -183,6 +251,12 @@ signals:
      */
     void queuedNotificationRemove(uint notificationId);
 
+    /*!
+     * Signal used to queue a removal request of several notifications
+     * \param notificationIds the IDs of the notifications to be removed
+     */
+    void queuedNotificationsRemove(const QList<uint> &notificationIds);
+
 
 protected slots:
     /*!
@@ -205,9 +279,22 @@ private slots:
      */
     void doRemoveGroup(uint groupId);
 
+    /*!
+     * Removes notifications from internal storage in a single transaction
+     * \param notificationIds the IDs of the notifications to be removed
+     */
+    void doRemoveNotifications(const QList<uint> &notificationIds);
+
+    /*!
+     * Compacts the persistent storage by writing a snapshot of all groups and
+     * notifications and clearing the journal of changes made since the previous snapshot.
+     */
+    void compactStore();
+
 private:
     /*!
      * Determines the type of a notification from the notification parameters.
+     * The parameters must already contain the event type parameters.
      *
      * \param parameters NotificationParameters to determine the type from
      * \return the type of the notification
@@ -217,28 +304,91 @@ private:
     /*!
      * Handles the notification which either signals addNotification() immediatelly
      * or adds the notification into the notification wait queue to be processed later.
+     * In a transaction the notification is relayed with the rest of the transaction
+     * and only alerting the user about it waits in the notification wait queue.
      * \param notification The submitted notification object.
      */
     void submitNotification(const Notification &notification);
 
+    /*!
+     * Informs the sinks that a notification has been added or updated. If a
+     * transaction is in progress the sinks are informed when it is committed.
+     * \param notification the notification that has been added or updated
+     */
+    void relayNotificationUpdate(const Notification &notification);
+
+    /*!
+     * Informs the sinks that a notification should alert the user. If a
+     * transaction is in progress the sinks are informed when it is committed.
+     * \param notification the notification that has been updated
+     */
+    void relayNotificationAlert(const Notification &notification);
+
+    /*!
+     * Informs the sinks that a notification has been removed. If a
+     * transaction is in progress the sinks are informed when it is committed.
+     * \param notificationId the ID of the removed notification
+     */
+    void relayNotificationRemoval(uint notificationId);
+
+    /*!
+     * Informs the sinks that a notification group has been removed. If a
+     * transaction is in progress the sinks are informed when it is committed.
+     * \param groupId the ID of the removed group
+     */
+    void relayGroupRemoval(uint groupId);
+
+    /*!
+     * Starts a transaction. Until the transaction is committed the changes
+     * are not handed over to the persistent storage, group timestamps are not
+     * updated and the sinks are not informed about added, updated and removed
+     * notifications and removed groups. Transactions may be nested: the changes take effect when
+     * the outermost transaction is committed.
+     */
+    void beginTransaction();
+
+    /*!
+     * Commits a transaction started with beginTransaction(). When the
+     * outermost transaction is committed the group timestamps are updated,
+     * the sinks are informed about all removed, added and updated
+     * notifications at once and the changes are handed over to the persistent storage.
+     */
+    void commitTransaction();
+
     /*!
      * Appends the notification parameters determined by the event type to the parameters
      * and returns a new instance of the complete parameters. The returned parameters contain
      * both the parameters supplied in the \a parameters argument as well as thos determined
-     * by the event type configuration.
+     * by the event type configuration. The event type parameters are set as shared defaults
+     * of the returned parameters so they are not copied to every notification. The
+     * parameters supplied in the \a parameters argument that are determined by the event
+     * type are left out.
      * @param parameters the notification parameters.
      * @return the parameters passed in as an argument appended with the event type specific parameters.
      */
     NotificationParameters appendEventTypeParameters(const NotificationParameters &parameters) const;
 
     /*!
-     * Returns the index of a notification in the wait queue matching the notification
-     * id given as a parameter.
-     * \param notificationId Notification ID to be searched from the wait queue.
-     * \returns Index of matching notification in the wait queue or -1 if no matching
-     * notification is found.
+     * Returns the parameters determined by the configuration of an event type.
+     * The parameters are read from the event type store once and shared by
+     * all notifications and groups of the event type.
+     *
+     * \param eventType the event type
+     * \return the parameters of the event type
      */
-    int findNotificationFromWaitQueue(uint notificationId);
+    NotificationParameters eventTypeParameters(const QString &eventType) const;
+
+    /*!
+     * Returns the priority of a notification in the wait queue. System
+     * notifications are relayed before application notifications. Within
+     * each class the notifications with a larger priority parameter are
+     * relayed first, and notifications with the same priority in the order
+     * they were submitted.
+     *
+     * \param notification the notification to determine the priority of
+     * \return the priority of the notification. Smaller values are relayed first.
+     */
+    int relayPriority(const Notification &notification) const;
 
     /*!
      * Returns the next available notification ID
@@ -272,28 +422,26 @@ private:
     bool ensurePersistentDataPath();
 
     /*!
-     * Stores the group information and the last user id to a permanent storage
+     * Schedules compaction of the persistent storage if the journal has grown
+     * too large compared to the amount of data in the store.
      */
-    void saveStateData();
-
-    /*!
-     * Stores the notifications to a permanent storage
-     */
-    void saveNotifications();
+    void scheduleCompactionIfNeeded();
 
     //! Returns \c true if sysuid was previously started after system boot, \c false otherwise
     bool isSubsequentStart();
 
+    //! Reads the group information and the last user id from the snapshot in the permanent storage
     void restoreState();
-    void restoreNotifications();
 
     /*!
-     * Determines persistence of a notification from the notification parameters.
+     * Determines persistence of a notification from the value of its
+     * persistent parameter and its event type.
      *
-     * \param parameters NotificationParameters to determine the persistence from
+     * \param persistentVariant the value of the persistent parameter or an invalid QVariant if the notification doesn't have one
+     * \param eventType the event type of the notification
      * \return \c true if the notification is persistent, \c false otherwise.
      */
-    bool isPersistent(const NotificationParameters &parameters);
+    bool isPersistent(const QVariant &persistentVariant, const QString &eventType);
 
     /*!
      * Extracts timestamp information of notification from the notification parameters.
@@ -306,19 +454,104 @@ private:
     uint timestamp(const NotificationParameters &parameters);
 
     /*! Updates the given group's timestamp according to the latest timestamp of group's notifications.
+     * The group is updated only if its timestamp changes.
      *
      * \param groupId The id of the group of which timestamp should be updated
      */
     void updateGroupTimestampFromNotifications(uint groupId);
 
+    /*!
+     * Adds a notification to the secondary indexes.
+     *
+     * \param notification the notification to add
+     */
+    void indexNotification(const Notification &notification);
+
+    /*!
+     * Removes a notification from the secondary indexes.
+     *
+     * \param notification the notification to remove
+     */
+    void unindexNotification(const Notification &notification);
+
+    /*!
+     * Adds a notification group to the secondary indexes.
+     *
+     * \param group the notification group to add
+     */
+    void indexGroup(const NotificationGroup &group);
+
+    /*!
+     * Removes a notification group from the secondary indexes.
+     *
+     * \param group the notification group to remove
+     */
+    void unindexGroup(const NotificationGroup &group);
+
+    /*!
+     * Returns the IDs of the notifications a query needs to look at. The IDs
+     * are taken from the secondary index that is most selective for the
+     * given criteria, so they may include notifications that don't match
+     * the other criteria.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param eventType the event type to look for or an empty string
+     * \param groupId the group ID to look for or 0
+     * \param identifier the user supplied identifier to look for or an empty string
+     * \param sinceTimestamp the timestamp after which the notifications are looked for or 0
+     * \return a superset of the IDs of the matching notifications in ascending order
+     */
+    QList<uint> candidateNotificationIds(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp) const;
+
+    /*!
+     * Returns the IDs of the notification groups a query needs to look at.
+     *
+     * \param notificationUserId the ID of the user of notifications
+     * \param eventType the event type to look for or an empty string
+     * \param identifier the user supplied identifier to look for or an empty string
+     * \param sinceTimestamp the timestamp after which the groups are looked for or 0
+     * \return a superset of the IDs of the matching notification groups in ascending order
+     */
+    QList<uint> candidateGroupIds(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp) const;
+
     //! Hash of all notifications keyed by notification IDs
     QHash<uint, Notification> notificationContainer;
 
     //! Hash of all notification groups keyed by group IDs
     QHash<uint, NotificationGroup> groupContainer;
 
+    //! IDs of the notifications in ascending order keyed by notification user IDs
+    QHash<uint, QList<uint> > notificationIdsByUserId;
+
+    //! IDs of the notifications in ascending order keyed by group IDs. Notifications not in a group are stored with group ID 0.
+    QHash<uint, QList<uint> > notificationIdsByGroupId;
+
+    //! IDs of the notifications in ascending order keyed by event types
+    QHash<QString, QList<uint> > notificationIdsByEventType;
+
+    //! The number of notifications with each timestamp, ordered by the timestamp, keyed by group IDs. Notifications not in a group are not indexed.
+    QHash<uint, QMap<uint, uint> > notificationTimestampsByGroupId;
+
+    //! IDs of the notifications ordered by their timestamps, keyed by notification user IDs
+    QHash<uint, QMultiMap<uint, uint> > notificationIdsByTimestamp;
+
+    //! IDs of the notifications in ascending order keyed by notification user IDs and user supplied identifiers. Notifications without an identifier are not indexed.
+    QHash<QPair<uint, QString>, QList<uint> > notificationIdsByIdentifier;
+
+    //! IDs of the notification groups in ascending order keyed by notification user IDs
+    QHash<uint, QList<uint> > groupIdsByUserId;
+
+    //! IDs of the notification groups in ascending order keyed by event types
+    QHash<QString, QList<uint> > groupIdsByEventType;
+
+    //! IDs of the notification groups ordered by their timestamps, keyed by notification user IDs
+    QHash<uint, QMultiMap<uint, uint> > groupIdsByTimestamp;
+
+    //! IDs of the notification groups in ascending order keyed by notification user IDs and user supplied identifiers. Groups without an identifier are not indexed.
+    QHash<QPair<uint, QString>, QList<uint> > groupIdsByIdentifier;
+
     //! Used to store notifications that wait their turn to be relayed to sinks.
-    QList<Notification> waitQueue;
+    NotificationWaitQueue *waitQueue;
 
     //! Maximum amount of notifications in the wait queue.
     const uint maxWaitQueueSize;
@@ -347,18 +580,60 @@ private:
     //! EventTypeStore for notification event types
     QSharedPointer<EventTypeStore> notificationEventTypeStore;
 
+    //! The parameters of the event types keyed by the event type. Event types without parameters are not cached.
+    mutable QHash<QString, NotificationParameters> eventTypeParameterCache;
+
     //! The last used notification user ID
     quint32 lastUsedNotificationUserId;
 
+    //! The highest notification user ID reserved in the persistent storage
+    quint32 reservedNotificationUserId;
+
+    //! Allocator for the notification IDs
+    NotificationIdAllocator *notificationIdAllocator;
+
+    //! Allocator for the notification group IDs
+    NotificationIdAllocator *groupIdAllocator;
+
+    //! Writes the changes made to the notifications and groups to the persistent storage
+    NotificationPersistenceWorker *persistenceWorker;
+
+    //! The latest changes made to the notifications and groups, for sending only the changes to reconnecting sinks
+    NotificationChangeLog *changeLog;
+
+    //! Whether compaction of the persistent storage has been scheduled
+    bool compactionScheduled;
+
+    //! The number of nested transactions in progress
+    uint transactionDepth;
+
+    //! IDs of the notifications added or updated during the transaction in the order the sinks should be informed about them
+    QList<uint> transactionUpdatedNotificationIds;
+
+    //! IDs of the notifications added or updated during the transaction
+    QSet<uint> transactionUpdatedNotificationIdSet;
+
+    //! IDs of the notifications removed during the transaction
+    QList<uint> transactionRemovedNotificationIds;
+
+    //! IDs of the groups removed during the transaction
+    QList<uint> transactionRemovedGroupIds;
+
+    //! IDs of the groups whose timestamps need to be updated when the transaction is committed
+    QSet<uint> transactionTimestampGroupIds;
+
+    //! IDs of the notifications updated during the transaction that alert the user when it is committed
+    QList<uint> transactionAlertedNotificationIds;
+
+    //! IDs of the notifications in the wait queue that were relayed with a transaction but have not alerted the user yet
+    QSet<uint> unalertedNotificationIds;
+
     //! Flag to determine if the persistent data has been restored yet
     bool persistentDataRestored;
 
     //! Whether store initialization is subsequent after initialization in boot
     bool subsequentStart;
 
-    //! Returns the position where notification should be inserted in the queue, depending upon type of notification
-    int insertPosition(const Notification &notification);
-
 #ifdef UNIT_TEST
     friend class Ut_NotificationManager;
 #endif
@@ -0,0 +1,325 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include "notificationpersistenceworker.h"
+#include "notificationjournal.h"
+#include "notificationsnapshot.h"
+#include <QFile>
+#include <QDataStream>
+#include <QMutexLocker>
+#include <stdio.h>
+#include <unistd.h>
+
+//! The suffix of the temporary files a snapshot is written to
+static const char *TEMPORARY_FILE_SUFFIX = ".tmp";
+
+//! Writes the given data to the temporary file of the given file and makes sure it is on the disk
+static bool writeTemporaryFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName + TEMPORARY_FILE_SUFFIX);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    bool written = file.write(data) == data.size() && file.flush() && fsync(file.handle()) == 0;
+    file.close();
+    if (!written) {
+        file.remove();
+    }
+    return written;
+}
+
+//! Atomically replaces the given file with its temporary file
+static bool replaceWithTemporaryFile(const QString &fileName)
+{
+    return rename(QFile::encodeName(fileName + TEMPORARY_FILE_SUFFIX).constData(), QFile::encodeName(fileName).constData()) == 0;
+}
+
+NotificationPersistenceWorker::NotificationPersistenceWorker(const QString &journalFileName, const QString &stateFileName, const QString &notificationsFileName, int coalescingWindow) :
+    journal(new NotificationJournal(journalFileName)),
+    stateFileName(stateFileName),
+    notificationsFileName(notificationsFileName),
+    batchPending(false),
+    writing(false),
+    stopping(false),
+    journalRecords(0),
+    queued(0),
+    coalesced(0),
+    written(0)
+{
+    coalescingTimer.setSingleShot(true);
+    coalescingTimer.setInterval(coalescingWindow);
+    connect(&coalescingTimer, SIGNAL(timeout()), this, SLOT(writeQueuedOperations()));
+
+    start(QThread::LowPriority);
+}
+
+NotificationPersistenceWorker::~NotificationPersistenceWorker()
+{
+    flush();
+
+    mutex.lock();
+    stopping = true;
+    workAvailable.wakeOne();
+    mutex.unlock();
+    wait();
+
+    delete journal;
+}
+
+void NotificationPersistenceWorker::replayJournal(QHash<uint, Notification> &notifications, QHash<uint, NotificationGroup> &groups, quint32 &lastUsedUserId, quint32 *notificationIdHighWaterMark, quint32 *groupIdHighWaterMark, QSet<uint> *removedNotificationIds)
+{
+    // Make sure nothing is being written while the journal is read
+    flush();
+
+    QMutexLocker locker(&mutex);
+    journalRecords = journal->replay(notifications, groups, lastUsedUserId, notificationIdHighWaterMark, groupIdHighWaterMark, removedNotificationIds);
+}
+
+void NotificationPersistenceWorker::saveNotification(const Notification &notification)
+{
+    queueRecord(OperationKey(NotificationTarget, notification.notificationId()), NotificationJournal::notificationRecord(notification));
+}
+
+void NotificationPersistenceWorker::removeNotification(uint notificationId)
+{
+    queueRecord(OperationKey(NotificationTarget, notificationId), NotificationJournal::notificationRemovalRecord(notificationId));
+}
+
+void NotificationPersistenceWorker::saveGroup(const NotificationGroup &group)
+{
+    queueRecord(OperationKey(GroupTarget, group.groupId()), NotificationJournal::groupRecord(group));
+}
+
+void NotificationPersistenceWorker::removeGroup(uint groupId)
+{
+    queueRecord(OperationKey(GroupTarget, groupId), NotificationJournal::groupRemovalRecord(groupId));
+}
+
+void NotificationPersistenceWorker::saveLastUsedUserId(quint32 userId)
+{
+    queueRecord(OperationKey(UserIdTarget, 0), NotificationJournal::lastUsedUserIdRecord(userId));
+}
+
+void NotificationPersistenceWorker::saveIdHighWaterMarks(quint32 notificationIdHighWaterMark, quint32 groupIdHighWaterMark)
+{
+    queueRecord(OperationKey(IdHighWaterMarksTarget, 0), NotificationJournal::idHighWaterMarksRecord(notificationIdHighWaterMark, groupIdHighWaterMark));
+}
+
+void NotificationPersistenceWorker::saveSnapshot(quint32 lastUsedUserId, const QHash<uint, NotificationGroup> &groups, const QHash<uint, Notification> &notifications)
+{
+    QMutexLocker locker(&mutex);
+
+    // The snapshot supersedes all changes queued before it, but they are kept until the snapshot has been written
+    queued++;
+    coalesced += queuedBatch.records.count();
+    Batch batch;
+    batch.hasSnapshot = true;
+    batch.lastUsedUserId = lastUsedUserId;
+    batch.groups = groups;
+    batch.notifications = notifications;
+    batch.supersededRecords = queuedBatch.supersededRecords + queuedBatch.records;
+    batch.supersededJournalRecords = queuedBatch.supersededJournalRecords + journalRecords;
+    queuedBatch = batch;
+    journalRecords = 0;
+
+    scheduleWrite();
+}
+
+void NotificationPersistenceWorker::queueRecord(const OperationKey &key, const QByteArray &record)
+{
+    QMutexLocker locker(&mutex);
+
+    queued++;
+    QHash<OperationKey, int>::const_iterator index = queuedBatch.recordIndexes.constFind(key);
+    if (index != queuedBatch.recordIndexes.constEnd()) {
+        // Each record contains the complete state of the item so only the latest one needs to be written
+        queuedBatch.records[*index] = record;
+        coalesced++;
+    } else {
+        queuedBatch.recordIndexes.insert(key, queuedBatch.records.count());
+        queuedBatch.records.append(record);
+        journalRecords++;
+    }
+
+    scheduleWrite();
+}
+
+void NotificationPersistenceWorker::scheduleWrite()
+{
+    // The window is not restarted so that a steady stream of changes can't postpone writing indefinitely
+    if (!coalescingTimer.isActive()) {
+        coalescingTimer.start();
+    }
+}
+
+void NotificationPersistenceWorker::writeQueuedOperations()
+{
+    coalescingTimer.stop();
+
+    QMutexLocker locker(&mutex);
+    handOverQueuedBatch();
+}
+
+void NotificationPersistenceWorker::handOverQueuedBatch()
+{
+    if (!queuedBatch.hasSnapshot && queuedBatch.records.isEmpty()) {
+        return;
+    }
+
+    if (queuedBatch.hasSnapshot) {
+        // The worker thread hasn't picked up the previous batch yet: the snapshot supersedes it
+        coalesced += pendingBatch.records.count() + (pendingBatch.hasSnapshot ? 1 : 0);
+        queuedBatch.supersededRecords = pendingBatch.supersededRecords + pendingBatch.records + queuedBatch.supersededRecords;
+        queuedBatch.supersededJournalRecords += pendingBatch.supersededJournalRecords;
+        pendingBatch = queuedBatch;
+    } else {
+        pendingBatch.records += queuedBatch.records;
+    }
+    queuedBatch = Batch();
+
+    batchPending = true;
+    workAvailable.wakeOne();
+}
+
+void NotificationPersistenceWorker::flush()
+{
+    coalescingTimer.stop();
+
+    QMutexLocker locker(&mutex);
+    handOverQueuedBatch();
+    while (batchPending || writing) {
+        batchWritten.wait(&mutex);
+    }
+}
+
+uint NotificationPersistenceWorker::journalRecordCount() const
+{
+    QMutexLocker locker(&mutex);
+    return journalRecords;
+}
+
+uint NotificationPersistenceWorker::queuedOperations() const
+{
+    QMutexLocker locker(&mutex);
+    return queued;
+}
+
+uint NotificationPersistenceWorker::coalescedOperations() const
+{
+    QMutexLocker locker(&mutex);
+    return coalesced;
+}
+
+uint NotificationPersistenceWorker::writtenOperations() const
+{
+    QMutexLocker locker(&mutex);
+    return written;
+}
+
+void NotificationPersistenceWorker::run()
+{
+    QMutexLocker locker(&mutex);
+
+    forever {
+        while (!batchPending && !stopping) {
+            workAvailable.wait(&mutex);
+        }
+
+        if (!batchPending) {
+            break;
+        }
+
+        Batch batch = pendingBatch;
+        pendingBatch = Batch();
+        batchPending = false;
+        writing = true;
+
+        locker.unlock();
+        bool snapshotWritten = writeBatch(batch);
+        locker.relock();
+
+        if (snapshotWritten) {
+            written += batch.records.count() + (batch.hasSnapshot ? 1 : 0);
+        } else {
+            // The superseded records were journaled instead of the snapshot
+            written += batch.supersededRecords.count() + batch.records.count();
+            journalRecords += batch.supersededJournalRecords;
+        }
+        writing = false;
+        batchWritten.wakeAll();
+    }
+}
+
+bool NotificationPersistenceWorker::writeBatch(const Batch &batch)
+{
+    QList<QByteArray> records;
+    bool snapshotWritten = true;
+    if (batch.hasSnapshot) {
+        // The journal is cleared only after the snapshot is on the disk so that a crash in between only causes the journal to be replayed on top of an up-to-date snapshot
+        snapshotWritten = writeSnapshot(batch);
+        if (snapshotWritten) {
+            journal->clear();
+        } else {
+            // The previous snapshot and the journal are left intact, so the changes superseded by the snapshot must be journaled
+            records = batch.supersededRecords;
+        }
+    }
+    records += batch.records;
+
+    if (!records.isEmpty()) {
+        QByteArray data;
+        foreach (const QByteArray &record, records) {
+            data.append(record);
+        }
+        journal->appendRecords(data, records.count());
+    }
+
+    return snapshotWritten;
+}
+
+bool NotificationPersistenceWorker::writeSnapshot(const Batch &batch)
+{
+    QByteArray state;
+    QDataStream stream(&state, QIODevice::WriteOnly);
+    stream << batch.lastUsedUserId;
+    foreach (const NotificationGroup &group, batch.groups) {
+        stream << group;
+    }
+
+    // Both files are written before either of them is replaced so that a failed write leaves the previous snapshot intact
+    if (!writeTemporaryFile(stateFileName, state)) {
+        return false;
+    }
+    if (batch.notifications.size() && !writeTemporaryFile(notificationsFileName, NotificationSnapshot::serialize(batch.notifications.values()))) {
+        QFile::remove(stateFileName + TEMPORARY_FILE_SUFFIX);
+        return false;
+    }
+
+    if (!replaceWithTemporaryFile(stateFileName)) {
+        QFile::remove(notificationsFileName + TEMPORARY_FILE_SUFFIX);
+        return false;
+    }
+    if (batch.notifications.size()) {
+        return replaceWithTemporaryFile(notificationsFileName);
+    } else {
+        QFile::remove(notificationsFileName);
+        return true;
+    }
+}
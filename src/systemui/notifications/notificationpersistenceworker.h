@@ -0,0 +1,267 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef NOTIFICATIONPERSISTENCEWORKER_H_
+#define NOTIFICATIONPERSISTENCEWORKER_H_
+
+#include "notification.h"
+#include "notificationgroup.h"
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QTimer>
+#include <QHash>
+#include <QSet>
+#include <QPair>
+#include <QList>
+
+class NotificationJournal;
+
+/*!
+ * Writes the notification store to the persistent storage in a separate thread.
+ *
+ * Changes are queued by the thread owning the worker (usually the GUI thread)
+ * and kept in memory for a short coalescing window. Several changes to the same
+ * notification or group during the window are coalesced into a single journal
+ * record. When the window expires the queued changes are handed over to the
+ * worker thread which appends them to the journal. Snapshots of the whole
+ * store are written by the worker thread as well. A snapshot is written to
+ * temporary files which replace the snapshot files only once they are on the
+ * disk, and the journal is cleared only after that. If the snapshot can't be
+ * written the changes it superseded are appended to the journal instead.
+ *
+ * The queueing methods and flush() must only be called from the thread that
+ * created the worker.
+ */
+class NotificationPersistenceWorker : public QThread
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * Creates a new persistence worker and starts the worker thread.
+     *
+     * \param journalFileName the name of the file the journal is stored in
+     * \param stateFileName the name of the file the group snapshot is stored in
+     * \param notificationsFileName the name of the file the notification snapshot is stored in
+     * \param coalescingWindow time in milliseconds changes are kept in memory before they are written
+     */
+    NotificationPersistenceWorker(const QString &journalFileName, const QString &stateFileName, const QString &notificationsFileName, int coalescingWindow = 100);
+
+    /*!
+     * Writes all queued changes and stops the worker thread.
+     */
+    virtual ~NotificationPersistenceWorker();
+
+    /*!
+     * Replays the journal on top of the given containers. Must be called
+     * before any changes are queued.
+     *
+     * \param notifications the notifications to apply the journal to
+     * \param groups the notification groups to apply the journal to
+     * \param lastUsedUserId the last used user ID to apply the journal to
+     * \param notificationIdHighWaterMark if not \c NULL, raised to the highest notification ID appearing in the journal
+     * \param groupIdHighWaterMark if not \c NULL, raised to the highest notification group ID appearing in the journal
+     * \param removedNotificationIds if not \c NULL, receives the IDs of the notifications the journal leaves removed
+     */
+    void replayJournal(QHash<uint, Notification> &notifications, QHash<uint, NotificationGroup> &groups, quint32 &lastUsedUserId, quint32 *notificationIdHighWaterMark = NULL, quint32 *groupIdHighWaterMark = NULL, QSet<uint> *removedNotificationIds = NULL);
+
+    //! Queues an added or updated notification to be written
+    void saveNotification(const Notification &notification);
+
+    //! Queues a removed notification to be written
+    void removeNotification(uint notificationId);
+
+    //! Queues an added or updated notification group to be written
+    void saveGroup(const NotificationGroup &group);
+
+    //! Queues a removed notification group to be written
+    void removeGroup(uint groupId);
+
+    //! Queues the last used notification user ID to be written
+    void saveLastUsedUserId(quint32 userId);
+
+    //! Queues the highest notification and group IDs ever allocated to be written
+    void saveIdHighWaterMarks(quint32 notificationIdHighWaterMark, quint32 groupIdHighWaterMark);
+
+    /*!
+     * Queues a snapshot of the whole store to be written. Any queued changes
+     * are already part of the snapshot so they are not journaled unless the
+     * snapshot can't be written. The journal is cleared once the snapshot has
+     * been written.
+     *
+     * \param lastUsedUserId the last used notification user ID
+     * \param groups all notification groups
+     * \param notifications all notifications
+     */
+    void saveSnapshot(quint32 lastUsedUserId, const QHash<uint, NotificationGroup> &groups, const QHash<uint, Notification> &notifications);
+
+    /*!
+     * Writes all queued changes immediately and waits until they have been written.
+     */
+    void flush();
+
+    //! Returns the number of records in the journal, including the queued ones
+    uint journalRecordCount() const;
+
+    //! Returns the number of changes queued to be written
+    uint queuedOperations() const;
+
+    //! Returns the number of queued changes that were dropped because a later change superseded them
+    uint coalescedOperations() const;
+
+    //! Returns the number of changes written to the persistent storage
+    uint writtenOperations() const;
+
+public slots:
+    /*!
+     * Hands the queued changes over to the worker thread without waiting for
+     * the coalescing window to expire. Unlike flush() this does not wait for
+     * the changes to be written.
+     */
+    void writeQueuedOperations();
+
+protected:
+    //! \reimp
+    virtual void run();
+    //! \reimp_end
+
+private:
+    //! Identifies the item an operation applies to
+    enum OperationTarget {
+        NotificationTarget,
+        GroupTarget,
+        UserIdTarget,
+        IdHighWaterMarksTarget
+    };
+
+    //! Target and ID of the item an operation applies to
+    typedef QPair<int, uint> OperationKey;
+
+    //! A batch of changes to be written by the worker thread
+    struct Batch {
+        Batch() : hasSnapshot(false), lastUsedUserId(0), supersededJournalRecords(0) {}
+
+        //! Whether the batch contains a snapshot of the store
+        bool hasSnapshot;
+        //! The last used notification user ID in the snapshot
+        quint32 lastUsedUserId;
+        //! The notification groups in the snapshot
+        QHash<uint, NotificationGroup> groups;
+        //! The notifications in the snapshot
+        QHash<uint, Notification> notifications;
+        //! The serialized journal records superseded by the snapshot, appended to the journal if the snapshot can't be written
+        QList<QByteArray> supersededRecords;
+        //! The number of records the journal would contain if the snapshot can't be written
+        uint supersededJournalRecords;
+        //! The serialized journal records to be appended after the snapshot
+        QList<QByteArray> records;
+        //! Indexes of the records keyed by the items they apply to
+        QHash<OperationKey, int> recordIndexes;
+    };
+
+    /*!
+     * Queues a journal record. Replaces any record queued earlier for the same item.
+     *
+     * \param key the item the record applies to
+     * \param record the serialized journal record
+     */
+    void queueRecord(const OperationKey &key, const QByteArray &record);
+
+    //! Starts the coalescing window unless it is already running
+    void scheduleWrite();
+
+    /*!
+     * Hands the changes queued in the owning thread over to the worker thread.
+     * Must be called with the mutex locked.
+     */
+    void handOverQueuedBatch();
+
+    /*!
+     * Writes the given batch. Called in the worker thread.
+     *
+     * \param batch the batch to write
+     * \return \c true if the batch has no snapshot or its snapshot was written, \c false otherwise
+     */
+    bool writeBatch(const Batch &batch);
+
+    /*!
+     * Writes the snapshot in the given batch to temporary files and replaces
+     * the snapshot files with them. Called in the worker thread.
+     *
+     * \param batch the batch containing the snapshot
+     * \return \c true if the snapshot was written, \c false otherwise
+     */
+    bool writeSnapshot(const Batch &batch);
+
+    //! Journal in which the changes are written
+    NotificationJournal *journal;
+
+    //! The name of the file the group snapshot is stored in
+    QString stateFileName;
+
+    //! The name of the file the notification snapshot is stored in
+    QString notificationsFileName;
+
+    //! Timer for the coalescing window
+    QTimer coalescingTimer;
+
+    //! Protects the data shared between the threads
+    mutable QMutex mutex;
+
+    //! Signaled when there is something for the worker thread to do
+    QWaitCondition workAvailable;
+
+    //! Signaled when the worker thread has written a batch
+    QWaitCondition batchWritten;
+
+    //! Changes queued in the owning thread
+    Batch queuedBatch;
+
+    //! Changes handed over to the worker thread
+    Batch pendingBatch;
+
+    //! Whether pendingBatch contains changes to be written
+    bool batchPending;
+
+    //! Whether the worker thread is currently writing
+    bool writing;
+
+    //! Whether the worker thread should stop
+    bool stopping;
+
+    //! The number of records in the journal once all queued changes have been written
+    uint journalRecords;
+
+    //! The number of changes queued to be written
+    uint queued;
+
+    //! The number of changes dropped because they were superseded
+    uint coalesced;
+
+    //! The number of changes written
+    uint written;
+
+#ifdef UNIT_TEST
+    friend class Ut_NotificationPersistenceWorker;
+#endif
+};
+
+#endif /* NOTIFICATIONPERSISTENCEWORKER_H_ */
@@ -17,12 +17,22 @@ HEADERS +=  \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/ngfadapter.h \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationstatusindicatorsink.h \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/eventtypestore.h \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/eventtypetable.h \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationmanager.h \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationjournal.h \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationpersistenceworker.h \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationsnapshot.h \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationidallocator.h \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationwaitqueue.h \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationchangelog.h \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationsource.h \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/mnotificationproxy.h \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/dbusinterfacenotificationsink.h \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/dbusinterfacenotificationsinkadaptor.h \
-    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/dbusinterfacenotificationsinkproxy.h
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/dbusinterfacenotificationsinkproxy.h \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/dbusinterfacenotificationsinkqueue.h \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationsinkfilter.h \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationsinkdispatcher.h
 
 SOURCES +=  \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/dbusinterfacenotificationsource.cpp \
@@ -34,9 +44,19 @@ SOURCES +=  \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/ngfadapter.cpp \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationstatusindicatorsink.cpp \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/eventtypestore.cpp \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/eventtypetable.cpp \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationmanager.cpp \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationjournal.cpp \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationpersistenceworker.cpp \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationsnapshot.cpp \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationidallocator.cpp \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationwaitqueue.cpp \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationchangelog.cpp \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationsource.cpp \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/mnotificationproxy.cpp \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/dbusinterfacenotificationsink.cpp \
     $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/dbusinterfacenotificationsinkadaptor.cpp \
-    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/dbusinterfacenotificationsinkproxy.cpp
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/dbusinterfacenotificationsinkproxy.cpp \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/dbusinterfacenotificationsinkqueue.cpp \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationsinkfilter.cpp \
+    $$SYSTEMUI_NOTIFICATIONS_SRC_DIR/notificationsinkdispatcher.cpp
@@ -0,0 +1,445 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include "notificationsinkdispatcher.h"
+#include "notificationsink.h"
+
+//! Adds notifications to a sink with the call that suits the number of notifications
+static void addNotificationsToSink(NotificationSink *sink, const QList<Notification> &notifications)
+{
+    if (notifications.count() == 1) {
+        sink->addNotification(notifications.first());
+    } else {
+        sink->addNotifications(notifications);
+    }
+}
+
+NotificationSinkDispatcher::NotificationSinkDispatcher(QObject *notificationManager, QObject *parent) :
+    QObject(parent),
+    deliveries(0),
+    flushScheduled(false)
+{
+    clock.start();
+
+    connect(notificationManager, SIGNAL(notificationUpdated(const Notification &)), this, SLOT(updateNotification(const Notification &)));
+    connect(notificationManager, SIGNAL(notificationsUpdated(const QList<Notification> &)), this, SLOT(updateNotifications(const QList<Notification> &)));
+    connect(notificationManager, SIGNAL(notificationRemoved(uint)), this, SLOT(removeNotification(uint)));
+    connect(notificationManager, SIGNAL(notificationsRemoved(const QList<uint> &)), this, SLOT(removeNotifications(const QList<uint> &)));
+    connect(notificationManager, SIGNAL(groupUpdated(uint, const NotificationParameters &)), this, SLOT(updateGroup(uint, const NotificationParameters &)));
+    connect(notificationManager, SIGNAL(groupRemoved(uint)), this, SLOT(removeGroup(uint)));
+    connect(notificationManager, SIGNAL(notificationsRestored(const QList<Notification> &)), this, SLOT(restoreNotifications(const QList<Notification> &)));
+    connect(notificationManager, SIGNAL(notificationAlerted(const Notification &)), this, SLOT(alertNotification(const Notification &)));
+}
+
+NotificationSinkDispatcher::~NotificationSinkDispatcher()
+{
+}
+
+void NotificationSinkDispatcher::addSink(NotificationSink *sink, LatencyClass latencyClass, Subscriptions subscriptions)
+{
+    removeSink(sink);
+
+    Sink entry;
+    entry.sink = sink;
+    entry.latencyClass = latencyClass;
+    entry.subscriptions = subscriptions;
+    entry.latestLatency = -1;
+    entry.maximumLatency = -1;
+    sinks_.append(entry);
+
+    connect(sink, SIGNAL(destroyed(QObject *)), this, SLOT(removeDestroyedSink(QObject *)));
+}
+
+void NotificationSinkDispatcher::removeSink(NotificationSink *sink)
+{
+    for (int i = 0; i < sinks_.count(); ++i) {
+        if (sinks_.at(i).sink == sink) {
+            disconnect(sink, SIGNAL(destroyed(QObject *)), this, SLOT(removeDestroyedSink(QObject *)));
+            removeSinkAt(i);
+            return;
+        }
+    }
+}
+
+void NotificationSinkDispatcher::removeDestroyedSink(QObject *sink)
+{
+    for (int i = 0; i < sinks_.count(); ++i) {
+        if (sinks_.at(i).sink == sink) {
+            removeSinkAt(i);
+            return;
+        }
+    }
+}
+
+void NotificationSinkDispatcher::removeSinkAt(int index)
+{
+    if (deliveries > 0) {
+        // The sinks being delivered to point to the entry, so it is removed once the delivery has ended
+        sinks_[index].sink = NULL;
+    } else {
+        sinks_.removeAt(index);
+    }
+}
+
+void NotificationSinkDispatcher::beginDelivery()
+{
+    deliveries++;
+}
+
+void NotificationSinkDispatcher::endDelivery()
+{
+    if (--deliveries == 0) {
+        for (int i = sinks_.count() - 1; i >= 0; --i) {
+            if (sinks_.at(i).sink == NULL) {
+                sinks_.removeAt(i);
+            }
+        }
+    }
+}
+
+int NotificationSinkDispatcher::latestLatency(const NotificationSink *sink) const
+{
+    foreach (const Sink &entry, sinks_) {
+        if (entry.sink == sink) {
+            return entry.latestLatency;
+        }
+    }
+    return -1;
+}
+
+int NotificationSinkDispatcher::maximumLatency(const NotificationSink *sink) const
+{
+    foreach (const Sink &entry, sinks_) {
+        if (entry.sink == sink) {
+            return entry.maximumLatency;
+        }
+    }
+    return -1;
+}
+
+QList<NotificationSinkDispatcher::Sink *> NotificationSinkDispatcher::sinks(LatencyClass latencyClass, Subscriptions subscriptions)
+{
+    QList<Sink *> subscribedSinks;
+    for (int i = 0; i < sinks_.count(); ++i) {
+        Sink &entry = sinks_[i];
+        if (entry.sink != NULL && entry.latencyClass == latencyClass && (entry.subscriptions & subscriptions)) {
+            subscribedSinks.append(&entry);
+        }
+    }
+    return subscribedSinks;
+}
+
+void NotificationSinkDispatcher::updateNotification(const Notification &notification)
+{
+    qint64 time = clock.elapsed();
+    deliverNotifications(sinks(Immediate, NotificationChanges), QList<Notification>() << notification, time);
+
+    Change change;
+    change.type = Change::UpdateNotification;
+    change.id = notification.notificationId();
+    change.notification = notification;
+    change.time = time;
+    defer(change, NotificationChanges);
+}
+
+void NotificationSinkDispatcher::updateNotifications(const QList<Notification> &notifications)
+{
+    qint64 time = clock.elapsed();
+    deliverNotifications(sinks(Immediate, NotificationChanges), notifications, time);
+
+    foreach (const Notification &notification, notifications) {
+        Change change;
+        change.type = Change::UpdateNotification;
+        change.id = notification.notificationId();
+        change.notification = notification;
+        change.time = time;
+        defer(change, NotificationChanges);
+    }
+}
+
+void NotificationSinkDispatcher::removeNotification(uint notificationId)
+{
+    deliverNotificationRemovals(sinks(Immediate, NotificationChanges | NotificationAlerts), QList<uint>() << notificationId);
+
+    Change change;
+    change.type = Change::RemoveNotification;
+    change.id = notificationId;
+    change.time = clock.elapsed();
+    defer(change, NotificationChanges | NotificationAlerts);
+}
+
+void NotificationSinkDispatcher::removeNotifications(const QList<uint> &notificationIds)
+{
+    deliverNotificationRemovals(sinks(Immediate, NotificationChanges | NotificationAlerts), notificationIds);
+
+    qint64 time = clock.elapsed();
+    foreach (uint notificationId, notificationIds) {
+        Change change;
+        change.type = Change::RemoveNotification;
+        change.id = notificationId;
+        change.time = time;
+        defer(change, NotificationChanges | NotificationAlerts);
+    }
+}
+
+void NotificationSinkDispatcher::alertNotification(const Notification &notification)
+{
+    qint64 time = clock.elapsed();
+    deliverNotifications(sinks(Immediate, NotificationAlerts), QList<Notification>() << notification, time);
+
+    Change change;
+    change.type = Change::AlertNotification;
+    change.id = notification.notificationId();
+    change.notification = notification;
+    change.time = time;
+    defer(change, NotificationAlerts);
+}
+
+void NotificationSinkDispatcher::updateGroup(uint groupId, const NotificationParameters &parameters)
+{
+    beginDelivery();
+    foreach (Sink *sink, sinks(Immediate, GroupChanges)) {
+        if (sink->sink != NULL) {
+            sink->sink->addGroup(groupId, parameters);
+        }
+    }
+    endDelivery();
+
+    Change change;
+    change.type = Change::UpdateGroup;
+    change.id = groupId;
+    change.parameters = parameters;
+    change.time = clock.elapsed();
+    defer(change, GroupChanges);
+}
+
+void NotificationSinkDispatcher::removeGroup(uint groupId)
+{
+    beginDelivery();
+    foreach (Sink *sink, sinks(Immediate, GroupChanges)) {
+        if (sink->sink != NULL) {
+            sink->sink->removeGroup(groupId);
+        }
+    }
+    endDelivery();
+
+    Change change;
+    change.type = Change::RemoveGroup;
+    change.id = groupId;
+    change.time = clock.elapsed();
+    defer(change, GroupChanges);
+}
+
+void NotificationSinkDispatcher::restoreNotifications(const QList<Notification> &notifications)
+{
+    deliverRestoredNotifications(sinks(Immediate, RestoredNotifications), notifications);
+
+    qint64 time = clock.elapsed();
+    foreach (const Notification &notification, notifications) {
+        Change change;
+        change.type = Change::RestoreNotification;
+        change.id = notification.notificationId();
+        change.notification = notification;
+        change.time = time;
+        defer(change, RestoredNotifications);
+    }
+}
+
+void NotificationSinkDispatcher::defer(const Change &change, Subscriptions subscriptions)
+{
+    if (sinks(Deferred, subscriptions).isEmpty()) {
+        return;
+    }
+
+    if (change.type == Change::UpdateNotification || change.type == Change::UpdateGroup || change.type == Change::AlertNotification) {
+        ChangeKey key(int(subscriptions), change.id);
+        QHash<ChangeKey, int>::iterator i = deferredUpdates.find(key);
+        if (i != deferredUpdates.end()) {
+            // Only the latest contents are delivered, as soon as the first update would have been
+            Change &deferredChange = changes[*i];
+            qint64 time = deferredChange.time;
+            deferredChange = change;
+            deferredChange.time = time;
+            return;
+        }
+        deferredUpdates.insert(key, changes.count());
+    } else if (change.type != Change::RestoreNotification) {
+        // The updates deferred before a removal are not delivered, only the removal that follows them
+        foreach (Subscription subscription, QList<Subscription>() << NotificationChanges << GroupChanges << NotificationAlerts) {
+            if (!subscriptions.testFlag(subscription)) {
+                continue;
+            }
+
+            QHash<ChangeKey, int>::iterator i = deferredUpdates.find(ChangeKey(subscription, change.id));
+            if (i != deferredUpdates.end()) {
+                Change &supersededChange = changes[*i];
+                supersededChange.type = Change::Superseded;
+                supersededChange.notification = Notification();
+                supersededChange.parameters = NotificationParameters();
+                deferredUpdates.erase(i);
+            }
+        }
+    }
+    changes.append(change);
+
+    if (!flushScheduled) {
+        flushScheduled = true;
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+    }
+}
+
+void NotificationSinkDispatcher::flush()
+{
+    flushScheduled = false;
+
+    QList<Change> deferredChanges = changes;
+    changes.clear();
+    deferredUpdates.clear();
+
+    beginDelivery();
+    QList<Sink *> notificationSinks = sinks(Deferred, NotificationChanges);
+    QList<Sink *> groupSinks = sinks(Deferred, GroupChanges);
+    QList<Sink *> restoreSinks = sinks(Deferred, RestoredNotifications);
+    QList<Sink *> alertSinks = sinks(Deferred, NotificationAlerts);
+    QList<Sink *> removalSinks = sinks(Deferred, NotificationChanges | NotificationAlerts);
+
+    for (int i = 0; i < deferredChanges.count();) {
+        const Change &change = deferredChanges.at(i);
+        switch (change.type) {
+        case Change::UpdateNotification: {
+            // Consecutive updates are delivered at once
+            QList<Notification> notifications;
+            qint64 time = change.time;
+            for (; i < deferredChanges.count() && deferredChanges.at(i).type == Change::UpdateNotification; ++i) {
+                notifications.append(deferredChanges.at(i).notification);
+                time = qMin(time, deferredChanges.at(i).time);
+            }
+            deliverNotifications(notificationSinks, notifications, time);
+            break;
+        }
+        case Change::RemoveNotification: {
+            // Consecutive removals are delivered at once
+            QList<uint> notificationIds;
+            for (; i < deferredChanges.count() && deferredChanges.at(i).type == Change::RemoveNotification; ++i) {
+                notificationIds.append(deferredChanges.at(i).id);
+            }
+            deliverNotificationRemovals(removalSinks, notificationIds);
+            break;
+        }
+        case Change::AlertNotification: {
+            // Consecutive alerts are delivered at once
+            QList<Notification> notifications;
+            qint64 time = change.time;
+            for (; i < deferredChanges.count() && deferredChanges.at(i).type == Change::AlertNotification; ++i) {
+                notifications.append(deferredChanges.at(i).notification);
+                time = qMin(time, deferredChanges.at(i).time);
+            }
+            deliverNotifications(alertSinks, notifications, time);
+            break;
+        }
+        case Change::UpdateGroup:
+            foreach (Sink *sink, groupSinks) {
+                if (sink->sink != NULL) {
+                    sink->sink->addGroup(change.id, change.parameters);
+                }
+            }
+            ++i;
+            break;
+        case Change::RemoveGroup:
+            foreach (Sink *sink, groupSinks) {
+                if (sink->sink != NULL) {
+                    sink->sink->removeGroup(change.id);
+                }
+            }
+            ++i;
+            break;
+        case Change::RestoreNotification: {
+            // The restored notifications are delivered at once
+            QList<Notification> notifications;
+            for (; i < deferredChanges.count() && deferredChanges.at(i).type == Change::RestoreNotification; ++i) {
+                notifications.append(deferredChanges.at(i).notification);
+            }
+            deliverRestoredNotifications(restoreSinks, notifications);
+            break;
+        }
+        default:
+            ++i;
+            break;
+        }
+    }
+    endDelivery();
+}
+
+void NotificationSinkDispatcher::deliverNotifications(const QList<Sink *> &sinks, const QList<Notification> &notifications, qint64 time)
+{
+    if (notifications.isEmpty()) {
+        return;
+    }
+
+    beginDelivery();
+    foreach (Sink *sink, sinks) {
+        if (sink->sink != NULL) {
+            recordLatency(sink, time);
+            addNotificationsToSink(sink->sink, notifications);
+        }
+    }
+    endDelivery();
+}
+
+void NotificationSinkDispatcher::deliverRestoredNotifications(const QList<Sink *> &sinks, const QList<Notification> &notifications)
+{
+    if (notifications.isEmpty()) {
+        return;
+    }
+
+    beginDelivery();
+    foreach (Sink *sink, sinks) {
+        if (sink->sink != NULL) {
+            addNotificationsToSink(sink->sink, notifications);
+        }
+    }
+    endDelivery();
+}
+
+void NotificationSinkDispatcher::deliverNotificationRemovals(const QList<Sink *> &sinks, const QList<uint> &notificationIds)
+{
+    if (notificationIds.isEmpty()) {
+        return;
+    }
+
+    beginDelivery();
+    foreach (Sink *sink, sinks) {
+        if (sink->sink == NULL) {
+            continue;
+        }
+
+        if (notificationIds.count() == 1) {
+            sink->sink->removeNotification(notificationIds.first());
+        } else {
+            sink->sink->removeNotifications(notificationIds);
+        }
+    }
+    endDelivery();
+}
+
+void NotificationSinkDispatcher::recordLatency(Sink *sink, qint64 time)
+{
+    sink->latestLatency = int(clock.elapsed() - time);
+    sink->maximumLatency = qMax(sink->maximumLatency, sink->latestLatency);
+}
@@ -0,0 +1,258 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef NOTIFICATIONSINKDISPATCHER_H_
+#define NOTIFICATIONSINKDISPATCHER_H_
+
+#include <QObject>
+#include <QList>
+#include <QHash>
+#include <QPair>
+#include <QElapsedTimer>
+#include "notification.h"
+
+class NotificationSink;
+
+/*!
+ * Dispatches the changes signaled by a notification manager to notification
+ * sinks in the order of their latency class.
+ *
+ * Sinks that have to react right away and are cheap to run, like the
+ * feedback and the status indicator sinks, are in the Immediate latency
+ * class. They are called as soon as the notification manager signals a
+ * change, in the order they were added. Sinks that build user interface, like
+ * the banner sinks, are in the Deferred latency class. Their changes are
+ * collected and delivered on the next event loop iteration, so that they do
+ * not delay the immediate sinks of other changes either. A notification or a
+ * group that changes several times before the deferred changes are delivered
+ * is delivered once with its latest contents, a change followed by a removal
+ * is delivered as the removal only, and consecutive changes are delivered
+ * to the sinks with one addNotifications() or removeNotifications() call.
+ * The notifications restored from the persistent storage are delivered to
+ * both latency classes with one addNotifications() call.
+ *
+ * Sinks that alert the user, like the feedback and the banner sinks, subscribe
+ * to the notification alerts instead of the notification changes. They get a
+ * notification when the notification manager relays it to alert the user, so
+ * the notifications added in one transaction reach them one relay interval
+ * apart instead of all at once.
+ *
+ * The time it takes for a notification update to reach each sink after the
+ * notification manager signaled it is measured.
+ */
+class NotificationSinkDispatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    //! How soon a sink is called after a change
+    enum LatencyClass {
+        //! The sink is called right away
+        Immediate,
+        //! The sink is called on the next event loop iteration
+        Deferred
+    };
+
+    //! The changes a sink is interested in
+    enum Subscription {
+        //! Notifications that are updated or removed
+        NotificationChanges = 0x1,
+        //! Notification groups that are updated or removed
+        GroupChanges = 0x2,
+        //! Notifications that are restored from the persistent storage
+        RestoredNotifications = 0x4,
+        //! All of the above
+        AllChanges = NotificationChanges | GroupChanges | RestoredNotifications,
+        //! Notifications that alert the user, and notifications that are removed
+        NotificationAlerts = 0x8
+    };
+    Q_DECLARE_FLAGS(Subscriptions, Subscription)
+
+    /*!
+     * Creates a dispatcher for the changes signaled by a notification manager.
+     *
+     * \param notificationManager the notification manager whose signals are dispatched
+     * \param parent the parent object
+     */
+    NotificationSinkDispatcher(QObject *notificationManager, QObject *parent = NULL);
+
+    /*!
+     * Destroys the NotificationSinkDispatcher. Changes that have not been
+     * delivered yet are not delivered.
+     */
+    virtual ~NotificationSinkDispatcher();
+
+    /*!
+     * Adds a sink to dispatch the changes to. A sink that is destroyed is
+     * removed automatically.
+     *
+     * \param sink the sink to add
+     * \param latencyClass how soon the sink is called after a change
+     * \param subscriptions the changes the sink is interested in
+     */
+    void addSink(NotificationSink *sink, LatencyClass latencyClass, Subscriptions subscriptions);
+
+    /*!
+     * Removes a sink. The sink is not called any more.
+     *
+     * \param sink the sink to remove
+     */
+    void removeSink(NotificationSink *sink);
+
+    /*!
+     * Returns the time it took for the latest notification update to reach a sink.
+     *
+     * \param sink the sink
+     * \return the latency in milliseconds or -1 if the sink has not received any notification updates
+     */
+    int latestLatency(const NotificationSink *sink) const;
+
+    /*!
+     * Returns the longest time it has taken for a notification update to reach a sink.
+     *
+     * \param sink the sink
+     * \return the latency in milliseconds or -1 if the sink has not received any notification updates
+     */
+    int maximumLatency(const NotificationSink *sink) const;
+
+private slots:
+    //! Dispatches an updated notification
+    void updateNotification(const Notification &notification);
+
+    //! Dispatches several updated notifications
+    void updateNotifications(const QList<Notification> &notifications);
+
+    //! Dispatches a removed notification
+    void removeNotification(uint notificationId);
+
+    //! Dispatches several removed notifications
+    void removeNotifications(const QList<uint> &notificationIds);
+
+    //! Dispatches a notification that alerts the user
+    void alertNotification(const Notification &notification);
+
+    //! Dispatches an updated group
+    void updateGroup(uint groupId, const NotificationParameters &parameters);
+
+    //! Dispatches a removed group
+    void removeGroup(uint groupId);
+
+    //! Dispatches the notifications restored from the persistent storage
+    void restoreNotifications(const QList<Notification> &notifications);
+
+    //! Delivers the deferred changes to the deferred sinks
+    void flush();
+
+    //! Removes a sink that has been destroyed
+    void removeDestroyedSink(QObject *sink);
+
+private:
+    //! A sink to dispatch the changes to
+    struct Sink {
+        //! The sink or NULL if it was removed while changes were being delivered
+        NotificationSink *sink;
+        LatencyClass latencyClass;
+        Subscriptions subscriptions;
+        //! The latency of the latest notification update in milliseconds or -1
+        int latestLatency;
+        //! The longest latency of a notification update in milliseconds or -1
+        int maximumLatency;
+    };
+
+    //! A change waiting to be delivered to the deferred sinks
+    struct Change {
+        //! The type of a change
+        enum Type {
+            UpdateNotification,
+            RemoveNotification,
+            UpdateGroup,
+            RemoveGroup,
+            RestoreNotification,
+            AlertNotification,
+            //! A change superseded by a later one
+            Superseded
+        };
+
+        Type type;
+        //! The ID of the notification or group
+        uint id;
+        //! The updated or restored notification
+        Notification notification;
+        //! The parameters of the updated group
+        NotificationParameters parameters;
+        //! The time the change was signaled
+        qint64 time;
+    };
+
+    //! Identifies the notification or group of a change. The first member is the subscription the change is delivered to.
+    typedef QPair<int, uint> ChangeKey;
+
+    //! Returns the sinks of the given latency class that are subscribed to any of the given changes
+    QList<Sink *> sinks(LatencyClass latencyClass, Subscriptions subscriptions);
+
+    //! Defers a change to be delivered to the deferred sinks subscribed to the given changes
+    void defer(const Change &change, Subscriptions subscriptions);
+
+    //! Delivers notification updates signaled at the given time to the given sinks
+    void deliverNotifications(const QList<Sink *> &sinks, const QList<Notification> &notifications, qint64 time);
+
+    //! Delivers restored notifications to the given sinks
+    void deliverRestoredNotifications(const QList<Sink *> &sinks, const QList<Notification> &notifications);
+
+    //! Delivers notification removals to the given sinks
+    void deliverNotificationRemovals(const QList<Sink *> &sinks, const QList<uint> &notificationIds);
+
+    //! Records the latency of a notification update signaled at the given time for a sink
+    void recordLatency(Sink *sink, qint64 time);
+
+    //! Removes the sink at the given index, or only marks it removed if changes are being delivered
+    void removeSinkAt(int index);
+
+    //! Marks the beginning of a delivery. The sinks are not removed from the list until the delivery has ended.
+    void beginDelivery();
+
+    //! Marks the end of a delivery and removes the sinks that were removed during the outermost delivery
+    void endDelivery();
+
+    //! The sinks in the order they were added. The entries are allocated separately, so appending does not move them.
+    QList<Sink> sinks_;
+
+    //! The number of deliveries in progress. A sink can add or remove sinks while it is being called.
+    int deliveries;
+
+    //! The changes waiting to be delivered to the deferred sinks
+    QList<Change> changes;
+
+    //! The indexes of the deferred updates keyed by the notification or group they are for
+    QHash<ChangeKey, int> deferredUpdates;
+
+    //! Whether a flush has been scheduled
+    bool flushScheduled;
+
+    //! Measures the time from a change to its delivery
+    QElapsedTimer clock;
+
+#ifdef UNIT_TEST
+    friend class Ut_NotificationSinkDispatcher;
+#endif
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(NotificationSinkDispatcher::Subscriptions)
+
+#endif /* NOTIFICATIONSINKDISPATCHER_H_ */
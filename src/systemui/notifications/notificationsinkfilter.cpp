@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include "notificationsinkfilter.h"
+#include "notification.h"
+#include "genericnotificationparameterfactory.h"
+
+//! The class of the system notifications
+static const QString SYSTEM_CLASS = "system";
+
+NotificationSinkFilter::NotificationSinkFilter() :
+    anyEventType(true),
+    userId(0),
+    anyClass(true),
+    notificationType(Notification::ApplicationEvent),
+    groups(true)
+{
+}
+
+NotificationSinkFilter::NotificationSinkFilter(const QStringList &eventTypes, uint userId, const QString &notificationClass, bool groups) :
+    anyEventType(eventTypes.isEmpty()),
+    userId(userId),
+    anyClass(notificationClass.isEmpty()),
+    notificationType(notificationClass == SYSTEM_CLASS ? Notification::SystemEvent : Notification::ApplicationEvent),
+    groups(groups)
+{
+    foreach (const QString &eventType, eventTypes) {
+        if (eventType.contains('*') || eventType.contains('?') || eventType.contains('[')) {
+            eventTypePatterns.append(QRegExp(eventType, Qt::CaseSensitive, QRegExp::Wildcard));
+        } else {
+            eventTypeNames.insert(eventType);
+        }
+    }
+}
+
+bool NotificationSinkFilter::matches(const Notification &notification) const
+{
+    if (matchesAllNotifications()) {
+        return true;
+    }
+
+    if (userId != 0 && notification.userId() != userId) {
+        return false;
+    }
+
+    if (!anyClass && notification.type() != notificationType) {
+        return false;
+    }
+
+    return anyEventType || matchesEventType(notification.parameters().value(GenericNotificationParameterFactory::eventTypeKey()).toString());
+}
+
+bool NotificationSinkFilter::matchesAllNotifications() const
+{
+    return anyEventType && userId == 0 && anyClass;
+}
+
+bool NotificationSinkFilter::acceptsGroups() const
+{
+    return groups;
+}
+
+bool NotificationSinkFilter::matchesEventType(const QString &eventType) const
+{
+    if (eventTypeNames.contains(eventType)) {
+        return true;
+    }
+
+    foreach (const QRegExp &pattern, eventTypePatterns) {
+        if (pattern.exactMatch(eventType)) {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef NOTIFICATIONSINKFILTER_H_
+#define NOTIFICATIONSINKFILTER_H_
+
+#include <QStringList>
+#include <QSet>
+#include <QRegExp>
+#include "notification.h"
+
+/*!
+ * Selects the notifications and notification groups an external sink wants
+ * to receive.
+ *
+ * A notification matches the filter when its event type matches one of the
+ * event type patterns, it belongs to the user ID and it is of the class given
+ * to the filter. The class \c system selects the system notifications and any
+ * other class the application notifications, the same way the notification
+ * manager decides the type of a notification. The event type patterns may
+ * contain the wildcards \c *, \c ? and \c [...]. An empty list of event
+ * types, a zero user ID and an empty class match every notification. Notification groups carry no user ID, so they are
+ * either all wanted or not wanted at all.
+ *
+ * The patterns are compiled when the filter is created. Event types without
+ * wildcards are looked up from a set, so matching a notification does not
+ * depend on the number of plain event type names in the filter.
+ */
+class NotificationSinkFilter
+{
+public:
+    /*!
+     * Creates a filter that matches every notification and group.
+     */
+    NotificationSinkFilter();
+
+    /*!
+     * Creates a filter.
+     *
+     * \param eventTypes the event types of the wanted notifications. May contain wildcards. An empty list matches every event type.
+     * \param userId the user ID of the wanted notifications or 0 for every user ID
+     * \param notificationClass the class of the wanted notifications or an empty string for every class
+     * \param groups whether notification groups are wanted
+     */
+    NotificationSinkFilter(const QStringList &eventTypes, uint userId, const QString &notificationClass, bool groups);
+
+    /*!
+     * Returns whether a notification matches the filter.
+     *
+     * \param notification the notification to check
+     * \return \c true if the notification is wanted, \c false otherwise
+     */
+    bool matches(const Notification &notification) const;
+
+    /*!
+     * Returns whether every notification matches the filter.
+     *
+     * \return \c true if the filter lets every notification through, \c false otherwise
+     */
+    bool matchesAllNotifications() const;
+
+    /*!
+     * Returns whether notification groups are wanted.
+     *
+     * \return \c true if notification groups are wanted, \c false otherwise
+     */
+    bool acceptsGroups() const;
+
+private:
+    //! Returns whether the given event type matches one of the event type patterns
+    bool matchesEventType(const QString &eventType) const;
+
+    //! Whether every event type is wanted
+    bool anyEventType;
+
+    //! The wanted event types that contain no wildcards
+    QSet<QString> eventTypeNames;
+
+    //! The wanted event types that contain wildcards
+    QList<QRegExp> eventTypePatterns;
+
+    //! The wanted user ID or 0 for every user ID
+    uint userId;
+
+    //! Whether notifications of every class are wanted
+    bool anyClass;
+
+    //! The type of the wanted notifications when not every class is wanted
+    Notification::NotificationType notificationType;
+
+    //! Whether notification groups are wanted
+    bool groups;
+};
+
+#endif /* NOTIFICATIONSINKFILTER_H_ */
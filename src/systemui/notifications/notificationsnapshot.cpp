@@ -0,0 +1,372 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include "notificationsnapshot.h"
+#include "genericnotificationparameterfactory.h"
+#include <QFile>
+#include <QDataStream>
+#include <QHash>
+#include <QtEndian>
+#include <QtAlgorithms>
+#include <climits>
+
+const quint32 NotificationSnapshot::Magic = 0x4d4e5353;
+const quint32 NotificationSnapshot::Version = 1;
+
+//! Size of the file header: magic, version, string count and notification count
+static const qint64 FILE_HEADER_SIZE = 16;
+
+//! Size of a notification header
+static const qint64 NOTIFICATION_HEADER_SIZE = 32;
+
+//! Offsets of the fields in a notification header
+static const int HEADER_NOTIFICATION_ID = 0;
+static const int HEADER_GROUP_ID = 4;
+static const int HEADER_USER_ID = 8;
+static const int HEADER_TIMEOUT = 12;
+static const int HEADER_TYPE = 16;
+static const int HEADER_FLAGS = 17;
+static const int HEADER_EVENT_TYPE = 20;
+static const int HEADER_PAYLOAD_OFFSET = 24;
+static const int HEADER_PAYLOAD_SIZE = 28;
+
+//! String table index denoting a missing string
+static const quint32 NO_STRING = 0xffffffff;
+
+//! Orders notifications by their IDs
+static bool notificationIdLessThan(const Notification &notification1, const Notification &notification2)
+{
+    return notification1.notificationId() < notification2.notificationId();
+}
+
+//! Returns the index of a string in the string table being built, adding the string if necessary
+static quint32 stringIndex(const QString &string, QHash<QString, quint32> &stringIndexes, QList<QString> &strings)
+{
+    QHash<QString, quint32>::const_iterator i = stringIndexes.constFind(string);
+    if (i != stringIndexes.constEnd()) {
+        return *i;
+    }
+
+    quint32 index = strings.count();
+    stringIndexes.insert(string, index);
+    strings.append(string);
+    return index;
+}
+
+NotificationSnapshot::NotificationSnapshot() :
+    file(NULL),
+    mappedData(NULL),
+    data(NULL),
+    size(0),
+    notificationCount(0),
+    stringCount(0),
+    stringOffsetsOffset(0),
+    stringDataOffset(0),
+    headersOffset(0),
+    payloadsOffset(0)
+{
+}
+
+NotificationSnapshot::~NotificationSnapshot()
+{
+    close();
+}
+
+bool NotificationSnapshot::open(const QString &fileName)
+{
+    close();
+
+    file = new QFile(fileName);
+    if (!file->open(QIODevice::ReadOnly)) {
+        close();
+        return false;
+    }
+
+    qint64 fileSize = file->size();
+    if (fileSize == 0) {
+        // An empty file is an empty snapshot
+        close();
+        return true;
+    }
+
+    mappedData = file->map(0, fileSize);
+    if (mappedData != NULL && parse(mappedData, fileSize)) {
+        return true;
+    }
+
+    // Not a snapshot in the current format or the file can't be mapped: read the whole file instead
+    QByteArray fileData = mappedData != NULL ? QByteArray(reinterpret_cast<const char *>(mappedData), fileSize) : file->readAll();
+    return load(fileData);
+}
+
+bool NotificationSnapshot::load(const QByteArray &snapshotData)
+{
+    close();
+
+    loadedData = snapshotData;
+    if (parse(reinterpret_cast<const uchar *>(loadedData.constData()), loadedData.size())) {
+        return true;
+    }
+
+    return parseLegacy(loadedData);
+}
+
+void NotificationSnapshot::close()
+{
+    if (file != NULL) {
+        if (mappedData != NULL) {
+            file->unmap(mappedData);
+        }
+        delete file;
+    }
+    file = NULL;
+    mappedData = NULL;
+    loadedData.clear();
+    data = NULL;
+    size = 0;
+    notificationCount = 0;
+    stringCount = 0;
+    strings.clear();
+    decodedStrings.clear();
+    legacyNotifications.clear();
+}
+
+bool NotificationSnapshot::parse(const uchar *snapshotData, qint64 snapshotSize)
+{
+    if (snapshotSize < FILE_HEADER_SIZE || qFromBigEndian<quint32>(snapshotData) != Magic || qFromBigEndian<quint32>(snapshotData + 4) != Version) {
+        return false;
+    }
+
+    quint32 stringTableSize = qFromBigEndian<quint32>(snapshotData + 8);
+    quint32 notifications = qFromBigEndian<quint32>(snapshotData + 12);
+
+    // The last entry of the string offset table is the size of the string data
+    qint64 offsetsOffset = FILE_HEADER_SIZE;
+    qint64 dataOffset = offsetsOffset + (qint64(stringTableSize) + 1) * 4;
+    if (dataOffset > snapshotSize) {
+        return false;
+    }
+    qint64 headers = dataOffset + qFromBigEndian<quint32>(snapshotData + offsetsOffset + qint64(stringTableSize) * 4);
+    qint64 payloads = headers + qint64(notifications) * NOTIFICATION_HEADER_SIZE;
+    if (payloads > snapshotSize || notifications > INT_MAX) {
+        return false;
+    }
+
+    data = snapshotData;
+    size = snapshotSize;
+    notificationCount = notifications;
+    stringCount = stringTableSize;
+    stringOffsetsOffset = offsetsOffset;
+    stringDataOffset = dataOffset;
+    headersOffset = headers;
+    payloadsOffset = payloads;
+    strings.resize(stringCount);
+    decodedStrings.resize(stringCount);
+    return true;
+}
+
+bool NotificationSnapshot::parseLegacy(const QByteArray &snapshotData)
+{
+    QDataStream stream(snapshotData);
+    while (!stream.atEnd()) {
+        Notification notification;
+        stream >> notification;
+        if (stream.status() != QDataStream::Ok) {
+            break;
+        }
+        legacyNotifications.append(notification);
+    }
+
+    qSort(legacyNotifications.begin(), legacyNotifications.end(), notificationIdLessThan);
+    notificationCount = legacyNotifications.count();
+    return stream.status() == QDataStream::Ok || notificationCount > 0;
+}
+
+int NotificationSnapshot::count() const
+{
+    return notificationCount;
+}
+
+const uchar *NotificationSnapshot::header(int index) const
+{
+    return data + headersOffset + index * NOTIFICATION_HEADER_SIZE;
+}
+
+uint NotificationSnapshot::notificationId(int index) const
+{
+    if (data == NULL) {
+        return legacyNotifications.at(index).notificationId();
+    }
+    return qFromBigEndian<quint32>(header(index) + HEADER_NOTIFICATION_ID);
+}
+
+uint NotificationSnapshot::groupId(int index) const
+{
+    if (data == NULL) {
+        return legacyNotifications.at(index).groupId();
+    }
+    return qFromBigEndian<quint32>(header(index) + HEADER_GROUP_ID);
+}
+
+QString NotificationSnapshot::eventType(int index) const
+{
+    if (data == NULL) {
+        return legacyNotifications.at(index).parameters().value(GenericNotificationParameterFactory::eventTypeKey()).toString();
+    }
+    return string(qFromBigEndian<quint32>(header(index) + HEADER_EVENT_TYPE));
+}
+
+QVariant NotificationSnapshot::persistent(int index) const
+{
+    if (data == NULL) {
+        return legacyNotifications.at(index).parameters().value(GenericNotificationParameterFactory::persistentKey());
+    }
+
+    quint8 flags = header(index)[HEADER_FLAGS];
+    return (flags & HasPersistentFlag) ? QVariant(bool(flags & PersistentFlag)) : QVariant();
+}
+
+Notification NotificationSnapshot::notification(int index) const
+{
+    if (data == NULL) {
+        return legacyNotifications.at(index);
+    }
+
+    const uchar *notificationHeader = header(index);
+    quint32 payloadOffset = qFromBigEndian<quint32>(notificationHeader + HEADER_PAYLOAD_OFFSET);
+    quint32 payloadSize = qFromBigEndian<quint32>(notificationHeader + HEADER_PAYLOAD_SIZE);
+
+    NotificationParameters parameters;
+    if (payloadsOffset + payloadOffset + payloadSize <= size) {
+        // The payload is read in place without copying it
+        QByteArray payload = QByteArray::fromRawData(reinterpret_cast<const char *>(data + payloadsOffset + payloadOffset), payloadSize);
+        QDataStream stream(payload);
+
+        quint32 parameterCount = 0;
+        stream >> parameterCount;
+        for (quint32 i = 0; i < parameterCount && stream.status() == QDataStream::Ok; ++i) {
+            quint32 key;
+            quint8 kind;
+            stream >> key >> kind;
+            if (kind == StringValue) {
+                quint32 value;
+                stream >> value;
+                parameters.add(string(key), string(value));
+            } else {
+                QVariant value;
+                stream >> value;
+                parameters.add(string(key), value);
+            }
+        }
+    }
+
+    return Notification(qFromBigEndian<quint32>(notificationHeader + HEADER_NOTIFICATION_ID),
+                        qFromBigEndian<quint32>(notificationHeader + HEADER_GROUP_ID),
+                        qFromBigEndian<quint32>(notificationHeader + HEADER_USER_ID),
+                        parameters,
+                        static_cast<Notification::NotificationType>(notificationHeader[HEADER_TYPE]),
+                        qFromBigEndian<qint32>(notificationHeader + HEADER_TIMEOUT));
+}
+
+QString NotificationSnapshot::string(quint32 index) const
+{
+    if (index >= stringCount) {
+        return QString();
+    }
+
+    if (!decodedStrings.testBit(index)) {
+        const uchar *offsets = data + stringOffsetsOffset + index * 4;
+        quint32 begin = qFromBigEndian<quint32>(offsets);
+        quint32 end = qFromBigEndian<quint32>(offsets + 4);
+        if (begin <= end && stringDataOffset + end <= headersOffset) {
+            strings[index] = QString::fromUtf8(reinterpret_cast<const char *>(data + stringDataOffset + begin), end - begin);
+        }
+        decodedStrings.setBit(index);
+    }
+
+    // The decoded strings are implicitly shared by all notifications referring to them
+    return strings.at(index);
+}
+
+QByteArray NotificationSnapshot::serialize(const QList<Notification> &notifications)
+{
+    QList<Notification> sortedNotifications = notifications;
+    qSort(sortedNotifications.begin(), sortedNotifications.end(), notificationIdLessThan);
+
+    QHash<QString, quint32> stringIndexes;
+    QList<QString> strings;
+
+    QByteArray headers;
+    QDataStream headerStream(&headers, QIODevice::WriteOnly);
+    QByteArray payloads;
+    QDataStream payloadStream(&payloads, QIODevice::WriteOnly);
+
+    foreach (const Notification &notification, sortedNotifications) {
+        // The event type parameters are not stored: they are applied again when the notifications are restored
+        NotificationParameters parameters(notification.parameters().overrides());
+
+        quint32 payloadOffset = payloads.size();
+        QList<QString> keys = parameters.keys();
+        payloadStream << quint32(keys.count());
+        foreach (const QString &key, keys) {
+            QVariant value = parameters.value(key);
+            payloadStream << stringIndex(key, stringIndexes, strings);
+            if (value.type() == QVariant::String) {
+                payloadStream << quint8(StringValue) << stringIndex(value.toString(), stringIndexes, strings);
+            } else {
+                payloadStream << quint8(VariantValue) << value;
+            }
+        }
+
+        quint8 flags = 0;
+        QVariant persistent = parameters.value(GenericNotificationParameterFactory::persistentKey());
+        if (persistent.isValid()) {
+            flags |= HasPersistentFlag;
+            if (persistent.toBool()) {
+                flags |= PersistentFlag;
+            }
+        }
+
+        QVariant eventType = parameters.value(GenericNotificationParameterFactory::eventTypeKey());
+        quint32 eventTypeIndex = eventType.isValid() ? stringIndex(eventType.toString(), stringIndexes, strings) : NO_STRING;
+
+        headerStream << quint32(notification.notificationId()) << quint32(notification.groupId()) << quint32(notification.userId()) << qint32(notification.timeout());
+        headerStream << quint8(notification.type()) << flags << quint16(0);
+        headerStream << eventTypeIndex << payloadOffset << quint32(payloads.size() - payloadOffset);
+    }
+
+    QByteArray stringData;
+    QList<quint32> stringOffsets;
+    foreach (const QString &string, strings) {
+        stringOffsets.append(stringData.size());
+        stringData.append(string.toUtf8());
+    }
+    stringOffsets.append(stringData.size());
+
+    QByteArray snapshot;
+    QDataStream stream(&snapshot, QIODevice::WriteOnly);
+    stream << Magic << Version << quint32(strings.count()) << quint32(sortedNotifications.count());
+    foreach (quint32 offset, stringOffsets) {
+        stream << offset;
+    }
+    stream.writeRawData(stringData.constData(), stringData.size());
+    stream.writeRawData(headers.constData(), headers.size());
+    stream.writeRawData(payloads.constData(), payloads.size());
+    return snapshot;
+}
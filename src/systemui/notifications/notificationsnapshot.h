@@ -0,0 +1,206 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef NOTIFICATIONSNAPSHOT_H_
+#define NOTIFICATIONSNAPSHOT_H_
+
+#include "notification.h"
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QBitArray>
+#include <QList>
+
+class QFile;
+
+/*!
+ * A read-only view of the notifications in a snapshot of the notification store.
+ *
+ * The snapshot is stored in a versioned binary format designed to be memory
+ * mapped. All integers are stored in big endian byte order.
+ *
+ * - A file header: magic number, format version, number of strings and number of notifications
+ * - A string table: the offsets of the strings followed by the UTF-8 encoded strings.
+ *   Every string appearing in the snapshot (parameter names and string values) is stored only once.
+ * - A fixed-size header for each notification, sorted by notification ID:
+ *   notification ID, group ID, user ID, timeout, type, flags, the event type as
+ *   a string table index and the offset and size of the notification parameters
+ * - The parameters of each notification referring to the string table
+ *
+ * Opening a snapshot only validates the file header. The notification headers
+ * can be read without decoding any parameters, so deciding which
+ * notifications to restore is cheap. The parameters of a notification are
+ * decoded only when the notification is requested, and each string is decoded
+ * only once so the restored notifications share the memory of the strings
+ * they have in common.
+ *
+ * Snapshots written by earlier versions (a plain QDataStream of notifications)
+ * are still read, although they are parsed in full when opened.
+ */
+class NotificationSnapshot
+{
+public:
+    //! The magic number identifying a notification snapshot
+    static const quint32 Magic;
+
+    //! The version of the format written by serialize()
+    static const quint32 Version;
+
+    /*!
+     * Creates an empty snapshot.
+     */
+    NotificationSnapshot();
+
+    /*!
+     * Destroys the NotificationSnapshot. Unmaps the snapshot file.
+     */
+    virtual ~NotificationSnapshot();
+
+    /*!
+     * Maps the given snapshot file into memory.
+     *
+     * \param fileName the name of the snapshot file
+     * \return \c true if the file could be opened and contains a valid snapshot, \c false otherwise
+     */
+    bool open(const QString &fileName);
+
+    /*!
+     * Uses the given serialized snapshot.
+     *
+     * \param data the serialized snapshot
+     * \return \c true if the data contains a valid snapshot, \c false otherwise
+     */
+    bool load(const QByteArray &data);
+
+    /*!
+     * Closes the snapshot. The snapshot is empty afterwards.
+     */
+    void close();
+
+    //! Returns the number of notifications in the snapshot
+    int count() const;
+
+    //! Returns the ID of the notification at the given index
+    uint notificationId(int index) const;
+
+    //! Returns the group ID of the notification at the given index
+    uint groupId(int index) const;
+
+    //! Returns the event type of the notification at the given index
+    QString eventType(int index) const;
+
+    /*!
+     * Returns the value of the persistent parameter of the notification at
+     * the given index without decoding the rest of the parameters.
+     *
+     * \param index the index of the notification
+     * \return the value of the persistent parameter or an invalid QVariant if the notification doesn't have one
+     */
+    QVariant persistent(int index) const;
+
+    /*!
+     * Decodes the notification at the given index.
+     *
+     * \param index the index of the notification
+     * \return the notification
+     */
+    Notification notification(int index) const;
+
+    /*!
+     * Serializes the given notifications into a snapshot.
+     *
+     * \param notifications the notifications to serialize
+     * \return the serialized snapshot
+     */
+    static QByteArray serialize(const QList<Notification> &notifications);
+
+private:
+    //! Flags stored in the notification headers
+    enum HeaderFlag {
+        HasPersistentFlag = 0x01,
+        PersistentFlag = 0x02
+    };
+
+    //! Kinds of parameter values stored in the payloads
+    enum ValueKind {
+        StringValue,
+        VariantValue
+    };
+
+    //! Sets up the snapshot from the serialized data. Returns \c false if the data is not a valid snapshot.
+    bool parse(const uchar *data, qint64 size);
+
+    //! Reads a snapshot written by an earlier version
+    bool parseLegacy(const QByteArray &data);
+
+    //! Returns a pointer to the header of the notification at the given index
+    const uchar *header(int index) const;
+
+    //! Returns the string at the given index of the string table, decoding it on first use
+    QString string(quint32 index) const;
+
+    //! The file the snapshot is mapped from
+    QFile *file;
+
+    //! The mapped snapshot file, or NULL if the file is not mapped
+    uchar *mappedData;
+
+    //! Snapshot data given to load(), kept so that the data stays valid
+    QByteArray loadedData;
+
+    //! The snapshot data
+    const uchar *data;
+
+    //! The size of the snapshot data in bytes
+    qint64 size;
+
+    //! The number of notifications in the snapshot
+    int notificationCount;
+
+    //! The number of strings in the string table
+    quint32 stringCount;
+
+    //! Offset of the string offset table
+    qint64 stringOffsetsOffset;
+
+    //! Offset of the UTF-8 string data
+    qint64 stringDataOffset;
+
+    //! Offset of the notification headers
+    qint64 headersOffset;
+
+    //! Offset of the notification parameters
+    qint64 payloadsOffset;
+
+    //! Strings decoded so far
+    mutable QVector<QString> strings;
+
+    //! Which strings have been decoded
+    mutable QBitArray decodedStrings;
+
+    //! Notifications read from a snapshot written by an earlier version
+    QList<Notification> legacyNotifications;
+
+#ifdef UNIT_TEST
+    friend class Ut_NotificationSnapshot;
+#endif
+};
+
+#endif /* NOTIFICATIONSNAPSHOT_H_ */
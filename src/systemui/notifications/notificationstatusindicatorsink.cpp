@@ -19,6 +19,7 @@
 
 #include "notificationstatusindicatorsink.h"
 #include <notificationwidgetparameterfactory.h>
+#include <genericnotificationparameterfactory.h>
 #include <notificationmanagerinterface.h>
 
 NotificationStatusIndicatorSink::NotificationStatusIndicatorSink(QObject *parent) :
@@ -44,7 +45,7 @@ void NotificationStatusIndicatorSink::addNotification(const Notification &notifi
         int notificationId = notification.notificationId();
         int groupId = notification.groupId();
         QString iconId = notification.parameters().value("statusAreaIconId").toString();
-        int priority = notification.parameters().value("priority").toInt();
+        int priority = notification.priority();
 
         if (iconId.isEmpty()) {
             iconId = "icon-s-status-notifier";
@@ -81,7 +82,7 @@ void NotificationStatusIndicatorSink::removeNotification(uint notificationId)
 void NotificationStatusIndicatorSink::addGroup(uint groupId, const NotificationParameters &parameters)
 {
     QString iconId = parameters.value("statusAreaIconId").toString();
-    int priority = parameters.value("priority").toInt();
+    int priority = parameters.value(GenericNotificationParameterFactory::priorityKey()).toInt();
 
     if (iconId.isEmpty()) {
         iconId = "icon-s-status-notifier";
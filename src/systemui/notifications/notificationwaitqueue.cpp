@@ -0,0 +1,94 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include "notificationwaitqueue.h"
+
+NotificationWaitQueue::NotificationWaitQueue() :
+    nextSequenceNumber(0)
+{
+}
+
+NotificationWaitQueue::~NotificationWaitQueue()
+{
+}
+
+void NotificationWaitQueue::enqueue(const Notification &notification, int priority)
+{
+    remove(notification.notificationId());
+
+    Entry entry;
+    entry.position = Position(priority, nextSequenceNumber++);
+    entry.notification = notification;
+    order.insert(entry.position, notification.notificationId());
+    entries.insert(notification.notificationId(), entry);
+}
+
+Notification NotificationWaitQueue::dequeue()
+{
+    Q_ASSERT(!order.isEmpty());
+
+    QMap<Position, uint>::iterator first = order.begin();
+    Notification notification = entries.take(first.value()).notification;
+    order.erase(first);
+    return notification;
+}
+
+bool NotificationWaitQueue::updateParameters(uint notificationId, const NotificationParameters &parameters)
+{
+    QHash<uint, Entry>::iterator entry = entries.find(notificationId);
+    if (entry == entries.end()) {
+        return false;
+    }
+
+    entry->notification.updateParameters(parameters);
+    return true;
+}
+
+bool NotificationWaitQueue::remove(uint notificationId)
+{
+    QHash<uint, Entry>::iterator entry = entries.find(notificationId);
+    if (entry == entries.end()) {
+        return false;
+    }
+
+    order.remove(entry->position);
+    entries.erase(entry);
+    return true;
+}
+
+bool NotificationWaitQueue::contains(uint notificationId) const
+{
+    return entries.contains(notificationId);
+}
+
+int NotificationWaitQueue::size() const
+{
+    return entries.size();
+}
+
+bool NotificationWaitQueue::isEmpty() const
+{
+    return entries.isEmpty();
+}
+
+void NotificationWaitQueue::clear()
+{
+    order.clear();
+    entries.clear();
+}
@@ -0,0 +1,127 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef NOTIFICATIONWAITQUEUE_H_
+#define NOTIFICATIONWAITQUEUE_H_
+
+#include "notification.h"
+
+#include <QMap>
+#include <QHash>
+#include <QPair>
+
+/*!
+ * A priority queue of notifications waiting for their turn to be relayed to the sinks.
+ *
+ * Notifications are ordered by their priority and, within the same priority,
+ * by their arrival order. Any number of priorities can be used; a smaller
+ * value means a higher priority. The queue is indexed by notification ID so
+ * queued notifications can be updated in constant time and cancelled in
+ * logarithmic time. Enqueueing and dequeueing take logarithmic time.
+ */
+class NotificationWaitQueue
+{
+public:
+    /*!
+     * Creates a new empty NotificationWaitQueue.
+     */
+    NotificationWaitQueue();
+
+    /*!
+     * Destroys the NotificationWaitQueue.
+     */
+    virtual ~NotificationWaitQueue();
+
+    /*!
+     * Adds a notification to the queue after all queued notifications with the
+     * same or a higher priority. If a notification with the same ID is already
+     * queued it is replaced and moved to its new position.
+     *
+     * \param notification the notification to add
+     * \param priority the priority of the notification. Smaller values are dequeued first.
+     */
+    void enqueue(const Notification &notification, int priority);
+
+    /*!
+     * Removes the notification with the highest priority from the queue and
+     * returns it. The queue must not be empty.
+     *
+     * \return the notification with the highest priority
+     */
+    Notification dequeue();
+
+    /*!
+     * Updates the parameters of a queued notification without changing its position in the queue.
+     *
+     * \param notificationId the ID of the notification to update
+     * \param parameters the parameters to update the notification with
+     * \return \c true if the notification was in the queue, \c false otherwise
+     */
+    bool updateParameters(uint notificationId, const NotificationParameters &parameters);
+
+    /*!
+     * Removes a notification from the queue.
+     *
+     * \param notificationId the ID of the notification to remove
+     * \return \c true if the notification was in the queue, \c false otherwise
+     */
+    bool remove(uint notificationId);
+
+    /*!
+     * Returns whether a notification is in the queue.
+     *
+     * \param notificationId the ID of the notification
+     * \return \c true if the notification is in the queue, \c false otherwise
+     */
+    bool contains(uint notificationId) const;
+
+    //! Returns the number of notifications in the queue
+    int size() const;
+
+    //! Returns \c true if the queue is empty, \c false otherwise
+    bool isEmpty() const;
+
+    //! Removes all notifications from the queue
+    void clear();
+
+private:
+    //! Position of a notification in the queue: priority and arrival order
+    typedef QPair<int, quint64> Position;
+
+    //! A queued notification and its position in the queue
+    struct Entry {
+        Position position;
+        Notification notification;
+    };
+
+    //! IDs of the queued notifications ordered by their positions
+    QMap<Position, uint> order;
+
+    //! The queued notifications keyed by their IDs
+    QHash<uint, Entry> entries;
+
+    //! Arrival order of the next notification
+    quint64 nextSequenceNumber;
+
+#ifdef UNIT_TEST
+    friend class Ut_NotificationWaitQueue;
+#endif
+};
+
+#endif /* NOTIFICATIONWAITQUEUE_H_ */
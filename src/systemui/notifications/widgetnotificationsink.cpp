@@ -81,13 +81,6 @@ MBanner *WidgetNotificationSink::createInfoBanner(Notification::NotificationType
     return infoBanner;
 }
 
-bool WidgetNotificationSink::containsText(const Notification &notification)
-{
-    return !(infoBannerTitleText(notification.parameters()).isEmpty()
-             && infoBannerGenericText(notification.parameters()).isEmpty()
-             && infoBannerSubtitleText(notification.parameters()).isEmpty());
-}
-
 void WidgetNotificationSink::updateTitles(MBanner *infoBanner)
 {
     if (privacySetting != NULL && privacySetting->value().toBool()) {
@@ -19,16 +19,20 @@
 
 #include "notificationarea.h"
 #include "notificationareasink.h"
+#include "notificationsinkdispatcher.h"
 #include "notificationmanagerinterface.h"
 #include <MBanner>
+#include <QSet>
 
 NotificationArea::NotificationArea(QGraphicsItem *parent, bool notificationsClickable) :
     MWidgetController(new NotificationAreaModel, parent),
-    notificationAreaSink(new NotificationAreaSink)
+    notificationAreaSink(new NotificationAreaSink),
+    notificationSinkDispatcher(NULL)
 {
     // Connect notification signals
     notificationAreaSink->setNotificationsClickable(notificationsClickable);
     connect(notificationAreaSink, SIGNAL(addNotification(MBanner &)), this, SLOT(addNotification(MBanner &)));
+    connect(notificationAreaSink, SIGNAL(addNotifications(const QList<MBanner *> &)), this, SLOT(addNotifications(const QList<MBanner *> &)));
     connect(notificationAreaSink, SIGNAL(removeNotification(MBanner &)), this, SLOT(removeNotification(MBanner &)));
     connect(notificationAreaSink, SIGNAL(notificationAddedToGroup(MBanner &)), this, SLOT(moveNotificationToTop(MBanner &)));
     connect(notificationAreaSink, SIGNAL(bannerClicked()), this, SIGNAL(bannerClicked()));
@@ -38,17 +42,18 @@ NotificationArea::NotificationArea(QGraphicsItem *parent, bool notificationsClic
 
 NotificationArea::~NotificationArea()
 {
+    delete notificationSinkDispatcher;
     delete notificationAreaSink;
 }
 
 void NotificationArea::setNotificationManagerInterface(NotificationManagerInterface &notificationManagerInterface)
 {
     QObject *notificationManager = notificationManagerInterface.qObject();
-    connect(notificationManager, SIGNAL(groupUpdated(uint, const NotificationParameters &)), notificationAreaSink, SLOT(addGroup(uint, const NotificationParameters &)));
-    connect(notificationManager, SIGNAL(groupRemoved(uint)), notificationAreaSink, SLOT(removeGroup(uint)));
-    connect(notificationManager, SIGNAL(notificationRemoved(uint)), notificationAreaSink, SLOT(removeNotification(uint)));
-    connect(notificationManager, SIGNAL(notificationRestored(const Notification &)), notificationAreaSink, SLOT(addNotification(const Notification &)));
-    connect(notificationManager, SIGNAL(notificationUpdated(const Notification &)), notificationAreaSink, SLOT(addNotification(const Notification &)));
+
+    // Building the banners is heavy, so the changes are delivered on the next event loop iteration
+    delete notificationSinkDispatcher;
+    notificationSinkDispatcher = new NotificationSinkDispatcher(notificationManager);
+    notificationSinkDispatcher->addSink(notificationAreaSink, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::AllChanges);
     connect(notificationAreaSink, SIGNAL(notificationRemovalRequested(uint)), notificationManager, SLOT(removeNotification(uint)));
     connect(notificationAreaSink, SIGNAL(notificationGroupClearingRequested(uint)), notificationManager, SLOT(removeNotificationsInGroup(uint)));
     notificationAreaSink->updateCurrentNotifications(notificationManagerInterface);
@@ -71,6 +76,23 @@ void NotificationArea::addNotification(MBanner &notification)
     model()->setBanners(banners);
 }
 
+void NotificationArea::addNotifications(const QList<MBanner *> &notifications)
+{
+    // Put the notifications into the model of the notification area in one go so that it is laid out only once
+    QList<MBanner *> banners;
+    for (int i = notifications.count() - 1; i >= 0; --i) {
+        banners.append(notifications.at(i));
+    }
+
+    QSet<MBanner *> addedBanners = notifications.toSet();
+    foreach (MBanner *banner, model()->banners()) {
+        if (!addedBanners.contains(banner)) {
+            banners.append(banner);
+        }
+    }
+    model()->setBanners(banners);
+}
+
 void NotificationArea::removeNotification(MBanner &notification)
 {
     // Remove the notification from the model of the notification area
@@ -26,6 +26,7 @@
 
 class NotificationManagerInterface;
 class NotificationAreaSink;
+class NotificationSinkDispatcher;
 class MBanner;
 
 /*!
@@ -88,6 +89,15 @@ private slots:
      */
     void addNotification(MBanner &notification);
 
+    /*!
+     * Adds several notifications to the notification area at once. Notifications
+     * that are already in the notification area are moved. The last notification
+     * goes topmost.
+     *
+     * \param notifications the MBanners to be added
+     */
+    void addNotifications(const QList<MBanner *> &notifications);
+
     /*!
      * Moves the banner to top. Called when relayouting is asked by notification area sink
      * when a notification/group is updated.
@@ -116,6 +126,9 @@ private:
     //! Notification sink for visualizing the notification on the notification area
     NotificationAreaSink *notificationAreaSink;
 
+    //! Delivers the changes of the notification manager to the notification area sink on the next event loop iteration
+    NotificationSinkDispatcher *notificationSinkDispatcher;
+
 #ifdef UNIT_TEST
     friend class Ut_NotificationArea;
 #endif
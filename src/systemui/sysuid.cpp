@@ -39,6 +39,7 @@
 #include "ngfnotificationsink.h"
 #include "contextframeworkcontext.h"
 #include "notificationstatusindicatorsink.h"
+#include "notificationsinkdispatcher.h"
 #include "closeeventeater.h"
 #include "diskspacenotifier.h"
 #include <QX11Info>
@@ -74,21 +75,15 @@ Sysuid::Sysuid(QObject* parent) : QObject(parent)
     mCompositorNotificationSink = new MCompositorNotificationSink;
     ngfNotificationSink = new NGFNotificationSink;
     notificationStatusIndicatorSink_ = new NotificationStatusIndicatorSink;
+    notificationSinkDispatcher = new NotificationSinkDispatcher(notificationManager, this);
 
-    // Connect the notification signals for the compositor notification sink
-    connect(notificationManager, SIGNAL(notificationUpdated(const Notification &)), mCompositorNotificationSink, SLOT(addNotification(const Notification &)));
-    connect(notificationManager, SIGNAL(notificationRemoved(uint)), mCompositorNotificationSink, SLOT(removeNotification(uint)));
-    connect(mCompositorNotificationSink, SIGNAL(notificationRemovalRequested(uint)), notificationManager, SLOT(removeNotification(uint)));
-
-    // Connect the notification signals for the feedback notification sink
-    connect(notificationManager, SIGNAL(notificationUpdated(const Notification &)), ngfNotificationSink, SLOT(addNotification(const Notification &)));
-    connect(notificationManager, SIGNAL(notificationRemoved(uint)), ngfNotificationSink, SLOT(removeNotification(uint)));
+    // The feedback and the notification status indicator are cheap to update and must react right away
+    notificationSinkDispatcher->addSink(ngfNotificationSink, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::NotificationAlerts);
+    notificationSinkDispatcher->addSink(notificationStatusIndicatorSink_, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::AllChanges);
 
-    // Connect the notification signals for the notification status indicator sink
-    connect(notificationManager, SIGNAL(notificationUpdated(const Notification &)), notificationStatusIndicatorSink_, SLOT(addNotification(const Notification &)));
-    connect(notificationManager, SIGNAL(notificationRemoved(uint)), notificationStatusIndicatorSink_, SLOT(removeNotification(uint)));
-    connect(notificationManager, SIGNAL(notificationRestored(const Notification &)), notificationStatusIndicatorSink_, SLOT(addNotification(const Notification &)));
-    connect(notificationManager, SIGNAL(groupUpdated(uint, const NotificationParameters &)), notificationStatusIndicatorSink_, SLOT(addGroup(uint, const NotificationParameters &)));
+    // Creating the banners is heavy, so the compositor notification sink is updated on the next event loop iteration
+    notificationSinkDispatcher->addSink(mCompositorNotificationSink, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::NotificationAlerts);
+    connect(mCompositorNotificationSink, SIGNAL(notificationRemovalRequested(uint)), notificationManager, SLOT(removeNotification(uint)));
 
     // Subscribe to a context property for getting information about the video recording status
     ContextFrameworkContext context;
@@ -158,6 +153,7 @@ Sysuid::Sysuid(QObject* parent) : QObject(parent)
 
 Sysuid::~Sysuid()
 {
+    delete notificationSinkDispatcher;
     delete notificationStatusIndicatorSink_;
     delete ngfNotificationSink;
     delete mCompositorNotificationSink;
@@ -40,6 +40,7 @@ class MCompositorNotificationSink;
 class NGFNotificationSink;
 class UnlockNotificationSink;
 class NotificationStatusIndicatorSink;
+class NotificationSinkDispatcher;
 class ScreenLockBusinessLogic;
 class VolumeBarLogic;
 class MApplicationExtensionArea;
@@ -111,6 +112,9 @@ private:
     //! Notification sink for the notification status indicator
     NotificationStatusIndicatorSink *notificationStatusIndicatorSink_;
 
+    //! Dispatches the changes of the notification manager to the notification sinks
+    NotificationSinkDispatcher *notificationSinkDispatcher;
+
     //! The lock screen business logic
     ScreenLockBusinessLogic *screenLockBusinessLogic;
 
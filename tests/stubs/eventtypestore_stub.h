@@ -27,7 +27,7 @@
 // FIXME - stubgen is not yet finished
 class EventTypeStoreStub : public StubBase {
   public:
-  virtual void EventTypeStoreConstructor(const QString &eventTypesPath, uint maxStoredEventTypes);
+  virtual void EventTypeStoreConstructor(const QString &eventTypesPath, uint maxStoredEventTypes, const QString &tableFileName);
   virtual bool eventTypeExists(const QString &eventType) const;
   virtual QList<QString> allKeys(const QString &eventType) const;
   virtual bool contains(const QString &eventType, const QString &key) const;
@@ -35,10 +35,11 @@ class EventTypeStoreStub : public StubBase {
 };
 
 // 2. IMPLEMENT STUB
-void EventTypeStoreStub::EventTypeStoreConstructor(const QString &eventTypesPath, uint maxStoredEventTypes)
+void EventTypeStoreStub::EventTypeStoreConstructor(const QString &eventTypesPath, uint maxStoredEventTypes, const QString &tableFileName)
 {
     Q_UNUSED(eventTypesPath);
     Q_UNUSED(maxStoredEventTypes);
+    Q_UNUSED(tableFileName);
 
 }
 
@@ -82,9 +83,9 @@ EventTypeStoreStub *gEventTypeStoreStub = &gDefaultEventTypeStoreStub;
 
 
 // 4. CREATE A PROXY WHICH CALLS THE STUB
-EventTypeStore::EventTypeStore(const QString &eventTypesPath, uint maxStoredEventTypes)
+EventTypeStore::EventTypeStore(const QString &eventTypesPath, uint maxStoredEventTypes, const QString &tableFileName)
 {
-    gEventTypeStoreStub->EventTypeStoreConstructor(eventTypesPath, maxStoredEventTypes);
+    gEventTypeStoreStub->EventTypeStoreConstructor(eventTypesPath, maxStoredEventTypes, tableFileName);
 }
 
 bool EventTypeStore::eventTypeExists(const QString &eventType) const
@@ -107,15 +108,11 @@ QString EventTypeStore::value(const QString &eventType, const QString &key) cons
     return gEventTypeStoreStub->value(eventType, key);
 }
 
-void EventTypeStore::loadSettings(const QString&)
-{
-}
-
 void EventTypeStore::updateEventTypeFileList()
 {
 }
 
-void EventTypeStore::updateEventTypeFile(const QString&)
+void EventTypeStore::scheduleUpdate()
 {
 }
 
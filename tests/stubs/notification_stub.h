@@ -38,6 +38,10 @@ public:
     virtual void setParameters(const NotificationParameters &parameters);
     virtual Notification::NotificationType type() const;
     virtual int timeout() const;
+    virtual bool isPersistent() const;
+    virtual bool hasText() const;
+    virtual int priority() const;
+    virtual QString feedbackId() const;
 };
 
 
@@ -92,6 +96,26 @@ int NotificationStub::timeout() const {
     return stubReturnValue<int>("timeout");
 }
 
+bool NotificationStub::isPersistent() const {
+    stubMethodEntered("isPersistent");
+    return stubReturnValue<bool>("isPersistent");
+}
+
+bool NotificationStub::hasText() const {
+    stubMethodEntered("hasText");
+    return stubReturnValue<bool>("hasText");
+}
+
+int NotificationStub::priority() const {
+    stubMethodEntered("priority");
+    return stubReturnValue<int>("priority");
+}
+
+QString NotificationStub::feedbackId() const {
+    stubMethodEntered("feedbackId");
+    return stubReturnValue<QString>("feedbackId");
+}
+
 // 3. CREATE A STUB INSTANCE
 NotificationStub gDefaultNotificationStub;
 NotificationStub* gNotificationStub = &gDefaultNotificationStub;
@@ -141,6 +165,22 @@ int Notification::timeout() const {
     return gNotificationStub->timeout();
 }
 
+bool Notification::isPersistent() const {
+    return gNotificationStub->isPersistent();
+}
+
+bool Notification::hasText() const {
+    return gNotificationStub->hasText();
+}
+
+int Notification::priority() const {
+    return gNotificationStub->priority();
+}
+
+QString Notification::feedbackId() const {
+    return gNotificationStub->feedbackId();
+}
+
 QDBusArgument &operator<<(QDBusArgument &argument, const Notification &)
 {
     return argument;
@@ -29,6 +29,7 @@ public:
     virtual void notificationAreaConstructor(NotificationArea *notificationArea, QGraphicsItem *parent, bool notificationsClickable);
     virtual void notificationAreaDestructor();
     virtual void addNotification(MBanner &notification);
+    virtual void addNotifications(const QList<MBanner *> &notifications);
     virtual void moveNotificationToTop(MBanner &notification);
     virtual void removeNotification(MBanner &notification);
     virtual void removeAllRemovableBanners();
@@ -57,6 +58,13 @@ void NotificationAreaStub::addNotification(MBanner &notification)
     stubMethodEntered("addNotification", params);
 }
 
+void NotificationAreaStub::addNotifications(const QList<MBanner *> &notifications)
+{
+    QList<ParameterBase *> params;
+    params.append(new Parameter<QList<MBanner *> >(notifications));
+    stubMethodEntered("addNotifications", params);
+}
+
 void NotificationAreaStub::moveNotificationToTop(MBanner &notification)
 {
     QList<ParameterBase *> params;
@@ -108,6 +116,11 @@ void NotificationArea::addNotification(MBanner &notification)
     gNotificationAreaStub->addNotification(notification);
 }
 
+void NotificationArea::addNotifications(const QList<MBanner *> &notifications)
+{
+    gNotificationAreaStub->addNotifications(notifications);
+}
+
 void NotificationArea::moveNotificationToTop(MBanner &notification)
 {
     gNotificationAreaStub->moveNotificationToTop(notification);
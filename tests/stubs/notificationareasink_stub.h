@@ -33,6 +33,7 @@ public:
     virtual void addGroup(uint groupId, const NotificationParameters &parameters);
     virtual void removeGroup(uint groupId);
     virtual void addNotification(const Notification &notification);
+    virtual void addNotifications(const QList<Notification> &notifications);
     virtual void removeNotification(uint notificationId);
     virtual void addNotification(MBanner &notification);
     virtual void removeNotification(MBanner &notification);
@@ -74,6 +75,13 @@ void NotificationAreaSinkStub::addNotification(const Notification &notification)
     stubMethodEntered("addNotification", params);
 }
 
+void NotificationAreaSinkStub::addNotifications(const QList<Notification> &notifications)
+{
+    QList<ParameterBase *> params;
+    params.append(new Parameter<QList<Notification> >(notifications));
+    stubMethodEntered("addNotifications", params);
+}
+
 void NotificationAreaSinkStub::removeNotification(uint notificationId)
 {
     QList<ParameterBase *> params;
@@ -164,6 +172,11 @@ void NotificationAreaSink::addNotification(const Notification &notification)
     gNotificationAreaSinkStub->addNotification(notification);
 }
 
+void NotificationAreaSink::addNotifications(const QList<Notification> &notifications)
+{
+    gNotificationAreaSinkStub->addNotifications(notifications);
+}
+
 void NotificationAreaSink::removeNotification(uint notificationId)
 {
     gNotificationAreaSinkStub->removeNotification(notificationId);
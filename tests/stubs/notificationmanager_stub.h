@@ -45,23 +45,51 @@ class NotificationManagerStub : public StubBase {
   virtual bool removeNotificationsInGroup(uint groupId);
   virtual void removeNotificationsAndGroupsWithEventType(const QString &eventType);
   virtual void updateNotificationsAndGroupsWithEventType(const QString &eventType);
+  virtual void updateNotificationsAndGroupsWithEventTypes(const QStringList &eventTypes);
   virtual void relayNextNotification();
   virtual Notification::NotificationType determineType(const NotificationParameters &parameters);
   virtual void submitNotification(const Notification &notification);
-  virtual int findNotificationFromWaitQueue(uint notificationId);
+  virtual void relayNotificationUpdate(const Notification &notification);
+  virtual void relayNotificationAlert(const Notification &notification);
+  virtual void beginTransaction();
+  virtual void commitTransaction();
+  virtual QList<uint> addNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications);
+  virtual bool updateNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications);
+  virtual bool removeNotifications(uint notificationUserId, const QList<uint> &notificationIds);
+  virtual uint addOrUpdateNotification(uint notificationUserId, uint groupId, const QString &identifier, const NotificationParameters &parameters);
+  virtual bool removeNotificationsWithIdentifier(uint notificationUserId, const QString &identifier);
+  virtual uint addOrUpdateGroup(uint notificationUserId, const QString &identifier, const NotificationParameters &parameters);
+  virtual bool removeGroupsWithIdentifier(uint notificationUserId, const QString &identifier);
+  virtual void doRemoveNotifications(const QList<uint> &notificationIds);
+  virtual int relayPriority(const Notification &notification);
   virtual uint nextAvailableNotificationID();
   virtual uint nextAvailableGroupID();
   virtual void initializeNotificationUserIdDataStore();
   virtual void initializeEventTypeStore();
   virtual bool ensurePersistentDataPath();
-  virtual void saveStateData();
-  virtual void saveNotifications();
   virtual QList<Notification> notifications();
   virtual QList<NotificationGroup> groups();
   virtual void doRemoveGroup(uint groupId);
   virtual uint notificationCountInGroup(uint notificationUserId, uint groupId);
-  virtual bool isPersistent(const NotificationParameters &parameters);
+  virtual QList<Notification> queryNotifications(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit);
+  virtual uint queryNotificationCount(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp);
+  virtual QList<NotificationGroup> queryGroups(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit);
+  virtual uint queryGroupCount(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp);
+  virtual quint64 changeSequence();
+  virtual bool changesKnownSince(quint64 sequence);
+  virtual QList<NotificationGroup> groupsChangedSince(quint64 sequence);
+  virtual QList<Notification> notificationsChangedSince(quint64 sequence);
+  virtual QList<uint> groupIdsRemovedSince(quint64 sequence);
+  virtual QList<uint> notificationIdsRemovedSince(quint64 sequence);
+  virtual bool isPersistent(const QVariant &persistentVariant, const QString &eventType);
   virtual void initializeStore();
+  virtual void compactStore();
+  virtual void scheduleCompactionIfNeeded();
+  virtual void flushPersistentData();
+  virtual void indexNotification(const Notification &notification);
+  virtual void unindexNotification(const Notification &notification);
+  virtual void indexGroup(const NotificationGroup &group);
+  virtual void unindexGroup(const NotificationGroup &group);
 };
 
 // 2. IMPLEMENT STUB
@@ -198,6 +226,12 @@ void NotificationManagerStub::updateNotificationsAndGroupsWithEventType(const QS
   stubMethodEntered("updateNotificationsAndGroupsWithEventType",params);
 }
 
+void NotificationManagerStub::updateNotificationsAndGroupsWithEventTypes(const QStringList &eventTypes) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<const QStringList & >(eventTypes));
+  stubMethodEntered("updateNotificationsAndGroupsWithEventTypes",params);
+}
+
 void NotificationManagerStub::relayNextNotification() {
   stubMethodEntered("relayNextNotification");
 }
@@ -215,11 +249,96 @@ void NotificationManagerStub::submitNotification(const Notification &notificatio
   stubMethodEntered("submitNotification",params);
 }
 
-int NotificationManagerStub::findNotificationFromWaitQueue(uint notificationId) {
+void NotificationManagerStub::relayNotificationUpdate(const Notification &notification) {
   QList<ParameterBase*> params;
-  params.append( new Parameter<uint >(notificationId));
-  stubMethodEntered("findNotificationFromWaitQueue",params);
-  return stubReturnValue<int>("findNotificationFromWaitQueue");
+  params.append( new Parameter<const Notification & >(notification));
+  stubMethodEntered("relayNotificationUpdate",params);
+}
+
+void NotificationManagerStub::relayNotificationAlert(const Notification &notification) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<const Notification & >(notification));
+  stubMethodEntered("relayNotificationAlert",params);
+}
+
+void NotificationManagerStub::beginTransaction() {
+  stubMethodEntered("beginTransaction");
+}
+
+void NotificationManagerStub::commitTransaction() {
+  stubMethodEntered("commitTransaction");
+}
+
+QList<uint> NotificationManagerStub::addNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<uint >(notificationUserId));
+  params.append( new Parameter<QList<QPair<uint, NotificationParameters> > >(notifications));
+  stubMethodEntered("addNotifications",params);
+  return stubReturnValue<QList<uint> >("addNotifications");
+}
+
+bool NotificationManagerStub::updateNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<uint >(notificationUserId));
+  params.append( new Parameter<QList<QPair<uint, NotificationParameters> > >(notifications));
+  stubMethodEntered("updateNotifications",params);
+  return stubReturnValue<bool>("updateNotifications");
+}
+
+bool NotificationManagerStub::removeNotifications(uint notificationUserId, const QList<uint> &notificationIds) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<uint >(notificationUserId));
+  params.append( new Parameter<QList<uint> >(notificationIds));
+  stubMethodEntered("removeNotifications",params);
+  return stubReturnValue<bool>("removeNotifications");
+}
+
+uint NotificationManagerStub::addOrUpdateNotification(uint notificationUserId, uint groupId, const QString &identifier, const NotificationParameters &parameters) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<uint >(notificationUserId));
+  params.append( new Parameter<uint >(groupId));
+  params.append( new Parameter<QString >(identifier));
+  params.append( new Parameter<NotificationParameters >(parameters));
+  stubMethodEntered("addOrUpdateNotification",params);
+  return stubReturnValue<uint>("addOrUpdateNotification");
+}
+
+bool NotificationManagerStub::removeNotificationsWithIdentifier(uint notificationUserId, const QString &identifier) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<uint >(notificationUserId));
+  params.append( new Parameter<QString >(identifier));
+  stubMethodEntered("removeNotificationsWithIdentifier",params);
+  return stubReturnValue<bool>("removeNotificationsWithIdentifier");
+}
+
+uint NotificationManagerStub::addOrUpdateGroup(uint notificationUserId, const QString &identifier, const NotificationParameters &parameters) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<uint >(notificationUserId));
+  params.append( new Parameter<QString >(identifier));
+  params.append( new Parameter<NotificationParameters >(parameters));
+  stubMethodEntered("addOrUpdateGroup",params);
+  return stubReturnValue<uint>("addOrUpdateGroup");
+}
+
+bool NotificationManagerStub::removeGroupsWithIdentifier(uint notificationUserId, const QString &identifier) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<uint >(notificationUserId));
+  params.append( new Parameter<QString >(identifier));
+  stubMethodEntered("removeGroupsWithIdentifier",params);
+  return stubReturnValue<bool>("removeGroupsWithIdentifier");
+}
+
+void NotificationManagerStub::doRemoveNotifications(const QList<uint> &notificationIds) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<QList<uint> >(notificationIds));
+  stubMethodEntered("doRemoveNotifications",params);
+}
+
+int NotificationManagerStub::relayPriority(const Notification &notification) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<const Notification & >(notification));
+  stubMethodEntered("relayPriority",params);
+  return stubReturnValue<int>("relayPriority");
 }
 
 uint NotificationManagerStub::nextAvailableNotificationID() {
@@ -245,14 +364,6 @@ bool NotificationManagerStub::ensurePersistentDataPath() {
   return stubReturnValue<bool>("ensurePersistentDataPath");
 }
 
-void NotificationManagerStub::saveStateData() {
-  stubMethodEntered("saveStateData");
-}
-
-void NotificationManagerStub::saveNotifications() {
-  stubMethodEntered("saveNotifications");
-}
-
 QList<Notification> NotificationManagerStub::notifications()
 {
     stubMethodEntered("notifications");
@@ -281,10 +392,107 @@ uint NotificationManagerStub::notificationCountInGroup(uint notificationUserId,
     return stubReturnValue<uint>("notificationCountInGroup");
 }
 
-bool NotificationManagerStub::isPersistent(const NotificationParameters &parameters)
+QList<Notification> NotificationManagerStub::queryNotifications(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<uint>(notificationUserId));
+    params.append(new Parameter<QString>(eventType));
+    params.append(new Parameter<uint>(groupId));
+    params.append(new Parameter<QString>(identifier));
+    params.append(new Parameter<uint>(sinceTimestamp));
+    params.append(new Parameter<uint>(lastId));
+    params.append(new Parameter<uint>(limit));
+    stubMethodEntered("queryNotifications", params);
+    return stubReturnValue<QList<Notification> >("queryNotifications");
+}
+
+uint NotificationManagerStub::queryNotificationCount(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<uint>(notificationUserId));
+    params.append(new Parameter<QString>(eventType));
+    params.append(new Parameter<uint>(groupId));
+    params.append(new Parameter<QString>(identifier));
+    params.append(new Parameter<uint>(sinceTimestamp));
+    stubMethodEntered("queryNotificationCount", params);
+    return stubReturnValue<uint>("queryNotificationCount");
+}
+
+QList<NotificationGroup> NotificationManagerStub::queryGroups(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<uint>(notificationUserId));
+    params.append(new Parameter<QString>(eventType));
+    params.append(new Parameter<QString>(identifier));
+    params.append(new Parameter<uint>(sinceTimestamp));
+    params.append(new Parameter<uint>(lastId));
+    params.append(new Parameter<uint>(limit));
+    stubMethodEntered("queryGroups", params);
+    return stubReturnValue<QList<NotificationGroup> >("queryGroups");
+}
+
+uint NotificationManagerStub::queryGroupCount(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<uint>(notificationUserId));
+    params.append(new Parameter<QString>(eventType));
+    params.append(new Parameter<QString>(identifier));
+    params.append(new Parameter<uint>(sinceTimestamp));
+    stubMethodEntered("queryGroupCount", params);
+    return stubReturnValue<uint>("queryGroupCount");
+}
+
+quint64 NotificationManagerStub::changeSequence()
+{
+    stubMethodEntered("changeSequence");
+    return stubReturnValue<quint64>("changeSequence");
+}
+
+bool NotificationManagerStub::changesKnownSince(quint64 sequence)
 {
     QList<ParameterBase*> params;
-    params.append( new Parameter<const NotificationParameters & >(parameters));
+    params.append(new Parameter<quint64>(sequence));
+    stubMethodEntered("changesKnownSince", params);
+    return stubReturnValue<bool>("changesKnownSince");
+}
+
+QList<NotificationGroup> NotificationManagerStub::groupsChangedSince(quint64 sequence)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<quint64>(sequence));
+    stubMethodEntered("groupsChangedSince", params);
+    return stubReturnValue<QList<NotificationGroup> >("groupsChangedSince");
+}
+
+QList<Notification> NotificationManagerStub::notificationsChangedSince(quint64 sequence)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<quint64>(sequence));
+    stubMethodEntered("notificationsChangedSince", params);
+    return stubReturnValue<QList<Notification> >("notificationsChangedSince");
+}
+
+QList<uint> NotificationManagerStub::groupIdsRemovedSince(quint64 sequence)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<quint64>(sequence));
+    stubMethodEntered("groupIdsRemovedSince", params);
+    return stubReturnValue<QList<uint> >("groupIdsRemovedSince");
+}
+
+QList<uint> NotificationManagerStub::notificationIdsRemovedSince(quint64 sequence)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<quint64>(sequence));
+    stubMethodEntered("notificationIdsRemovedSince", params);
+    return stubReturnValue<QList<uint> >("notificationIdsRemovedSince");
+}
+
+bool NotificationManagerStub::isPersistent(const QVariant &persistentVariant, const QString &eventType)
+{
+    QList<ParameterBase*> params;
+    params.append( new Parameter<QVariant >(persistentVariant));
+    params.append( new Parameter<QString >(eventType));
     stubMethodEntered("isPersistent", params);
     return stubReturnValue<bool>("isPersistent");
 }
@@ -294,6 +502,49 @@ void NotificationManagerStub::initializeStore()
     stubMethodEntered("initializeStore");
 }
 
+void NotificationManagerStub::compactStore()
+{
+    stubMethodEntered("compactStore");
+}
+
+void NotificationManagerStub::scheduleCompactionIfNeeded()
+{
+    stubMethodEntered("scheduleCompactionIfNeeded");
+}
+
+void NotificationManagerStub::flushPersistentData()
+{
+    stubMethodEntered("flushPersistentData");
+}
+
+void NotificationManagerStub::indexNotification(const Notification &notification)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<const Notification & >(notification));
+    stubMethodEntered("indexNotification", params);
+}
+
+void NotificationManagerStub::unindexNotification(const Notification &notification)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<const Notification & >(notification));
+    stubMethodEntered("unindexNotification", params);
+}
+
+void NotificationManagerStub::indexGroup(const NotificationGroup &group)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<const NotificationGroup & >(group));
+    stubMethodEntered("indexGroup", params);
+}
+
+void NotificationManagerStub::unindexGroup(const NotificationGroup &group)
+{
+    QList<ParameterBase*> params;
+    params.append(new Parameter<const NotificationGroup & >(group));
+    stubMethodEntered("unindexGroup", params);
+}
+
 // 3. CREATE A STUB INSTANCE
 NotificationManagerStub gDefaultNotificationManagerStub;
 NotificationManagerStub* gNotificationManagerStub = &gDefaultNotificationManagerStub;
@@ -376,6 +627,10 @@ void NotificationManager::updateNotificationsAndGroupsWithEventType(const QStrin
   gNotificationManagerStub->updateNotificationsAndGroupsWithEventType(eventType);
 }
 
+void NotificationManager::updateNotificationsAndGroupsWithEventTypes(const QStringList &eventTypes) {
+  gNotificationManagerStub->updateNotificationsAndGroupsWithEventTypes(eventTypes);
+}
+
 void NotificationManager::relayNextNotification() {
   gNotificationManagerStub->relayNextNotification();
 }
@@ -388,8 +643,56 @@ void NotificationManager::submitNotification(const Notification &notification) {
   gNotificationManagerStub->submitNotification(notification);
 }
 
-int NotificationManager::findNotificationFromWaitQueue(uint notificationId) {
-  return gNotificationManagerStub->findNotificationFromWaitQueue(notificationId);
+void NotificationManager::relayNotificationUpdate(const Notification &notification) {
+  gNotificationManagerStub->relayNotificationUpdate(notification);
+}
+
+void NotificationManager::relayNotificationAlert(const Notification &notification) {
+  gNotificationManagerStub->relayNotificationAlert(notification);
+}
+
+void NotificationManager::beginTransaction() {
+  gNotificationManagerStub->beginTransaction();
+}
+
+void NotificationManager::commitTransaction() {
+  gNotificationManagerStub->commitTransaction();
+}
+
+QList<uint> NotificationManager::addNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications) {
+  return gNotificationManagerStub->addNotifications(notificationUserId, notifications);
+}
+
+bool NotificationManager::updateNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications) {
+  return gNotificationManagerStub->updateNotifications(notificationUserId, notifications);
+}
+
+bool NotificationManager::removeNotifications(uint notificationUserId, const QList<uint> &notificationIds) {
+  return gNotificationManagerStub->removeNotifications(notificationUserId, notificationIds);
+}
+
+uint NotificationManager::addOrUpdateNotification(uint notificationUserId, uint groupId, const QString &identifier, const NotificationParameters &parameters) {
+  return gNotificationManagerStub->addOrUpdateNotification(notificationUserId, groupId, identifier, parameters);
+}
+
+bool NotificationManager::removeNotificationsWithIdentifier(uint notificationUserId, const QString &identifier) {
+  return gNotificationManagerStub->removeNotificationsWithIdentifier(notificationUserId, identifier);
+}
+
+uint NotificationManager::addOrUpdateGroup(uint notificationUserId, const QString &identifier, const NotificationParameters &parameters) {
+  return gNotificationManagerStub->addOrUpdateGroup(notificationUserId, identifier, parameters);
+}
+
+bool NotificationManager::removeGroupsWithIdentifier(uint notificationUserId, const QString &identifier) {
+  return gNotificationManagerStub->removeGroupsWithIdentifier(notificationUserId, identifier);
+}
+
+void NotificationManager::doRemoveNotifications(const QList<uint> &notificationIds) {
+  gNotificationManagerStub->doRemoveNotifications(notificationIds);
+}
+
+int NotificationManager::relayPriority(const Notification &notification) const {
+  return gNotificationManagerStub->relayPriority(notification);
 }
 
 uint NotificationManager::nextAvailableNotificationID() {
@@ -412,10 +715,6 @@ bool NotificationManager::ensurePersistentDataPath() {
   return gNotificationManagerStub->ensurePersistentDataPath();
 }
 
-void NotificationManager::saveStateData() {
-  gNotificationManagerStub->saveStateData();
-}
-
 QList<Notification> NotificationManager::notifications() const
 {
     return gNotificationManagerStub->notifications();
@@ -441,9 +740,59 @@ uint NotificationManager::notificationCountInGroup(uint notificationUserId, uint
     return gNotificationManagerStub->notificationCountInGroup(notificationUserId, groupId);
 }
 
-bool NotificationManager::isPersistent(const NotificationParameters &parameters)
+QList<Notification> NotificationManager::queryNotifications(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit)
 {
-    return gNotificationManagerStub->isPersistent(parameters);
+    return gNotificationManagerStub->queryNotifications(notificationUserId, eventType, groupId, identifier, sinceTimestamp, lastId, limit);
+}
+
+uint NotificationManager::queryNotificationCount(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp)
+{
+    return gNotificationManagerStub->queryNotificationCount(notificationUserId, eventType, groupId, identifier, sinceTimestamp);
+}
+
+QList<NotificationGroup> NotificationManager::queryGroups(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit)
+{
+    return gNotificationManagerStub->queryGroups(notificationUserId, eventType, identifier, sinceTimestamp, lastId, limit);
+}
+
+uint NotificationManager::queryGroupCount(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp)
+{
+    return gNotificationManagerStub->queryGroupCount(notificationUserId, eventType, identifier, sinceTimestamp);
+}
+
+quint64 NotificationManager::changeSequence() const
+{
+    return gNotificationManagerStub->changeSequence();
+}
+
+bool NotificationManager::changesKnownSince(quint64 sequence) const
+{
+    return gNotificationManagerStub->changesKnownSince(sequence);
+}
+
+QList<NotificationGroup> NotificationManager::groupsChangedSince(quint64 sequence) const
+{
+    return gNotificationManagerStub->groupsChangedSince(sequence);
+}
+
+QList<Notification> NotificationManager::notificationsChangedSince(quint64 sequence) const
+{
+    return gNotificationManagerStub->notificationsChangedSince(sequence);
+}
+
+QList<uint> NotificationManager::groupIdsRemovedSince(quint64 sequence) const
+{
+    return gNotificationManagerStub->groupIdsRemovedSince(sequence);
+}
+
+QList<uint> NotificationManager::notificationIdsRemovedSince(quint64 sequence) const
+{
+    return gNotificationManagerStub->notificationIdsRemovedSince(sequence);
+}
+
+bool NotificationManager::isPersistent(const QVariant &persistentVariant, const QString &eventType)
+{
+    return gNotificationManagerStub->isPersistent(persistentVariant, eventType);
 }
 
 void NotificationManager::initializeStore()
@@ -451,4 +800,39 @@ void NotificationManager::initializeStore()
     gNotificationManagerStub->initializeStore();
 }
 
+void NotificationManager::compactStore()
+{
+    gNotificationManagerStub->compactStore();
+}
+
+void NotificationManager::scheduleCompactionIfNeeded()
+{
+    gNotificationManagerStub->scheduleCompactionIfNeeded();
+}
+
+void NotificationManager::flushPersistentData()
+{
+    gNotificationManagerStub->flushPersistentData();
+}
+
+void NotificationManager::indexNotification(const Notification &notification)
+{
+    gNotificationManagerStub->indexNotification(notification);
+}
+
+void NotificationManager::unindexNotification(const Notification &notification)
+{
+    gNotificationManagerStub->unindexNotification(notification);
+}
+
+void NotificationManager::indexGroup(const NotificationGroup &group)
+{
+    gNotificationManagerStub->indexGroup(group);
+}
+
+void NotificationManager::unindexGroup(const NotificationGroup &group)
+{
+    gNotificationManagerStub->unindexGroup(group);
+}
+
 #endif
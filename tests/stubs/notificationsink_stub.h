@@ -34,6 +34,8 @@ public:
     virtual bool canAddNotification(const Notification &notification);
     void addNotification(const Notification &notification);
     void removeNotification(uint notificationId);
+    virtual void addNotifications(const QList<Notification> &notifications);
+    virtual void removeNotifications(const QList<uint> &notificationIds);
     virtual void addGroup(uint groupId, const NotificationParameters &parameters);
     virtual void removeGroup(uint groupId);
 };
@@ -64,6 +66,20 @@ bool NotificationSinkStub::canAddNotification(const Notification &notification)
     return stubReturnValue<bool>("canAddNotification");
 }
 
+void NotificationSinkStub::addNotifications(const QList<Notification> &notifications)
+{
+    QList<ParameterBase *> params;
+    params.append(new Parameter<QList<Notification> >(notifications));
+    stubMethodEntered("addNotifications", params);
+}
+
+void NotificationSinkStub::removeNotifications(const QList<uint> &notificationIds)
+{
+    QList<ParameterBase *> params;
+    params.append(new Parameter<QList<uint> >(notificationIds));
+    stubMethodEntered("removeNotifications", params);
+}
+
 void NotificationSinkStub::addGroup(uint groupId, const NotificationParameters &parameters)
 {
     QList<ParameterBase *> params;
@@ -107,6 +123,16 @@ bool NotificationSink::canAddNotification(const Notification &notification)
     return gNotificationSinkStub->canAddNotification(notification);
 }
 
+void NotificationSink::addNotifications(const QList<Notification> &notifications)
+{
+    gNotificationSinkStub->addNotifications(notifications);
+}
+
+void NotificationSink::removeNotifications(const QList<uint> &notificationIds)
+{
+    gNotificationSinkStub->removeNotifications(notificationIds);
+}
+
 void NotificationSink::addGroup(uint groupId, const NotificationParameters &parameters)
 {
     gNotificationSinkStub->addGroup(groupId, parameters);
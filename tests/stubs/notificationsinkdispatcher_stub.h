@@ -0,0 +1,201 @@
+#ifndef NOTIFICATIONSINKDISPATCHER_STUB
+#define NOTIFICATIONSINKDISPATCHER_STUB
+
+#include "notificationsinkdispatcher.h"
+#include <stubbase.h>
+
+
+// 1. DECLARE STUB
+// FIXME - stubgen is not yet finished
+class NotificationSinkDispatcherStub : public StubBase {
+  public:
+  virtual void NotificationSinkDispatcherConstructor(QObject *notificationManager, QObject *parent);
+  virtual void NotificationSinkDispatcherDestructor();
+  virtual void addSink(NotificationSink *sink, NotificationSinkDispatcher::LatencyClass latencyClass, NotificationSinkDispatcher::Subscriptions subscriptions);
+  virtual void removeSink(NotificationSink *sink);
+  virtual int latestLatency(const NotificationSink *sink) const;
+  virtual int maximumLatency(const NotificationSink *sink) const;
+  virtual void updateNotification(const Notification &notification);
+  virtual void updateNotifications(const QList<Notification> &notifications);
+  virtual void removeNotification(uint notificationId);
+  virtual void removeNotifications(const QList<uint> &notificationIds);
+  virtual void alertNotification(const Notification &notification);
+  virtual void updateGroup(uint groupId, const NotificationParameters &parameters);
+  virtual void removeGroup(uint groupId);
+  virtual void restoreNotifications(const QList<Notification> &notifications);
+  virtual void flush();
+  virtual void removeDestroyedSink(QObject *sink);
+};
+
+// 2. IMPLEMENT STUB
+void NotificationSinkDispatcherStub::NotificationSinkDispatcherConstructor(QObject *notificationManager, QObject *parent) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<QObject * >(notificationManager));
+  params.append( new Parameter<QObject * >(parent));
+  stubMethodEntered("NotificationSinkDispatcherConstructor",params);
+}
+void NotificationSinkDispatcherStub::NotificationSinkDispatcherDestructor() {
+
+}
+
+void NotificationSinkDispatcherStub::addSink(NotificationSink *sink, NotificationSinkDispatcher::LatencyClass latencyClass, NotificationSinkDispatcher::Subscriptions subscriptions) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<NotificationSink * >(sink));
+  params.append( new Parameter<NotificationSinkDispatcher::LatencyClass >(latencyClass));
+  params.append( new Parameter<NotificationSinkDispatcher::Subscriptions >(subscriptions));
+  stubMethodEntered("addSink",params);
+}
+
+void NotificationSinkDispatcherStub::removeSink(NotificationSink *sink) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<NotificationSink * >(sink));
+  stubMethodEntered("removeSink",params);
+}
+
+int NotificationSinkDispatcherStub::latestLatency(const NotificationSink *sink) const {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<const NotificationSink * >(sink));
+  stubMethodEntered("latestLatency",params);
+  return stubReturnValue<int>("latestLatency");
+}
+
+int NotificationSinkDispatcherStub::maximumLatency(const NotificationSink *sink) const {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<const NotificationSink * >(sink));
+  stubMethodEntered("maximumLatency",params);
+  return stubReturnValue<int>("maximumLatency");
+}
+
+void NotificationSinkDispatcherStub::updateNotification(const Notification &notification) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<const Notification & >(notification));
+  stubMethodEntered("updateNotification",params);
+}
+
+void NotificationSinkDispatcherStub::updateNotifications(const QList<Notification> &notifications) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<const QList<Notification> & >(notifications));
+  stubMethodEntered("updateNotifications",params);
+}
+
+void NotificationSinkDispatcherStub::removeNotification(uint notificationId) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<uint >(notificationId));
+  stubMethodEntered("removeNotification",params);
+}
+
+void NotificationSinkDispatcherStub::removeNotifications(const QList<uint> &notificationIds) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<const QList<uint> & >(notificationIds));
+  stubMethodEntered("removeNotifications",params);
+}
+
+void NotificationSinkDispatcherStub::alertNotification(const Notification &notification) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<const Notification & >(notification));
+  stubMethodEntered("alertNotification",params);
+}
+
+void NotificationSinkDispatcherStub::updateGroup(uint groupId, const NotificationParameters &parameters) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<uint >(groupId));
+  params.append( new Parameter<const NotificationParameters & >(parameters));
+  stubMethodEntered("updateGroup",params);
+}
+
+void NotificationSinkDispatcherStub::removeGroup(uint groupId) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<uint >(groupId));
+  stubMethodEntered("removeGroup",params);
+}
+
+void NotificationSinkDispatcherStub::restoreNotifications(const QList<Notification> &notifications) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<const QList<Notification> & >(notifications));
+  stubMethodEntered("restoreNotifications",params);
+}
+
+void NotificationSinkDispatcherStub::flush() {
+  stubMethodEntered("flush");
+}
+
+void NotificationSinkDispatcherStub::removeDestroyedSink(QObject *sink) {
+  QList<ParameterBase*> params;
+  params.append( new Parameter<QObject * >(sink));
+  stubMethodEntered("removeDestroyedSink",params);
+}
+
+
+
+// 3. CREATE A STUB INSTANCE
+NotificationSinkDispatcherStub gDefaultNotificationSinkDispatcherStub;
+NotificationSinkDispatcherStub* gNotificationSinkDispatcherStub = &gDefaultNotificationSinkDispatcherStub;
+
+
+// 4. CREATE A PROXY WHICH CALLS THE STUB
+NotificationSinkDispatcher::NotificationSinkDispatcher(QObject *notificationManager, QObject *parent) : QObject(parent) {
+  gNotificationSinkDispatcherStub->NotificationSinkDispatcherConstructor(notificationManager, parent);
+}
+
+NotificationSinkDispatcher::~NotificationSinkDispatcher() {
+  gNotificationSinkDispatcherStub->NotificationSinkDispatcherDestructor();
+}
+
+void NotificationSinkDispatcher::addSink(NotificationSink *sink, LatencyClass latencyClass, Subscriptions subscriptions) {
+  gNotificationSinkDispatcherStub->addSink(sink, latencyClass, subscriptions);
+}
+
+void NotificationSinkDispatcher::removeSink(NotificationSink *sink) {
+  gNotificationSinkDispatcherStub->removeSink(sink);
+}
+
+int NotificationSinkDispatcher::latestLatency(const NotificationSink *sink) const {
+  return gNotificationSinkDispatcherStub->latestLatency(sink);
+}
+
+int NotificationSinkDispatcher::maximumLatency(const NotificationSink *sink) const {
+  return gNotificationSinkDispatcherStub->maximumLatency(sink);
+}
+
+void NotificationSinkDispatcher::updateNotification(const Notification &notification) {
+  gNotificationSinkDispatcherStub->updateNotification(notification);
+}
+
+void NotificationSinkDispatcher::updateNotifications(const QList<Notification> &notifications) {
+  gNotificationSinkDispatcherStub->updateNotifications(notifications);
+}
+
+void NotificationSinkDispatcher::removeNotification(uint notificationId) {
+  gNotificationSinkDispatcherStub->removeNotification(notificationId);
+}
+
+void NotificationSinkDispatcher::removeNotifications(const QList<uint> &notificationIds) {
+  gNotificationSinkDispatcherStub->removeNotifications(notificationIds);
+}
+
+void NotificationSinkDispatcher::alertNotification(const Notification &notification) {
+  gNotificationSinkDispatcherStub->alertNotification(notification);
+}
+
+void NotificationSinkDispatcher::updateGroup(uint groupId, const NotificationParameters &parameters) {
+  gNotificationSinkDispatcherStub->updateGroup(groupId, parameters);
+}
+
+void NotificationSinkDispatcher::removeGroup(uint groupId) {
+  gNotificationSinkDispatcherStub->removeGroup(groupId);
+}
+
+void NotificationSinkDispatcher::restoreNotifications(const QList<Notification> &notifications) {
+  gNotificationSinkDispatcherStub->restoreNotifications(notifications);
+}
+
+void NotificationSinkDispatcher::flush() {
+  gNotificationSinkDispatcherStub->flush();
+}
+
+void NotificationSinkDispatcher::removeDestroyedSink(QObject *sink) {
+  gNotificationSinkDispatcherStub->removeDestroyedSink(sink);
+}
+
+
+#endif
@@ -20,6 +20,7 @@
 #include "ut_dbusinterfacenotificationsink.h"
 #include "dbusinterfacenotificationsink.h"
 #include "dbusinterfacenotificationsinkadaptor.h"
+#include "dbusinterfacenotificationsinkqueue.h"
 #include "genericnotificationparameterfactory.h"
 #include "notificationwidgetparameterfactory.h"
 #include "notification.h"
@@ -43,6 +44,20 @@ void DBusInterfaceNotificationSinkAdaptor::registerSink(QString const&, QString
 {
 }
 
+void DBusInterfaceNotificationSinkAdaptor::registerSinkWithFilter(QString const&, QString const&, QStringList const&, uint, QString const&, bool)
+{
+}
+
+qulonglong DBusInterfaceNotificationSinkAdaptor::registerSinkWithCursor(QString const&, QString const&, qulonglong, bool &)
+{
+    return 0;
+}
+
+qulonglong DBusInterfaceNotificationSinkAdaptor::cursor(QString const&, QString const&)
+{
+    return 0;
+}
+
 void DBusInterfaceNotificationSinkAdaptor::unregisterSink(QString const&, QString const&)
 {
 }
@@ -109,10 +124,14 @@ bool QDBusConnection::connect(const QString &service, const QString &path, const
 
 void Ut_DBusInterfaceNotificationSink::initTestCase()
 {
+    static int argc = 1;
+    static char *app_name = (char *)"./ut_dbusinterfacenotificationsink";
+    app = new QCoreApplication(argc, &app_name);
 }
 
 void Ut_DBusInterfaceNotificationSink::cleanupTestCase()
 {
+    delete app;
 }
 
 void Ut_DBusInterfaceNotificationSink::init()
@@ -144,6 +163,15 @@ void Ut_DBusInterfaceNotificationSink::cleanup()
     gAddNotificationProxies.clear();
     gNewSinkProxies.clear();
     gAddGroupProxies.clear();
+    gRemoveNotificationProxies.clear();
+    gRemoveGroupProxies.clear();
+}
+
+void Ut_DBusInterfaceNotificationSink::flushQueues()
+{
+    foreach (const QSharedPointer<DBusInterfaceNotificationSinkQueue> &queue, sink->queues) {
+        queue->flush();
+    }
 }
 
 void Ut_DBusInterfaceNotificationSink::testNothingCalledWhenNothingRegistered()
@@ -175,6 +203,7 @@ void Ut_DBusInterfaceNotificationSink::testProxyCalledWhenServiceRegistered()
     emit addGroup(0, np);
     emit removeNotification(0);
     emit removeGroup(0);
+    flushQueues();
 
     QCOMPARE(gAddNotificationProxies.count(), 1);
     QCOMPARE(gAddNotificationProxies.at(0), gNewSinkProxies.at(0));
@@ -216,6 +245,7 @@ void Ut_DBusInterfaceNotificationSink::testRegisteringSameServiceAndPathReplaces
     QCOMPARE(gNewSinkProxies.count(), 2);
 
     emit addNotification(n);
+    flushQueues();
 
     QCOMPARE(gAddNotificationProxies.count(), 1);
     QCOMPARE(gAddNotificationProxies.at(0), gNewSinkProxies.at(1));
@@ -232,6 +262,7 @@ void Ut_DBusInterfaceNotificationSink::testRegisteringTwoDifferentServicesCallsB
     QCOMPARE(gNewSinkProxies.count(), 2);
 
     emit addNotification(n);
+    flushQueues();
     QCOMPARE(gAddNotificationProxies.count(), 2);
     QVERIFY(gAddNotificationProxies.contains(gNewSinkProxies.at(0)));
     QVERIFY(gAddNotificationProxies.contains(gNewSinkProxies.at(1)));
@@ -250,6 +281,7 @@ void Ut_DBusInterfaceNotificationSink::testUnregistering()
     sink->unregisterSink("service1", "path");
 
     emit addNotification(n);
+    flushQueues();
 
     QCOMPARE(gAddNotificationProxies.count(), 1);
     QCOMPARE(gAddNotificationProxies.at(0), gNewSinkProxies.at(1));
@@ -324,4 +356,279 @@ void Ut_DBusInterfaceNotificationSink::testManagerNotDefined()
     QCOMPARE(gNotificationManagerStub->stubCallCount("notifications"), 0);
 }
 
+void Ut_DBusInterfaceNotificationSink::testRegisteringWithKnownCursorSendsOnlyChanges()
+{
+    gNotificationManagerStub->stubSetReturnValue("changesKnownSince", true);
+    gNotificationManagerStub->stubSetReturnValue("groupsChangedSince", createGroups());
+    gNotificationManagerStub->stubSetReturnValue("notificationsChangedSince", createNotifications());
+    gNotificationManagerStub->stubSetReturnValue("groupIdsRemovedSince", QList<uint>() << 9);
+    gNotificationManagerStub->stubSetReturnValue("notificationIdsRemovedSince", QList<uint>() << 10 << 11);
+    gNotificationManagerStub->stubSetReturnValue("changeSequence", (quint64)42);
+
+    bool fullResync = true;
+    QCOMPARE(sink->registerSinkWithCursor("service1", "path", 40, fullResync), (quint64)42);
+
+    QVERIFY(!fullResync);
+    QCOMPARE(gNotificationManagerStub->stubLastCallTo("changesKnownSince").parameter<quint64>(0), (quint64)40);
+    QCOMPARE(gNotificationManagerStub->stubLastCallTo("notificationsChangedSince").parameter<quint64>(0), (quint64)40);
+    QCOMPARE(gNotificationManagerStub->stubCallCount("groups"), 0);
+    QCOMPARE(gNotificationManagerStub->stubCallCount("notifications"), 0);
+    QCOMPARE(gNewSinkProxies.count(), 1);
+    QCOMPARE(gAddGroupProxies.count(), 1);
+    // The system notification is not sent
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+    QCOMPARE(gRemoveGroupProxies.count(), 1);
+    QCOMPARE(gRemoveNotificationProxies.count(), 2);
+}
+
+void Ut_DBusInterfaceNotificationSink::testRegisteringWithUnknownCursorSendsEverything()
+{
+    gNotificationManagerStub->stubSetReturnValue("changesKnownSince", false);
+    gNotificationManagerStub->stubSetReturnValue("groups", createGroups());
+    gNotificationManagerStub->stubSetReturnValue("notifications", createNotifications());
+    gNotificationManagerStub->stubSetReturnValue("changeSequence", (quint64)42);
+
+    bool fullResync = false;
+    QCOMPARE(sink->registerSinkWithCursor("service1", "path", 1, fullResync), (quint64)42);
+
+    QVERIFY(fullResync);
+    QCOMPARE(gNotificationManagerStub->stubCallCount("notificationsChangedSince"), 0);
+    QCOMPARE(gNotificationManagerStub->stubCallCount("groups"), 1);
+    QCOMPARE(gNotificationManagerStub->stubCallCount("notifications"), 1);
+    QCOMPARE(gAddGroupProxies.count(), 1);
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+    QCOMPARE(gRemoveGroupProxies.count(), 0);
+    QCOMPARE(gRemoveNotificationProxies.count(), 0);
+}
+
+void Ut_DBusInterfaceNotificationSink::testCursorIsTheChangeSequence()
+{
+    gNotificationManagerStub->stubSetReturnValue("changeSequence", (quint64)42);
+    QCOMPARE(sink->cursor("service1", "path"), (quint64)0);
+    sink->registerSink("service1", "path");
+    QCOMPARE(sink->cursor("service1", "path"), (quint64)42);
+
+    delete sink;
+    sink = new DBusInterfaceNotificationSink(NULL);
+    bool fullResync = false;
+    sink->registerSinkWithCursor("service1", "path", 1, fullResync);
+    QVERIFY(fullResync);
+    QCOMPARE(sink->cursor("service1", "path"), (quint64)0);
+}
+
+void Ut_DBusInterfaceNotificationSink::testChangesAreSentOnNextEventLoopIteration()
+{
+    Notification n(1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0);
+    sink->registerSink("service1", "path");
+
+    emit addNotification(n);
+    QCOMPARE(gAddNotificationProxies.count(), 0);
+    QCOMPARE(sink->queueDepth("service1", "path"), 1);
+
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+    QCOMPARE(sink->queueDepth("service1", "path"), 0);
+}
+
+void Ut_DBusInterfaceNotificationSink::testQueuedChangesAreCoalesced()
+{
+    Notification n1(1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0);
+    Notification n2(2, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0);
+    NotificationParameters np;
+    sink->registerSink("service1", "path");
+
+    emit addGroup(1, np);
+    emit addNotification(n1);
+    emit addNotification(n2);
+    emit addGroup(1, np);
+    emit addNotification(n1);
+    emit removeNotification(2);
+    QCOMPARE(sink->queueDepth("service1", "path"), 3);
+    flushQueues();
+
+    // The updates are sent once and the removed notification is only removed
+    QCOMPARE(gAddGroupProxies.count(), 1);
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+    QCOMPARE(gRemoveNotificationProxies.count(), 1);
+    QCOMPARE(sink->queueDepth("service1", "path"), 0);
+    QCOMPARE(sink->peakQueueDepth("service1", "path"), 3);
+
+    // A notification added again after its removal is sent again
+    emit removeNotification(1);
+    emit addNotification(n1);
+    flushQueues();
+    QCOMPARE(gRemoveNotificationProxies.count(), 2);
+    QCOMPARE(gAddNotificationProxies.count(), 2);
+}
+
+void Ut_DBusInterfaceNotificationSink::testCallsWaitWhileTooManyArePending()
+{
+    Notification n(1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0);
+    sink->registerSink("service1", "path");
+    DBusInterfaceNotificationSinkQueue *queue = sink->queue("service1", "path");
+    queue->pendingCallCount_ = queue->maxPendingCalls;
+
+    emit addNotification(n);
+    flushQueues();
+    QCOMPARE(gAddNotificationProxies.count(), 0);
+    QCOMPARE(sink->pendingCallCount("service1", "path"), queue->maxPendingCalls);
+    QCOMPARE(sink->queueDepth("service1", "path"), 1);
+
+    queue->pendingCallCount_ = 0;
+    flushQueues();
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+}
+
+void Ut_DBusInterfaceNotificationSink::testSyncCallsWaitWhileTooManyArePending()
+{
+    sink->registerSink("service1", "path");
+    DBusInterfaceNotificationSinkQueue *queue = sink->queue("service1", "path");
+    queue->pendingCallCount_ = queue->maxPendingCalls;
+
+    // The calls that bring the sink up to date wait like any other call but are not dropped
+    gNotificationManagerStub->stubSetReturnValue("changeSequence", (quint64)42);
+    queue->beginSync(40);
+    for (int i = 0; i <= queue->maxQueueDepth; ++i) {
+        queue->addNotification(Notification(i + 1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    }
+    queue->endSync();
+    QCOMPARE(gAddNotificationProxies.count(), 0);
+    QCOMPARE(sink->queueDepth("service1", "path"), queue->maxQueueDepth + 1);
+    QCOMPARE(sink->dropCount("service1", "path"), (uint)0);
+    QCOMPARE(sink->cursor("service1", "path"), (quint64)40);
+
+    emit removeNotification(1);
+    QCOMPARE(sink->dropCount("service1", "path"), (uint)0);
+
+    queue->pendingCallCount_ = 0;
+    flushQueues();
+    QCOMPARE(gAddNotificationProxies.count(), queue->maxQueueDepth);
+    QCOMPARE(sink->queueDepth("service1", "path"), 0);
+    QCOMPARE(sink->cursor("service1", "path"), (quint64)42);
+}
+
+void Ut_DBusInterfaceNotificationSink::testQueueIsDroppedWhenSinkDoesNotKeepUp()
+{
+    gNotificationManagerStub->stubSetReturnValue("changeSequence", (quint64)7);
+    sink->registerSink("service1", "path");
+    DBusInterfaceNotificationSinkQueue *queue = sink->queue("service1", "path");
+    queue->pendingCallCount_ = queue->maxPendingCalls;
+    gNotificationManagerStub->stubSetReturnValue("changeSequence", (quint64)2000);
+
+    for (int i = 0; i <= queue->maxQueueDepth; ++i) {
+        emit addNotification(Notification(i + 1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    }
+    QCOMPARE(sink->dropCount("service1", "path"), (uint)1);
+    QCOMPARE(sink->queueDepth("service1", "path"), 0);
+    QCOMPARE(sink->cursor("service1", "path"), (quint64)7);
+
+    // Nothing is queued until the sink has been resynchronized
+    emit addNotification(Notification(1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    QCOMPARE(sink->queueDepth("service1", "path"), 0);
+
+    // Once the pending calls have been answered the missed changes are sent
+    gNotificationManagerStub->stubSetReturnValue("changesKnownSince", true);
+    gNotificationManagerStub->stubSetReturnValue("notificationsChangedSince", createNotifications());
+    queue->pendingCallCount_ = 0;
+    flushQueues();
+    QCOMPARE(gNotificationManagerStub->stubLastCallTo("changesKnownSince").parameter<quint64>(0), (quint64)7);
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+    QCOMPARE(sink->cursor("service1", "path"), (quint64)2000);
+}
+
+void Ut_DBusInterfaceNotificationSink::testSinksOfVanishedServiceAreUnregistered()
+{
+    Notification n(1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0);
+    sink->registerSink("service1", "path1");
+    sink->registerSink("service1", "path2");
+    sink->registerSink("service2", "path");
+    QCOMPARE(sink->serviceWatcher.watchedServices().toSet(), QSet<QString>() << "service1" << "service2");
+
+    sink->unregisterSinks("service1");
+    QCOMPARE(sink->serviceWatcher.watchedServices(), QStringList() << "service2");
+
+    emit addNotification(n);
+    flushQueues();
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+    QCOMPARE(gAddNotificationProxies.at(0), gNewSinkProxies.at(2));
+}
+
+void Ut_DBusInterfaceNotificationSink::testServiceIsNotWatchedAfterItsLastSinkIsUnregistered()
+{
+    sink->registerSink("service1", "path1");
+    sink->registerSink("service1", "path2");
+
+    sink->unregisterSink("service1", "path1");
+    QCOMPARE(sink->serviceWatcher.watchedServices(), QStringList() << "service1");
+
+    sink->unregisterSink("service1", "path2");
+    QVERIFY(sink->serviceWatcher.watchedServices().isEmpty());
+}
+
+static Notification createNotification(uint notificationId, uint userId, const QString &eventType)
+{
+    NotificationParameters parameters;
+    parameters.add(GenericNotificationParameterFactory::eventTypeKey(), eventType);
+    return Notification(notificationId, 0, userId, parameters, Notification::ApplicationEvent, 0);
+}
+
+void Ut_DBusInterfaceNotificationSink::testFilteredSinkIsSentOnlyMatchingNotifications()
+{
+    QList<Notification> notifications;
+    notifications << createNotification(1, 3, "email.arrived") << createNotification(2, 3, "sms.arrived") << createNotification(3, 4, "email.arrived");
+    gNotificationManagerStub->stubSetReturnValue("notifications", notifications);
+    gNotificationManagerStub->stubSetReturnValue("groups", createGroups());
+
+    sink->registerSinkWithFilter("service1", "path", QStringList() << "email.*", 3, QString(), false);
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+    QCOMPARE(gAddGroupProxies.count(), 0);
+
+    NotificationParameters np;
+    emit addNotification(createNotification(4, 3, "sms.arrived"));
+    emit addGroup(1, np);
+    emit removeGroup(1);
+    emit removeNotification(2);
+    QCOMPARE(sink->queueDepth("service1", "path"), 0);
+
+    emit removeNotification(1);
+    flushQueues();
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+    QCOMPARE(gAddGroupProxies.count(), 0);
+    QCOMPARE(gRemoveGroupProxies.count(), 0);
+    QCOMPARE(gRemoveNotificationProxies.count(), 1);
+}
+
+void Ut_DBusInterfaceNotificationSink::testNotificationNoLongerMatchingFilterIsRemoved()
+{
+    sink->registerSinkWithFilter("service1", "path", QStringList() << "email.arrived", 0, QString(), true);
+
+    emit addNotification(createNotification(5, 3, "email.arrived"));
+    flushQueues();
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+
+    emit addNotification(createNotification(5, 3, "sms.arrived"));
+    flushQueues();
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+    QCOMPARE(gRemoveNotificationProxies.count(), 1);
+
+    // The sink no longer has the notification, so its removal is not sent
+    emit removeNotification(5);
+    flushQueues();
+    QCOMPARE(gRemoveNotificationProxies.count(), 1);
+}
+
+void Ut_DBusInterfaceNotificationSink::testUnfilteredSinkIsSentEverything()
+{
+    NotificationParameters np;
+    sink->registerSinkWithFilter("service1", "path", QStringList(), 0, QString(), true);
+
+    emit addNotification(createNotification(5, 3, "sms.arrived"));
+    emit removeNotification(6);
+    emit addGroup(1, np);
+    flushQueues();
+    QCOMPARE(gAddNotificationProxies.count(), 1);
+    QCOMPARE(gRemoveNotificationProxies.count(), 1);
+    QCOMPARE(gAddGroupProxies.count(), 1);
+}
+
 QTEST_APPLESS_MAIN(Ut_DBusInterfaceNotificationSink)
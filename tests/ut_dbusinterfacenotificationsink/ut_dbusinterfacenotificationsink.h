@@ -27,6 +27,7 @@
 #include <QDBusPendingReply>
 
 class NotificationManager;
+class QCoreApplication;
 
 class DBusInterfaceNotificationSinkProxy: public QDBusAbstractInterface
 {
@@ -70,6 +71,19 @@ private slots:
     void testSendingGroupsToProxy();
     void testSendingNotificationsToProxy();
     void testManagerNotDefined();
+    void testRegisteringWithKnownCursorSendsOnlyChanges();
+    void testRegisteringWithUnknownCursorSendsEverything();
+    void testCursorIsTheChangeSequence();
+    void testChangesAreSentOnNextEventLoopIteration();
+    void testQueuedChangesAreCoalesced();
+    void testCallsWaitWhileTooManyArePending();
+    void testSyncCallsWaitWhileTooManyArePending();
+    void testQueueIsDroppedWhenSinkDoesNotKeepUp();
+    void testSinksOfVanishedServiceAreUnregistered();
+    void testServiceIsNotWatchedAfterItsLastSinkIsUnregistered();
+    void testFilteredSinkIsSentOnlyMatchingNotifications();
+    void testNotificationNoLongerMatchingFilterIsRemoved();
+    void testUnfilteredSinkIsSentEverything();
 
 signals:
     void addNotification(Notification n);
@@ -78,10 +92,15 @@ signals:
     void removeNotification(uint notificationId);
 
 private:
+    // Sends the calls queued for the registered sinks
+    void flushQueues();
+
     // The object being tested
     DBusInterfaceNotificationSink *sink;
     // Stubbed manager
     NotificationManager *manager;
+    // Delivers the queued flushes
+    QCoreApplication *app;
 };
 
 #endif
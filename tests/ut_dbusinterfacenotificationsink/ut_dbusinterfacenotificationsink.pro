@@ -9,6 +9,8 @@ QMAKE_CXXFLAGS += -fno-inline
 SOURCES += \
     ut_dbusinterfacenotificationsink.cpp \
     $$NOTIFICATIONSRCDIR/dbusinterfacenotificationsink.cpp \
+    $$NOTIFICATIONSRCDIR/dbusinterfacenotificationsinkqueue.cpp \
+    $$NOTIFICATIONSRCDIR/notificationsinkfilter.cpp \
     $$LIBNOTIFICATIONSRCDIR/notificationsink.cpp \
     $$LIBNOTIFICATIONSRCDIR/notificationparameters.cpp \
     $$LIBNOTIFICATIONSRCDIR/notificationparameter.cpp \
@@ -23,6 +25,8 @@ HEADERS += \
     ut_dbusinterfacenotificationsink.h \
     $$NOTIFICATIONSRCDIR/dbusinterfacenotificationsink.h \
     $$NOTIFICATIONSRCDIR/dbusinterfacenotificationsinkadaptor.h \
+    $$NOTIFICATIONSRCDIR/dbusinterfacenotificationsinkqueue.h \
+    $$NOTIFICATIONSRCDIR/notificationsinkfilter.h \
     $$LIBNOTIFICATIONSRCDIR/notificationparameters.h \
     $$LIBNOTIFICATIONSRCDIR/notificationparameter.h \
     $$LIBNOTIFICATIONSRCDIR/notification.h \
@@ -23,6 +23,16 @@
 #include "genericnotificationparameterfactory.h"
 #include "notificationwidgetparameterfactory.h"
 #include "notificationmanager_stub.h"
+#include <QDBusArgument>
+
+// Counts the heap allocations. Both operator new and the Qt containers allocate through malloc.
+static int allocationCount = 0;
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *malloc(size_t size)
+{
+    allocationCount++;
+    return __libc_malloc(size);
+}
 
 // DBusInterfaceNotificationSourceAdaptor stubs (used by NotificationManager)
 DBusInterfaceNotificationSourceAdaptor::DBusInterfaceNotificationSourceAdaptor(DBusInterfaceNotificationSource *parent) : QDBusAbstractAdaptor(parent)
@@ -120,27 +130,27 @@ QList<uint> DBusInterfaceNotificationSourceAdaptor::notificationIdList(uint noti
     return tmp;
 }
 
-QList < MNotificationProxy >  DBusInterfaceNotificationSourceAdaptor::notificationList(uint)
+MNotificationListProxy DBusInterfaceNotificationSourceAdaptor::notificationList(uint)
 {
-    QList<MNotificationProxy> l;
+    MNotificationListProxy l;
     return l;
 }
 
-QList < MNotificationWithIdentifierProxy>  DBusInterfaceNotificationSourceAdaptor::notificationListWithIdentifiers(uint)
+MNotificationWithIdentifierListProxy DBusInterfaceNotificationSourceAdaptor::notificationListWithIdentifiers(uint)
 {
-    QList<MNotificationWithIdentifierProxy> l;
+    MNotificationWithIdentifierListProxy l;
     return l;
 }
 
-QList<MNotificationGroupProxy> DBusInterfaceNotificationSourceAdaptor::notificationGroupList(uint)
+MNotificationGroupListProxy DBusInterfaceNotificationSourceAdaptor::notificationGroupList(uint)
 {
-    QList<MNotificationGroupProxy> l;
+    MNotificationGroupListProxy l;
     return l;
 }
 
-QList<MNotificationGroupWithIdentifierProxy> DBusInterfaceNotificationSourceAdaptor::notificationGroupListWithIdentifiers(uint)
+MNotificationGroupWithIdentifierListProxy DBusInterfaceNotificationSourceAdaptor::notificationGroupListWithIdentifiers(uint)
 {
-    QList<MNotificationGroupWithIdentifierProxy> l;
+    MNotificationGroupWithIdentifierListProxy l;
     return l;
 }
 
@@ -176,6 +186,61 @@ QList < MNotificationGroupProxyWithParameters>  DBusInterfaceNotificationSourceA
     return QList<MNotificationGroupProxyWithParameters>();
 }
 
+QList<uint> DBusInterfaceNotificationSourceAdaptor::addNotifications(uint, const QList<MNotificationBatchItemProxy> &)
+{
+    return QList<uint>();
+}
+
+bool DBusInterfaceNotificationSourceAdaptor::updateNotifications(uint, const QList<MNotificationBatchItemProxy> &)
+{
+    return true;
+}
+
+bool DBusInterfaceNotificationSourceAdaptor::removeNotifications(uint, const QList<uint> &)
+{
+    return true;
+}
+
+uint DBusInterfaceNotificationSourceAdaptor::addOrUpdateNotification(uint, uint, const QString &, NotificationParameters)
+{
+    return 1;
+}
+
+bool DBusInterfaceNotificationSourceAdaptor::removeNotificationsWithIdentifier(uint, const QString &)
+{
+    return true;
+}
+
+uint DBusInterfaceNotificationSourceAdaptor::addOrUpdateGroup(uint, const QString &, NotificationParameters)
+{
+    return 1;
+}
+
+bool DBusInterfaceNotificationSourceAdaptor::removeGroupsWithIdentifier(uint, const QString &)
+{
+    return true;
+}
+
+QList<MNotificationProxyWithParameters> DBusInterfaceNotificationSourceAdaptor::queryNotifications(uint, const QString &, uint, const QString &, uint, uint, uint)
+{
+    return QList<MNotificationProxyWithParameters>();
+}
+
+uint DBusInterfaceNotificationSourceAdaptor::queryNotificationCount(uint, const QString &, uint, const QString &, uint)
+{
+    return 0;
+}
+
+QList<MNotificationGroupProxyWithParameters> DBusInterfaceNotificationSourceAdaptor::queryGroups(uint, const QString &, const QString &, uint, uint, uint)
+{
+    return QList<MNotificationGroupProxyWithParameters>();
+}
+
+uint DBusInterfaceNotificationSourceAdaptor::queryGroupCount(uint, const QString &, const QString &, uint)
+{
+    return 0;
+}
+
 void Ut_DBusInterfaceNotificationSource::initTestCase()
 {
 }
@@ -396,18 +461,18 @@ void Ut_DBusInterfaceNotificationSource::testNotificationList()
     expectedResults.append(Notification(NOTIFICATION_ID2, NOTIFICATION_GROUP_ID2, USER_ID, params, Notification::ApplicationEvent, 0));
     gNotificationManagerStub->stubSetReturnValue("notificationList", expectedResults);
 
-    QList<MNotificationProxy> receivedResults = source->notificationList(USER_ID);
+    QList<Notification> receivedResults = source->notificationList(USER_ID).notifications;
     QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("notificationList"), 1);
     QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("notificationList").parameter<uint>(0), USER_ID);
 
     QCOMPARE(receivedResults.count(), 2);
-    const MNotificationProxy &res0(receivedResults.at(0));
-    QCOMPARE(res0.notificationId, NOTIFICATION_ID1);
-    QCOMPARE(res0.groupId, NOTIFICATION_GROUP_ID1);
+    const Notification &res0(receivedResults.at(0));
+    QCOMPARE(res0.notificationId(), NOTIFICATION_ID1);
+    QCOMPARE(res0.groupId(), NOTIFICATION_GROUP_ID1);
 
-    const MNotificationProxy &res1(receivedResults.at(1));
-    QCOMPARE(res1.notificationId, NOTIFICATION_ID2);
-    QCOMPARE(res1.groupId, NOTIFICATION_GROUP_ID2);
+    const Notification &res1(receivedResults.at(1));
+    QCOMPARE(res1.notificationId(), NOTIFICATION_ID2);
+    QCOMPARE(res1.groupId(), NOTIFICATION_GROUP_ID2);
 }
 
 void Ut_DBusInterfaceNotificationSource::testNotificationListWithIdentifiers()
@@ -420,21 +485,21 @@ void Ut_DBusInterfaceNotificationSource::testNotificationListWithIdentifiers()
     expectedResults.append(Notification(NOTIFICATION_ID2, NOTIFICATION_GROUP_ID2, USER_ID, params, Notification::ApplicationEvent, 0));
     gNotificationManagerStub->stubSetReturnValue("notificationListWithIdentifiers", expectedResults);
 
-    QList<MNotificationWithIdentifierProxy> receivedResults = source->notificationListWithIdentifiers(USER_ID);
+    QList<Notification> receivedResults = source->notificationListWithIdentifiers(USER_ID).notifications;
 
     QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("notificationListWithIdentifiers"), 1);
     QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("notificationListWithIdentifiers").parameter<uint>(0), USER_ID);
 
     QCOMPARE(receivedResults.count(), 2);
-    const MNotificationWithIdentifierProxy &res0(receivedResults.at(0));
-    QCOMPARE(res0.notificationId, NOTIFICATION_ID1);
-    QCOMPARE(res0.groupId, NOTIFICATION_GROUP_ID1);
-    QCOMPARE(res0.identifier, IDENTIFIER1);
+    const Notification &res0(receivedResults.at(0));
+    QCOMPARE(res0.notificationId(), NOTIFICATION_ID1);
+    QCOMPARE(res0.groupId(), NOTIFICATION_GROUP_ID1);
+    QCOMPARE(res0.parameters().value(IDENTIFIER).toString(), IDENTIFIER1);
 
-    const MNotificationWithIdentifierProxy &res1(receivedResults.at(1));
-    QCOMPARE(res1.notificationId, NOTIFICATION_ID2);
-    QCOMPARE(res1.groupId, NOTIFICATION_GROUP_ID2);
-    QCOMPARE(res1.identifier, IDENTIFIER2);
+    const Notification &res1(receivedResults.at(1));
+    QCOMPARE(res1.notificationId(), NOTIFICATION_ID2);
+    QCOMPARE(res1.groupId(), NOTIFICATION_GROUP_ID2);
+    QCOMPARE(res1.parameters().value(IDENTIFIER).toString(), IDENTIFIER2);
 }
 
 void Ut_DBusInterfaceNotificationSource::testNotificationGroupList()
@@ -445,16 +510,16 @@ void Ut_DBusInterfaceNotificationSource::testNotificationGroupList()
     expectedResults.append(NotificationGroup(NOTIFICATION_GROUP_ID2, USER_ID, params));
     gNotificationManagerStub->stubSetReturnValue("notificationGroupList", expectedResults);
 
-    QList<MNotificationGroupProxy> receivedResults = source->notificationGroupList(USER_ID);
+    QList<NotificationGroup> receivedResults = source->notificationGroupList(USER_ID).groups;
     QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("notificationGroupList"), 1);
     QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("notificationGroupList").parameter<uint>(0), USER_ID);
 
     QCOMPARE(receivedResults.count(), 2);
-    const MNotificationGroupProxy &res0(receivedResults.at(0));
-    QCOMPARE(res0.groupId, NOTIFICATION_GROUP_ID1);
+    const NotificationGroup &res0(receivedResults.at(0));
+    QCOMPARE(res0.groupId(), NOTIFICATION_GROUP_ID1);
 
-    const MNotificationGroupProxy &res1(receivedResults.at(1));
-    QCOMPARE(res1.groupId, NOTIFICATION_GROUP_ID2);
+    const NotificationGroup &res1(receivedResults.at(1));
+    QCOMPARE(res1.groupId(), NOTIFICATION_GROUP_ID2);
 }
 
 void Ut_DBusInterfaceNotificationSource::testNotificationGroupListWithIdentifiers()
@@ -467,18 +532,18 @@ void Ut_DBusInterfaceNotificationSource::testNotificationGroupListWithIdentifier
     expectedResults.append(NotificationGroup(NOTIFICATION_GROUP_ID2, USER_ID, params));
     gNotificationManagerStub->stubSetReturnValue("notificationGroupListWithIdentifiers", expectedResults);
 
-    QList<MNotificationGroupWithIdentifierProxy> receivedResults = source->notificationGroupListWithIdentifiers(USER_ID);
+    QList<NotificationGroup> receivedResults = source->notificationGroupListWithIdentifiers(USER_ID).groups;
     QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("notificationGroupListWithIdentifiers"), 1);
     QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("notificationGroupListWithIdentifiers").parameter<uint>(0), USER_ID);
 
     QCOMPARE(receivedResults.count(), 2);
-    const MNotificationGroupWithIdentifierProxy &res0(receivedResults.at(0));
-    QCOMPARE(res0.groupId, NOTIFICATION_GROUP_ID1);
-    QCOMPARE(res0.groupIdentifier, IDENTIFIER1);
+    const NotificationGroup &res0(receivedResults.at(0));
+    QCOMPARE(res0.groupId(), NOTIFICATION_GROUP_ID1);
+    QCOMPARE(res0.parameters().value(IDENTIFIER).toString(), IDENTIFIER1);
 
-    const MNotificationGroupWithIdentifierProxy &res1(receivedResults.at(1));
-    QCOMPARE(res1.groupId, NOTIFICATION_GROUP_ID2);
-    QCOMPARE(res1.groupIdentifier, IDENTIFIER2);
+    const NotificationGroup &res1(receivedResults.at(1));
+    QCOMPARE(res1.groupId(), NOTIFICATION_GROUP_ID2);
+    QCOMPARE(res1.parameters().value(IDENTIFIER).toString(), IDENTIFIER2);
 }
 
 void Ut_DBusInterfaceNotificationSource::testUpdateGroupWithEmptyStrings()
@@ -658,4 +723,259 @@ void Ut_DBusInterfaceNotificationSource::testReturningNotificationGroupsWithNoti
     QCOMPARE(notification2.parameters.value(NotificationWidgetParameterFactory::summaryKey()).toString(), SUMMARY);
 }
 
+void Ut_DBusInterfaceNotificationSource::testAddNotifications()
+{
+    QList<uint> expectedIds;
+    expectedIds << NOTIFICATION_ID1 << NOTIFICATION_ID2;
+    gNotificationManagerStub->stubSetReturnValue("addNotifications", expectedIds);
+
+    QList<MNotificationBatchItemProxy> notifications;
+    notifications.append(MNotificationBatchItemProxy(NOTIFICATION_GROUP_ID1, createDefaultNotificationParameters()));
+    notifications.append(MNotificationBatchItemProxy(NOTIFICATION_GROUP_ID2, createDefaultNotificationParameters()));
+    QList<uint> receivedIds = source->addNotifications(USER_ID, notifications);
+
+    // All notifications should be passed to the manager in a single call
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("addNotifications"), 1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("addNotification"), 0);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("addNotifications").parameter<uint>(0), USER_ID);
+    QList<QPair<uint, NotificationParameters> > notificationsGivenToManager = gDefaultNotificationManagerStub.stubLastCallTo("addNotifications").parameter<QList<QPair<uint, NotificationParameters> > >(1);
+    QCOMPARE(notificationsGivenToManager.count(), 2);
+    QCOMPARE(notificationsGivenToManager.at(0).first, NOTIFICATION_GROUP_ID1);
+    QCOMPARE(notificationsGivenToManager.at(0).second.value(GenericNotificationParameterFactory::eventTypeKey()).toString(), EVENT);
+    QCOMPARE(notificationsGivenToManager.at(1).first, NOTIFICATION_GROUP_ID2);
+    QCOMPARE(notificationsGivenToManager.at(1).second.value(NotificationWidgetParameterFactory::summaryKey()).toString(), SUMMARY);
+    QCOMPARE(receivedIds, expectedIds);
+}
+
+void Ut_DBusInterfaceNotificationSource::testUpdateNotifications()
+{
+    gNotificationManagerStub->stubSetReturnValue("updateNotifications", true);
+
+    QList<MNotificationBatchItemProxy> notifications;
+    notifications.append(MNotificationBatchItemProxy(NOTIFICATION_ID1, createDefaultNotificationParameters()));
+    notifications.append(MNotificationBatchItemProxy(NOTIFICATION_ID2, createDefaultNotificationParameters()));
+    QVERIFY(source->updateNotifications(USER_ID, notifications));
+
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("updateNotifications"), 1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("updateNotifications").parameter<uint>(0), USER_ID);
+    QList<QPair<uint, NotificationParameters> > notificationsGivenToManager = gDefaultNotificationManagerStub.stubLastCallTo("updateNotifications").parameter<QList<QPair<uint, NotificationParameters> > >(1);
+    QCOMPARE(notificationsGivenToManager.count(), 2);
+    QCOMPARE(notificationsGivenToManager.at(0).first, NOTIFICATION_ID1);
+    QCOMPARE(notificationsGivenToManager.at(1).first, NOTIFICATION_ID2);
+    QCOMPARE(notificationsGivenToManager.at(1).second.value(GenericNotificationParameterFactory::eventTypeKey()).toString(), EVENT);
+}
+
+void Ut_DBusInterfaceNotificationSource::testRemoveNotifications()
+{
+    gNotificationManagerStub->stubSetReturnValue("removeNotifications", true);
+
+    QList<uint> notificationIds;
+    notificationIds << NOTIFICATION_ID1 << NOTIFICATION_ID2;
+    QVERIFY(source->removeNotifications(USER_ID, notificationIds));
+
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("removeNotifications"), 1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("removeNotifications").parameter<uint>(0), USER_ID);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("removeNotifications").parameter<QList<uint> >(1), notificationIds);
+}
+
+void Ut_DBusInterfaceNotificationSource::testAddOrUpdateNotification()
+{
+    gNotificationManagerStub->stubSetReturnValue("addOrUpdateNotification", NOTIFICATION_ID1);
+
+    NotificationParameters parameters;
+    parameters.add(GenericNotificationParameterFactory::summaryKey(), SUMMARY);
+    QCOMPARE(source->addOrUpdateNotification(USER_ID, NOTIFICATION_GROUP_ID2, IDENTIFIER1, parameters), NOTIFICATION_ID1);
+
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("addOrUpdateNotification"), 1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("addOrUpdateNotification").parameter<uint>(0), USER_ID);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("addOrUpdateNotification").parameter<uint>(1), NOTIFICATION_GROUP_ID2);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("addOrUpdateNotification").parameter<QString>(2), IDENTIFIER1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("addOrUpdateNotification").parameter<NotificationParameters>(3).value(GenericNotificationParameterFactory::summaryKey()).toString(), SUMMARY);
+}
+
+void Ut_DBusInterfaceNotificationSource::testRemoveNotificationsWithIdentifier()
+{
+    gNotificationManagerStub->stubSetReturnValue("removeNotificationsWithIdentifier", true);
+
+    QVERIFY(source->removeNotificationsWithIdentifier(USER_ID, IDENTIFIER1));
+
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("removeNotificationsWithIdentifier"), 1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("removeNotificationsWithIdentifier").parameter<uint>(0), USER_ID);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("removeNotificationsWithIdentifier").parameter<QString>(1), IDENTIFIER1);
+}
+
+void Ut_DBusInterfaceNotificationSource::testAddOrUpdateGroup()
+{
+    gNotificationManagerStub->stubSetReturnValue("addOrUpdateGroup", NOTIFICATION_GROUP_ID2);
+
+    NotificationParameters parameters;
+    parameters.add(GenericNotificationParameterFactory::summaryKey(), SUMMARY);
+    QCOMPARE(source->addOrUpdateGroup(USER_ID, IDENTIFIER2, parameters), NOTIFICATION_GROUP_ID2);
+
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("addOrUpdateGroup"), 1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("addOrUpdateGroup").parameter<uint>(0), USER_ID);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("addOrUpdateGroup").parameter<QString>(1), IDENTIFIER2);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("addOrUpdateGroup").parameter<NotificationParameters>(2).value(GenericNotificationParameterFactory::summaryKey()).toString(), SUMMARY);
+}
+
+void Ut_DBusInterfaceNotificationSource::testRemoveGroupsWithIdentifier()
+{
+    gNotificationManagerStub->stubSetReturnValue("removeGroupsWithIdentifier", false);
+
+    QVERIFY(!source->removeGroupsWithIdentifier(USER_ID, IDENTIFIER2));
+
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("removeGroupsWithIdentifier"), 1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("removeGroupsWithIdentifier").parameter<uint>(0), USER_ID);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("removeGroupsWithIdentifier").parameter<QString>(1), IDENTIFIER2);
+}
+
+void Ut_DBusInterfaceNotificationSource::testListAllocationsDoNotDependOnNumberOfNotifications()
+{
+    NotificationParameters params = createDefaultNotificationParameters();
+    params.add(NotificationWidgetParameterFactory::createImageIdParameter(IMAGE));
+    params.add(NotificationWidgetParameterFactory::createActionParameter(ACTION));
+    params.add(GenericNotificationParameterFactory::createIdentifierParameter(IDENTIFIER));
+
+    QList<int> notificationAllocations;
+    QList<int> groupAllocations;
+    QList<int> notificationProxyAllocations;
+    QList<int> groupProxyAllocations;
+    QList<int> counts = QList<int>() << 1 << 1 << 100;
+    foreach (int count, counts) {
+        QList<Notification> notifications;
+        QList<NotificationGroup> groups;
+        for (int i = 0; i < count; i++) {
+            notifications.append(Notification(i + 1, 0, USER_ID, params, Notification::ApplicationEvent, 0));
+            groups.append(NotificationGroup(i + 1, USER_ID, params));
+        }
+        gNotificationManagerStub->stubSetReturnValue("notificationListWithIdentifiers", notifications);
+        gNotificationManagerStub->stubSetReturnValue("notificationGroupListWithIdentifiers", groups);
+
+        // Each list is marshalled into a D-Bus message like the reply sent by the adaptor
+        int allocationsBefore = allocationCount;
+        {
+            MNotificationWithIdentifierListProxy notificationList = source->notificationListWithIdentifiers(USER_ID);
+            QDBusArgument argument;
+            argument << notificationList;
+        }
+        notificationAllocations.append(allocationCount - allocationsBefore);
+
+        allocationsBefore = allocationCount;
+        {
+            MNotificationGroupWithIdentifierListProxy groupList = source->notificationGroupListWithIdentifiers(USER_ID);
+            QDBusArgument argument;
+            argument << groupList;
+        }
+        groupAllocations.append(allocationCount - allocationsBefore);
+
+        // Marshalling a list of item proxies copied from the same notifications and groups is the baseline
+        allocationsBefore = allocationCount;
+        {
+            QList<MNotificationWithIdentifierProxy> notificationProxies;
+            foreach (const Notification &notification, notifications) {
+                notificationProxies.append(MNotificationWithIdentifierProxy(notification));
+            }
+            QDBusArgument argument;
+            argument << notificationProxies;
+        }
+        notificationProxyAllocations.append(allocationCount - allocationsBefore);
+
+        allocationsBefore = allocationCount;
+        {
+            QList<MNotificationGroupWithIdentifierProxy> groupProxies;
+            foreach (const NotificationGroup &group, groups) {
+                groupProxies.append(MNotificationGroupWithIdentifierProxy(group));
+            }
+            QDBusArgument argument;
+            argument << groupProxies;
+        }
+        groupProxyAllocations.append(allocationCount - allocationsBefore);
+    }
+
+    // The first calls are only for warming up. The D-Bus marshaller allocates for every item it writes,
+    // so compare the allocations of the additional items to the baseline: the item proxies allocate
+    // for each of their string fields, the list proxies don't.
+    const int stringFields = 6;
+    int additionalItems = counts.at(2) - counts.at(1);
+    int notificationGrowth = notificationAllocations.at(2) - notificationAllocations.at(1);
+    int notificationProxyGrowth = notificationProxyAllocations.at(2) - notificationProxyAllocations.at(1);
+    int groupGrowth = groupAllocations.at(2) - groupAllocations.at(1);
+    int groupProxyGrowth = groupProxyAllocations.at(2) - groupProxyAllocations.at(1);
+    QVERIFY(notificationGrowth <= notificationProxyGrowth - additionalItems * stringFields);
+    QVERIFY(groupGrowth <= groupProxyGrowth - additionalItems * stringFields);
+}
+
+void Ut_DBusInterfaceNotificationSource::testQueryNotifications()
+{
+    QList<Notification> expectedResults;
+    expectedResults.append(Notification(NOTIFICATION_ID2, NOTIFICATION_GROUP_ID2, USER_ID, createDefaultNotificationParameters(), Notification::ApplicationEvent, 0));
+    gNotificationManagerStub->stubSetReturnValue("queryNotifications", expectedResults);
+
+    QList<MNotificationProxyWithParameters> receivedResults = source->queryNotifications(USER_ID, EVENT, NOTIFICATION_GROUP_ID2, IDENTIFIER1, TIMESTAMP, 10, 20);
+
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("queryNotifications"), 1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("notificationList"), 0);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotifications").parameter<uint>(0), USER_ID);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotifications").parameter<QString>(1), EVENT);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotifications").parameter<uint>(2), NOTIFICATION_GROUP_ID2);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotifications").parameter<QString>(3), IDENTIFIER1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotifications").parameter<uint>(4), TIMESTAMP);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotifications").parameter<uint>(5), (uint)10);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotifications").parameter<uint>(6), (uint)20);
+    QCOMPARE(receivedResults.count(), 1);
+    QCOMPARE(receivedResults.at(0).notificationId, NOTIFICATION_ID2);
+    QCOMPARE(receivedResults.at(0).groupId, NOTIFICATION_GROUP_ID2);
+    QCOMPARE(receivedResults.at(0).parameters.value(NotificationWidgetParameterFactory::summaryKey()).toString(), SUMMARY);
+}
+
+void Ut_DBusInterfaceNotificationSource::testQueryNotificationCount()
+{
+    gNotificationManagerStub->stubSetReturnValue("queryNotificationCount", (uint)5);
+
+    QCOMPARE(source->queryNotificationCount(USER_ID, EVENT, NOTIFICATION_GROUP_ID2, IDENTIFIER1, TIMESTAMP), (uint)5);
+
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("queryNotificationCount"), 1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("queryNotifications"), 0);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotificationCount").parameter<uint>(0), USER_ID);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotificationCount").parameter<QString>(1), EVENT);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotificationCount").parameter<uint>(2), NOTIFICATION_GROUP_ID2);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotificationCount").parameter<QString>(3), IDENTIFIER1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryNotificationCount").parameter<uint>(4), TIMESTAMP);
+}
+
+void Ut_DBusInterfaceNotificationSource::testQueryGroups()
+{
+    QList<NotificationGroup> expectedResults;
+    expectedResults.append(NotificationGroup(NOTIFICATION_GROUP_ID2, USER_ID, createDefaultNotificationParameters()));
+    gNotificationManagerStub->stubSetReturnValue("queryGroups", expectedResults);
+
+    QList<MNotificationGroupProxyWithParameters> receivedResults = source->queryGroups(USER_ID, EVENT, IDENTIFIER2, TIMESTAMP, 10, 20);
+
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("queryGroups"), 1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("notificationGroupList"), 0);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryGroups").parameter<uint>(0), USER_ID);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryGroups").parameter<QString>(1), EVENT);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryGroups").parameter<QString>(2), IDENTIFIER2);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryGroups").parameter<uint>(3), TIMESTAMP);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryGroups").parameter<uint>(4), (uint)10);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryGroups").parameter<uint>(5), (uint)20);
+    QCOMPARE(receivedResults.count(), 1);
+    QCOMPARE(receivedResults.at(0).groupId, NOTIFICATION_GROUP_ID2);
+    QCOMPARE(receivedResults.at(0).parameters.value(NotificationWidgetParameterFactory::summaryKey()).toString(), SUMMARY);
+}
+
+void Ut_DBusInterfaceNotificationSource::testQueryGroupCount()
+{
+    gNotificationManagerStub->stubSetReturnValue("queryGroupCount", (uint)3);
+
+    QCOMPARE(source->queryGroupCount(USER_ID, EVENT, IDENTIFIER2, TIMESTAMP), (uint)3);
+
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("queryGroupCount"), 1);
+    QCOMPARE(gDefaultNotificationManagerStub.stubCallCount("queryGroups"), 0);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryGroupCount").parameter<uint>(0), USER_ID);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryGroupCount").parameter<QString>(1), EVENT);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryGroupCount").parameter<QString>(2), IDENTIFIER2);
+    QCOMPARE(gDefaultNotificationManagerStub.stubLastCallTo("queryGroupCount").parameter<uint>(3), TIMESTAMP);
+}
+
 QTEST_APPLESS_MAIN(Ut_DBusInterfaceNotificationSource)
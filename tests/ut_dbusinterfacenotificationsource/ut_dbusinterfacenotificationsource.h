@@ -86,6 +86,18 @@ private slots:
     // Test the query of notifications
     void testReturningNotificationsWithNotificationParameters();
     void testReturningNotificationGroupsWithNotificationParameters();
+    void testAddNotifications();
+    void testUpdateNotifications();
+    void testRemoveNotifications();
+    void testAddOrUpdateNotification();
+    void testRemoveNotificationsWithIdentifier();
+    void testAddOrUpdateGroup();
+    void testRemoveGroupsWithIdentifier();
+    void testListAllocationsDoNotDependOnNumberOfNotifications();
+    void testQueryNotifications();
+    void testQueryNotificationCount();
+    void testQueryGroups();
+    void testQueryGroupCount();
 
 private:
     // Notification manager interface used by the test subject
@@ -26,10 +26,32 @@ QStringList eventTypeFilesList;
 QMap<QString, QMap<QString, QString> > eventTypeSettingsMap;
 //Size of the event configuration file
 uint eventTypeFileSize;
+// Modification time of the event configuration files
+QDateTime eventTypeFileModified;
+// Modification times of individual event configuration files
+QHash<QString, QDateTime> eventTypeFileModifiedTimes;
+// Number of times the update timer has been started
+int timerStartCount;
+// Number of times the settings of an event type have been read
+int eventTypeSettingsReadCount;
+
+// Paths watched by the file system watcher
+QStringList watchedPaths;
 
 // QFileSystemWatcher stubs
-void QFileSystemWatcher::addPath(const QString &)
+void QFileSystemWatcher::addPath(const QString &path)
 {
+    watchedPaths.append(path);
+}
+
+void QFileSystemWatcher::removePath(const QString &path)
+{
+    watchedPaths.removeAll(path);
+}
+
+QStringList QFileSystemWatcher::files() const
+{
+    return watchedPaths;
 }
 
 // QFileInfo stubs
@@ -43,6 +65,17 @@ qint64 QFileInfo::size() const
     return eventTypeFileSize;
 }
 
+QDateTime QFileInfo::lastModified() const
+{
+    return eventTypeFileModifiedTimes.value(fileName(), eventTypeFileModified);
+}
+
+// QTimer stubs
+void QTimer::start()
+{
+    timerStartCount++;
+}
+
 // QDir stubs
 bool QDir::exists() const
 {
@@ -57,6 +90,7 @@ QStringList QDir::entryList(const QStringList &, Filters, SortFlags) const
 // Stubs of QSettings methods
 QStringList QSettings::allKeys() const
 {
+    eventTypeSettingsReadCount++;
     return QStringList(eventTypeSettingsMap.value(QFileInfo(fileName()).baseName()).keys());
 }
 
@@ -79,6 +113,11 @@ void Ut_EventTypeStore::init()
     eventTypeFilesList.clear();
     eventTypeSettingsMap.clear();
     eventTypeFileSize = 100;
+    eventTypeFileModified = QDateTime::fromTime_t(1000);
+    eventTypeFileModifiedTimes.clear();
+    timerStartCount = 0;
+    eventTypeSettingsReadCount = 0;
+    watchedPaths.clear();
 }
 
 void Ut_EventTypeStore::cleanup()
@@ -185,4 +224,150 @@ void Ut_EventTypeStore::testEventTypeUninstalling()
     QCOMPARE(m_subject->eventTypeExists("smsEventType"), false);
 }
 
+void Ut_EventTypeStore::testEventTypeTableIsCompiledOnlyWhenFilesChange()
+{
+    QString tableFileName = QDir::tempPath() + "/ut_eventtypestore.data";
+    QFile::remove(tableFileName);
+
+    eventTypeFilesList.append("smsEventType.conf");
+    QMap<QString, QString> smsSettingsMap;
+    smsSettingsMap.insert("iconId", "sms-icon");
+    eventTypeSettingsMap.insert("smsEventType", smsSettingsMap);
+
+    // The table is compiled from the configuration files and stored
+    m_subject = new EventTypeStore("/eventtypepath", 100, tableFileName);
+    QCOMPARE(eventTypeSettingsReadCount, 1);
+    QCOMPARE(m_subject->value("smsEventType", "iconId"), QString("sms-icon"));
+    QVERIFY(QFile(tableFileName).open(QIODevice::ReadOnly));
+    delete m_subject;
+
+    // The stored table is used as long as the configuration files are not modified
+    eventTypeSettingsMap["smsEventType"].insert("iconId", "modified-sms-icon");
+    m_subject = new EventTypeStore("/eventtypepath", 100, tableFileName);
+    QCOMPARE(eventTypeSettingsReadCount, 1);
+    QCOMPARE(m_subject->value("smsEventType", "iconId"), QString("sms-icon"));
+    delete m_subject;
+
+    // The table is compiled again when a configuration file is modified
+    eventTypeFileModified = eventTypeFileModified.addSecs(1);
+    m_subject = new EventTypeStore("/eventtypepath", 100, tableFileName);
+    QCOMPARE(eventTypeSettingsReadCount, 2);
+    QCOMPARE(m_subject->value("smsEventType", "iconId"), QString("modified-sms-icon"));
+
+    QFile::remove(tableFileName);
+}
+
+void Ut_EventTypeStore::testLeastRecentlyUsedEventTypeIsEvicted()
+{
+    eventTypeFilesList << "smsEventType.conf" << "emailEventType.conf" << "chatEventType.conf";
+    QMap<QString, QString> settingsMap;
+    settingsMap.insert("iconId", "icon");
+    eventTypeSettingsMap.insert("smsEventType", settingsMap);
+    eventTypeSettingsMap.insert("emailEventType", settingsMap);
+    eventTypeSettingsMap.insert("chatEventType", settingsMap);
+
+    m_subject = new EventTypeStore("/eventtypepath", 2);
+
+    QVERIFY(m_subject->eventTypeExists("smsEventType"));
+    QVERIFY(m_subject->eventTypeExists("emailEventType"));
+    QCOMPARE(m_subject->cacheMisses(), (uint)2);
+    QCOMPARE(m_subject->cacheHits(), (uint)0);
+
+    // Using the SMS event type makes the e-mail event type the least recently used one
+    QCOMPARE(m_subject->value("smsEventType", "iconId"), QString("icon"));
+    QCOMPARE(m_subject->cacheHits(), (uint)1);
+    QCOMPARE(m_subject->cacheEvictions(), (uint)0);
+
+    QVERIFY(m_subject->eventTypeExists("chatEventType"));
+    QCOMPARE(m_subject->cacheMisses(), (uint)3);
+    QCOMPARE(m_subject->cacheEvictions(), (uint)1);
+
+    // The SMS event type is still in memory, the e-mail event type has to be read again
+    QVERIFY(m_subject->eventTypeExists("smsEventType"));
+    QCOMPARE(m_subject->cacheHits(), (uint)2);
+    QCOMPARE(m_subject->value("emailEventType", "iconId"), QString("icon"));
+    QCOMPARE(m_subject->cacheMisses(), (uint)4);
+    QCOMPARE(m_subject->cacheEvictions(), (uint)2);
+}
+
+void Ut_EventTypeStore::testMissingEventTypesAreCachedUntilDirectoryChanges()
+{
+    eventTypeFilesList.append("smsEventType.conf");
+
+    m_subject = new EventTypeStore("/eventtypepath");
+    connect(this, SIGNAL(directoryChanged(QString)), m_subject, SLOT(updateEventTypeFileList()));
+
+    QVERIFY(!m_subject->eventTypeExists("chatEventType"));
+    QCOMPARE(m_subject->cacheMisses(), (uint)1);
+    QVERIFY(!m_subject->contains("chatEventType", "iconId"));
+    QCOMPARE(m_subject->value("chatEventType", "iconId"), QString());
+    QCOMPARE(m_subject->cacheMisses(), (uint)1);
+    QCOMPARE(m_subject->cacheHits(), (uint)2);
+
+    // Installing the event type invalidates the cached missing event types
+    eventTypeFilesList.append("chatEventType.conf");
+    emit directoryChanged("/eventtypepath");
+    QVERIFY(m_subject->eventTypeExists("chatEventType"));
+    QCOMPARE(m_subject->cacheMisses(), (uint)2);
+}
+
+void Ut_EventTypeStore::testChangesAreHandledInOneBatch()
+{
+    eventTypeFilesList << "smsEventType.conf" << "emailEventType.conf";
+    QMap<QString, QString> settingsMap;
+    settingsMap.insert("iconId", "icon");
+    eventTypeSettingsMap.insert("smsEventType", settingsMap);
+    eventTypeSettingsMap.insert("emailEventType", settingsMap);
+
+    m_subject = new EventTypeStore("/eventtypepath");
+    QCOMPARE(eventTypeSettingsReadCount, 2);
+    QSignalSpy modifiedSpy(m_subject, SIGNAL(eventTypesModified(QStringList)));
+    connect(this, SIGNAL(directoryChanged(QString)), m_subject, SLOT(scheduleUpdate()));
+
+    // Install one event type and modify another one
+    eventTypeFilesList.append("chatEventType.conf");
+    eventTypeSettingsMap.insert("chatEventType", settingsMap);
+    emit directoryChanged("/eventtypepath");
+    eventTypeSettingsMap["smsEventType"].insert("iconId", "modified-icon");
+    eventTypeFileModifiedTimes.insert("smsEventType.conf", eventTypeFileModified.addSecs(1));
+    emit directoryChanged("/eventtypepath");
+
+    // Nothing is done until the changes have settled
+    QCOMPARE(timerStartCount, 2);
+    QCOMPARE(modifiedSpy.count(), 0);
+    QCOMPARE(eventTypeSettingsReadCount, 2);
+
+    // Only the changed files are read and all changes are signaled at once
+    QVERIFY(QMetaObject::invokeMethod(m_subject, "updateEventTypeFileList"));
+    QCOMPARE(eventTypeSettingsReadCount, 4);
+    QCOMPARE(modifiedSpy.count(), 1);
+    QCOMPARE(modifiedSpy.at(0).at(0).toStringList(), QStringList() << "chatEventType" << "smsEventType");
+    QCOMPARE(m_subject->value("smsEventType", "iconId"), QString("modified-icon"));
+    QCOMPARE(m_subject->value("emailEventType", "iconId"), QString("icon"));
+    QVERIFY(m_subject->eventTypeExists("chatEventType"));
+
+    // Nothing is signaled if nothing has changed
+    QVERIFY(QMetaObject::invokeMethod(m_subject, "updateEventTypeFileList"));
+    QCOMPARE(eventTypeSettingsReadCount, 4);
+    QCOMPARE(modifiedSpy.count(), 1);
+}
+
+void Ut_EventTypeStore::testReplacedFilesAreWatchedAgain()
+{
+    eventTypeFilesList << "smsEventType.conf" << "emailEventType.conf";
+
+    m_subject = new EventTypeStore("/eventtypepath/");
+    connect(this, SIGNAL(directoryChanged(QString)), m_subject, SLOT(updateEventTypeFileList()));
+    QVERIFY(watchedPaths.contains("/eventtypepath/smsEventType.conf"));
+    QVERIFY(watchedPaths.contains("/eventtypepath/emailEventType.conf"));
+
+    // Replacing a file by renaming another file over it drops the watch of the file
+    watchedPaths.removeAll("/eventtypepath/smsEventType.conf");
+    emit directoryChanged("/eventtypepath/");
+    QCOMPARE(watchedPaths.count("/eventtypepath/smsEventType.conf"), 1);
+
+    // Files that are still being watched are not watched twice
+    QCOMPARE(watchedPaths.count("/eventtypepath/emailEventType.conf"), 1);
+}
+
 QTEST_APPLESS_MAIN(Ut_EventTypeStore)
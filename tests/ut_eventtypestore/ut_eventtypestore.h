@@ -37,6 +37,11 @@ private slots:
     void testEventTypeSettingsValues();
     void testEventTypeStoreMaxFileSizeHandling();
     void testEventTypeUninstalling();
+    void testEventTypeTableIsCompiledOnlyWhenFilesChange();
+    void testLeastRecentlyUsedEventTypeIsEvicted();
+    void testMissingEventTypesAreCachedUntilDirectoryChanges();
+    void testChangesAreHandledInOneBatch();
+    void testReplacedFilesAreWatchedAgain();
 
 private:
     EventTypeStore *m_subject;
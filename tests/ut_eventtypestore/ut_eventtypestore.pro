@@ -6,11 +6,13 @@ INCLUDEPATH +=$$NOTIFICATIONSRCDIR
 # unit test and unit
 SOURCES += \
     ut_eventtypestore.cpp \
-   $$NOTIFICATIONSRCDIR/eventtypestore.cpp
+   $$NOTIFICATIONSRCDIR/eventtypestore.cpp \
+   $$NOTIFICATIONSRCDIR/eventtypetable.cpp
 
 # unit test and unit
 HEADERS += \
     ut_eventtypestore.h \
    $$NOTIFICATIONSRCDIR/eventtypestore.h \
+   $$NOTIFICATIONSRCDIR/eventtypetable.h \
 
 include(../common_bot.pri)
@@ -0,0 +1,157 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QFile>
+#include <QDir>
+#include "ut_eventtypetable.h"
+#include "eventtypetable.h"
+
+static QMap<QString, EventTypeTable::Parameters> createEventTypes()
+{
+    EventTypeTable::Parameters email;
+    email.insert("iconId", "icon-email");
+    email.insert("feedbackId", "sound");
+    email.insert("persistent", "true");
+    EventTypeTable::Parameters sms;
+    sms.insert("iconId", "icon-sms");
+    sms.insert("feedbackId", "sound");
+
+    QMap<QString, EventTypeTable::Parameters> eventTypes;
+    eventTypes.insert("email", email);
+    eventTypes.insert("sms", sms);
+    eventTypes.insert("empty", EventTypeTable::Parameters());
+    return eventTypes;
+}
+
+void Ut_EventTypeTable::initTestCase()
+{
+    tableFileName = QDir::tempPath() + "/ut_eventtypetable.data";
+}
+
+void Ut_EventTypeTable::cleanupTestCase()
+{
+}
+
+void Ut_EventTypeTable::init()
+{
+    QFile::remove(tableFileName);
+}
+
+void Ut_EventTypeTable::cleanup()
+{
+    QFile::remove(tableFileName);
+}
+
+void Ut_EventTypeTable::testEmptyTable()
+{
+    EventTypeTable table;
+    QCOMPARE(table.contains("email"), false);
+    QVERIFY(table.parameters("email").isEmpty());
+    QVERIFY(table.sources().isEmpty());
+
+    QVERIFY(table.load(EventTypeTable::serialize(QMap<QString, EventTypeTable::Parameters>(), EventTypeTable::Sources())));
+    QCOMPARE(table.contains("email"), false);
+    QCOMPARE(table.contains(QString()), false);
+}
+
+void Ut_EventTypeTable::testSerializingAndReadingEventTypes()
+{
+    QMap<QString, EventTypeTable::Parameters> eventTypes = createEventTypes();
+
+    EventTypeTable table;
+    QVERIFY(table.load(EventTypeTable::serialize(eventTypes, EventTypeTable::Sources())));
+
+    QCOMPARE(table.contains("email"), true);
+    QCOMPARE(table.contains("sms"), true);
+    QCOMPARE(table.contains("empty"), true);
+    QCOMPARE(table.contains("chat"), false);
+
+    // Parameter names and values are not event types
+    QCOMPARE(table.contains("iconId"), false);
+    QCOMPARE(table.contains("icon-sms"), false);
+
+    QCOMPARE(table.parameters("email"), eventTypes.value("email"));
+    QCOMPARE(table.parameters("sms"), eventTypes.value("sms"));
+    QVERIFY(table.parameters("empty").isEmpty());
+    QVERIFY(table.parameters("chat").isEmpty());
+}
+
+void Ut_EventTypeTable::testSources()
+{
+    EventTypeTable::Sources sources;
+    sources.insert("email.conf", qMakePair(1000u, 50u));
+    sources.insert("sms.conf", qMakePair(2000u, 40u));
+
+    EventTypeTable table;
+    QVERIFY(table.load(EventTypeTable::serialize(createEventTypes(), sources)));
+    QCOMPARE(table.sources(), sources);
+
+    // The names of the configuration files are not event types
+    QCOMPARE(table.contains("email.conf"), false);
+}
+
+void Ut_EventTypeTable::testOpeningTableFile()
+{
+    QFile file(tableFileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(EventTypeTable::serialize(createEventTypes(), EventTypeTable::Sources()));
+    file.close();
+
+    EventTypeTable table;
+    QVERIFY(table.open(tableFileName));
+    QCOMPARE(table.parameters("sms").value("iconId"), QString("icon-sms"));
+
+    table.close();
+    QCOMPARE(table.contains("sms"), false);
+}
+
+void Ut_EventTypeTable::testOpeningMissingFile()
+{
+    EventTypeTable table;
+    QVERIFY(!table.open(tableFileName));
+    QCOMPARE(table.contains("sms"), false);
+}
+
+void Ut_EventTypeTable::testStringsAreStoredOnce()
+{
+    EventTypeTable table;
+    QVERIFY(table.load(EventTypeTable::serialize(createEventTypes(), EventTypeTable::Sources())));
+
+    // email, empty, sms, iconId, feedbackId, persistent, icon-email, icon-sms, sound, true
+    QCOMPARE(table.stringCount, (quint32)10);
+}
+
+void Ut_EventTypeTable::testReadingInvalidTable()
+{
+    QByteArray data = EventTypeTable::serialize(createEventTypes(), EventTypeTable::Sources());
+
+    EventTypeTable table;
+    QVERIFY(!table.load(data.left(data.size() - 1)));
+    QCOMPARE(table.contains("email"), false);
+
+    QByteArray wrongVersion(data);
+    wrongVersion[7] = wrongVersion[7] + 1;
+    QVERIFY(!table.load(wrongVersion));
+
+    QVERIFY(!table.load(QByteArray("not a table")));
+    QVERIFY(!table.load(QByteArray()));
+}
+
+QTEST_APPLESS_MAIN(Ut_EventTypeTable)
@@ -0,0 +1,59 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef UT_EVENTTYPETABLE_H
+#define UT_EVENTTYPETABLE_H
+
+#include <QObject>
+#include <QString>
+
+class Ut_EventTypeTable : public QObject
+{
+    Q_OBJECT
+
+private:
+    QString tableFileName;
+
+private slots:
+    // Called before the first testfunction is executed
+    void initTestCase();
+    // Called after the last testfunction was executed
+    void cleanupTestCase();
+    // Called before each testfunction is executed
+    void init();
+    // Called after every testfunction
+    void cleanup();
+
+    // Test that an empty table contains no event types
+    void testEmptyTable();
+    // Test that serialized event types are read back
+    void testSerializingAndReadingEventTypes();
+    // Test that the configuration files the table was compiled from are read back
+    void testSources();
+    // Test that a table file can be opened
+    void testOpeningTableFile();
+    // Test that opening a missing file fails
+    void testOpeningMissingFile();
+    // Test that strings are stored only once
+    void testStringsAreStoredOnce();
+    // Test that tables in an unknown format or truncated tables are rejected
+    void testReadingInvalidTable();
+};
+
+#endif
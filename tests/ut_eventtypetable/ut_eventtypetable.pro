@@ -0,0 +1,16 @@
+include(../coverage.pri)
+include(../common_top.pri)
+TARGET = ut_eventtypetable
+INCLUDEPATH += $$NOTIFICATIONSRCDIR
+
+# unit test and unit
+SOURCES += \
+    ut_eventtypetable.cpp \
+    $$NOTIFICATIONSRCDIR/eventtypetable.cpp
+
+# unit test and unit
+HEADERS += \
+    ut_eventtypetable.h \
+    $$NOTIFICATIONSRCDIR/eventtypetable.h
+
+include(../common_bot.pri)
@@ -114,6 +114,43 @@ bool MockNotificationManager::removeNotification(uint, uint notificationId)
     return removed;
 }
 
+QList<uint> MockNotificationManager::addNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications)
+{
+    QList<uint> notificationIds;
+    for (int i = 0; i < notifications.count(); ++i) {
+        notificationIds.append(addNotification(notificationUserId, notifications.at(i).second, notifications.at(i).first));
+    }
+    return notificationIds;
+}
+
+bool MockNotificationManager::updateNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications)
+{
+    bool result = true;
+    for (int i = 0; i < notifications.count(); ++i) {
+        result &= updateNotification(notificationUserId, notifications.at(i).first, notifications.at(i).second);
+    }
+    return result;
+}
+
+bool MockNotificationManager::removeNotifications(uint notificationUserId, const QList<uint> &notificationIds)
+{
+    bool result = true;
+    foreach (uint notificationId, notificationIds) {
+        result &= removeNotification(notificationUserId, notificationId);
+    }
+    return result;
+}
+
+uint MockNotificationManager::addOrUpdateNotification(uint, uint, const QString &, const NotificationParameters &)
+{
+    return 0;
+}
+
+bool MockNotificationManager::removeNotificationsWithIdentifier(uint, const QString &)
+{
+    return false;
+}
+
 uint MockNotificationManager::addGroup(uint, const NotificationParameters &)
 {
     return 0;
@@ -129,6 +166,16 @@ bool MockNotificationManager::removeGroup(uint, uint)
     return false;
 }
 
+uint MockNotificationManager::addOrUpdateGroup(uint, const QString &, const NotificationParameters &)
+{
+    return 0;
+}
+
+bool MockNotificationManager::removeGroupsWithIdentifier(uint, const QString &)
+{
+    return false;
+}
+
 uint MockNotificationManager::notificationUserId()
 {
     return 0;
@@ -177,6 +224,56 @@ uint MockNotificationManager::notificationCountInGroup(uint, uint)
     return 0;
 }
 
+QList<Notification> MockNotificationManager::queryNotifications(uint, const QString &, uint, const QString &, uint, uint, uint)
+{
+    return QList<Notification>();
+}
+
+uint MockNotificationManager::queryNotificationCount(uint, const QString &, uint, const QString &, uint)
+{
+    return 0;
+}
+
+QList<NotificationGroup> MockNotificationManager::queryGroups(uint, const QString &, const QString &, uint, uint, uint)
+{
+    return QList<NotificationGroup>();
+}
+
+uint MockNotificationManager::queryGroupCount(uint, const QString &, const QString &, uint)
+{
+    return 0;
+}
+
+quint64 MockNotificationManager::changeSequence() const
+{
+    return 0;
+}
+
+bool MockNotificationManager::changesKnownSince(quint64) const
+{
+    return false;
+}
+
+QList<NotificationGroup> MockNotificationManager::groupsChangedSince(quint64) const
+{
+    return QList<NotificationGroup>();
+}
+
+QList<Notification> MockNotificationManager::notificationsChangedSince(quint64) const
+{
+    return QList<Notification>();
+}
+
+QList<uint> MockNotificationManager::groupIdsRemovedSince(quint64) const
+{
+    return QList<uint>();
+}
+
+QList<uint> MockNotificationManager::notificationIdsRemovedSince(quint64) const
+{
+    return QList<uint>();
+}
+
 QObject* MockNotificationManager::qObject()
 {
     return NULL;
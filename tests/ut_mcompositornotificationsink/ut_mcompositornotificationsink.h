@@ -50,9 +50,16 @@ public:
     uint addNotification(uint notificationUserId, const NotificationParameters &parameters, uint groupId, int timeout);
     uint addNotification(uint notificationUserId, const NotificationParameters &parameters = NotificationParameters(), uint groupId = 0);
     bool updateNotification(uint notificationUserId, uint notificationId, const NotificationParameters &parameters = NotificationParameters());
+    QList<uint> addNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications);
+    bool updateNotifications(uint notificationUserId, const QList<QPair<uint, NotificationParameters> > &notifications);
+    bool removeNotifications(uint notificationUserId, const QList<uint> &notificationIds);
+    uint addOrUpdateNotification(uint notificationUserId, uint groupId, const QString &identifier, const NotificationParameters &parameters = NotificationParameters());
+    bool removeNotificationsWithIdentifier(uint notificationUserId, const QString &identifier);
     uint addGroup(uint notificationUserId, const NotificationParameters &parameters = NotificationParameters());
     bool updateGroup(uint notificationUserId, uint groupId, const NotificationParameters &parameters = NotificationParameters());
     bool removeGroup(uint notificationUserId, uint groupId);
+    uint addOrUpdateGroup(uint notificationUserId, const QString &identifier, const NotificationParameters &parameters = NotificationParameters());
+    bool removeGroupsWithIdentifier(uint notificationUserId, const QString &identifier);
     uint notificationUserId();
     QList<uint> notificationIdList(uint notificationUserId);
     QList<Notification> notificationList(uint notificationUserId);
@@ -63,6 +70,16 @@ public:
     QList<Notification> notifications() const;
     QList<NotificationGroup> groups() const;
     uint notificationCountInGroup(uint notificationUserId, uint groupId);
+    QList<Notification> queryNotifications(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit);
+    uint queryNotificationCount(uint notificationUserId, const QString &eventType, uint groupId, const QString &identifier, uint sinceTimestamp);
+    QList<NotificationGroup> queryGroups(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp, uint lastId, uint limit);
+    uint queryGroupCount(uint notificationUserId, const QString &eventType, const QString &identifier, uint sinceTimestamp);
+    quint64 changeSequence() const;
+    bool changesKnownSince(quint64 sequence) const;
+    QList<NotificationGroup> groupsChangedSince(quint64 sequence) const;
+    QList<Notification> notificationsChangedSince(quint64 sequence) const;
+    QList<uint> groupIdsRemovedSince(quint64 sequence) const;
+    QList<uint> notificationIdsRemovedSince(quint64 sequence) const;
 
     uint nextAvailableNotificationID;
     QList<Notification> notificationContainer;
@@ -0,0 +1,163 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include "qdbusargument_fake.h"
+#include "ut_mnotificationlistproxy.h"
+#include "mnotificationproxy.h"
+#include "genericnotificationparameterfactory.h"
+#include "notificationwidgetparameterfactory.h"
+
+#define EVENT_TYPE GenericNotificationParameterFactory::eventTypeKey()
+#define COUNT      GenericNotificationParameterFactory::countKey()
+#define IDENTIFIER GenericNotificationParameterFactory::identifierKey()
+
+#define SUMMARY    NotificationWidgetParameterFactory::summaryKey()
+#define BODY       NotificationWidgetParameterFactory::bodyKey()
+#define IMAGE      NotificationWidgetParameterFactory::imageIdKey()
+#define ACTION     NotificationWidgetParameterFactory::actionKey()
+
+// Returns parameters with all the fields of an MNotification set
+static NotificationParameters fieldParameters(int index)
+{
+    NotificationParameters parameters;
+    parameters.add(EVENT_TYPE, QString("type%1").arg(index));
+    parameters.add(SUMMARY, QString("summary%1").arg(index));
+    parameters.add(BODY, QString("body%1").arg(index));
+    parameters.add(IMAGE, QString("image%1").arg(index));
+    parameters.add(ACTION, QString("action%1").arg(index));
+    parameters.add(COUNT, index + 5);
+    parameters.add(IDENTIFIER, QString("identifier%1").arg(index));
+    return parameters;
+}
+
+// Verifies that the fields of the demarshalled parameters are the same as the fields of the original ones
+static void compareFields(const NotificationParameters &parameters, const NotificationParameters &expectedParameters)
+{
+    QCOMPARE(parameters.value(EVENT_TYPE).toString(), expectedParameters.value(EVENT_TYPE).toString());
+    QCOMPARE(parameters.value(SUMMARY).toString(), expectedParameters.value(SUMMARY).toString());
+    QCOMPARE(parameters.value(BODY).toString(), expectedParameters.value(BODY).toString());
+    QCOMPARE(parameters.value(IMAGE).toString(), expectedParameters.value(IMAGE).toString());
+    QCOMPARE(parameters.value(ACTION).toString(), expectedParameters.value(ACTION).toString());
+    QCOMPARE(parameters.value(COUNT).toUInt(), expectedParameters.value(COUNT).toUInt());
+}
+
+static QList<Notification> notifications()
+{
+    QList<Notification> notifications;
+    notifications.append(Notification(10, 100, 200, fieldParameters(0), Notification::ApplicationEvent, 0));
+    notifications.append(Notification(11, 0, 200, fieldParameters(1), Notification::ApplicationEvent, 0));
+    return notifications;
+}
+
+static QList<NotificationGroup> groups()
+{
+    QList<NotificationGroup> groups;
+    groups.append(NotificationGroup(100, 200, fieldParameters(0)));
+    groups.append(NotificationGroup(101, 200, fieldParameters(1)));
+    return groups;
+}
+
+void Ut_MNotificationListProxy::initTestCase()
+{
+}
+
+void Ut_MNotificationListProxy::cleanupTestCase()
+{
+}
+
+void Ut_MNotificationListProxy::init()
+{
+}
+
+void Ut_MNotificationListProxy::cleanup()
+{
+}
+
+void Ut_MNotificationListProxy::testNotificationListSerialization()
+{
+    MNotificationListProxy list(notifications());
+    MNotificationListProxy demarshalledList;
+
+    QDBusArgument arg;
+    arg << list;
+    arg >> demarshalledList;
+
+    QCOMPARE(demarshalledList.notifications.count(), list.notifications.count());
+    for (int i = 0; i < list.notifications.count(); i++) {
+        QCOMPARE(demarshalledList.notifications.at(i).notificationId(), list.notifications.at(i).notificationId());
+        QCOMPARE(demarshalledList.notifications.at(i).groupId(), list.notifications.at(i).groupId());
+        compareFields(demarshalledList.notifications.at(i).parameters(), list.notifications.at(i).parameters());
+        QVERIFY(!demarshalledList.notifications.at(i).parameters().value(IDENTIFIER).isValid());
+    }
+}
+
+void Ut_MNotificationListProxy::testNotificationWithIdentifierListSerialization()
+{
+    MNotificationWithIdentifierListProxy list(notifications());
+    MNotificationWithIdentifierListProxy demarshalledList;
+
+    QDBusArgument arg;
+    arg << list;
+    arg >> demarshalledList;
+
+    QCOMPARE(demarshalledList.notifications.count(), list.notifications.count());
+    for (int i = 0; i < list.notifications.count(); i++) {
+        QCOMPARE(demarshalledList.notifications.at(i).notificationId(), list.notifications.at(i).notificationId());
+        QCOMPARE(demarshalledList.notifications.at(i).groupId(), list.notifications.at(i).groupId());
+        compareFields(demarshalledList.notifications.at(i).parameters(), list.notifications.at(i).parameters());
+        QCOMPARE(demarshalledList.notifications.at(i).parameters().value(IDENTIFIER).toString(), list.notifications.at(i).parameters().value(IDENTIFIER).toString());
+    }
+}
+
+void Ut_MNotificationListProxy::testGroupListSerialization()
+{
+    MNotificationGroupListProxy list(groups());
+    MNotificationGroupListProxy demarshalledList;
+
+    QDBusArgument arg;
+    arg << list;
+    arg >> demarshalledList;
+
+    QCOMPARE(demarshalledList.groups.count(), list.groups.count());
+    for (int i = 0; i < list.groups.count(); i++) {
+        QCOMPARE(demarshalledList.groups.at(i).groupId(), list.groups.at(i).groupId());
+        compareFields(demarshalledList.groups.at(i).parameters(), list.groups.at(i).parameters());
+        QVERIFY(!demarshalledList.groups.at(i).parameters().value(IDENTIFIER).isValid());
+    }
+}
+
+void Ut_MNotificationListProxy::testGroupWithIdentifierListSerialization()
+{
+    MNotificationGroupWithIdentifierListProxy list(groups());
+    MNotificationGroupWithIdentifierListProxy demarshalledList;
+
+    QDBusArgument arg;
+    arg << list;
+    arg >> demarshalledList;
+
+    QCOMPARE(demarshalledList.groups.count(), list.groups.count());
+    for (int i = 0; i < list.groups.count(); i++) {
+        QCOMPARE(demarshalledList.groups.at(i).groupId(), list.groups.at(i).groupId());
+        compareFields(demarshalledList.groups.at(i).parameters(), list.groups.at(i).parameters());
+        QCOMPARE(demarshalledList.groups.at(i).parameters().value(IDENTIFIER).toString(), list.groups.at(i).parameters().value(IDENTIFIER).toString());
+    }
+}
+
+QTEST_APPLESS_MAIN(Ut_MNotificationListProxy)
@@ -0,0 +1,46 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef UT_MNOTIFICATIONLISTPROXY_H
+#define UT_MNOTIFICATIONLISTPROXY_H
+
+#include <QObject>
+
+class Ut_MNotificationListProxy : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Called before the first testfunction is executed
+    void initTestCase();
+    // Called after the last testfunction was executed
+    void cleanupTestCase();
+    // Called before each testfunction is executed
+    void init();
+    // Called after every testfunction
+    void cleanup();
+
+    // Test that the list proxies can be read back from the QDBusArgument they were written to
+    void testNotificationListSerialization();
+    void testNotificationWithIdentifierListSerialization();
+    void testGroupListSerialization();
+    void testGroupWithIdentifierListSerialization();
+};
+
+#endif
@@ -0,0 +1,27 @@
+include(../coverage.pri)
+include(../common_top.pri)
+TARGET = ut_mnotificationlistproxy
+INCLUDEPATH += $$NOTIFICATIONSRCDIR $$LIBNOTIFICATIONSRCDIR
+
+# unit test and unit
+SOURCES += \
+    ut_mnotificationlistproxy.cpp \
+    $$NOTIFICATIONSRCDIR/mnotificationproxy.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notification.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationgroup.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.cpp
+
+# unit test and unit
+HEADERS += \
+    ut_mnotificationlistproxy.h \
+    $$NOTIFICATIONSRCDIR/mnotificationproxy.h \
+    $$LIBNOTIFICATIONSRCDIR/notification.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationgroup.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.h
+
+HEADERS += \
+    qdbusargument_fake.h
+
+include(../common_bot.pri)
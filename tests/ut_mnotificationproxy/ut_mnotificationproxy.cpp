@@ -37,9 +37,6 @@
 #define ICON       NotificationWidgetParameterFactory::iconIdKey()
 #define ACTION     NotificationWidgetParameterFactory::actionKey()
 
-Q_DECLARE_METATYPE(MNotificationProxy);
-Q_DECLARE_METATYPE(MNotificationGroupProxy);
-
 void Ut_MNotificationProxy::init()
 {
     qRegisterMetaType<MNotificationProxy>("MNotificationProxy");
@@ -47,6 +44,12 @@ void Ut_MNotificationProxy::init()
 
     qDBusRegisterMetaType<MNotificationProxy>();
     qDBusRegisterMetaType<MNotificationGroupProxy>();
+    qDBusRegisterMetaType<MNotificationWithIdentifierProxy>();
+    qDBusRegisterMetaType<MNotificationGroupWithIdentifierProxy>();
+    qDBusRegisterMetaType<MNotificationListProxy>();
+    qDBusRegisterMetaType<MNotificationWithIdentifierListProxy>();
+    qDBusRegisterMetaType<MNotificationGroupListProxy>();
+    qDBusRegisterMetaType<MNotificationGroupWithIdentifierListProxy>();
 }
 
 void Ut_MNotificationProxy::cleanup()
@@ -124,4 +127,25 @@ void Ut_MNotificationProxy::testMNotificationGroupProxy()
     QCOMPARE(QString("(usssssu)"), signature);
 }
 
+void Ut_MNotificationProxy::testListProxies()
+{
+    QList<Notification> notifications;
+    notifications.append(Notification(10, 100, 200, NotificationParameters(), Notification::ApplicationEvent, 0));
+    MNotificationListProxy notificationList(notifications);
+    QCOMPARE(notificationList.notifications.count(), 1);
+    QCOMPARE(notificationList.notifications.at(0).notificationId(), (uint)10);
+
+    QList<NotificationGroup> groups;
+    groups.append(NotificationGroup(100, 200, NotificationParameters()));
+    MNotificationGroupListProxy groupList(groups);
+    QCOMPARE(groupList.groups.count(), 1);
+    QCOMPARE(groupList.groups.at(0).groupId(), (uint)100);
+
+    // The lists are serialized the same way as lists of the item proxies
+    QCOMPARE(QString(QDBusMetaType::typeToSignature(qMetaTypeId<MNotificationListProxy>())), QString("a(uusssssu)"));
+    QCOMPARE(QString(QDBusMetaType::typeToSignature(qMetaTypeId<MNotificationWithIdentifierListProxy>())), QString("a(uusssssus)"));
+    QCOMPARE(QString(QDBusMetaType::typeToSignature(qMetaTypeId<MNotificationGroupListProxy>())), QString("a(usssssu)"));
+    QCOMPARE(QString(QDBusMetaType::typeToSignature(qMetaTypeId<MNotificationGroupWithIdentifierListProxy>())), QString("a(usssssus)"));
+}
+
 QTEST_APPLESS_MAIN(Ut_MNotificationProxy)
@@ -45,6 +45,7 @@ private slots:
 
     void testMNotificationProxy();
     void testMNotificationGroupProxy();
+    void testListProxies();
 };
 
 #endif //_UT_STATUSINDICATOR_
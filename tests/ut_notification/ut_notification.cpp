@@ -23,6 +23,13 @@
 #include "ut_notification.h"
 #include "notificationparameters.h"
 #include "notification.h"
+#include <malloc.h>
+
+// Returns the number of bytes currently allocated from the heap
+static int allocatedBytes()
+{
+    return mallinfo().uordblks;
+}
 
 static QDateTime timestamp = QDateTime::fromString("M1d1y9911:11:11", "'M'M'd'd'y'yyhh:mm:ss"); //Fri Jan 1 11:11:11 1999
 
@@ -142,4 +149,142 @@ void Ut_Notification::testDBusSerialization()
              n2.parameters().value("timestamp"));
 }
 
+void Ut_Notification::testHeaderIsResolvedFromParameters()
+{
+    Notification defaultNotification(1234, 20, 678, NotificationParameters(), Notification::ApplicationEvent, 0);
+    QCOMPARE(defaultNotification.isPersistent(), true);
+    QCOMPARE(defaultNotification.priority(), 0);
+    QCOMPARE(defaultNotification.feedbackId(), QString());
+
+    NotificationParameters parameters;
+    parameters.add("persistent", false);
+    parameters.add("priority", 5);
+    parameters.add("feedbackId", "feedback");
+    Notification notification(1234, 20, 678, parameters, Notification::ApplicationEvent, 0);
+    QCOMPARE(notification.isPersistent(), false);
+    QCOMPARE(notification.priority(), 5);
+    QCOMPARE(notification.feedbackId(), QString("feedback"));
+}
+
+void Ut_Notification::testHeaderIsResolvedWhenParametersChange()
+{
+    Notification notification(1234, 20, 678, NotificationParameters(), Notification::ApplicationEvent, 0);
+
+    NotificationParameters updateParameters;
+    updateParameters.add("priority", 3);
+    notification.updateParameters(updateParameters);
+    QCOMPARE(notification.priority(), 3);
+
+    NotificationParameters parameters;
+    parameters.add("persistent", false);
+    parameters.add("feedbackId", "feedback");
+    notification.setParameters(parameters);
+    QCOMPARE(notification.isPersistent(), false);
+    QCOMPARE(notification.priority(), 0);
+    QCOMPARE(notification.feedbackId(), QString("feedback"));
+}
+
+void Ut_Notification::testHeaderIsResolvedWhenDeserializing()
+{
+    NotificationParameters parameters;
+    parameters.add("persistent", false);
+    parameters.add("priority", 5);
+    parameters.add("feedbackId", "feedback");
+    Notification n1(1234, 20, 678, parameters, Notification::ApplicationEvent, 0);
+
+    Notification n2;
+    QByteArray ba;
+    QDataStream stream(&ba, QIODevice::ReadWrite);
+    stream << n1;
+    stream.device()->seek(0);
+    stream >> n2;
+    QCOMPARE(n2.isPersistent(), false);
+    QCOMPARE(n2.priority(), 5);
+    QCOMPARE(n2.feedbackId(), QString("feedback"));
+
+    Notification n3;
+    QDBusArgument arg;
+    arg << n1;
+    arg >> n3;
+    QCOMPARE(n3.isPersistent(), false);
+    QCOMPARE(n3.priority(), 5);
+    QCOMPARE(n3.feedbackId(), QString("feedback"));
+}
+
+void Ut_Notification::testTextIsResolvedFromParameters_data()
+{
+    QTest::addColumn<QString>("summary");
+    QTest::addColumn<QString>("body");
+    QTest::addColumn<QString>("genericTextId");
+    QTest::addColumn<QString>("genericTextCatalogue");
+    QTest::addColumn<bool>("hasText");
+
+    QTest::newRow("No text") << "" << "" << "" << "" << false;
+    QTest::newRow("Summary") << "summary" << "" << "" << "" << true;
+    QTest::newRow("Body") << "" << "body" << "" << "" << true;
+    QTest::newRow("Generic text") << "" << "" << "textId" << "catalogue" << true;
+    QTest::newRow("Generic text without a catalogue") << "" << "" << "textId" << "" << false;
+}
+
+void Ut_Notification::testTextIsResolvedFromParameters()
+{
+    QFETCH(QString, summary);
+    QFETCH(QString, body);
+    QFETCH(QString, genericTextId);
+    QFETCH(QString, genericTextCatalogue);
+    QFETCH(bool, hasText);
+
+    NotificationParameters parameters;
+    parameters.add("summary", summary);
+    parameters.add("body", body);
+    parameters.add("genericTextId", genericTextId);
+    parameters.add("genericTextCatalogue", genericTextCatalogue);
+    Notification notification(1234, 20, 678, parameters, Notification::ApplicationEvent, 0);
+    QCOMPARE(notification.hasText(), hasText);
+
+    notification.setParameters(NotificationParameters());
+    QCOMPARE(notification.hasText(), false);
+}
+
+void Ut_Notification::testCopiesAreIndependent()
+{
+    NotificationParameters parameters;
+    parameters.add("priority", 1);
+    Notification n1(1234, 20, 678, parameters, Notification::ApplicationEvent, 0);
+    Notification n2(n1);
+
+    NotificationParameters updateParameters;
+    updateParameters.add("priority", 2);
+    n2.updateParameters(updateParameters);
+    QCOMPARE(n1.parameters().value("priority").toInt(), 1);
+    QCOMPARE(n1.priority(), 1);
+    QCOMPARE(n2.parameters().value("priority").toInt(), 2);
+    QCOMPARE(n2.priority(), 2);
+
+    Notification n3;
+    n3 = n1;
+    n1.setParameters(NotificationParameters());
+    QCOMPARE(n3.parameters().value("priority").toInt(), 1);
+    QCOMPARE(n3.notificationId(), uint(1234));
+}
+
+void Ut_Notification::testCopyingDoesNotAllocateMemory()
+{
+    NotificationParameters parameters;
+    parameters.add("summary", "summary");
+    parameters.add("body", "body");
+    Notification notification(1234, 20, 678, parameters, Notification::ApplicationEvent, 0);
+
+    // Delivering a notification to several sinks copies it once per sink
+    const int sinkCount = 100;
+    QList<Notification> copies;
+    copies.reserve(sinkCount);
+    int bytesBefore = allocatedBytes();
+    for (int i = 0; i < sinkCount; ++i) {
+        copies.append(notification);
+    }
+    QCOMPARE(allocatedBytes() - bytesBefore, 0);
+    QCOMPARE(copies.last().parameters().value("summary").toString(), QString("summary"));
+}
+
 QTEST_MAIN(Ut_Notification)
@@ -44,6 +44,17 @@ private slots:
 
     // Test serialization into QDBusArgument
     void testDBusSerialization();
+
+    // Test the header resolved from the parameters
+    void testHeaderIsResolvedFromParameters();
+    void testHeaderIsResolvedWhenParametersChange();
+    void testHeaderIsResolvedWhenDeserializing();
+    void testTextIsResolvedFromParameters_data();
+    void testTextIsResolvedFromParameters();
+
+    // Test the implicit sharing
+    void testCopiesAreIndependent();
+    void testCopyingDoesNotAllocateMemory();
 };
 
 #endif
@@ -31,6 +31,7 @@
 #include "notificationsink_stub.h"
 #include "notificationareasink_stub.h"
 #include "widgetnotificationsink_stub.h"
+#include "notificationsinkdispatcher_stub.h"
 
 // Tests
 void Ut_NotificationArea::initTestCase()
@@ -50,9 +51,11 @@ void Ut_NotificationArea::cleanupTestCase()
 void Ut_NotificationArea::init()
 {
     gNotificationAreaSinkStub->stubReset();
+    gNotificationSinkDispatcherStub->stubReset();
     m_subject = new NotificationArea();
 
     connect(this, SIGNAL(addNotification(MBanner &)), m_subject, SLOT(addNotification(MBanner &)));
+    connect(this, SIGNAL(addNotifications(const QList<MBanner *> &)), m_subject, SLOT(addNotifications(const QList<MBanner *> &)));
     connect(this, SIGNAL(removeNotification(MBanner &)), m_subject, SLOT(removeNotification(MBanner &)));
     connect(this, SIGNAL(notificationUpdated(MBanner &)), m_subject, SLOT(moveNotificationToTop(MBanner &)));
 
@@ -103,6 +106,20 @@ void Ut_NotificationArea::testUpdatedNotificationComesFirst()
     QCOMPARE(m_subject->model()->banners().at(0), &notification2);
 }
 
+void Ut_NotificationArea::testAddNotificationsAtOnce()
+{
+    MBanner notification1;
+    emit addNotification(notification1);
+    MBanner notification2;
+    emit addNotification(notification2);
+
+    // The banners should end up in the same order as when added one by one, also when a banner is already in the notification area
+    MBanner notification3;
+    MBanner notification4;
+    emit addNotifications(QList<MBanner *>() << &notification3 << &notification1 << &notification4);
+    QCOMPARE(m_subject->model()->banners(), QList<MBanner *>() << &notification4 << &notification1 << &notification3 << &notification2);
+}
+
 void Ut_NotificationArea::testRemoveAllRemovableBanners()
 {
     QSignalSpy notificationSpy(m_subject, SIGNAL(notificationRemovalRequested(uint)));
@@ -158,4 +175,55 @@ void Ut_NotificationArea::testNotificationSinkUpdatedWhenManagerIsSet()
     QCOMPARE(gNotificationAreaSinkStub->stubCallCount("updateCurrentNotifications") , 1);
 }
 
+void Ut_NotificationArea::testNotificationSinkIsDeferredWhenManagerIsSet()
+{
+    NotificationManager notificationManager;
+    m_subject->setNotificationManagerInterface(notificationManager);
+    QCOMPARE(gNotificationSinkDispatcherStub->stubLastCallTo("NotificationSinkDispatcherConstructor").parameter<QObject *>(0), notificationManager.qObject());
+    QCOMPARE(gNotificationSinkDispatcherStub->stubCallCount("addSink"), 1);
+    QCOMPARE(gNotificationSinkDispatcherStub->stubLastCallTo("addSink").parameter<NotificationSink *>(0), (NotificationSink *)m_subject->notificationAreaSink);
+    QCOMPARE(gNotificationSinkDispatcherStub->stubLastCallTo("addSink").parameter<NotificationSinkDispatcher::LatencyClass>(1), NotificationSinkDispatcher::Deferred);
+    QCOMPARE(gNotificationSinkDispatcherStub->stubLastCallTo("addSink").parameter<NotificationSinkDispatcher::Subscriptions>(2), NotificationSinkDispatcher::Subscriptions(NotificationSinkDispatcher::AllChanges));
+}
+
+// The number of banners in the notification area after restoring the notifications on boot
+static const int BENCHMARK_BANNER_COUNT = 500;
+
+void Ut_NotificationArea::benchmarkAddingNotificationsAtOnce()
+{
+    QList<MBanner *> banners;
+    for (int i = 0; i < BENCHMARK_BANNER_COUNT; ++i) {
+        banners.append(new MBanner);
+    }
+
+    QBENCHMARK {
+        NotificationArea area;
+        area.addNotifications(banners);
+        QCOMPARE(area.model()->banners().count(), BENCHMARK_BANNER_COUNT);
+        QCOMPARE(area.model()->banners().first(), banners.last());
+    }
+
+    qDeleteAll(banners);
+}
+
+void Ut_NotificationArea::benchmarkAddingNotificationsOneByOne()
+{
+    // The baseline for benchmarkAddingNotificationsAtOnce(): every banner updates the model separately
+    QList<MBanner *> banners;
+    for (int i = 0; i < BENCHMARK_BANNER_COUNT; ++i) {
+        banners.append(new MBanner);
+    }
+
+    QBENCHMARK {
+        NotificationArea area;
+        foreach (MBanner *banner, banners) {
+            area.addNotification(*banner);
+        }
+        QCOMPARE(area.model()->banners().count(), BENCHMARK_BANNER_COUNT);
+        QCOMPARE(area.model()->banners().first(), banners.last());
+    }
+
+    qDeleteAll(banners);
+}
+
 QTEST_APPLESS_MAIN(Ut_NotificationArea)
@@ -46,13 +46,18 @@ private slots:
     void testRemoveNotification();
     void testAddNotificationLatestComesFirst();
     void testUpdatedNotificationComesFirst();
+    void testAddNotificationsAtOnce();
     void testRemoveAllRemovableBanners();
     void testHonorPrivacySetting();
     void testWhenNotificationAreaIsCreatedNotificationAreaSinkHasClickablePropertySet();
     void testNotificationSinkUpdatedWhenManagerIsSet();
+    void testNotificationSinkIsDeferredWhenManagerIsSet();
+    void benchmarkAddingNotificationsAtOnce();
+    void benchmarkAddingNotificationsOneByOne();
 
 signals:
     void addNotification(MBanner &notification);
+    void addNotifications(const QList<MBanner *> &notifications);
     void removeNotification(MBanner &notification);
     void notificationUpdated(MBanner &notification);
 
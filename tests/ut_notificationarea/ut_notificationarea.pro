@@ -31,6 +31,7 @@ HEADERS += \
     $$LIBNOTIFICATIONSRCDIR/notificationsink.h \
     $$NOTIFICATIONSRCDIR/widgetnotificationsink.h \
     $$NOTIFICATIONSRCDIR/notificationareasink.h \
+    $$NOTIFICATIONSRCDIR/notificationsinkdispatcher.h \
     $$NOTIFICATIONSRCDIR/notificationmanager.h
 
 include(../common_bot.pri)
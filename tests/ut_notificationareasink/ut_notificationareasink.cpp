@@ -139,6 +139,7 @@ QList<QDateTime> Ut_NotificationAreaSink::timestamps;
 QHash<MBanner *, QString> Ut_NotificationAreaSink::prefixTimeStamps;
 QList<MBanner *> Ut_NotificationAreaSink::notifications;
 QList<MBanner *> Ut_NotificationAreaSink::destroyedNotifications;
+QList<QList<MBanner *> > Ut_NotificationAreaSink::addedNotificationLists;
 
 void MBannerCatcher::mBannerEmitted(MBanner &banner)
 {
@@ -167,6 +168,7 @@ void Ut_NotificationAreaSink::init()
     connect(this, SIGNAL(addGroup(uint, const NotificationParameters &)), sink, SLOT(addGroup(uint, const NotificationParameters &)));
     connect(this, SIGNAL(removeGroup(uint)), sink, SLOT(removeGroup(uint)));
     connect(sink, SIGNAL(addNotification(MBanner &)), this, SLOT(addNotification(MBanner &)));
+    connect(sink, SIGNAL(addNotifications(const QList<MBanner *> &)), this, SLOT(addNotifications(const QList<MBanner *> &)));
     connect(sink, SIGNAL(removeNotification(MBanner &)), this, SLOT(removeNotification(MBanner &)));
 }
 
@@ -177,6 +179,17 @@ void Ut_NotificationAreaSink::addNotification(MBanner &notification)
     notification.setParentItem(new MWidget());
 }
 
+void Ut_NotificationAreaSink::addNotifications(const QList<MBanner *> &notifications)
+{
+    Ut_NotificationAreaSink::addedNotificationLists.append(notifications);
+
+    foreach (MBanner *notification, notifications) {
+        if (!Ut_NotificationAreaSink::notifications.contains(notification)) {
+            addNotification(*notification);
+        }
+    }
+}
+
 void Ut_NotificationAreaSink::removeNotification(MBanner &notification)
 {
     int index = Ut_NotificationAreaSink::notifications.indexOf(&notification);
@@ -204,6 +217,7 @@ void Ut_NotificationAreaSink::cleanup()
     notifications.clear();
     prefixTimeStamps.clear();
     destroyedNotifications.clear();
+    addedNotificationLists.clear();
 }
 void Ut_NotificationAreaSink::testAddNotification()
 {
@@ -526,4 +540,94 @@ void Ut_NotificationAreaSink::testNotUpdatingGroupBannerTimestampPrefixWhenBanne
     QCOMPARE(prefixTimeStamps.count(), 1);
 }
 
+void Ut_NotificationAreaSink::testAddNotificationsAtOnce()
+{
+    QSignalSpy addSpy(sink, SIGNAL(addNotification(MBanner &)));
+    QSignalSpy updateSpy(sink, SIGNAL(notificationAddedToGroup(MBanner &)));
+    emit addGroup(1, TestNotificationParameters("title0", "subtitle0", "icon0", "content0"));
+
+    QList<Notification> notifications;
+    notifications.append(Notification(0, 0, 2, TestNotificationParameters("title1", "subtitle1", "icon1", "content1"), Notification::ApplicationEvent, 1000));
+    notifications.append(Notification(1, 1, 2, TestNotificationParameters("title2", "subtitle2", "icon2", "content2"), Notification::ApplicationEvent, 1000));
+    notifications.append(Notification(2, 0, 2, TestNotificationParameters("title3", "subtitle3", "icon3", "content3"), Notification::ApplicationEvent, 1000));
+    notifications.append(Notification(3, 1, 2, TestNotificationParameters("title4", "subtitle4", "icon4", "content4"), Notification::ApplicationEvent, 1000));
+    sink->addNotifications(notifications);
+
+    // All banners should be added at once, the group banner topmost since it was added to last
+    QCOMPARE(addSpy.count(), 0);
+    QCOMPARE(updateSpy.count(), 0);
+    QCOMPARE(addedNotificationLists.count(), 1);
+    QCOMPARE(addedNotificationLists.at(0).count(), 3);
+    QCOMPARE(addedNotificationLists.at(0).at(0), sink->notificationIdToMBanner.value(0));
+    QCOMPARE(addedNotificationLists.at(0).at(1), sink->notificationIdToMBanner.value(2));
+    QCOMPARE(addedNotificationLists.at(0).at(2), sink->groupIdToMBanner.value(1));
+    QCOMPARE(sink->notificationCountOfGroup.value(1), (uint)2);
+
+    // Adding to a group that is already in the notification area should move it to the top
+    notifications.clear();
+    notifications.append(Notification(4, 1, 2, TestNotificationParameters("title5", "subtitle5", "icon5", "content5"), Notification::ApplicationEvent, 1000));
+    notifications.append(Notification(5, 0, 2, TestNotificationParameters("title6", "subtitle6", "icon6", "content6"), Notification::ApplicationEvent, 1000));
+    sink->addNotifications(notifications);
+    QCOMPARE(addedNotificationLists.count(), 2);
+    QCOMPARE(addedNotificationLists.at(1).count(), 2);
+    QCOMPARE(addedNotificationLists.at(1).at(0), sink->groupIdToMBanner.value(1));
+    QCOMPARE(addedNotificationLists.at(1).at(1), sink->notificationIdToMBanner.value(5));
+}
+
+static QList<Notification> createRestoredNotifications()
+{
+    // 500 notifications restored on boot, every fifth of them in one of ten groups
+    QList<Notification> restoredNotifications;
+    for (uint i = 0; i < 500; ++i) {
+        uint groupId = i % 5 == 0 ? (i / 5) % 10 + 1 : 0;
+        restoredNotifications.append(Notification(i, groupId, 2, TestNotificationParameters("title", "subtitle", "icon", "content", i), Notification::ApplicationEvent, 0));
+    }
+    return restoredNotifications;
+}
+
+void Ut_NotificationAreaSink::benchmarkRestoringNotificationsOnBoot()
+{
+    QList<Notification> restoredNotifications(createRestoredNotifications());
+
+    QBENCHMARK {
+        NotificationAreaSink restoringSink;
+        for (uint groupId = 1; groupId <= 10; ++groupId) {
+            restoringSink.addGroup(groupId, TestNotificationParameters("group", "subtitle", "icon", "content"));
+        }
+        restoringSink.addNotifications(restoredNotifications);
+        QCOMPARE(restoringSink.notificationIdToMBanner.count(), 400);
+
+        titles.clear();
+        subtitles.clear();
+        buttonIcons.clear();
+        timestamps.clear();
+        contents.clear();
+        prefixTimeStamps.clear();
+    }
+}
+
+void Ut_NotificationAreaSink::benchmarkRestoringNotificationsOneByOne()
+{
+    // The baseline for benchmarkRestoringNotificationsOnBoot(): the same notifications added one at a time
+    QList<Notification> restoredNotifications(createRestoredNotifications());
+
+    QBENCHMARK {
+        NotificationAreaSink restoringSink;
+        for (uint groupId = 1; groupId <= 10; ++groupId) {
+            restoringSink.addGroup(groupId, TestNotificationParameters("group", "subtitle", "icon", "content"));
+        }
+        foreach (const Notification &notification, restoredNotifications) {
+            restoringSink.addNotification(notification);
+        }
+        QCOMPARE(restoringSink.notificationIdToMBanner.count(), 400);
+
+        titles.clear();
+        subtitles.clear();
+        buttonIcons.clear();
+        timestamps.clear();
+        contents.clear();
+        prefixTimeStamps.clear();
+    }
+}
+
 QTEST_APPLESS_MAIN(Ut_NotificationAreaSink)
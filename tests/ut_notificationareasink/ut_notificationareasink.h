@@ -57,6 +57,7 @@ public:
     static QHash<MBanner *, QString> prefixTimeStamps;
     static QList<MBanner *> notifications;
     static QList<MBanner *> destroyedNotifications;
+    static QList<QList<MBanner *> > addedNotificationLists;
 
 private:
     MApplication *app;
@@ -65,6 +66,8 @@ private:
 public slots:
     // For faking the addition of a notification to a layout
     void addNotification(MBanner &notification);
+    // For faking the addition of several notifications to a layout at once
+    void addNotifications(const QList<MBanner *> &notifications);
     // For faking the removal of a notification from a layout
     void removeNotification(MBanner &notification);
 
@@ -94,6 +97,9 @@ private slots:
     void testNotificationsFetchedFromNotificationManager();
     void testSetPrefixForNotificationGroupBannerWhenThereIsMoreThanOneNotificationInAGroup();
     void testNotUpdatingGroupBannerTimestampPrefixWhenBannerUpdated();
+    void testAddNotificationsAtOnce();
+    void benchmarkRestoringNotificationsOnBoot();
+    void benchmarkRestoringNotificationsOneByOne();
 
 signals:
     void addGroup(uint groupId, const NotificationParameters &parameters);
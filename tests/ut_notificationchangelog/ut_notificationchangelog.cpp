@@ -0,0 +1,96 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include "ut_notificationchangelog.h"
+#include "notificationchangelog.h"
+
+static const quint64 START_SEQUENCE = 100;
+
+void Ut_NotificationChangeLog::initTestCase()
+{
+}
+
+void Ut_NotificationChangeLog::cleanupTestCase()
+{
+}
+
+void Ut_NotificationChangeLog::init()
+{
+    changeLog = new NotificationChangeLog(START_SEQUENCE, 4);
+}
+
+void Ut_NotificationChangeLog::cleanup()
+{
+    delete changeLog;
+}
+
+void Ut_NotificationChangeLog::testRecordingChangesIncreasesSequence()
+{
+    QCOMPARE(changeLog->sequence(), START_SEQUENCE);
+    changeLog->recordNotificationChange(1);
+    QCOMPARE(changeLog->sequence(), START_SEQUENCE + 1);
+    changeLog->recordGroupChange(1);
+    QCOMPARE(changeLog->sequence(), START_SEQUENCE + 2);
+}
+
+void Ut_NotificationChangeLog::testChangedIdsSinceSequence()
+{
+    changeLog->recordNotificationChange(3);
+    changeLog->recordGroupChange(2);
+    changeLog->recordNotificationChange(1);
+    changeLog->recordNotificationChange(3);
+
+    QCOMPARE(changeLog->notificationIdsChangedSince(START_SEQUENCE), QList<uint>() << 1 << 3);
+    QCOMPARE(changeLog->groupIdsChangedSince(START_SEQUENCE), QList<uint>() << 2);
+    QCOMPARE(changeLog->notificationIdsChangedSince(START_SEQUENCE + 2), QList<uint>() << 1 << 3);
+    QCOMPARE(changeLog->groupIdsChangedSince(START_SEQUENCE + 2), QList<uint>());
+    QCOMPARE(changeLog->notificationIdsChangedSince(START_SEQUENCE + 3), QList<uint>() << 3);
+    QCOMPARE(changeLog->notificationIdsChangedSince(START_SEQUENCE + 4), QList<uint>());
+}
+
+void Ut_NotificationChangeLog::testContainedSequences()
+{
+    QVERIFY(changeLog->contains(START_SEQUENCE));
+    QVERIFY(!changeLog->contains(START_SEQUENCE - 1));
+    QVERIFY(!changeLog->contains(START_SEQUENCE + 1));
+    QVERIFY(!changeLog->contains(0));
+
+    changeLog->recordNotificationChange(1);
+    changeLog->recordNotificationChange(2);
+    QVERIFY(changeLog->contains(START_SEQUENCE));
+    QVERIFY(changeLog->contains(START_SEQUENCE + 2));
+    QVERIFY(!changeLog->contains(START_SEQUENCE + 3));
+}
+
+void Ut_NotificationChangeLog::testOldestChangesAreDroppedWhenFull()
+{
+    for (uint id = 1; id <= 6; ++id) {
+        changeLog->recordNotificationChange(id);
+    }
+
+    QCOMPARE(changeLog->sequence(), START_SEQUENCE + 6);
+    QVERIFY(!changeLog->contains(START_SEQUENCE + 1));
+    QVERIFY(changeLog->contains(START_SEQUENCE + 2));
+    QCOMPARE(changeLog->notificationIdsChangedSince(START_SEQUENCE + 1), QList<uint>());
+    QCOMPARE(changeLog->notificationIdsChangedSince(START_SEQUENCE + 2), QList<uint>() << 3 << 4 << 5 << 6);
+    QCOMPARE(changeLog->notificationIdsChangedSince(START_SEQUENCE + 5), QList<uint>() << 6);
+}
+
+QTEST_MAIN(Ut_NotificationChangeLog)
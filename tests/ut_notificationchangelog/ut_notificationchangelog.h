@@ -0,0 +1,54 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef UT_NOTIFICATIONCHANGELOG_H
+#define UT_NOTIFICATIONCHANGELOG_H
+
+#include <QObject>
+
+class NotificationChangeLog;
+
+class Ut_NotificationChangeLog : public QObject
+{
+    Q_OBJECT
+
+private:
+    NotificationChangeLog *changeLog;
+
+private slots:
+    // Called before the first testfunction is executed
+    void initTestCase();
+    // Called after the last testfunction was executed
+    void cleanupTestCase();
+    // Called before each testfunction is executed
+    void init();
+    // Called after every testfunction
+    void cleanup();
+
+    // Test that every change increases the sequence number by one
+    void testRecordingChangesIncreasesSequence();
+    // Test that the changed IDs are returned once each and separately for notifications and groups
+    void testChangedIdsSinceSequence();
+    // Test that only the sequence numbers whose later changes are all in the log are contained
+    void testContainedSequences();
+    // Test that the oldest changes are dropped when the log is full
+    void testOldestChangesAreDroppedWhenFull();
+};
+
+#endif
@@ -0,0 +1,16 @@
+include(../coverage.pri)
+include(../common_top.pri)
+TARGET = ut_notificationchangelog
+INCLUDEPATH += $$NOTIFICATIONSRCDIR
+
+# unit test and unit
+SOURCES += \
+    ut_notificationchangelog.cpp \
+    $$NOTIFICATIONSRCDIR/notificationchangelog.cpp
+
+# unit test and unit
+HEADERS += \
+    ut_notificationchangelog.h \
+    $$NOTIFICATIONSRCDIR/notificationchangelog.h
+
+include(../common_bot.pri)
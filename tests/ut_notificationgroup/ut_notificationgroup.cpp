@@ -128,4 +128,20 @@ void Ut_NotificationGroup::testDBusSerialization()
              n2.parameters().value("count"));
 }
 
+void Ut_NotificationGroup::testCopiesAreIndependent()
+{
+    NotificationParameters parameters;
+    parameters.add("summary", "summary");
+    NotificationGroup group1(20, 678, parameters);
+    NotificationGroup group2(group1);
+
+    NotificationParameters updateParameters;
+    updateParameters.add("summary", "updated");
+    group2.updateParameters(updateParameters);
+    QCOMPARE(group1.parameters().value("summary").toString(), QString("summary"));
+    QCOMPARE(group2.parameters().value("summary").toString(), QString("updated"));
+    QCOMPARE(group2.groupId(), uint(20));
+    QCOMPARE(group2.userId(), uint(678));
+}
+
 QTEST_MAIN(Ut_NotificationGroup)
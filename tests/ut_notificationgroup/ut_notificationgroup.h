@@ -44,6 +44,9 @@ private slots:
 
     // Test serialization into QDBusArgument
     void testDBusSerialization();
+
+    // Test that modifying a copy doesn't modify the original group
+    void testCopiesAreIndependent();
 };
 
 #endif
@@ -0,0 +1,95 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include "ut_notificationidallocator.h"
+#include "notificationidallocator.h"
+
+void Ut_NotificationIdAllocator::initTestCase()
+{
+}
+
+void Ut_NotificationIdAllocator::cleanupTestCase()
+{
+}
+
+void Ut_NotificationIdAllocator::init()
+{
+    allocator = new NotificationIdAllocator;
+}
+
+void Ut_NotificationIdAllocator::cleanup()
+{
+    delete allocator;
+}
+
+void Ut_NotificationIdAllocator::testAllocatingNewIds()
+{
+    QCOMPARE(allocator->highWaterMark(), (uint)0);
+    QCOMPARE(allocator->allocate(), (uint)1);
+    QCOMPARE(allocator->allocate(), (uint)2);
+    QCOMPARE(allocator->allocate(), (uint)3);
+    QCOMPARE(allocator->highWaterMark(), (uint)3);
+}
+
+void Ut_NotificationIdAllocator::testReleasedIdsAreReused()
+{
+    for (int i = 0; i < 4; ++i) {
+        allocator->allocate();
+    }
+
+    allocator->release(3);
+    allocator->release(1);
+    QCOMPARE(allocator->allocate(), (uint)3);
+    QCOMPARE(allocator->allocate(), (uint)1);
+    QCOMPARE(allocator->allocate(), (uint)5);
+    QCOMPARE(allocator->highWaterMark(), (uint)5);
+}
+
+void Ut_NotificationIdAllocator::testReleasingInvalidIds()
+{
+    allocator->allocate();
+    allocator->release(0);
+    allocator->release(7);
+    QCOMPARE(allocator->allocate(), (uint)2);
+}
+
+void Ut_NotificationIdAllocator::testRestoring()
+{
+    allocator->restore(6, QList<uint>() << 2 << 5);
+
+    QCOMPARE(allocator->highWaterMark(), (uint)6);
+    QCOMPARE(allocator->allocate(), (uint)1);
+    QCOMPARE(allocator->allocate(), (uint)3);
+    QCOMPARE(allocator->allocate(), (uint)4);
+    QCOMPARE(allocator->allocate(), (uint)6);
+    QCOMPARE(allocator->allocate(), (uint)7);
+}
+
+void Ut_NotificationIdAllocator::testRestoringRaisesHighWaterMark()
+{
+    allocator->restore(2, QList<uint>() << 0 << 1 << 4);
+
+    QCOMPARE(allocator->highWaterMark(), (uint)4);
+    QCOMPARE(allocator->allocate(), (uint)2);
+    QCOMPARE(allocator->allocate(), (uint)3);
+    QCOMPARE(allocator->allocate(), (uint)5);
+}
+
+QTEST_MAIN(Ut_NotificationIdAllocator)
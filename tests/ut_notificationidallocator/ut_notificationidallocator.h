@@ -0,0 +1,56 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef UT_NOTIFICATIONIDALLOCATOR_H
+#define UT_NOTIFICATIONIDALLOCATOR_H
+
+#include <QObject>
+
+class NotificationIdAllocator;
+
+class Ut_NotificationIdAllocator : public QObject
+{
+    Q_OBJECT
+
+private:
+    NotificationIdAllocator *allocator;
+
+private slots:
+    // Called before the first testfunction is executed
+    void initTestCase();
+    // Called after the last testfunction was executed
+    void cleanupTestCase();
+    // Called before each testfunction is executed
+    void init();
+    // Called after every testfunction
+    void cleanup();
+
+    // Test that IDs are allocated sequentially starting from 1
+    void testAllocatingNewIds();
+    // Test that released IDs are reused in the order they were released
+    void testReleasedIdsAreReused();
+    // Test that releasing invalid IDs has no effect
+    void testReleasingInvalidIds();
+    // Test that restoring makes the unused IDs up to the high-water mark available
+    void testRestoring();
+    // Test that restoring raises the high-water mark to the highest used ID
+    void testRestoringRaisesHighWaterMark();
+};
+
+#endif
@@ -0,0 +1,16 @@
+include(../coverage.pri)
+include(../common_top.pri)
+TARGET = ut_notificationidallocator
+INCLUDEPATH += $$NOTIFICATIONSRCDIR
+
+# unit test and unit
+SOURCES += \
+    ut_notificationidallocator.cpp \
+    $$NOTIFICATIONSRCDIR/notificationidallocator.cpp
+
+# unit test and unit
+HEADERS += \
+    ut_notificationidallocator.h \
+    $$NOTIFICATIONSRCDIR/notificationidallocator.h
+
+include(../common_bot.pri)
@@ -0,0 +1,200 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QFile>
+#include <QDir>
+#include "ut_notificationjournal.h"
+#include "notificationjournal.h"
+#include "notification.h"
+#include "notificationgroup.h"
+#include "notificationparameters.h"
+
+void Ut_NotificationJournal::initTestCase()
+{
+    journalFileName = QDir::tempPath() + "/ut_notificationjournal.data";
+}
+
+void Ut_NotificationJournal::cleanupTestCase()
+{
+}
+
+void Ut_NotificationJournal::init()
+{
+    QFile::remove(journalFileName);
+    journal = new NotificationJournal(journalFileName);
+}
+
+void Ut_NotificationJournal::cleanup()
+{
+    delete journal;
+    QFile::remove(journalFileName);
+}
+
+void Ut_NotificationJournal::testReplayingEmptyJournal()
+{
+    QHash<uint, Notification> notifications;
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUsedUserId = 5;
+
+    QCOMPARE(journal->replay(notifications, groups, lastUsedUserId), (uint)0);
+    QCOMPARE(notifications.count(), 0);
+    QCOMPARE(groups.count(), 0);
+    QCOMPARE(lastUsedUserId, (quint32)5);
+}
+
+void Ut_NotificationJournal::testReplayingNotificationUpdates()
+{
+    NotificationParameters parameters0;
+    parameters0.add("summary", "summary0");
+    journal->appendNotification(Notification(1, 0, 2, parameters0, Notification::ApplicationEvent, 0));
+
+    NotificationParameters parameters1;
+    parameters1.add("summary", "summary1");
+    journal->appendNotification(Notification(1, 0, 2, parameters1, Notification::ApplicationEvent, 0));
+    journal->appendNotification(Notification(2, 0, 2, parameters0, Notification::SystemEvent, 0));
+
+    QHash<uint, Notification> notifications;
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUsedUserId = 0;
+    NotificationJournal replayedJournal(journalFileName);
+    QCOMPARE(replayedJournal.replay(notifications, groups, lastUsedUserId), (uint)3);
+
+    QCOMPARE(notifications.count(), 2);
+    QCOMPARE(notifications.value(1).userId(), (uint)2);
+    QCOMPARE(notifications.value(1).parameters().value("summary").toString(), QString("summary1"));
+    QCOMPARE(notifications.value(2).type(), Notification::SystemEvent);
+    QCOMPARE(replayedJournal.recordCount(), (uint)3);
+}
+
+void Ut_NotificationJournal::testReplayingNotificationRemovals()
+{
+    journal->appendNotification(Notification(1, 0, 2, NotificationParameters(), Notification::ApplicationEvent, 0));
+    journal->appendNotification(Notification(2, 0, 2, NotificationParameters(), Notification::ApplicationEvent, 0));
+    journal->appendNotificationRemoval(1);
+    journal->appendNotificationRemoval(3);
+
+    QHash<uint, Notification> notifications;
+    notifications.insert(3, Notification(3, 0, 2, NotificationParameters(), Notification::ApplicationEvent, 0));
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUsedUserId = 0;
+    journal->replay(notifications, groups, lastUsedUserId);
+
+    QCOMPARE(notifications.count(), 1);
+    QVERIFY(notifications.contains(2));
+}
+
+void Ut_NotificationJournal::testReplayingReportsRemovedNotificationIds()
+{
+    journal->appendNotificationRemoval(1);
+    journal->appendNotificationRemoval(2);
+    journal->appendNotification(Notification(2, 0, 2, NotificationParameters(), Notification::ApplicationEvent, 0));
+
+    QHash<uint, Notification> notifications;
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUsedUserId = 0;
+    QSet<uint> removedNotificationIds;
+    journal->replay(notifications, groups, lastUsedUserId, NULL, NULL, &removedNotificationIds);
+
+    // A notification added again after its removal is not reported as removed
+    QCOMPARE(removedNotificationIds, QSet<uint>() << 1);
+    QCOMPARE(notifications.count(), 1);
+    QVERIFY(notifications.contains(2));
+}
+
+void Ut_NotificationJournal::testReplayingGroupChanges()
+{
+    NotificationParameters parameters;
+    parameters.add("body", "body0");
+    journal->appendGroup(NotificationGroup(1, 2, parameters));
+    journal->appendGroup(NotificationGroup(2, 2, NotificationParameters()));
+    journal->appendGroupRemoval(2);
+
+    QHash<uint, Notification> notifications;
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUsedUserId = 0;
+    journal->replay(notifications, groups, lastUsedUserId);
+
+    QCOMPARE(groups.count(), 1);
+    QCOMPARE(groups.value(1).userId(), (uint)2);
+    QCOMPARE(groups.value(1).parameters().value("body").toString(), QString("body0"));
+}
+
+void Ut_NotificationJournal::testReplayingLastUsedUserId()
+{
+    journal->appendLastUsedUserId(7);
+    journal->appendLastUsedUserId(8);
+
+    QHash<uint, Notification> notifications;
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUsedUserId = 0;
+    journal->replay(notifications, groups, lastUsedUserId);
+
+    QCOMPARE(lastUsedUserId, (quint32)8);
+}
+
+void Ut_NotificationJournal::testReplayingIdHighWaterMarks()
+{
+    journal->appendIdHighWaterMarks(5, 3);
+    journal->appendNotification(Notification(2, 0, 2, NotificationParameters(), Notification::ApplicationEvent, 0));
+    journal->appendNotificationRemoval(9);
+    journal->appendGroupRemoval(2);
+
+    QHash<uint, Notification> notifications;
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUsedUserId = 0;
+    quint32 notificationIdHighWaterMark = 0;
+    quint32 groupIdHighWaterMark = 4;
+    journal->replay(notifications, groups, lastUsedUserId, &notificationIdHighWaterMark, &groupIdHighWaterMark);
+
+    QCOMPARE(notificationIdHighWaterMark, (quint32)9);
+    QCOMPARE(groupIdHighWaterMark, (quint32)4);
+}
+
+void Ut_NotificationJournal::testRecordCountAndClearing()
+{
+    journal->appendNotificationRemoval(1);
+    journal->appendGroupRemoval(1);
+    QCOMPARE(journal->recordCount(), (uint)2);
+
+    journal->clear();
+    QCOMPARE(journal->recordCount(), (uint)0);
+    QVERIFY(!QFile::exists(journalFileName));
+}
+
+void Ut_NotificationJournal::testReplayingTruncatedJournal()
+{
+    journal->appendNotification(Notification(1, 0, 2, NotificationParameters(), Notification::ApplicationEvent, 0));
+    journal->appendNotification(Notification(2, 0, 2, NotificationParameters(), Notification::ApplicationEvent, 0));
+
+    // Cut the last record in half
+    QFile file(journalFileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    file.resize(file.size() - 4);
+    file.close();
+
+    QHash<uint, Notification> notifications;
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUsedUserId = 0;
+    QCOMPARE(journal->replay(notifications, groups, lastUsedUserId), (uint)1);
+    QCOMPARE(notifications.count(), 1);
+    QVERIFY(notifications.contains(1));
+}
+
+QTEST_MAIN(Ut_NotificationJournal)
@@ -0,0 +1,66 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef UT_NOTIFICATIONJOURNAL_H
+#define UT_NOTIFICATIONJOURNAL_H
+
+#include <QObject>
+#include <QString>
+
+class NotificationJournal;
+
+class Ut_NotificationJournal : public QObject
+{
+    Q_OBJECT
+
+private:
+    NotificationJournal *journal;
+    QString journalFileName;
+
+private slots:
+    // Called before the first testfunction is executed
+    void initTestCase();
+    // Called after the last testfunction was executed
+    void cleanupTestCase();
+    // Called before each testfunction is executed
+    void init();
+    // Called after every testfunction
+    void cleanup();
+
+    // Test that replaying an empty journal does not change anything
+    void testReplayingEmptyJournal();
+    // Test that added and updated notifications are replayed with their latest state
+    void testReplayingNotificationUpdates();
+    // Test that removed notifications are removed when replaying
+    void testReplayingNotificationRemovals();
+    // Test that the IDs of the notifications left removed are reported
+    void testReplayingReportsRemovedNotificationIds();
+    // Test that group changes are replayed
+    void testReplayingGroupChanges();
+    // Test that the last used user ID is replayed
+    void testReplayingLastUsedUserId();
+    // Test that the highest IDs appearing in the journal are replayed as high-water marks
+    void testReplayingIdHighWaterMarks();
+    // Test that records are counted and clearing removes them
+    void testRecordCountAndClearing();
+    // Test that a partially written record at the end of the journal is ignored
+    void testReplayingTruncatedJournal();
+};
+
+#endif
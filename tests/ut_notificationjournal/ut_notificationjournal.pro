@@ -0,0 +1,24 @@
+include(../coverage.pri)
+include(../common_top.pri)
+TARGET = ut_notificationjournal
+INCLUDEPATH += $$NOTIFICATIONSRCDIR $$LIBNOTIFICATIONSRCDIR
+
+# unit test and unit
+SOURCES += \
+    ut_notificationjournal.cpp \
+    $$NOTIFICATIONSRCDIR/notificationjournal.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notification.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationgroup.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.cpp
+
+# unit test and unit
+HEADERS += \
+    ut_notificationjournal.h \
+    $$NOTIFICATIONSRCDIR/notificationjournal.h \
+    $$LIBNOTIFICATIONSRCDIR/notification.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationgroup.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.h
+
+include(../common_bot.pri)
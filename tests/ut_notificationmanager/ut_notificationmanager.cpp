@@ -33,6 +33,9 @@
 #include "genericnotificationparameterfactory.h"
 #include "notificationwidgetparameterfactory.h"
 #include "notificationsink_stub.h"
+#include "notificationjournal.h"
+#include "notificationsnapshot.h"
+#include "metatypedeclarations.h"
 #include <QFile>
 #include <QStringList>
 
@@ -40,6 +43,7 @@ bool Ut_NotificationManager::catchTimerTimeouts;
 QList<int> Ut_NotificationManager::timerTimeouts;
 QBuffer gStateBuffer;
 QBuffer gNotificationBuffer;
+QBuffer gJournalBuffer;
 QList<NotificationGroup> gGroupList;
 QList<NotificationGroup> gGroupListWithIdentifiers;
 QList<Notification> gNotificationList;
@@ -96,7 +100,7 @@ void DBusInterfaceNotificationSink::addNotification(const Notification &)
 {
 }
 
-void DBusInterfaceNotificationSink::sendNotificationsToProxy(const QList<Notification> &, const DBusInterface &) const
+void DBusInterfaceNotificationSink::sendNotificationsToSink(const QList<Notification> &, DBusInterfaceNotificationSinkQueue *) const
 {
 }
 
@@ -104,7 +108,7 @@ void DBusInterfaceNotificationSink::removeNotification(uint)
 {
 }
 
-void DBusInterfaceNotificationSink::sendGroupsToProxy(const QList<NotificationGroup> &, const DBusInterface &) const
+void DBusInterfaceNotificationSink::sendGroupsToSink(const QList<NotificationGroup> &, DBusInterfaceNotificationSinkQueue *) const
 {
 }
 
@@ -116,7 +120,15 @@ void DBusInterfaceNotificationSink::removeGroup(uint)
 {
 }
 
-void DBusInterfaceNotificationSink::sendCurrentNotifications(const DBusInterface&) const
+void DBusInterfaceNotificationSink::sendCurrentNotifications(DBusInterfaceNotificationSinkQueue *) const
+{
+}
+
+void DBusInterfaceNotificationSink::resynchronize(quint64)
+{
+}
+
+void DBusInterfaceNotificationSink::unregisterSinks(const QString &)
 {
 }
 
@@ -136,7 +148,9 @@ QFile::QFile(const QString & name) {
 }
 
 bool QFile::remove(const QString & name) {
-    Q_UNUSED(name)
+    if (name.contains("journal.data")) {
+        gJournalBuffer.buffer().clear();
+    }
     return true;
 }
 
@@ -152,6 +166,8 @@ bool QFile::open(OpenMode mode) {
             return false;
         }
         gNotificationBuffer.open(mode);
+    } else if (fileName.contains("journal.data")) {
+        gJournalBuffer.open(mode);
     } else if (fileName.contains(QDir::tempPath() + "/sysuid_boot")) {
         gBootFileOpenedMode = mode;
     } else {
@@ -166,11 +182,36 @@ void QFile::close() {
         gStateBuffer.close();
     } else if (fileName.contains("notifications.data")) {
         gNotificationBuffer.close();
+    } else if (fileName.contains("journal.data")) {
+        gJournalBuffer.close();
     } else {
         Q_ASSERT(0);
     }
 }
 
+qint64 QFile::size() const
+{
+    QString fileName = gFileInstances.key(this);
+    if (fileName.contains("notifications.data")) {
+        return gNotificationBuffer.buffer().size();
+    }
+    return 0;
+}
+
+uchar *QFile::map(qint64 offset, qint64 size, MemoryMapFlags)
+{
+    QString fileName = gFileInstances.key(this);
+    if (fileName.contains("notifications.data") && offset + size <= gNotificationBuffer.buffer().size()) {
+        return reinterpret_cast<uchar *>(gNotificationBuffer.buffer().data()) + offset;
+    }
+    return NULL;
+}
+
+bool QFile::unmap(uchar *)
+{
+    return true;
+}
+
 static bool gBootFileExists;
 bool QFile::exists() const
 {
@@ -194,6 +235,8 @@ void QDataStream::setDevice(QIODevice *d)
         dev = &gStateBuffer;
     } else if (gLastFileName.contains("notifications.data")) {
         dev = &gNotificationBuffer;
+    } else if (gLastFileName.contains("journal.data")) {
+        dev = &gJournalBuffer;
     } else {
         Q_ASSERT(0);
     }
@@ -201,9 +244,10 @@ void QDataStream::setDevice(QIODevice *d)
 
 // EventTypeStore stubs
 QHash<QString, QHash<QString, QString> > gEventTypeSettings;
-EventTypeStore::EventTypeStore(const QString &eventTypesPath, uint maxStoredEventTypes) :
+EventTypeStore::EventTypeStore(const QString &eventTypesPath, uint maxStoredEventTypes, const QString &tableFileName) :
     eventTypesPath(eventTypesPath),
-    maxStoredEventTypes(maxStoredEventTypes)
+    maxStoredEventTypes(maxStoredEventTypes),
+    tableFileName(tableFileName)
 {
 }
 
@@ -226,18 +270,24 @@ void EventTypeStore::updateEventTypeFileList()
 {
 }
 
-void EventTypeStore::updateEventTypeFile(const QString &)
+void EventTypeStore::scheduleUpdate()
 {
 }
 
-void EventTypeStore::loadSettings(const QString &)
+// Helper function for replaying the journal in gJournalBuffer on top of the given data
+void replayJournal(QHash<uint, Notification> &notifications, QHash<uint, NotificationGroup> &groups, quint32 &lastUserId)
 {
+    NotificationJournal journal("journal.data");
+    journal.replay(notifications, groups, lastUserId);
 }
 
 // Helper function for loading the last given user id and group information from gStateBuffer
-// and repopulating gGroupList accordingly
-void loadStateData()
+// and gJournalBuffer and repopulating gGroupList accordingly
+void loadStateData(NotificationManager *manager)
 {
+    // Make sure the pending changes have been written
+    manager->flushPersistentData();
+
     gStateBuffer.open(QIODevice::ReadOnly);
     QDataStream gds(&gStateBuffer);
     gGroupList.clear();
@@ -245,33 +295,51 @@ void loadStateData()
 
     gds >> gLastUserId;
 
+    QHash<uint, NotificationGroup> groups;
     NotificationGroup ng;
 
     while (!gds.atEnd()) {
         gds >> ng;
-        gGroupList.append(ng);
+        groups.insert(ng.groupId(), ng);
+    }
+    gStateBuffer.close();
+
+    QHash<uint, Notification> notifications;
+    replayJournal(notifications, groups, gLastUserId);
+
+    QList<uint> groupIds = groups.keys();
+    qSort(groupIds);
+    foreach (uint groupId, groupIds) {
+        gGroupList.append(groups.value(groupId));
     }
 }
 
 // Helper function for loading notifications from gNotificationBuffer
-// and repopulating gNotificationList
-void loadNotifications()
+// and gJournalBuffer and repopulating gNotificationList
+void loadNotifications(NotificationManager *manager)
 {
-    gNotificationBuffer.open(QIODevice::ReadOnly);
-    QDataStream nds;
-    nds.setDevice(&gNotificationBuffer);
+    // Make sure the pending changes have been written
+    manager->flushPersistentData();
 
     gNotificationList.clear();
     gNotificationListWithIdentifiers.clear();
 
-    gNotificationBuffer.seek(0);
+    QHash<uint, Notification> notifications;
+    NotificationSnapshot snapshot;
+    snapshot.load(gNotificationBuffer.buffer());
+    for (int i = 0; i < snapshot.count(); ++i) {
+        notifications.insert(snapshot.notificationId(i), snapshot.notification(i));
+    }
 
-    Notification notification;
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUserId = 0;
+    replayJournal(notifications, groups, lastUserId);
 
-    while (!nds.atEnd()) {
-        nds >> notification;
-        gNotificationList.append(notification);
-        gNotificationListWithIdentifiers.append(notification);
+    QList<uint> notificationIds = notifications.keys();
+    qSort(notificationIds);
+    foreach (uint notificationId, notificationIds) {
+        gNotificationList.append(notifications.value(notificationId));
+        gNotificationListWithIdentifiers.append(notifications.value(notificationId));
     }
 }
 
@@ -299,6 +367,8 @@ void Ut_NotificationManager::initTestCase()
 {
     qRegisterMetaType<Notification>();
     qRegisterMetaType<NotificationParameters>();
+    qRegisterMetaType<QList<Notification> >();
+    qRegisterMetaType<QList<uint> >();
 }
 
 void Ut_NotificationManager::cleanupTestCase()
@@ -318,6 +388,8 @@ void Ut_NotificationManager::init()
 
     gStateBuffer.open(QIODevice::ReadWrite | QIODevice::Truncate);
     gNotificationBuffer.open(QIODevice::ReadWrite| QIODevice::Truncate);
+    gJournalBuffer.open(QIODevice::ReadWrite | QIODevice::Truncate);
+    gJournalBuffer.close();
     gEventTypeSettings.clear();
     qDateTimeToTime_t = 0;
 }
@@ -338,18 +410,23 @@ void Ut_NotificationManager::testNotificationUserId()
     QVERIFY(id2 != 0);
     QVERIFY(id1 != id2);
 
+    // The storage contains the end of the reserved block of user IDs
+    loadStateData(manager);
+    quint32 reservedUserId = gLastUserId;
+    QVERIFY(reservedUserId >= id2);
+
     delete manager;
 
     manager = new TestNotificationManager(0);
     manager->initializeStore();
 
+    // After a restart the user IDs are allocated after the previously reserved block
     uint id3 = manager->notificationUserId();
-    QVERIFY(id3 != id1);
-    QVERIFY(id3 != id2);
+    QCOMPARE(id3, reservedUserId + 1);
 
-    loadStateData();
+    loadStateData(manager);
 
-    QVERIFY(id3 == gLastUserId);
+    QVERIFY(gLastUserId >= id3);
 
     gNotificationBuffer.buffer().clear();
     gStateBuffer.buffer().clear();
@@ -359,6 +436,38 @@ void Ut_NotificationManager::testNotificationUserId()
     manager = new TestNotificationManager(0);
 }
 
+void Ut_NotificationManager::testNotificationUserIdsAreReservedInBlocks()
+{
+    uint id1 = manager->notificationUserId();
+    manager->flushPersistentData();
+    uint journalRecords = manager->persistenceWorker->journalRecordCount();
+
+    // Allocating the rest of the reserved block doesn't touch the persistent storage
+    uint id2 = 0;
+    for (int i = 0; i < 10; ++i) {
+        id2 = manager->notificationUserId();
+    }
+    QCOMPARE(id2, id1 + 10);
+    manager->flushPersistentData();
+    QCOMPARE(manager->persistenceWorker->journalRecordCount(), journalRecords);
+}
+
+void Ut_NotificationManager::testReservedUserIdBlockIsWrittenBeforeUserIdIsReturned()
+{
+    manager->addNotification(0, NotificationParameters());
+    uint writtenOperations = manager->persistenceWorker->writtenOperations();
+
+    // Reserving a block writes it right away, together with the changes queued before it
+    manager->notificationUserId();
+    QCOMPARE(manager->persistenceWorker->queuedOperations(), (uint)0);
+    QVERIFY(manager->persistenceWorker->writtenOperations() > writtenOperations);
+
+    // Allocating the rest of the block doesn't write anything
+    writtenOperations = manager->persistenceWorker->writtenOperations();
+    manager->notificationUserId();
+    QCOMPARE(manager->persistenceWorker->writtenOperations(), writtenOperations);
+}
+
 void Ut_NotificationManager::testAddNotification()
 {
     QSignalSpy spy(manager, SIGNAL(notificationUpdated(Notification)));
@@ -439,6 +548,36 @@ void Ut_NotificationManager::testWhenNotificationIsAddedThenTheNotificationIsFil
     QCOMPARE(notification.parameters().value(PERSISTENT).toBool(), true);
 }
 
+void Ut_NotificationManager::testEventTypeDataIsNotStoredInPersistentStorage()
+{
+    gEventTypeSettings["persistent"][PERSISTENT] = "true";
+    gEventTypeSettings["persistent"][IMAGE] = "iconId";
+
+    delete manager;
+    manager = new TestNotificationManager(3000);
+
+    NotificationParameters parameters;
+    parameters.add(EVENT_TYPE, "persistent");
+    parameters.add(BODY, "body");
+    parameters.add(IMAGE, "icon");
+    uint id = manager->addNotification(0, parameters);
+
+    // The event type data is available to the sinks but overrides the data of the notification
+    Notification notification = manager->notificationContainer.value(id);
+    QCOMPARE(notification.parameters().value(IMAGE).toString(), QString("iconId"));
+    QCOMPARE(notification.parameters().value(PERSISTENT).toBool(), true);
+    QCOMPARE(notification.parameters().value(BODY).toString(), QString("body"));
+
+    // Only the data of the notification is stored
+    loadNotifications(manager);
+    QCOMPARE(gNotificationList.count(), 1);
+    NotificationParameters storedParameters = gNotificationList.at(0).parameters();
+    QCOMPARE(storedParameters.value(EVENT_TYPE).toString(), QString("persistent"));
+    QCOMPARE(storedParameters.value(BODY).toString(), QString("body"));
+    QVERIFY(!storedParameters.value(IMAGE).isValid());
+    QVERIFY(!storedParameters.value(PERSISTENT).isValid());
+}
+
 void Ut_NotificationManager::testNotificationsAndGroupsAreUpdatedWhenEventTypeIsUpdated()
 {
     connect(this, SIGNAL(eventTypeModified(QString)),
@@ -485,6 +624,36 @@ void Ut_NotificationManager::testNotificationsAndGroupsAreUpdatedWhenEventTypeIs
     QCOMPARE(parameters.value(IMAGE).toString(), QString("modified-iconId"));
 }
 
+void Ut_NotificationManager::testNotificationsAreUpdatedInOneTransactionWhenSeveralEventTypesAreUpdated()
+{
+    connect(this, SIGNAL(eventTypesModified(QStringList)),
+            manager, SLOT(updateNotificationsAndGroupsWithEventTypes(QStringList)));
+
+    gEventTypeSettings["testType1"][IMAGE] = "iconId1";
+    gEventTypeSettings["testType2"][IMAGE] = "iconId2";
+    NotificationParameters parameters1;
+    parameters1.add(EVENT_TYPE, "testType1");
+    manager->addNotification(0, parameters1);
+    NotificationParameters parameters2;
+    parameters2.add(EVENT_TYPE, "testType2");
+    manager->addNotification(0, parameters2);
+
+    QSignalSpy notificationSpy(manager, SIGNAL(notificationUpdated(Notification)));
+    QSignalSpy notificationsSpy(manager, SIGNAL(notificationsUpdated(QList<Notification>)));
+
+    gEventTypeSettings["testType1"][IMAGE] = "modified-iconId1";
+    gEventTypeSettings["testType2"][IMAGE] = "modified-iconId2";
+    emit eventTypesModified(QStringList() << "testType1" << "testType2");
+
+    // The sinks should be informed about the notifications of both event types at once
+    QCOMPARE(notificationSpy.count(), 0);
+    QCOMPARE(notificationsSpy.count(), 1);
+    QList<Notification> notifications = qvariant_cast<QList<Notification> >(notificationsSpy.at(0).at(0));
+    QCOMPARE(notifications.count(), 2);
+    QCOMPARE(notifications.at(0).parameters().value(IMAGE).toString(), QString("modified-iconId1"));
+    QCOMPARE(notifications.at(1).parameters().value(IMAGE).toString(), QString("modified-iconId2"));
+}
+
 void Ut_NotificationManager::testUpdateNotification()
 {
     QSignalSpy spy(manager, SIGNAL(notificationUpdated(Notification)));
@@ -695,6 +864,7 @@ void Ut_NotificationManager::testRemoveGroupWithNotifications()
     QSignalSpy addSpy(manager, SIGNAL(notificationUpdated(Notification)));
     QSignalSpy removeGroupSpy(manager, SIGNAL(groupRemoved(uint)));
     QSignalSpy removeNotificationSpy(manager, SIGNAL(notificationRemoved(uint)));
+    QSignalSpy removeNotificationsSpy(manager, SIGNAL(notificationsRemoved(QList<uint>)));
 
     NotificationParameters gparameters1;
     uint groupId = addGroup(&gparameters1, "1", 1);
@@ -707,12 +877,11 @@ void Ut_NotificationManager::testRemoveGroupWithNotifications()
 
     manager->doRemoveGroup(groupId);
 
+    // The notifications are removed in one batch before the group
     QCOMPARE(removeGroupSpy.count(), 1);
-    QCOMPARE(removeNotificationSpy.count(), 2);
-    QList<QVariant> arguments = removeNotificationSpy.takeFirst();
-    QCOMPARE(arguments.at(0).toUInt(), id0);
-    arguments = removeNotificationSpy.takeFirst();
-    QCOMPARE(arguments.at(0).toUInt(), id1);
+    QCOMPARE(removeNotificationSpy.count(), 0);
+    QCOMPARE(removeNotificationsSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QList<uint> >(removeNotificationsSpy.takeFirst().at(0)), QList<uint>() << id0 << id1);
 }
 
 void Ut_NotificationManager::testRemovingAllNotificationsFromAGroup()
@@ -1105,7 +1274,7 @@ void Ut_NotificationManager::testRemoveNotificationRelaysNotificationFromWaitQue
 
 void Ut_NotificationManager::testRemoveNotificationsInGroup()
 {
-    QSignalSpy removeSpy(manager, SIGNAL(notificationRemoved(uint)));
+    QSignalSpy removeSpy(manager, SIGNAL(notificationsRemoved(QList<uint>)));
 
     NotificationParameters gparameters1;
     gparameters1.add(IMAGE, "gicon1");
@@ -1122,9 +1291,8 @@ void Ut_NotificationManager::testRemoveNotificationsInGroup()
     manager->removeNotificationsInGroup(groupId);
 
     // Test that the relevant signals are sent
-    QCOMPARE(removeSpy.count(), 2);
-    QCOMPARE(removeSpy.at(0).at(0).toUInt(), id0);
-    QCOMPARE(removeSpy.at(1).at(0).toUInt(), id1);
+    QCOMPARE(removeSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QList<uint> >(removeSpy.at(0).at(0)), QList<uint>() << id0 << id1);
 }
 
 void Ut_NotificationManager::testNotificationIdList()
@@ -1384,7 +1552,7 @@ void Ut_NotificationManager::testGroupInfoStorage()
     uint id0 = addGroup(&parameters0, "0", 1);
     NotificationParameters parameters1;
     uint id1 = addGroup(&parameters1, "1", 2);
-    loadStateData();
+    loadStateData(manager);
     QCOMPARE((uint)gGroupList.count(), (uint)2);
     QCOMPARE((uint)gGroupList.at(0).groupId(), id0);
     QCOMPARE((uint)gGroupList.at(1).groupId(), id1);
@@ -1395,7 +1563,7 @@ void Ut_NotificationManager::testGroupInfoStorage()
 
     // Remove group and check that it is removed
     manager->doRemoveGroup(id0);
-    loadStateData();
+    loadStateData(manager);
     QCOMPARE((uint)gGroupList.count(), (uint)1);
     QCOMPARE((uint)gGroupList.at(0).groupId(), id1);
     ng = gGroupList.at(0);
@@ -1403,7 +1571,7 @@ void Ut_NotificationManager::testGroupInfoStorage()
 
     // Update group and verify that it is updated
     manager->updateGroup(0, id1, parameters0);
-    loadStateData();
+    loadStateData(manager);
     QCOMPARE((uint)gGroupList.count(), (uint)1);
     QCOMPARE((uint)gGroupList.at(0).groupId(), id1);
     ng = gGroupList.at(0);
@@ -1496,7 +1664,7 @@ void Ut_NotificationManager::testNotificationStorage()
     manager->addNotification(0, parameters2, gid1);
 
     // Load notifications and check that they are restored
-    loadNotifications();
+    loadNotifications(manager);
     QCOMPARE((uint)gNotificationList.count(), (uint)3);
     Notification notification = gNotificationList.at(0);
     QCOMPARE(notification.parameters().value(IMAGE).toString(), QString("icon0"));
@@ -1507,7 +1675,7 @@ void Ut_NotificationManager::testNotificationStorage()
 
     // Remove one notification and check that it is removed from persistent storage
     manager->removeNotification(id0);
-    loadNotifications();
+    loadNotifications(manager);
     QCOMPARE((uint)gNotificationList.count(), (uint)2);
     notification = gNotificationList.at(0);
     QCOMPARE(notification.parameters().value(BODY).toString(), QString("body1"));
@@ -1516,7 +1684,7 @@ void Ut_NotificationManager::testNotificationStorage()
 
     // Verify that persistent storage notifications can be updated
     manager->updateNotification(0, id1, parameters0);
-    loadNotifications();
+    loadNotifications(manager);
     QCOMPARE((uint)gNotificationList.count(), (uint)2);
     notification = gNotificationList.at(0);
     QCOMPARE(notification.parameters().value(IMAGE).toString(), QString("icon0"));
@@ -1550,25 +1718,25 @@ void Ut_NotificationManager::testNotificationRestoration()
 
     gEventTypeSettings["testType"][IMAGE] = "iconId";
     manager = new TestNotificationManager(0);
-    QSignalSpy spy(manager, SIGNAL(notificationRestored(Notification)));
+    QSignalSpy spy(manager, SIGNAL(notificationsRestored(QList<Notification>)));
     manager->restoreData();
 
     // Verify that timer was not started
     QCOMPARE(timerTimeouts.count(), 0);
 
-    // Check that three notifications were created with the given parameters
-    QCOMPARE(spy.count(), 3);
+    // Check that three notifications were created with the given parameters and restored at once
+    QCOMPARE(spy.count(), 1);
+    QList<Notification> notifications = qvariant_cast<QList<Notification> >(spy.takeFirst().at(0));
+    QCOMPARE(notifications.count(), 3);
 
-    QList<QVariant> arguments = spy.takeFirst();
-    Notification n = qvariant_cast<Notification>(arguments.at(0));
+    Notification n = notifications.at(0);
     QCOMPARE(n.notificationId(), (uint)0);
     QCOMPARE(n.groupId(), (uint)3);
     QCOMPARE(n.parameters().value(IMAGE).toString(), QString("iconId"));
     QCOMPARE(n.type(), Notification::ApplicationEvent);
     QCOMPARE(n.timeout(), 0);
 
-    arguments = spy.takeFirst();
-    n = qvariant_cast<Notification>(arguments.at(0));
+    n = notifications.at(1);
     QCOMPARE(n.notificationId(), (uint)1);
     QCOMPARE(n.groupId(), (uint)4);
     QCOMPARE(n.parameters().value(IMAGE).toString(), QString("iconId"));
@@ -1576,8 +1744,7 @@ void Ut_NotificationManager::testNotificationRestoration()
     QCOMPARE(n.type(), Notification::SystemEvent);
     QCOMPARE(n.timeout(), 1000);
 
-    arguments = spy.takeFirst();
-    n = qvariant_cast<Notification>(arguments.at(0));
+    n = notifications.at(2);
     QCOMPARE(n.notificationId(), (uint)2);
     QCOMPARE(n.groupId(), (uint)5);
     QCOMPARE(n.parameters().value(IMAGE).toString(), QString());
@@ -1586,6 +1753,108 @@ void Ut_NotificationManager::testNotificationRestoration()
     QCOMPARE(n.timeout(), 2000);
 }
 
+void Ut_NotificationManager::testChangesAreAppendedToJournal()
+{
+    gNotificationBuffer.buffer().clear();
+    gStateBuffer.buffer().clear();
+
+    uint groupId = manager->addGroup(0, NotificationParameters());
+    uint notificationId = manager->addNotification(0, NotificationParameters(), groupId);
+    manager->flushPersistentData();
+
+    // The snapshots should not have been touched
+    QCOMPARE(gStateBuffer.buffer().size(), 0);
+    QCOMPARE(gNotificationBuffer.buffer().size(), 0);
+    QCOMPARE(manager->persistenceWorker->journalRecordCount(), (uint)2);
+
+    // Each change should add a record to the journal
+    manager->removeNotification(notificationId);
+    QCOMPARE(manager->persistenceWorker->journalRecordCount(), (uint)3);
+
+    loadNotifications(manager);
+    QCOMPARE(gNotificationList.count(), 0);
+    loadStateData(manager);
+    QCOMPARE(gGroupList.count(), 1);
+    QCOMPARE(gGroupList.at(0).groupId(), groupId);
+}
+
+void Ut_NotificationManager::testJournalIsReplayedWhenRestoring()
+{
+    delete manager;
+
+    // Write a snapshot with two notifications
+    gNotificationBuffer.buffer().clear();
+    gNotificationBuffer.open(QIODevice::WriteOnly);
+    QDataStream stream(&gNotificationBuffer);
+    NotificationParameters parameters0;
+    parameters0.add(BODY, "body0");
+    stream << Notification(1, 0, 0, parameters0, Notification::ApplicationEvent, 0);
+    stream << Notification(2, 0, 0, parameters0, Notification::ApplicationEvent, 0);
+    gNotificationBuffer.close();
+
+    // Remove the first one and update the second one in the journal
+    NotificationParameters parameters1;
+    parameters1.add(BODY, "body1");
+    NotificationJournal journal("journal.data");
+    journal.appendNotificationRemoval(1);
+    journal.appendNotification(Notification(2, 0, 0, parameters1, Notification::ApplicationEvent, 0));
+
+    manager = new TestNotificationManager(0);
+    QSignalSpy spy(manager, SIGNAL(notificationsRestored(QList<Notification>)));
+    manager->restoreData();
+
+    QCOMPARE(spy.count(), 1);
+    QList<Notification> notifications = qvariant_cast<QList<Notification> >(spy.takeFirst().at(0));
+    QCOMPARE(notifications.count(), 1);
+    Notification n = notifications.at(0);
+    QCOMPARE(n.notificationId(), (uint)2);
+    QCOMPARE(n.parameters().value(BODY).toString(), QString("body1"));
+}
+
+void Ut_NotificationManager::testInitializingStoreCompactsJournal()
+{
+    gNotificationBuffer.buffer().clear();
+    manager->addNotification(0, NotificationParameters());
+    manager->flushPersistentData();
+    QVERIFY(gJournalBuffer.buffer().size() > 0);
+
+    delete manager;
+    manager = new TestNotificationManager(0);
+    manager->initializeStore();
+    manager->flushPersistentData();
+
+    // The notification should now be in the snapshot and the journal should be empty
+    QCOMPARE(gJournalBuffer.buffer().size(), 0);
+    QCOMPARE(manager->persistenceWorker->journalRecordCount(), (uint)0);
+    loadNotifications(manager);
+    QCOMPARE(gNotificationList.count(), 1);
+}
+
+void Ut_NotificationManager::testRestoredIdsAreNotAllocatedAgain()
+{
+    delete manager;
+
+    // Write a snapshot with notifications 1 and 3
+    gNotificationBuffer.buffer().clear();
+    gNotificationBuffer.open(QIODevice::WriteOnly);
+    QDataStream stream(&gNotificationBuffer);
+    stream << Notification(1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0);
+    stream << Notification(3, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0);
+    gNotificationBuffer.close();
+
+    // Notification 5 was allocated and removed after the snapshot
+    NotificationJournal journal("journal.data");
+    journal.appendNotificationRemoval(5);
+
+    manager = new TestNotificationManager(0);
+    manager->restoreData();
+
+    QCOMPARE(manager->addNotification(0), (uint)2);
+    QCOMPARE(manager->addNotification(0), (uint)4);
+    QCOMPARE(manager->addNotification(0), (uint)5);
+    QCOMPARE(manager->addNotification(0), (uint)6);
+}
+
 void Ut_NotificationManager::testRemovingNotificationsWithEventType()
 {
     QSignalSpy notificationRemovedSpy(manager, SIGNAL(notificationRemoved(uint)));
@@ -1604,6 +1873,35 @@ void Ut_NotificationManager::testRemovingNotificationsWithEventType()
     QCOMPARE(notificationRemovedSpy.takeFirst()[0].toUInt(), id0);
 }
 
+void Ut_NotificationManager::testRemovingNotificationsAndGroupsWithEventTypeInOneBatch()
+{
+    NotificationParameters parameters;
+    parameters.add(EVENT_TYPE, "sms");
+    uint groupId = manager->addGroup(0, parameters);
+    uint id0 = manager->addNotification(0, parameters);
+    uint id1 = manager->addNotification(0, NotificationParameters(), groupId);
+    uint id2 = manager->addNotification(0, parameters);
+    manager->flushPersistentData();
+    uint journalRecords = manager->persistenceWorker->journalRecordCount();
+
+    QSignalSpy notificationRemovedSpy(manager, SIGNAL(notificationRemoved(uint)));
+    QSignalSpy notificationsRemovedSpy(manager, SIGNAL(notificationsRemoved(QList<uint>)));
+    QSignalSpy groupRemovedSpy(manager, SIGNAL(groupRemoved(uint)));
+
+    manager->removeNotificationsAndGroupsWithEventType("sms");
+
+    // The sinks are informed about all removed notifications at once
+    QCOMPARE(notificationRemovedSpy.count(), 0);
+    QCOMPARE(notificationsRemovedSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QList<uint> >(notificationsRemovedSpy.at(0).at(0)), QList<uint>() << id0 << id2 << id1);
+    QCOMPARE(groupRemovedSpy.count(), 1);
+    QCOMPARE(groupRemovedSpy.at(0).at(0).toUInt(), groupId);
+
+    // Each removal is written to the journal
+    manager->flushPersistentData();
+    QCOMPARE(manager->persistenceWorker->journalRecordCount(), journalRecords + 4);
+}
+
 void Ut_NotificationManager::testRemovingGroupsWithEventType()
 {
     QSignalSpy groupRemovedSpy(manager, SIGNAL(groupRemoved(uint)));
@@ -1622,17 +1920,524 @@ void Ut_NotificationManager::testRemovingGroupsWithEventType()
     QCOMPARE(groupRemovedSpy.takeFirst()[0].toUInt(), id1);
 }
 
+void Ut_NotificationManager::testRemovingNotificationsWithChangedEventType()
+{
+    QSignalSpy notificationRemovedSpy(manager, SIGNAL(notificationRemoved(uint)));
+
+    NotificationParameters parameters0;
+    parameters0.add(EVENT_TYPE, "sms");
+    uint id0 = manager->addNotification(0, parameters0);
+
+    // change the event type of the notification
+    NotificationParameters parameters1;
+    parameters1.add(EVENT_TYPE, "email");
+    manager->updateNotification(0, id0, parameters1);
+
+    manager->removeNotificationsAndGroupsWithEventType("sms");
+    QCOMPARE(notificationRemovedSpy.count(), 0);
+
+    manager->removeNotificationsAndGroupsWithEventType("email");
+    QCOMPARE(notificationRemovedSpy.count(), 1);
+    QCOMPARE(notificationRemovedSpy.takeFirst()[0].toUInt(), id0);
+}
+
+void Ut_NotificationManager::testListsAreUpdatedWhenNotificationsAndGroupsAreRemoved()
+{
+    uint groupId = manager->addGroup(1);
+    uint id0 = manager->addNotification(1, NotificationParameters(), groupId);
+    uint id1 = manager->addNotification(1, NotificationParameters(), groupId);
+    uint id2 = manager->addNotification(1);
+    QCOMPARE(manager->notificationIdList(1), QList<uint>() << id0 << id1 << id2);
+    QCOMPARE(manager->notificationCountInGroup(1, groupId), (uint)2);
+
+    manager->removeNotification(id0);
+    QCOMPARE(manager->notificationIdList(1), QList<uint>() << id1 << id2);
+    QCOMPARE(manager->notificationCountInGroup(1, groupId), (uint)1);
+
+    manager->doRemoveGroup(groupId);
+    QCOMPARE(manager->notificationIdList(1), QList<uint>() << id2);
+    QCOMPARE(manager->notificationCountInGroup(1, groupId), (uint)0);
+    QCOMPARE(manager->notificationGroupList(1).count(), 0);
+}
+
+void Ut_NotificationManager::testAddingNotificationsInBatch()
+{
+    uint groupId = manager->addGroup(0, NotificationParameters());
+    manager->flushPersistentData();
+
+    QSignalSpy notificationSpy(manager, SIGNAL(notificationUpdated(Notification)));
+    QSignalSpy notificationsSpy(manager, SIGNAL(notificationsUpdated(QList<Notification>)));
+    QSignalSpy groupSpy(manager, SIGNAL(groupUpdated(uint, const NotificationParameters &)));
+
+    QList<QPair<uint, NotificationParameters> > notifications;
+    for (uint i = 1; i <= 3; ++i) {
+        NotificationParameters parameters;
+        parameters.add(BODY, QString("body%1").arg(i));
+        parameters.add(TIMESTAMP, i * 100);
+        notifications.append(qMakePair(groupId, parameters));
+    }
+    // A notification in a nonexistent group is not added
+    notifications.append(qMakePair(groupId + 1, NotificationParameters()));
+
+    QList<uint> notificationIds = manager->addNotifications(0, notifications);
+    QCOMPARE(notificationIds.count(), 4);
+    QVERIFY(notificationIds.at(0) != 0);
+    QVERIFY(notificationIds.at(1) != 0);
+    QVERIFY(notificationIds.at(2) != 0);
+    QCOMPARE(notificationIds.at(3), (uint)0);
+
+    // The sinks should be informed about all notifications at once
+    QCOMPARE(notificationSpy.count(), 0);
+    QCOMPARE(notificationsSpy.count(), 1);
+    QList<Notification> relayedNotifications = qvariant_cast<QList<Notification> >(notificationsSpy.takeFirst().at(0));
+    QCOMPARE(relayedNotifications.count(), 3);
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(relayedNotifications.at(i).notificationId(), notificationIds.at(i));
+        QCOMPARE(relayedNotifications.at(i).parameters().value(BODY).toString(), QString("body%1").arg(i + 1));
+    }
+
+    // The group timestamp should be updated once
+    QCOMPARE(groupSpy.count(), 1);
+    QCOMPARE(qvariant_cast<NotificationParameters>(groupSpy.takeFirst().at(1)).value(TIMESTAMP).toUInt(), (uint)300);
+
+    // There should be a record for each notification and a single one for the group timestamp
+    manager->flushPersistentData();
+    QCOMPARE(manager->persistenceWorker->journalRecordCount(), (uint)5);
+}
+
+void Ut_NotificationManager::testCommittedBatchAlertsOncePerInterval()
+{
+    delete manager;
+    manager = new TestNotificationManager(5000, 100);
+    catchTimerTimeouts = true;
+
+    QSignalSpy notificationSpy(manager, SIGNAL(notificationUpdated(Notification)));
+    QSignalSpy notificationsSpy(manager, SIGNAL(notificationsUpdated(QList<Notification>)));
+    QSignalSpy alertSpy(manager, SIGNAL(notificationAlerted(Notification)));
+
+    QList<QPair<uint, NotificationParameters> > notifications;
+    for (int i = 0; i < 150; ++i) {
+        NotificationParameters parameters;
+        parameters.add(BODY, QString("body%1").arg(i));
+        notifications.append(qMakePair((uint)0, parameters));
+    }
+    NotificationParameters highPriorityParameters;
+    highPriorityParameters.add("priority", 5);
+    notifications.insert(1, qMakePair((uint)0, highPriorityParameters));
+
+    // The whole batch should be relayed at once but only the notification with the highest priority alerts the user
+    QList<uint> notificationIds = manager->addNotifications(0, notifications);
+    QCOMPARE(notificationSpy.count(), 0);
+    QCOMPARE(notificationsSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QList<Notification> >(notificationsSpy.takeFirst().at(0)).count(), 151);
+    QCOMPARE(alertSpy.count(), 1);
+    QCOMPARE(qvariant_cast<Notification>(alertSpy.takeFirst().at(0)).notificationId(), notificationIds.at(1));
+    QCOMPARE(timerTimeouts, QList<int>() << 5000);
+
+    // The rest alert the user one per interval in the order they were added, as far as they fit in the wait queue
+    QCOMPARE(manager->waitQueue->size(), 99);
+    QList<uint> alertedIds;
+    while (!manager->waitQueue->isEmpty()) {
+        manager->relayNextNotification();
+        QCOMPARE(alertSpy.count(), 1);
+        alertedIds.append(qvariant_cast<Notification>(alertSpy.takeFirst().at(0)).notificationId());
+    }
+    QCOMPARE(alertedIds.count(), 99);
+    QCOMPARE(alertedIds.at(0), notificationIds.at(0));
+    QCOMPARE(alertedIds.at(1), notificationIds.at(2));
+    QCOMPARE(alertedIds.last(), notificationIds.at(99));
+    QCOMPARE(timerTimeouts.count(), 100);
+
+    // The notifications relayed with the batch are not relayed again when they alert the user
+    QCOMPARE(notificationSpy.count(), 0);
+    QCOMPARE(notificationsSpy.count(), 0);
+}
+
+void Ut_NotificationManager::testUpdatingNotificationsInBatch()
+{
+    uint id0 = manager->addNotification(0, NotificationParameters());
+    uint id1 = manager->addNotification(0, NotificationParameters());
+
+    QSignalSpy notificationSpy(manager, SIGNAL(notificationUpdated(Notification)));
+    QSignalSpy notificationsSpy(manager, SIGNAL(notificationsUpdated(QList<Notification>)));
+
+    QList<QPair<uint, NotificationParameters> > notifications;
+    NotificationParameters parameters0;
+    parameters0.add(BODY, "body0");
+    notifications.append(qMakePair(id0, parameters0));
+    NotificationParameters parameters1;
+    parameters1.add(BODY, "body1");
+    notifications.append(qMakePair(id1, parameters1));
+    QVERIFY(manager->updateNotifications(0, notifications));
+
+    QCOMPARE(notificationSpy.count(), 0);
+    QCOMPARE(notificationsSpy.count(), 1);
+    QList<Notification> relayedNotifications = qvariant_cast<QList<Notification> >(notificationsSpy.takeFirst().at(0));
+    QCOMPARE(relayedNotifications.count(), 2);
+    QCOMPARE(relayedNotifications.at(0).parameters().value(BODY).toString(), QString("body0"));
+    QCOMPARE(relayedNotifications.at(1).parameters().value(BODY).toString(), QString("body1"));
+
+    // Updating a nonexistent notification fails but the rest are updated
+    notifications.append(qMakePair(id1 + 1, parameters1));
+    QVERIFY(!manager->updateNotifications(0, notifications));
+    QCOMPARE(notificationsSpy.count(), 1);
+}
+
+void Ut_NotificationManager::testRemovingNotificationsInBatch()
+{
+    QSignalSpy queuedSpy(manager, SIGNAL(queuedNotificationsRemove(QList<uint>)));
+    QSignalSpy removeSpy(manager, SIGNAL(notificationsRemoved(QList<uint>)));
+
+    uint id0 = manager->addNotification(0, NotificationParameters());
+    uint id1 = manager->addNotification(0, NotificationParameters());
+    uint id2 = manager->addNotification(0, NotificationParameters());
+    manager->flushPersistentData();
+    QCOMPARE(manager->persistenceWorker->journalRecordCount(), (uint)3);
+
+    QList<uint> notificationIds;
+    notificationIds << id0 << id2;
+    QVERIFY(manager->removeNotifications(0, notificationIds));
+    QCOMPARE(queuedSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QList<uint> >(queuedSpy.takeFirst().at(0)), notificationIds);
+
+    // Removing a nonexistent notification fails
+    QVERIFY(!manager->removeNotifications(0, QList<uint>() << id1 << id2 + 1));
+
+    manager->doRemoveNotifications(notificationIds);
+    QCOMPARE(removeSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QList<uint> >(removeSpy.at(0).at(0)), notificationIds);
+    QCOMPARE(manager->notificationIdList(0), QList<uint>() << id1);
+
+    manager->flushPersistentData();
+    QCOMPARE(manager->persistenceWorker->journalRecordCount(), (uint)5);
+}
+
+void Ut_NotificationManager::testAddingOrUpdatingNotificationWithIdentifier()
+{
+    uint groupId = manager->addGroup(0, NotificationParameters());
+
+    NotificationParameters parameters;
+    parameters.add(SUMMARY, "summary0");
+    uint id0 = manager->addOrUpdateNotification(0, groupId, "identifier", parameters);
+    QVERIFY(id0 != 0);
+    QCOMPARE(manager->notificationContainer.value(id0).groupId(), groupId);
+    QCOMPARE(manager->notificationContainer.value(id0).parameters().value(IDENTIFIER).toString(), QString("identifier"));
+
+    // The same identifier of the same user updates the existing notification
+    parameters.add(SUMMARY, "summary1");
+    QCOMPARE(manager->addOrUpdateNotification(0, 0, "identifier", parameters), id0);
+    QCOMPARE(manager->notificationContainer.count(), 1);
+    QCOMPARE(manager->notificationContainer.value(id0).parameters().value(SUMMARY).toString(), QString("summary1"));
+    QCOMPARE(manager->notificationContainer.value(id0).groupId(), groupId);
+
+    // The same identifier of another user adds a new notification
+    uint id1 = manager->addOrUpdateNotification(1, 0, "identifier", parameters);
+    QVERIFY(id1 != 0 && id1 != id0);
+
+    // Changing the identifier with an update moves the notification in the index
+    NotificationParameters changedParameters;
+    changedParameters.add(IDENTIFIER, "changed");
+    QVERIFY(manager->updateNotification(0, id0, changedParameters));
+    QCOMPARE(manager->addOrUpdateNotification(0, 0, "changed", parameters), id0);
+    uint id2 = manager->addOrUpdateNotification(0, 0, "identifier", parameters);
+    QVERIFY(id2 != 0 && id2 != id0 && id2 != id1);
+
+    // Adding to a nonexistent group fails
+    QCOMPARE(manager->addOrUpdateNotification(0, groupId + 1, "other", parameters), (uint)0);
+
+    // Notifications without an identifier are always added and get no identifier parameter
+    uint id3 = manager->addOrUpdateNotification(0, 0, QString(), parameters);
+    uint id4 = manager->addOrUpdateNotification(0, 0, QString(), parameters);
+    QVERIFY(id3 != 0 && id4 != 0 && id3 != id4);
+    QVERIFY(!manager->notificationContainer.value(id3).parameters().value(IDENTIFIER).isValid());
+    QVERIFY(!manager->notificationContainer.value(id4).parameters().value(IDENTIFIER).isValid());
+}
+
+void Ut_NotificationManager::testRemovingNotificationsWithIdentifier()
+{
+    QSignalSpy queuedSpy(manager, SIGNAL(queuedNotificationsRemove(QList<uint>)));
+
+    uint id0 = manager->addOrUpdateNotification(0, 0, "identifier", NotificationParameters());
+    uint id1 = manager->addOrUpdateNotification(1, 0, "identifier", NotificationParameters());
+    manager->addOrUpdateNotification(0, 0, "other", NotificationParameters());
+
+    // Nothing is removed when no notification has the identifier
+    QVERIFY(!manager->removeNotificationsWithIdentifier(0, "nonexistent"));
+    QVERIFY(!manager->removeNotificationsWithIdentifier(0, QString()));
+    QCOMPARE(queuedSpy.count(), 0);
+
+    QVERIFY(manager->removeNotificationsWithIdentifier(0, "identifier"));
+    QCOMPARE(queuedSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QList<uint> >(queuedSpy.takeFirst().at(0)), QList<uint>() << id0);
+
+    // Once the notification has been removed it is no longer found by the identifier
+    manager->doRemoveNotifications(QList<uint>() << id0);
+    QVERIFY(!manager->removeNotificationsWithIdentifier(0, "identifier"));
+    QVERIFY(manager->notificationContainer.contains(id1));
+}
+
+void Ut_NotificationManager::testAddingOrUpdatingGroupWithIdentifier()
+{
+    NotificationParameters parameters;
+    parameters.add(SUMMARY, "summary0");
+    uint id0 = manager->addOrUpdateGroup(0, "identifier", parameters);
+    QVERIFY(id0 != 0);
+    QCOMPARE(manager->groupContainer.value(id0).parameters().value(IDENTIFIER).toString(), QString("identifier"));
+
+    // The same identifier of the same user updates the existing group
+    parameters.add(SUMMARY, "summary1");
+    QCOMPARE(manager->addOrUpdateGroup(0, "identifier", parameters), id0);
+    QCOMPARE(manager->groupContainer.count(), 1);
+    QCOMPARE(manager->groupContainer.value(id0).parameters().value(SUMMARY).toString(), QString("summary1"));
+
+    // The same identifier of another user adds a new group
+    uint id1 = manager->addOrUpdateGroup(1, "identifier", parameters);
+    QVERIFY(id1 != 0 && id1 != id0);
+
+    // A removed group is no longer found by the identifier
+    manager->doRemoveGroup(id0);
+    uint id2 = manager->addOrUpdateGroup(0, "identifier", parameters);
+    QVERIFY(id2 != 0 && id2 != id0 && id2 != id1);
+
+    // Groups without an identifier are always added and get no identifier parameter
+    uint id3 = manager->addOrUpdateGroup(0, QString(), parameters);
+    uint id4 = manager->addOrUpdateGroup(0, QString(), parameters);
+    QVERIFY(id3 != 0 && id4 != 0 && id3 != id4);
+    QVERIFY(!manager->groupContainer.value(id3).parameters().value(IDENTIFIER).isValid());
+    QVERIFY(!manager->groupContainer.value(id4).parameters().value(IDENTIFIER).isValid());
+}
+
+void Ut_NotificationManager::testRemovingGroupsWithIdentifier()
+{
+    QSignalSpy queuedSpy(manager, SIGNAL(queuedGroupRemove(uint)));
+
+    uint id0 = manager->addOrUpdateGroup(0, "identifier", NotificationParameters());
+    manager->addOrUpdateGroup(1, "identifier", NotificationParameters());
+
+    QVERIFY(!manager->removeGroupsWithIdentifier(0, "nonexistent"));
+    QCOMPARE(queuedSpy.count(), 0);
+
+    QVERIFY(manager->removeGroupsWithIdentifier(0, "identifier"));
+    QCOMPARE(queuedSpy.count(), 1);
+    QCOMPARE(queuedSpy.takeFirst().at(0).toUInt(), id0);
+}
+
+static QList<uint> notificationIds(const QList<Notification> &notifications)
+{
+    QList<uint> ids;
+    foreach (const Notification &notification, notifications) {
+        ids.append(notification.notificationId());
+    }
+    return ids;
+}
+
+static QList<uint> groupIds(const QList<NotificationGroup> &groups)
+{
+    QList<uint> ids;
+    foreach (const NotificationGroup &group, groups) {
+        ids.append(group.groupId());
+    }
+    return ids;
+}
+
+void Ut_NotificationManager::testQueryingNotifications()
+{
+    uint groupId = manager->addGroup(0, NotificationParameters());
+
+    NotificationParameters parameters1;
+    parameters1.add(EVENT_TYPE, "a");
+    parameters1.add(TIMESTAMP, 100);
+    uint id1 = manager->addNotification(0, parameters1);
+
+    NotificationParameters parameters2;
+    parameters2.add(EVENT_TYPE, "b");
+    parameters2.add(IDENTIFIER, "x");
+    parameters2.add(TIMESTAMP, 200);
+    uint id2 = manager->addNotification(0, parameters2, groupId);
+
+    NotificationParameters parameters3;
+    parameters3.add(EVENT_TYPE, "a");
+    parameters3.add(TIMESTAMP, 300);
+    uint id3 = manager->addNotification(0, parameters3, groupId);
+
+    // A notification of another user is never returned to the first user
+    NotificationParameters parameters4;
+    parameters4.add(EVENT_TYPE, "a");
+    parameters4.add(IDENTIFIER, "x");
+    parameters4.add(TIMESTAMP, 400);
+    uint id4 = manager->addNotification(1, parameters4);
+
+    // Empty criteria match all notifications of the user
+    QCOMPARE(notificationIds(manager->queryNotifications(0, QString(), 0, QString(), 0, 0, 0)), QList<uint>() << id1 << id2 << id3);
+    QCOMPARE(manager->queryNotificationCount(0, QString(), 0, QString(), 0), (uint)3);
+
+    QCOMPARE(notificationIds(manager->queryNotifications(0, "a", 0, QString(), 0, 0, 0)), QList<uint>() << id1 << id3);
+    QCOMPARE(manager->queryNotificationCount(0, "a", 0, QString(), 0), (uint)2);
+    QCOMPARE(notificationIds(manager->queryNotifications(0, QString(), groupId, QString(), 0, 0, 0)), QList<uint>() << id2 << id3);
+    QCOMPARE(manager->queryNotificationCount(0, QString(), groupId, QString(), 0), (uint)2);
+    QCOMPARE(notificationIds(manager->queryNotifications(0, QString(), 0, "x", 0, 0, 0)), QList<uint>() << id2);
+    QCOMPARE(manager->queryNotificationCount(0, QString(), 0, "x", 0), (uint)1);
+    QCOMPARE(notificationIds(manager->queryNotifications(0, QString(), 0, QString(), 150, 0, 0)), QList<uint>() << id2 << id3);
+    QCOMPARE(manager->queryNotificationCount(0, QString(), 0, QString(), 150), (uint)2);
+
+    // All criteria have to match
+    QCOMPARE(notificationIds(manager->queryNotifications(0, "a", groupId, QString(), 150, 0, 0)), QList<uint>() << id3);
+    QCOMPARE(manager->queryNotificationCount(0, "b", groupId, "x", 250), (uint)0);
+    QCOMPARE(notificationIds(manager->queryNotifications(1, "a", 0, "x", 0, 0, 0)), QList<uint>() << id4);
+
+    // The last ID of the previous page and the limit select the next page of the matching notifications
+    QCOMPARE(notificationIds(manager->queryNotifications(0, QString(), 0, QString(), 0, 0, 1)), QList<uint>() << id1);
+    QCOMPARE(notificationIds(manager->queryNotifications(0, QString(), 0, QString(), 0, id1, 1)), QList<uint>() << id2);
+    QCOMPARE(notificationIds(manager->queryNotifications(0, QString(), 0, QString(), 0, id1, 5)), QList<uint>() << id2 << id3);
+    QCOMPARE(notificationIds(manager->queryNotifications(0, "a", 0, QString(), 0, id1, 0)), QList<uint>() << id3);
+    QCOMPARE(notificationIds(manager->queryNotifications(0, "a", 0, QString(), 0, id2, 0)), QList<uint>() << id3);
+    QCOMPARE(notificationIds(manager->queryNotifications(0, QString(), 0, QString(), 150, id2, 0)), QList<uint>() << id3);
+    QVERIFY(manager->queryNotifications(0, QString(), 0, QString(), 0, id3, 0).isEmpty());
+}
+
+void Ut_NotificationManager::testQueryingNotificationsAfterUpdatesAndRemovals()
+{
+    NotificationParameters parameters;
+    parameters.add(EVENT_TYPE, "a");
+    parameters.add(TIMESTAMP, 100);
+    uint id1 = manager->addNotification(0, parameters);
+    uint id2 = manager->addNotification(0, parameters);
+
+    // Updating the timestamp moves the notification past the cursor
+    NotificationParameters updatedParameters;
+    updatedParameters.add(EVENT_TYPE, "b");
+    updatedParameters.add(TIMESTAMP, 500);
+    QVERIFY(manager->updateNotification(0, id1, updatedParameters));
+    QCOMPARE(notificationIds(manager->queryNotifications(0, QString(), 0, QString(), 450, 0, 0)), QList<uint>() << id1);
+    QCOMPARE(notificationIds(manager->queryNotifications(0, "a", 0, QString(), 0, 0, 0)), QList<uint>() << id2);
+
+    // Removed notifications are not returned
+    manager->removeNotification(id1);
+    QVERIFY(manager->queryNotifications(0, QString(), 0, QString(), 450, 0, 0).isEmpty());
+    QCOMPARE(manager->queryNotificationCount(0, "b", 0, QString(), 0), (uint)0);
+    QCOMPARE(manager->queryNotificationCount(0, QString(), 0, QString(), 0), (uint)1);
+    QVERIFY(!manager->notificationIdsByTimestamp.value(0).values().contains(id1));
+}
+
+void Ut_NotificationManager::testQueryingGroups()
+{
+    NotificationParameters parameters1;
+    parameters1.add(EVENT_TYPE, "a");
+    parameters1.add(IDENTIFIER, "x");
+    parameters1.add(TIMESTAMP, 100);
+    uint id1 = manager->addGroup(0, parameters1);
+
+    NotificationParameters parameters2;
+    parameters2.add(EVENT_TYPE, "b");
+    parameters2.add(TIMESTAMP, 200);
+    uint id2 = manager->addGroup(0, parameters2);
+
+    NotificationParameters parameters3;
+    parameters3.add(EVENT_TYPE, "a");
+    parameters3.add(TIMESTAMP, 300);
+    uint id3 = manager->addGroup(0, parameters3);
+
+    NotificationParameters parameters4;
+    parameters4.add(EVENT_TYPE, "a");
+    uint id4 = manager->addGroup(1, parameters4);
+
+    QCOMPARE(groupIds(manager->queryGroups(0, QString(), QString(), 0, 0, 0)), QList<uint>() << id1 << id2 << id3);
+    QCOMPARE(manager->queryGroupCount(0, QString(), QString(), 0), (uint)3);
+    QCOMPARE(groupIds(manager->queryGroups(0, "a", QString(), 0, 0, 0)), QList<uint>() << id1 << id3);
+    QCOMPARE(manager->queryGroupCount(0, "a", QString(), 0), (uint)2);
+    QCOMPARE(groupIds(manager->queryGroups(0, QString(), "x", 0, 0, 0)), QList<uint>() << id1);
+    QCOMPARE(manager->queryGroupCount(0, QString(), "x", 0), (uint)1);
+    QCOMPARE(groupIds(manager->queryGroups(0, QString(), QString(), 150, 0, 0)), QList<uint>() << id2 << id3);
+    QCOMPARE(manager->queryGroupCount(0, "a", QString(), 150), (uint)1);
+    QCOMPARE(groupIds(manager->queryGroups(1, "a", QString(), 0, 0, 0)), QList<uint>() << id4);
+
+    QCOMPARE(groupIds(manager->queryGroups(0, QString(), QString(), 0, id2, 1)), QList<uint>() << id3);
+    QCOMPARE(groupIds(manager->queryGroups(0, QString(), QString(), 0, 0, 2)), QList<uint>() << id1 << id2);
+    QCOMPARE(groupIds(manager->queryGroups(0, QString(), QString(), 150, id2, 0)), QList<uint>() << id3);
+
+    // The timestamp index of the groups follows the changes in the group timestamps
+    NotificationParameters updatedParameters;
+    updatedParameters.add(TIMESTAMP, 500);
+    QVERIFY(manager->updateGroup(0, id1, updatedParameters));
+    QCOMPARE(groupIds(manager->queryGroups(0, QString(), QString(), 450, 0, 0)), QList<uint>() << id1);
+    QCOMPARE(manager->queryGroupCount(0, QString(), QString(), 250), (uint)2);
+    manager->doRemoveGroup(id1);
+    QVERIFY(manager->queryGroups(0, QString(), QString(), 450, 0, 0).isEmpty());
+    QVERIFY(!manager->groupIdsByTimestamp.value(0).values().contains(id1));
+}
+
+void Ut_NotificationManager::testChangesSinceChangeSequence()
+{
+    uint removedGroupId = manager->addGroup(0);
+    uint groupId = manager->addGroup(0);
+    manager->addNotification(0, NotificationParameters(), groupId);
+
+    quint64 sequence = manager->changeSequence();
+    QVERIFY(manager->changesKnownSince(sequence));
+    QVERIFY(!manager->changesKnownSince(sequence + 1));
+
+    uint updatedId = manager->addNotification(0, NotificationParameters(), groupId);
+    uint removedId = manager->addNotification(0);
+    manager->updateNotification(0, updatedId);
+    manager->removeNotification(removedId);
+    manager->updateGroup(0, groupId);
+    manager->doRemoveGroup(removedGroupId);
+
+    QVERIFY(manager->changeSequence() > sequence);
+    QVERIFY(manager->changesKnownSince(sequence));
+    QCOMPARE(notificationIds(manager->notificationsChangedSince(sequence)), QList<uint>() << updatedId);
+    QCOMPARE(manager->notificationIdsRemovedSince(sequence), QList<uint>() << removedId);
+    QCOMPARE(manager->groupIdsRemovedSince(sequence), QList<uint>() << removedGroupId);
+    QCOMPARE(groupIds(manager->groupsChangedSince(sequence)), QList<uint>() << groupId);
+
+    QVERIFY(manager->notificationsChangedSince(manager->changeSequence()).isEmpty());
+    QVERIFY(manager->notificationIdsRemovedSince(manager->changeSequence()).isEmpty());
+}
+
+void Ut_NotificationManager::testChangesAreUnknownWhenChangeLogOverflows()
+{
+    quint64 sequence = manager->changeSequence();
+
+    QList<QPair<uint, NotificationParameters> > notifications;
+    for (int i = 0; i < 1001; ++i) {
+        notifications.append(qMakePair(0u, NotificationParameters()));
+    }
+    manager->addNotifications(0, notifications);
+
+    QVERIFY(!manager->changesKnownSince(sequence));
+    QVERIFY(manager->changesKnownSince(sequence + 1));
+    QVERIFY(manager->notificationsChangedSince(sequence).isEmpty());
+}
+
+void Ut_NotificationManager::testChangesOfPreviousRunAreUnknown()
+{
+    delete manager;
+    qDateTimeToTime_t = 100;
+    manager = new TestNotificationManager(0);
+    manager->addNotification(0);
+    quint64 sequence = manager->changeSequence();
+
+    delete manager;
+    qDateTimeToTime_t = 101;
+    manager = new TestNotificationManager(0);
+    QVERIFY(!manager->changesKnownSince(sequence));
+    QVERIFY(manager->changeSequence() > sequence);
+}
+
 void Ut_NotificationManager::testDBusNotificationSinkConnections()
 {
     QVERIFY(disconnect(manager, SIGNAL(groupUpdated(uint, const NotificationParameters &)), manager->dBusSink, SLOT(addGroup(uint, const NotificationParameters &))));
     QVERIFY(disconnect(manager, SIGNAL(groupRemoved(uint)), manager->dBusSink, SLOT(removeGroup(uint))));
     QVERIFY(disconnect(manager, SIGNAL(notificationRemoved(uint)), manager->dBusSink, SLOT(removeNotification(uint))));
-    QVERIFY(disconnect(manager, SIGNAL(notificationRestored(const Notification &)), manager->dBusSink, SLOT(addNotification(const Notification &))));
+    QVERIFY(disconnect(manager, SIGNAL(notificationsRemoved(const QList<uint> &)), manager->dBusSink, SLOT(removeNotifications(const QList<uint> &))));
+    QVERIFY(disconnect(manager, SIGNAL(notificationsRestored(const QList<Notification> &)), manager->dBusSink, SLOT(addNotifications(const QList<Notification> &))));
     QVERIFY(disconnect(manager, SIGNAL(notificationUpdated(const Notification &)), manager->dBusSink, SLOT(addNotification(const Notification &))));
+    QVERIFY(disconnect(manager, SIGNAL(notificationsUpdated(const QList<Notification> &)), manager->dBusSink, SLOT(addNotifications(const QList<Notification> &))));
     QVERIFY(disconnect(manager->dBusSink, SIGNAL(notificationRemovalRequested(uint)), manager, SLOT(removeNotification(uint))));
     QVERIFY(disconnect(manager->dBusSink, SIGNAL(notificationGroupClearingRequested(uint)), manager, SLOT(removeNotificationsInGroup(uint))));
     QVERIFY(disconnect(manager, SIGNAL(queuedGroupRemove(uint)), manager, SLOT(doRemoveGroup(uint))));
     QVERIFY(disconnect(manager, SIGNAL(queuedNotificationRemove(uint)), manager, SLOT(removeNotification(uint))));
+    QVERIFY(disconnect(manager, SIGNAL(queuedNotificationsRemove(const QList<uint> &)), manager, SLOT(doRemoveNotifications(const QList<uint> &))));
 }
 
 void Ut_NotificationManager::testGetNotificationGroups()
@@ -1682,7 +2487,7 @@ void Ut_NotificationManager::testPruningNonPersistentNotificationsOnBoot()
     gNotificationBuffer.open(QIODevice::WriteOnly);
     QDataStream stream(&gNotificationBuffer);
     manager = new TestNotificationManager(0);
-    QSignalSpy spy(manager, SIGNAL(notificationRestored(Notification)));
+    QSignalSpy spy(manager, SIGNAL(notificationsRestored(QList<Notification>)));
 
     // Create a persistent and a non-persistent notification
     NotificationParameters parameters0;
@@ -1705,12 +2510,46 @@ void Ut_NotificationManager::testPruningNonPersistentNotificationsOnBoot()
     QCOMPARE(spy.count(), 1);
 }
 
+void Ut_NotificationManager::testPruningNonPersistentNotificationsInSnapshotOnBoot()
+{
+    delete manager;
+
+    // Write a snapshot with a persistent and a non-persistent notification
+    NotificationParameters parameters0;
+    parameters0.add(PERSISTENT, "false");
+    parameters0.add(BODY, "body");
+    NotificationParameters parameters1;
+    parameters1.add(PERSISTENT, "true");
+    parameters1.add(BODY, "body");
+    QList<Notification> notifications;
+    notifications << Notification(0, 3, 0, parameters0, Notification::ApplicationEvent, 0);
+    notifications << Notification(1, 4, 0, parameters1, Notification::SystemEvent, 1000);
+    gNotificationBuffer.buffer() = NotificationSnapshot::serialize(notifications);
+
+    manager = new TestNotificationManager(0);
+    QSignalSpy spy(manager, SIGNAL(notificationsRestored(QList<Notification>)));
+    gBootFileExists = false;
+
+    manager->initializeStore();
+
+    // Verify that only the persistent notification was restored
+    QCOMPARE(spy.count(), 1);
+    QList<Notification> notifications = qvariant_cast<QList<Notification> >(spy.at(0).at(0));
+    QCOMPARE(notifications.count(), 1);
+    Notification notification = notifications.at(0);
+    QCOMPARE(notification.notificationId(), (uint)1);
+    QCOMPARE(notification.groupId(), (uint)4);
+    QCOMPARE(notification.type(), Notification::SystemEvent);
+    QCOMPARE(notification.timeout(), 1000);
+    QCOMPARE(notification.parameters().value(BODY).toString(), QString("body"));
+}
+
 void Ut_NotificationManager::testSystemStartupFileCreatedAfterFirstBoot()
 {
     delete manager;
     gNotificationBuffer.buffer().clear();
     manager = new TestNotificationManager(0);
-    QSignalSpy spy(manager, SIGNAL(notificationRestored(Notification)));
+    QSignalSpy spy(manager, SIGNAL(notificationsRestored(QList<Notification>)));
     gBootFileExists = false;
     gNotificationFileExists = false;
 
@@ -1799,6 +2638,34 @@ void Ut_NotificationManager::testSystemBannersWhenQueuedMaintainTheirOrder()
     QCOMPARE(n.notificationId(), idsystem2);
 }
 
+void Ut_NotificationManager::testQueuedApplicationNotificationsAreRelayedInPriorityOrder()
+{
+    delete manager;
+    manager = new TestNotificationManager(-1);
+    QSignalSpy spy(manager, SIGNAL(notificationUpdated(Notification)));
+
+    manager->addNotification(0, NotificationParameters());
+
+    NotificationParameters lowPriorityParameters;
+    lowPriorityParameters.add("priority", 1);
+    uint idLow = manager->addNotification(0, lowPriorityParameters);
+
+    NotificationParameters highPriorityParameters;
+    highPriorityParameters.add("priority", 5);
+    uint idHigh0 = manager->addNotification(0, highPriorityParameters);
+    uint idHigh1 = manager->addNotification(0, highPriorityParameters);
+    spy.clear();
+
+    // The notifications with the higher priority should come first, in the order they were added
+    QList<uint> relayedIds;
+    for (int i = 0; i < 3; ++i) {
+        manager->relayNextNotification();
+        QCOMPARE(spy.count(), 1);
+        relayedIds.append(qvariant_cast<Notification>(spy.takeFirst().at(0)).notificationId());
+    }
+    QCOMPARE(relayedIds, QList<uint>() << idHigh0 << idHigh1 << idLow);
+}
+
 void Ut_NotificationManager::testAddNotificationWithAndWithoutTimestamp()
 {
     QSignalSpy spy(manager, SIGNAL(notificationUpdated(Notification)));
@@ -2056,6 +2923,29 @@ void Ut_NotificationManager::testUpdatingGroupTimestampWhenRemovingNotifications
     QCOMPARE(qvariant_cast<NotificationParameters>(arguments.at(1)).value(TIMESTAMP).toUInt(), timestampNotification0);
 }
 
+void Ut_NotificationManager::testNotUpdatingGroupTimestampWhenRemovingNotificationsWithOlderOrSameTimestamp()
+{
+    uint groupId = manager->addGroup(0, NotificationParameters());
+
+    NotificationParameters parameters0;
+    parameters0.add(TIMESTAMP, 123);
+    uint notificationId0 = manager->addNotification(0, parameters0, groupId);
+
+    // Two notifications have the latest timestamp
+    NotificationParameters parameters1;
+    parameters1.add(TIMESTAMP, 123456);
+    uint notificationId1 = manager->addNotification(0, parameters1, groupId);
+    manager->addNotification(0, parameters1, groupId);
+
+    QSignalSpy groupSpy(manager, SIGNAL(groupUpdated(uint, const NotificationParameters &)));
+
+    // Removing an older notification or one of the latest ones doesn't change the group timestamp
+    manager->removeNotification(notificationId0);
+    manager->removeNotification(notificationId1);
+    QCOMPARE(groupSpy.count(), 0);
+    QCOMPARE(manager->groupContainer.value(groupId).parameters().value(TIMESTAMP).toUInt(), (uint)123456);
+}
+
 void Ut_NotificationManager:: testUpdatingGroupTimestampWhenGroupIsCleared()
 {
     uint groupId = manager->addGroup(0, NotificationParameters());
@@ -42,6 +42,7 @@ public:
 signals:
     void notifierSinkActive(bool ignore);
     void eventTypeModified(const QString& eventType);
+    void eventTypesModified(const QStringList& eventTypes);
 
 private:
     TestNotificationManager *manager;
@@ -62,10 +63,14 @@ private slots:
 
     // Test that notification system user IDs are allocated properly
     void testNotificationUserId();
+    // Test that notification user IDs are written to the persistent storage once per reserved block
+    void testNotificationUserIdsAreReservedInBlocks();
+    void testReservedUserIdBlockIsWrittenBeforeUserIdIsReturned();
     // Test that correct kinds of notification widgets are displayed that their IDs are unique
     void testAddNotification();
 
     void testWhenNotificationIsAddedThenTheNotificationIsFilledWithEventTypeData();
+    void testEventTypeDataIsNotStoredInPersistentStorage();
     // Test that updating with an ID updates the correct notification
     void testUpdateNotification();
 
@@ -136,16 +141,46 @@ private slots:
     void testNotificationStorage();
     // Test that the persistent notifications are restored from the persistent storage
     void testNotificationRestoration();
+    // Test that changes are appended to the journal instead of rewriting the whole storage
+    void testChangesAreAppendedToJournal();
+    // Test that the journal is replayed on top of the snapshot when restoring
+    void testJournalIsReplayedWhenRestoring();
+    // Test that initializing the store writes a snapshot and clears the journal
+    void testInitializingStoreCompactsJournal();
+    void testRestoredIdsAreNotAllocatedAgain();
     // Test the removal of notifications based on event type
     void testRemovingNotificationsWithEventType();
     // Test the removal of groups based on event type
     void testRemovingGroupsWithEventType();
+    // Test that purging an event type removes its notifications and groups in one transaction
+    void testRemovingNotificationsAndGroupsWithEventTypeInOneBatch();
+    void testRemovingNotificationsWithChangedEventType();
+    void testListsAreUpdatedWhenNotificationsAndGroupsAreRemoved();
+    // Test that notifications added in a batch are relayed to the sinks and written to the journal at once
+    void testAddingNotificationsInBatch();
+    // Test that a committed batch is relayed at once but alerts the user once per relay interval in priority order
+    void testCommittedBatchAlertsOncePerInterval();
+    void testUpdatingNotificationsInBatch();
+    void testRemovingNotificationsInBatch();
+    // Test that notifications and groups are looked up by the user supplied identifier
+    void testAddingOrUpdatingNotificationWithIdentifier();
+    void testRemovingNotificationsWithIdentifier();
+    void testAddingOrUpdatingGroupWithIdentifier();
+    void testRemovingGroupsWithIdentifier();
+    // Test that notifications and groups can be queried by pages and criteria
+    void testQueryingNotifications();
+    void testQueryingNotificationsAfterUpdatesAndRemovals();
+    void testQueryingGroups();
+    void testChangesSinceChangeSequence();
+    void testChangesAreUnknownWhenChangeLogOverflows();
+    void testChangesOfPreviousRunAreUnknown();
     // Test that system notifications are input always at the front of the queue
     void testSytemNotificationArePrepended();
     // Startup file should be created even when there are no notifications
     void testSystemStartupFileCreatedAfterFirstBoot();
     // Test when system banners are queued, they follow the order in which they are added
     void testSystemBannersWhenQueuedMaintainTheirOrder();
+    void testQueuedApplicationNotificationsAreRelayedInPriorityOrder();
 
     // Test that relevant signals are connected to the DBus sink
     void testDBusNotificationSinkConnections();
@@ -155,8 +190,10 @@ private slots:
     void testGetNotifications();
     // Test that updating an event type triggers updates of notifications and groups of that notification type
     void testNotificationsAndGroupsAreUpdatedWhenEventTypeIsUpdated();
+    void testNotificationsAreUpdatedInOneTransactionWhenSeveralEventTypesAreUpdated();
     void testNotificationCountInGroup();
     void testPruningNonPersistentNotificationsOnBoot();
+    void testPruningNonPersistentNotificationsInSnapshotOnBoot();
     // Test adding notification with and without user specified timestamp
     void testAddNotificationWithAndWithoutTimestamp();
     // Test that timestamp of notification is updated
@@ -172,6 +209,7 @@ private slots:
     void testUpdateNotificationInGroupWithTimestamp_data();
     void testUpdateNotificationInGroupWithTimestamp();
     void testUpdatingGroupTimestampWhenRemovingNotifications();
+    void testNotUpdatingGroupTimestampWhenRemovingNotificationsWithOlderOrSameTimestamp();
     void testUpdatingGroupTimestampWhenGroupIsCleared();
 };
 
@@ -9,6 +9,13 @@ LIBS += -L../../lib
 SOURCES += \
     ut_notificationmanager.cpp \
     $$NOTIFICATIONSRCDIR/notificationmanager.cpp \
+    $$NOTIFICATIONSRCDIR/notificationjournal.cpp \
+    $$NOTIFICATIONSRCDIR/notificationpersistenceworker.cpp \
+    $$NOTIFICATIONSRCDIR/notificationsnapshot.cpp \
+    $$NOTIFICATIONSRCDIR/eventtypetable.cpp \
+    $$NOTIFICATIONSRCDIR/notificationidallocator.cpp \
+    $$NOTIFICATIONSRCDIR/notificationwaitqueue.cpp \
+    $$NOTIFICATIONSRCDIR/notificationchangelog.cpp \
     $$NOTIFICATIONSRCDIR/mnotificationproxy.cpp \
     $$SRCDIR/contextframeworkcontext.cpp \
     $$NOTIFICATIONSRCDIR/notificationsource.cpp \
@@ -25,6 +32,13 @@ SOURCES += \
 HEADERS += \
     ut_notificationmanager.h \
     $$NOTIFICATIONSRCDIR/notificationmanager.h \
+    $$NOTIFICATIONSRCDIR/notificationjournal.h \
+    $$NOTIFICATIONSRCDIR/notificationpersistenceworker.h \
+    $$NOTIFICATIONSRCDIR/notificationsnapshot.h \
+    $$NOTIFICATIONSRCDIR/eventtypetable.h \
+    $$NOTIFICATIONSRCDIR/notificationidallocator.h \
+    $$NOTIFICATIONSRCDIR/notificationwaitqueue.h \
+    $$NOTIFICATIONSRCDIR/notificationchangelog.h \
     $$NOTIFICATIONSRCDIR/dbusinterfacenotificationsource.h \
     $$NOTIFICATIONSRCDIR/dbusinterfacenotificationsink.h \
     $$NOTIFICATIONSRCDIR/mnotificationproxy.h \
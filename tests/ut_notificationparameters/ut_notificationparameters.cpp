@@ -24,6 +24,7 @@
 #include "notificationparameter.h"
 #include "genericnotificationparameterfactory.h"
 #include "qdbusargument_fake.h"
+#include <malloc.h>
 
 static NotificationParameter createParameter(QString key, int value) {
     return NotificationParameter(key, QVariant(value));
@@ -33,6 +34,51 @@ static NotificationParameter createParameter(QString key, const QString &value)
     return NotificationParameter(key, QVariant(value));
 }
 
+#ifdef __GLIBC_PREREQ
+#if __GLIBC_PREREQ(2, 33)
+#define HAVE_MALLINFO2
+#endif
+#endif
+
+// The heap memory a typical notification may take at most
+static const qint64 MAX_BYTES_PER_NOTIFICATION = 1024;
+
+// Returns the number of bytes currently allocated from the heap
+static qint64 allocatedBytes()
+{
+#ifdef HAVE_MALLINFO2
+    // mallinfo() is deprecated since its int fields overflow with large heaps
+    return mallinfo2().uordblks;
+#else
+    return mallinfo().uordblks;
+#endif
+}
+
+// Creates the parameters of a typical notification with the given index
+static QHash<QString, QVariant> typicalParameters(int index)
+{
+    QHash<QString, QVariant> parameters;
+    parameters.insert("eventType", "email.arrived");
+    parameters.insert("summary", QString("Summary %1").arg(index));
+    parameters.insert("body", QString("Body %1").arg(index));
+    parameters.insert("imageId", "icon-m-email");
+    parameters.insert("action", "com.meego.email / com.meego.email showMessage");
+    parameters.insert("count", 1);
+    parameters.insert("identifier", QString("message%1").arg(index));
+    parameters.insert("timestamp", 1000 + index);
+    return parameters;
+}
+
+static NotificationParameters typicalNotificationParameters(int index)
+{
+    NotificationParameters parameters;
+    QHash<QString, QVariant> values = typicalParameters(index);
+    for (QHash<QString, QVariant>::const_iterator i = values.constBegin(); i != values.constEnd(); ++i) {
+        parameters.add(i.key(), i.value());
+    }
+    return parameters;
+}
+
 void Ut_NotificationParameters::initTestCase()
 {
 }
@@ -74,6 +120,61 @@ void Ut_NotificationParameters::testParameterAPI()
     QCOMPARE(params.value("test3").isNull(), true);
 }
 
+void Ut_NotificationParameters::testKeys()
+{
+    NotificationParameters params;
+    QVERIFY(params.keys().isEmpty());
+
+    params.add("test1", 5);
+    params.add("test2", "Test");
+
+    QList<QString> keys = params.keys();
+    QCOMPARE(keys.count(), 2);
+    QVERIFY(keys.contains("test1"));
+    QVERIFY(keys.contains("test2"));
+}
+
+void Ut_NotificationParameters::testDefaults()
+{
+    NotificationParameters defaults;
+    defaults.add("test1", 1);
+    defaults.add("test2", "Default");
+
+    NotificationParameters params;
+    params.add("test2", "Test");
+    params.add("test3", 3);
+    params.setDefaults(defaults);
+
+    QCOMPARE(params.value("test1"), QVariant(1));
+    QCOMPARE(params.value("test2"), QVariant("Test"));
+    QCOMPARE(params.value("test3"), QVariant(3));
+    QCOMPARE(params.count(), 3);
+    QList<QString> keys = params.keys();
+    QCOMPARE(keys.count(), 3);
+    QVERIFY(keys.contains("test1"));
+    QVERIFY(keys.contains("test2"));
+    QVERIFY(keys.contains("test3"));
+
+    // Updating doesn't change the defaults
+    NotificationParameters updated;
+    updated.add("test1", 2);
+    params.update(updated);
+    QCOMPARE(params.value("test1"), QVariant(2));
+    QCOMPARE(defaults.value("test1"), QVariant(1));
+
+    NotificationParameters overrides = params.overrides();
+    QCOMPARE(overrides.count(), 3);
+    QCOMPARE(overrides.value("test1"), QVariant(2));
+
+    // The defaults are not used once they are cleared
+    NotificationParameters copy(defaults);
+    copy.setDefaults(params);
+    QCOMPARE(copy.value("test3"), QVariant(3));
+    copy.setDefaults(NotificationParameters());
+    QCOMPARE(copy.value("test3").isNull(), true);
+    QCOMPARE(copy.count(), 2);
+}
+
 void Ut_NotificationParameters::testWhenUpdatingParametersThenTheParametersGetUpdated()
 {
     NotificationParameters params;
@@ -145,4 +246,188 @@ void Ut_NotificationParameters::testDBusSerialization()
     QCOMPARE(params2.value("test3").isNull(), true);
 }
 
+void Ut_NotificationParameters::testSerializationWithDefaults()
+{
+    NotificationParameters defaults;
+    defaults.add(createParameter("test1", 1));
+
+    NotificationParameters params1;
+    NotificationParameters params2;
+    params1.add(createParameter("test2", "Test"));
+    params1.setDefaults(defaults);
+
+    QByteArray ba;
+    QDataStream stream(&ba, QIODevice::ReadWrite);
+    stream << params1;
+    stream.device()->seek(0);
+    stream >> params2;
+
+    QCOMPARE(params2.count(), 1);
+    QCOMPARE(params2.value("test1").isNull(), true);
+    QCOMPARE(params2.value("test2"), QVariant("Test"));
+}
+
+void Ut_NotificationParameters::testDBusSerializationWithDefaults()
+{
+    NotificationParameters defaults;
+    defaults.add(createParameter("test1", 1));
+    defaults.add(createParameter("test2", "Default"));
+
+    NotificationParameters params1;
+    NotificationParameters params2;
+    params1.add(createParameter("test2", "Test"));
+    params1.setDefaults(defaults);
+
+    QDBusArgument arg;
+    arg << params1;
+    arg >> params2;
+
+    QCOMPARE(params2.count(), 2);
+    QCOMPARE(params2.value("test1"), QVariant(1));
+    QCOMPARE(params2.value("test2"), QVariant("Test"));
+}
+
+void Ut_NotificationParameters::testWellKnownAndCustomParameters()
+{
+    NotificationParameters params;
+    params.add("summary", "Summary");
+    params.add("test1", 5);
+    params.add("eventType", "type");
+    params.add("action", "action");
+    params.add("summary", "Summary2");
+
+    QCOMPARE(params.count(), 4);
+    QCOMPARE(params.value("summary"), QVariant("Summary2"));
+    QCOMPARE(params.value("test1"), QVariant(5));
+    QCOMPARE(params.value("eventType"), QVariant("type"));
+    QCOMPARE(params.value("action"), QVariant("action"));
+    QCOMPARE(params.value("body").isNull(), true);
+
+    QList<QString> keys = params.keys();
+    QCOMPARE(keys.count(), 4);
+    QVERIFY(keys.contains("summary"));
+    QVERIFY(keys.contains("test1"));
+    QVERIFY(keys.contains("eventType"));
+    QVERIFY(keys.contains("action"));
+
+    NotificationParameters defaults;
+    defaults.add("body", "Body");
+    defaults.add("summary", "Default");
+    defaults.add("test2", 2);
+    params.setDefaults(defaults);
+    QCOMPARE(params.count(), 6);
+    QCOMPARE(params.keys().count(), 6);
+    QCOMPARE(params.value("summary"), QVariant("Summary2"));
+    QCOMPARE(params.value("body"), QVariant("Body"));
+    QCOMPARE(params.value("test2"), QVariant(2));
+}
+
+void Ut_NotificationParameters::testUpdatingWellKnownParameters()
+{
+    NotificationParameters params;
+    params.add("body", "Body");
+    params.add("imageId", "image");
+    params.add("timestamp", 1);
+
+    NotificationParameters updated;
+    updated.add("action", "action");
+    updated.add("imageId", "image2");
+    updated.add("unseen", true);
+    params.update(updated);
+
+    QCOMPARE(params.count(), 5);
+    QCOMPARE(params.value("action"), QVariant("action"));
+    QCOMPARE(params.value("body"), QVariant("Body"));
+    QCOMPARE(params.value("imageId"), QVariant("image2"));
+    QCOMPARE(params.value("timestamp"), QVariant(1));
+    QCOMPARE(params.value("unseen"), QVariant(true));
+
+    // Updating empty parameters makes them equal to the update
+    NotificationParameters empty;
+    empty.update(updated);
+    QCOMPARE(empty.count(), 3);
+    QCOMPARE(empty.value("imageId"), QVariant("image2"));
+}
+
+void Ut_NotificationParameters::testSerializationFormatIsCompatibleWithHash()
+{
+    QHash<QString, QVariant> hash = typicalParameters(1);
+    hash.insert("test1", 5);
+
+    QByteArray ba;
+    QDataStream stream(&ba, QIODevice::ReadWrite);
+    stream << hash;
+    stream.device()->seek(0);
+    NotificationParameters params;
+    stream >> params;
+    QCOMPARE(params.count(), hash.count());
+    foreach (const QString &key, hash.keys()) {
+        QCOMPARE(params.value(key), hash.value(key));
+    }
+
+    QByteArray ba2;
+    QDataStream stream2(&ba2, QIODevice::ReadWrite);
+    stream2 << params;
+    stream2.device()->seek(0);
+    QHash<QString, QVariant> hash2;
+    stream2 >> hash2;
+    QCOMPARE(hash2, hash);
+}
+
+void Ut_NotificationParameters::testMemoryUsage()
+{
+    const int notificationCount = 1000;
+
+    qint64 bytesBefore = allocatedBytes();
+    QList<QHash<QString, QVariant> > hashes;
+    for (int i = 0; i < notificationCount; ++i) {
+        hashes.append(typicalParameters(i));
+    }
+    qint64 hashBytes = allocatedBytes() - bytesBefore;
+    hashes.clear();
+
+    bytesBefore = allocatedBytes();
+    QList<NotificationParameters> parameters;
+    for (int i = 0; i < notificationCount; ++i) {
+        parameters.append(typicalNotificationParameters(i));
+    }
+    qint64 parametersBytes = allocatedBytes() - bytesBefore;
+
+    // The notifications must fit in the budget and take less memory than the same parameters in a QHash
+    QVERIFY2(parametersBytes <= MAX_BYTES_PER_NOTIFICATION * notificationCount,
+             qPrintable(QString("%1 bytes per notification").arg(parametersBytes / notificationCount)));
+    QVERIFY(parametersBytes < hashBytes);
+}
+
+void Ut_NotificationParameters::benchmarkUpdatingParameters()
+{
+    NotificationParameters params = typicalNotificationParameters(1);
+    NotificationParameters updated;
+    updated.add("summary", "Updated summary");
+    updated.add("count", 2);
+    updated.add("timestamp", 2000);
+
+    QBENCHMARK {
+        NotificationParameters copy(params);
+        copy.update(updated);
+    }
+}
+
+void Ut_NotificationParameters::benchmarkUpdatingHash()
+{
+    QHash<QString, QVariant> params = typicalParameters(1);
+    QHash<QString, QVariant> updated;
+    updated.insert("summary", "Updated summary");
+    updated.insert("count", 2);
+    updated.insert("timestamp", 2000);
+
+    // The way the parameters were updated when they were stored in a hash
+    QBENCHMARK {
+        QHash<QString, QVariant> copy(params);
+        foreach (const QString &key, updated.keys()) {
+            copy[key] = updated[key];
+        }
+    }
+}
+
 QTEST_MAIN(Ut_NotificationParameters)
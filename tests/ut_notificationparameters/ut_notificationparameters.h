@@ -45,11 +45,28 @@ private slots:
 
     void testWhenUpdatingParametersThenTheParametersGetUpdated();
     void testWhenUpdatingParametersThenTheExistingParametersRemain();
+    void testKeys();
+    // Test that the defaults are used for the parameters that have not been added
+    void testDefaults();
 
     // Test serialization into QDataStream
     void testSerialization();
     // Test serialization into QDBusArgument
     void testDBusSerialization();
+    // Test that the defaults are serialized only into QDBusArgument
+    void testSerializationWithDefaults();
+    void testDBusSerializationWithDefaults();
+
+    // Test that parameters with well-known and other names can be mixed
+    void testWellKnownAndCustomParameters();
+    void testUpdatingWellKnownParameters();
+    // Test that the parameters are serialized in the format of QHash<QString, QVariant>
+    void testSerializationFormatIsCompatibleWithHash();
+
+    // Compare the memory usage and the cost of updating to parameters stored in a hash
+    void testMemoryUsage();
+    void benchmarkUpdatingParameters();
+    void benchmarkUpdatingHash();
 };
 
 #endif
@@ -0,0 +1,256 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QFile>
+#include <QDir>
+#include <QDataStream>
+#include "ut_notificationpersistenceworker.h"
+#include "notificationpersistenceworker.h"
+#include "notificationjournal.h"
+#include "notificationsnapshot.h"
+#include "notification.h"
+#include "notificationgroup.h"
+#include "notificationparameters.h"
+
+//! A coalescing window long enough not to expire during a test unless waited for
+static const int COALESCING_WINDOW = 200;
+
+void Ut_NotificationPersistenceWorker::initTestCase()
+{
+    journalFileName = QDir::tempPath() + "/ut_notificationpersistenceworker_journal.data";
+    stateFileName = QDir::tempPath() + "/ut_notificationpersistenceworker_state.data";
+    notificationsFileName = QDir::tempPath() + "/ut_notificationpersistenceworker_notifications.data";
+}
+
+void Ut_NotificationPersistenceWorker::cleanupTestCase()
+{
+}
+
+void Ut_NotificationPersistenceWorker::init()
+{
+    QFile::remove(journalFileName);
+    QFile::remove(stateFileName);
+    QFile::remove(notificationsFileName);
+    worker = new NotificationPersistenceWorker(journalFileName, stateFileName, notificationsFileName, COALESCING_WINDOW);
+}
+
+void Ut_NotificationPersistenceWorker::cleanup()
+{
+    delete worker;
+    QFile::remove(journalFileName);
+    QFile::remove(stateFileName);
+    QFile::remove(notificationsFileName);
+    QFile::remove(stateFileName + ".tmp");
+    QDir().rmdir(notificationsFileName + ".tmp");
+}
+
+void Ut_NotificationPersistenceWorker::readStore(QHash<uint, Notification> &notifications, QHash<uint, NotificationGroup> &groups, quint32 &lastUsedUserId)
+{
+    QFile stateFile(stateFileName);
+    if (stateFile.open(QIODevice::ReadOnly)) {
+        QDataStream stream(&stateFile);
+        stream >> lastUsedUserId;
+        while (!stream.atEnd()) {
+            NotificationGroup group;
+            stream >> group;
+            groups.insert(group.groupId(), group);
+        }
+    }
+
+    NotificationSnapshot snapshot;
+    if (snapshot.open(notificationsFileName)) {
+        for (int i = 0; i < snapshot.count(); ++i) {
+            notifications.insert(snapshot.notificationId(i), snapshot.notification(i));
+        }
+    }
+
+    NotificationJournal journal(journalFileName);
+    journal.replay(notifications, groups, lastUsedUserId);
+}
+
+void Ut_NotificationPersistenceWorker::testChangesAreNotWrittenImmediately()
+{
+    worker->saveNotification(Notification(1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    worker->saveGroup(NotificationGroup(1, 0, NotificationParameters()));
+
+    QVERIFY(!QFile::exists(journalFileName));
+    QCOMPARE(worker->queuedOperations(), (uint)2);
+    QCOMPARE(worker->writtenOperations(), (uint)0);
+    QCOMPARE(worker->journalRecordCount(), (uint)2);
+}
+
+void Ut_NotificationPersistenceWorker::testChangesAreWrittenWhenCoalescingWindowExpires()
+{
+    worker->saveNotification(Notification(1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    worker->saveLastUsedUserId(3);
+
+    QTest::qWait(COALESCING_WINDOW * 2);
+    for (int i = 0; i < 50 && worker->writtenOperations() < 2; ++i) {
+        QTest::qWait(20);
+    }
+    QCOMPARE(worker->writtenOperations(), (uint)2);
+
+    QHash<uint, Notification> notifications;
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUsedUserId = 0;
+    readStore(notifications, groups, lastUsedUserId);
+    QCOMPARE(notifications.count(), 1);
+    QVERIFY(notifications.contains(1));
+    QCOMPARE(lastUsedUserId, (quint32)3);
+}
+
+void Ut_NotificationPersistenceWorker::testChangesToSameItemAreCoalesced()
+{
+    NotificationParameters parameters0;
+    parameters0.add("summary", "summary0");
+    NotificationParameters parameters1;
+    parameters1.add("summary", "summary1");
+    worker->saveNotification(Notification(1, 0, 0, parameters0, Notification::ApplicationEvent, 0));
+    worker->saveNotification(Notification(2, 0, 0, parameters0, Notification::ApplicationEvent, 0));
+    worker->saveNotification(Notification(1, 0, 0, parameters1, Notification::ApplicationEvent, 0));
+    worker->removeNotification(2);
+    worker->flush();
+
+    QCOMPARE(worker->queuedOperations(), (uint)4);
+    QCOMPARE(worker->coalescedOperations(), (uint)2);
+    QCOMPARE(worker->writtenOperations(), (uint)2);
+    QCOMPARE(worker->journalRecordCount(), (uint)2);
+
+    QHash<uint, Notification> notifications;
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUsedUserId = 0;
+    NotificationJournal journal(journalFileName);
+    QCOMPARE(journal.replay(notifications, groups, lastUsedUserId), (uint)2);
+    QCOMPARE(notifications.count(), 1);
+    QCOMPARE(notifications.value(1).parameters().value("summary").toString(), QString("summary1"));
+}
+
+void Ut_NotificationPersistenceWorker::testSnapshotSupersedesQueuedChanges()
+{
+    worker->saveNotification(Notification(1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    worker->flush();
+    QVERIFY(QFile::exists(journalFileName));
+
+    QHash<uint, Notification> notifications;
+    notifications.insert(2, Notification(2, 1, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    QHash<uint, NotificationGroup> groups;
+    groups.insert(1, NotificationGroup(1, 0, NotificationParameters()));
+    worker->saveNotification(Notification(3, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    worker->saveSnapshot(7, groups, notifications);
+    worker->flush();
+
+    QCOMPARE(worker->coalescedOperations(), (uint)1);
+    QCOMPARE(worker->journalRecordCount(), (uint)0);
+    QVERIFY(!QFile::exists(journalFileName));
+
+    QHash<uint, Notification> storedNotifications;
+    QHash<uint, NotificationGroup> storedGroups;
+    quint32 lastUsedUserId = 0;
+    readStore(storedNotifications, storedGroups, lastUsedUserId);
+    QCOMPARE(storedNotifications.keys(), QList<uint>() << 2);
+    QCOMPARE(storedGroups.keys(), QList<uint>() << 1);
+    QCOMPARE(lastUsedUserId, (quint32)7);
+}
+
+void Ut_NotificationPersistenceWorker::testChangesAfterSnapshotAreJournaled()
+{
+    QHash<uint, Notification> notifications;
+    notifications.insert(1, Notification(1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    worker->saveSnapshot(0, QHash<uint, NotificationGroup>(), notifications);
+    worker->removeNotification(1);
+    worker->flush();
+
+    QCOMPARE(worker->journalRecordCount(), (uint)1);
+
+    QHash<uint, Notification> storedNotifications;
+    QHash<uint, NotificationGroup> storedGroups;
+    quint32 lastUsedUserId = 0;
+    readStore(storedNotifications, storedGroups, lastUsedUserId);
+    QCOMPARE(storedNotifications.count(), 0);
+}
+
+void Ut_NotificationPersistenceWorker::testFailedSnapshotKeepsPreviousDataLoadable()
+{
+    QHash<uint, Notification> notifications;
+    notifications.insert(1, Notification(1, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    QHash<uint, NotificationGroup> groups;
+    groups.insert(1, NotificationGroup(1, 0, NotificationParameters()));
+    worker->saveSnapshot(3, groups, notifications);
+    worker->saveNotification(Notification(2, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    worker->flush();
+
+    // A partial temporary file left behind by an interrupted snapshot is not loaded
+    QFile staleFile(stateFileName + ".tmp");
+    QVERIFY(staleFile.open(QIODevice::WriteOnly));
+    staleFile.write("x");
+    staleFile.close();
+
+    // The notification snapshot can't be written while a directory occupies its temporary file
+    QVERIFY(QDir().mkdir(notificationsFileName + ".tmp"));
+    worker->saveNotification(Notification(3, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    notifications.insert(2, Notification(2, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    notifications.insert(3, Notification(3, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0));
+    worker->saveSnapshot(7, QHash<uint, NotificationGroup>(), notifications);
+    worker->flush();
+    QVERIFY(QDir().rmdir(notificationsFileName + ".tmp"));
+    QVERIFY(!QFile::exists(stateFileName + ".tmp"));
+
+    // The previous snapshot is intact and the changes the failed snapshot superseded were journaled
+    QCOMPARE(worker->journalRecordCount(), (uint)2);
+    QHash<uint, Notification> storedNotifications;
+    QHash<uint, NotificationGroup> storedGroups;
+    quint32 lastUsedUserId = 0;
+    readStore(storedNotifications, storedGroups, lastUsedUserId);
+    QList<uint> notificationIds = storedNotifications.keys();
+    qSort(notificationIds);
+    QCOMPARE(notificationIds, QList<uint>() << 1 << 2 << 3);
+    QCOMPARE(storedGroups.keys(), QList<uint>() << 1);
+    QCOMPARE(lastUsedUserId, (quint32)3);
+
+    // The snapshot replaces the previous one once it can be written
+    worker->saveSnapshot(7, QHash<uint, NotificationGroup>(), notifications);
+    worker->flush();
+    QCOMPARE(worker->journalRecordCount(), (uint)0);
+    QVERIFY(!QFile::exists(journalFileName));
+
+    storedNotifications.clear();
+    storedGroups.clear();
+    readStore(storedNotifications, storedGroups, lastUsedUserId);
+    notificationIds = storedNotifications.keys();
+    qSort(notificationIds);
+    QCOMPARE(notificationIds, QList<uint>() << 1 << 2 << 3);
+    QVERIFY(storedGroups.isEmpty());
+    QCOMPARE(lastUsedUserId, (quint32)7);
+}
+
+void Ut_NotificationPersistenceWorker::testDestroyingWorkerWritesQueuedChanges()
+{
+    worker->saveGroup(NotificationGroup(4, 0, NotificationParameters()));
+    delete worker;
+    worker = NULL;
+
+    QHash<uint, Notification> notifications;
+    QHash<uint, NotificationGroup> groups;
+    quint32 lastUsedUserId = 0;
+    readStore(notifications, groups, lastUsedUserId);
+    QCOMPARE(groups.keys(), QList<uint>() << 4);
+}
+
+QTEST_MAIN(Ut_NotificationPersistenceWorker)
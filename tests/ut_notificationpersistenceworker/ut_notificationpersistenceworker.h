@@ -0,0 +1,70 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef UT_NOTIFICATIONPERSISTENCEWORKER_H
+#define UT_NOTIFICATIONPERSISTENCEWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+
+class NotificationPersistenceWorker;
+class Notification;
+class NotificationGroup;
+
+class Ut_NotificationPersistenceWorker : public QObject
+{
+    Q_OBJECT
+
+private:
+    NotificationPersistenceWorker *worker;
+    QString journalFileName;
+    QString stateFileName;
+    QString notificationsFileName;
+
+    // Reads the snapshot and the journal written by the worker
+    void readStore(QHash<uint, Notification> &notifications, QHash<uint, NotificationGroup> &groups, quint32 &lastUsedUserId);
+
+private slots:
+    // Called before the first testfunction is executed
+    void initTestCase();
+    // Called after the last testfunction was executed
+    void cleanupTestCase();
+    // Called before each testfunction is executed
+    void init();
+    // Called after every testfunction
+    void cleanup();
+
+    // Test that queued changes are not written before the coalescing window expires
+    void testChangesAreNotWrittenImmediately();
+    // Test that changes are written when the coalescing window expires
+    void testChangesAreWrittenWhenCoalescingWindowExpires();
+    // Test that several changes to the same item are coalesced into one record
+    void testChangesToSameItemAreCoalesced();
+    // Test that a snapshot supersedes the changes queued before it and clears the journal
+    void testSnapshotSupersedesQueuedChanges();
+    // Test that changes queued after a snapshot are appended to the journal
+    void testChangesAfterSnapshotAreJournaled();
+    // Test that a snapshot that can't be written leaves the previous snapshot and the superseded changes loadable
+    void testFailedSnapshotKeepsPreviousDataLoadable();
+    // Test that destroying the worker writes the queued changes
+    void testDestroyingWorkerWritesQueuedChanges();
+};
+
+#endif
@@ -0,0 +1,28 @@
+include(../coverage.pri)
+include(../common_top.pri)
+TARGET = ut_notificationpersistenceworker
+INCLUDEPATH += $$NOTIFICATIONSRCDIR $$LIBNOTIFICATIONSRCDIR
+
+# unit test and unit
+SOURCES += \
+    ut_notificationpersistenceworker.cpp \
+    $$NOTIFICATIONSRCDIR/notificationpersistenceworker.cpp \
+    $$NOTIFICATIONSRCDIR/notificationsnapshot.cpp \
+    $$NOTIFICATIONSRCDIR/notificationjournal.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notification.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationgroup.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.cpp
+
+# unit test and unit
+HEADERS += \
+    ut_notificationpersistenceworker.h \
+    $$NOTIFICATIONSRCDIR/notificationpersistenceworker.h \
+    $$NOTIFICATIONSRCDIR/notificationsnapshot.h \
+    $$NOTIFICATIONSRCDIR/notificationjournal.h \
+    $$LIBNOTIFICATIONSRCDIR/notification.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationgroup.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.h
+
+include(../common_bot.pri)
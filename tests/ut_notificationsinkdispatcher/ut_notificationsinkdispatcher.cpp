@@ -0,0 +1,346 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include "ut_notificationsinkdispatcher.h"
+#include "notificationsinkdispatcher.h"
+
+// The calls made to the test sinks
+QStringList gSinkCalls;
+
+TestNotificationSink::TestNotificationSink(const QString &name) : name(name)
+{
+}
+
+void TestNotificationSink::addNotification(const Notification &notification)
+{
+    gSinkCalls.append(QString("%1 addNotification %2/%3").arg(name).arg(notification.notificationId()).arg(notification.userId()));
+}
+
+void TestNotificationSink::addNotifications(const QList<Notification> &notifications)
+{
+    QStringList ids;
+    foreach (const Notification &notification, notifications) {
+        ids.append(QString::number(notification.notificationId()));
+    }
+    gSinkCalls.append(QString("%1 addNotifications %2").arg(name).arg(ids.join(",")));
+}
+
+void TestNotificationSink::removeNotification(uint notificationId)
+{
+    gSinkCalls.append(QString("%1 removeNotification %2").arg(name).arg(notificationId));
+}
+
+void TestNotificationSink::removeNotifications(const QList<uint> &notificationIds)
+{
+    QStringList ids;
+    foreach (uint notificationId, notificationIds) {
+        ids.append(QString::number(notificationId));
+    }
+    gSinkCalls.append(QString("%1 removeNotifications %2").arg(name).arg(ids.join(",")));
+}
+
+void TestNotificationSink::addGroup(uint groupId, const NotificationParameters &parameters)
+{
+    gSinkCalls.append(QString("%1 addGroup %2/%3").arg(name).arg(groupId).arg(parameters.value("count").toInt()));
+}
+
+void TestNotificationSink::removeGroup(uint groupId)
+{
+    gSinkCalls.append(QString("%1 removeGroup %2").arg(name).arg(groupId));
+}
+
+RemovingNotificationSink::RemovingNotificationSink(const QString &name, NotificationSinkDispatcher *dispatcher, NotificationSink *removedSink, NotificationSink *destroyedSink) :
+    TestNotificationSink(name),
+    dispatcher(dispatcher),
+    removedSink(removedSink),
+    destroyedSink(destroyedSink)
+{
+}
+
+void RemovingNotificationSink::addNotification(const Notification &notification)
+{
+    TestNotificationSink::addNotification(notification);
+    if (removedSink != NULL) {
+        dispatcher->removeSink(removedSink);
+        removedSink = NULL;
+    }
+    delete destroyedSink;
+    destroyedSink = NULL;
+}
+
+static Notification createNotification(uint notificationId, uint userId = 0)
+{
+    return Notification(notificationId, 0, userId, NotificationParameters(), Notification::ApplicationEvent, 0);
+}
+
+static NotificationParameters createGroupParameters(int count)
+{
+    NotificationParameters parameters;
+    parameters.add("count", count);
+    return parameters;
+}
+
+void Ut_NotificationSinkDispatcher::initTestCase()
+{
+}
+
+void Ut_NotificationSinkDispatcher::cleanupTestCase()
+{
+}
+
+void Ut_NotificationSinkDispatcher::init()
+{
+    dispatcher = new NotificationSinkDispatcher(this);
+    gSinkCalls.clear();
+}
+
+void Ut_NotificationSinkDispatcher::cleanup()
+{
+    delete dispatcher;
+}
+
+void Ut_NotificationSinkDispatcher::testImmediateSinksAreCalledBeforeDeferredSinks()
+{
+    TestNotificationSink deferred("deferred");
+    TestNotificationSink first("first");
+    TestNotificationSink second("second");
+    dispatcher->addSink(&deferred, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::NotificationChanges);
+    dispatcher->addSink(&first, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::NotificationChanges);
+    dispatcher->addSink(&second, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::NotificationChanges);
+
+    emit notificationUpdated(createNotification(1));
+    emit notificationRemoved(2);
+    QCOMPARE(gSinkCalls, QStringList() << "first addNotification 1/0" << "second addNotification 1/0" << "first removeNotification 2" << "second removeNotification 2");
+
+    gSinkCalls.clear();
+    dispatcher->flush();
+    QCOMPARE(gSinkCalls, QStringList() << "deferred addNotification 1/0" << "deferred removeNotification 2");
+
+    // Nothing is delivered twice
+    gSinkCalls.clear();
+    dispatcher->flush();
+    QVERIFY(gSinkCalls.isEmpty());
+}
+
+void Ut_NotificationSinkDispatcher::testSinksGetOnlySubscribedChanges()
+{
+    TestNotificationSink notifications("notifications");
+    TestNotificationSink groups("groups");
+    TestNotificationSink restored("restored");
+    dispatcher->addSink(&notifications, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::NotificationChanges);
+    dispatcher->addSink(&groups, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::GroupChanges);
+    dispatcher->addSink(&restored, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::RestoredNotifications);
+
+    emit notificationUpdated(createNotification(1));
+    emit notificationsUpdated(QList<Notification>() << createNotification(2) << createNotification(3));
+    emit notificationRemoved(1);
+    emit notificationsRemoved(QList<uint>() << 2 << 3);
+    emit groupUpdated(4, createGroupParameters(1));
+    emit groupRemoved(4);
+    emit notificationsRestored(QList<Notification>() << createNotification(5) << createNotification(6));
+
+    QCOMPARE(gSinkCalls, QStringList() <<
+             "notifications addNotification 1/0" <<
+             "notifications addNotifications 2,3" <<
+             "notifications removeNotification 1" <<
+             "notifications removeNotifications 2,3" <<
+             "groups addGroup 4/1" <<
+             "groups removeGroup 4" <<
+             "restored addNotifications 5,6");
+}
+
+void Ut_NotificationSinkDispatcher::testAlertSinksGetAlertsAndRemovals()
+{
+    TestNotificationSink immediate("immediate");
+    TestNotificationSink deferred("deferred");
+    TestNotificationSink state("state");
+    dispatcher->addSink(&immediate, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::NotificationAlerts);
+    dispatcher->addSink(&deferred, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::NotificationAlerts);
+    dispatcher->addSink(&state, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::AllChanges);
+
+    emit notificationsUpdated(QList<Notification>() << createNotification(1) << createNotification(2) << createNotification(3));
+    emit notificationAlerted(createNotification(1));
+    emit notificationRemoved(3);
+    QCOMPARE(gSinkCalls, QStringList() <<
+             "state addNotifications 1,2,3" <<
+             "immediate addNotification 1/0" <<
+             "immediate removeNotification 3" <<
+             "state removeNotification 3");
+
+    gSinkCalls.clear();
+    dispatcher->flush();
+    QCOMPARE(gSinkCalls, QStringList() << "deferred addNotification 1/0" << "deferred removeNotification 3");
+
+    // An alert for a notification removed before the flush is not delivered
+    emit notificationAlerted(createNotification(2, 1));
+    emit notificationAlerted(createNotification(2, 2));
+    emit notificationRemoved(2);
+    gSinkCalls.clear();
+    dispatcher->flush();
+    QCOMPARE(gSinkCalls, QStringList() << "deferred removeNotification 2");
+}
+
+void Ut_NotificationSinkDispatcher::testDeferredChangesAreCoalesced()
+{
+    TestNotificationSink deferred("deferred");
+    dispatcher->addSink(&deferred, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::AllChanges);
+
+    emit notificationUpdated(createNotification(1, 1));
+    emit groupUpdated(3, createGroupParameters(1));
+    emit notificationUpdated(createNotification(2));
+    emit notificationUpdated(createNotification(1, 2));
+    emit groupUpdated(3, createGroupParameters(2));
+    emit notificationRemoved(2);
+    QVERIFY(gSinkCalls.isEmpty());
+
+    // The latest contents are delivered once and the removed notification is only removed
+    dispatcher->flush();
+    QCOMPARE(gSinkCalls, QStringList() << "deferred addNotification 1/2" << "deferred addGroup 3/2" << "deferred removeNotification 2");
+
+    // A notification updated again after its removal is delivered again
+    gSinkCalls.clear();
+    emit notificationRemoved(1);
+    emit notificationUpdated(createNotification(1, 3));
+    dispatcher->flush();
+    QCOMPARE(gSinkCalls, QStringList() << "deferred removeNotification 1" << "deferred addNotification 1/3");
+}
+
+void Ut_NotificationSinkDispatcher::testConsecutiveDeferredChangesAreDeliveredAtOnce()
+{
+    TestNotificationSink deferred("deferred");
+    dispatcher->addSink(&deferred, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::NotificationChanges);
+
+    emit notificationUpdated(createNotification(1));
+    emit notificationsUpdated(QList<Notification>() << createNotification(2) << createNotification(3));
+    emit notificationRemoved(4);
+    emit notificationsRemoved(QList<uint>() << 5 << 6);
+    emit notificationUpdated(createNotification(7));
+    dispatcher->flush();
+
+    QCOMPARE(gSinkCalls, QStringList() << "deferred addNotifications 1,2,3" << "deferred removeNotifications 4,5,6" << "deferred addNotification 7/0");
+}
+
+void Ut_NotificationSinkDispatcher::testRestoredNotificationsAreDeliveredAtOnce()
+{
+    TestNotificationSink immediate("immediate");
+    TestNotificationSink deferred("deferred");
+    dispatcher->addSink(&immediate, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::RestoredNotifications);
+    dispatcher->addSink(&deferred, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::RestoredNotifications);
+
+    emit notificationsRestored(QList<Notification>() << createNotification(1) << createNotification(2) << createNotification(3));
+    QCOMPARE(gSinkCalls, QStringList() << "immediate addNotifications 1,2,3");
+
+    gSinkCalls.clear();
+    dispatcher->flush();
+    QCOMPARE(gSinkCalls, QStringList() << "deferred addNotifications 1,2,3");
+
+    // A single restored notification is added as such
+    gSinkCalls.clear();
+    emit notificationsRestored(QList<Notification>() << createNotification(4));
+    dispatcher->flush();
+    QCOMPARE(gSinkCalls, QStringList() << "immediate addNotification 4/0" << "deferred addNotification 4/0");
+
+    // Restored notifications do not affect the latency of notification updates
+    QCOMPARE(dispatcher->latestLatency(&deferred), -1);
+}
+
+void Ut_NotificationSinkDispatcher::testNothingIsDeferredWithoutDeferredSinks()
+{
+    TestNotificationSink immediate("immediate");
+    TestNotificationSink deferred("deferred");
+    dispatcher->addSink(&immediate, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::AllChanges);
+    dispatcher->addSink(&deferred, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::GroupChanges);
+
+    emit notificationUpdated(createNotification(1));
+    emit notificationsRestored(QList<Notification>() << createNotification(2));
+    QVERIFY(dispatcher->changes.isEmpty());
+    QVERIFY(!dispatcher->flushScheduled);
+
+    emit groupUpdated(3, createGroupParameters(1));
+    QCOMPARE(dispatcher->changes.count(), 1);
+    QVERIFY(dispatcher->flushScheduled);
+}
+
+void Ut_NotificationSinkDispatcher::testLatencyIsMeasured()
+{
+    TestNotificationSink immediate("immediate");
+    TestNotificationSink deferred("deferred");
+    dispatcher->addSink(&immediate, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::NotificationChanges);
+    dispatcher->addSink(&deferred, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::NotificationChanges);
+    QCOMPARE(dispatcher->latestLatency(&immediate), -1);
+    QCOMPARE(dispatcher->maximumLatency(&deferred), -1);
+
+    emit notificationUpdated(createNotification(1));
+    QVERIFY(dispatcher->latestLatency(&immediate) >= 0);
+    QCOMPARE(dispatcher->latestLatency(&deferred), -1);
+
+    QTest::qSleep(20);
+    dispatcher->flush();
+    QVERIFY(dispatcher->latestLatency(&deferred) >= 20);
+    QCOMPARE(dispatcher->maximumLatency(&deferred), dispatcher->latestLatency(&deferred));
+
+    // Removals do not change the latency
+    int latency = dispatcher->latestLatency(&deferred);
+    emit notificationRemoved(1);
+    dispatcher->flush();
+    QCOMPARE(dispatcher->latestLatency(&deferred), latency);
+
+    QCOMPARE(dispatcher->latestLatency(NULL), -1);
+}
+
+void Ut_NotificationSinkDispatcher::testRemovedSinksAreNotCalled()
+{
+    TestNotificationSink *destroyed = new TestNotificationSink("destroyed");
+    TestNotificationSink removed("removed");
+    dispatcher->addSink(destroyed, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::NotificationChanges);
+    dispatcher->addSink(&removed, NotificationSinkDispatcher::Immediate, NotificationSinkDispatcher::NotificationChanges);
+
+    emit notificationUpdated(createNotification(1));
+    gSinkCalls.clear();
+    delete destroyed;
+    dispatcher->removeSink(&removed);
+    emit notificationUpdated(createNotification(2));
+    dispatcher->flush();
+
+    QVERIFY(gSinkCalls.isEmpty());
+    QVERIFY(dispatcher->sinks_.isEmpty());
+}
+
+void Ut_NotificationSinkDispatcher::testSinksRemovedDuringDeliveryAreNotCalled()
+{
+    TestNotificationSink removed("removed");
+    TestNotificationSink *destroyed = new TestNotificationSink("destroyed");
+    RemovingNotificationSink remover("remover", dispatcher, &removed, destroyed);
+    dispatcher->addSink(&remover, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::NotificationChanges);
+    dispatcher->addSink(&removed, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::NotificationChanges);
+    dispatcher->addSink(destroyed, NotificationSinkDispatcher::Deferred, NotificationSinkDispatcher::NotificationChanges);
+
+    emit notificationUpdated(createNotification(1));
+    dispatcher->flush();
+    QCOMPARE(gSinkCalls, QStringList() << "remover addNotification 1/0");
+    QCOMPARE(dispatcher->sinks_.count(), 1);
+
+    gSinkCalls.clear();
+    emit notificationUpdated(createNotification(2));
+    dispatcher->flush();
+    QCOMPARE(gSinkCalls, QStringList() << "remover addNotification 2/0");
+}
+
+QTEST_APPLESS_MAIN(Ut_NotificationSinkDispatcher)
@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef UT_NOTIFICATIONSINKDISPATCHER_H
+#define UT_NOTIFICATIONSINKDISPATCHER_H
+
+#include <QObject>
+#include "notificationsink.h"
+
+class NotificationSinkDispatcher;
+
+//! A sink that logs the calls made to it
+class TestNotificationSink : public NotificationSink
+{
+    Q_OBJECT
+
+public:
+    TestNotificationSink(const QString &name);
+
+    virtual void addNotification(const Notification &notification);
+    virtual void addNotifications(const QList<Notification> &notifications);
+    virtual void removeNotification(uint notificationId);
+    virtual void removeNotifications(const QList<uint> &notificationIds);
+    virtual void addGroup(uint groupId, const NotificationParameters &parameters);
+    virtual void removeGroup(uint groupId);
+
+private:
+    QString name;
+};
+
+//! A test sink that removes one sink and destroys another when it is sent a notification
+class RemovingNotificationSink : public TestNotificationSink
+{
+public:
+    RemovingNotificationSink(const QString &name, NotificationSinkDispatcher *dispatcher, NotificationSink *removedSink, NotificationSink *destroyedSink);
+
+    virtual void addNotification(const Notification &notification);
+
+private:
+    NotificationSinkDispatcher *dispatcher;
+    NotificationSink *removedSink;
+    NotificationSink *destroyedSink;
+};
+
+class Ut_NotificationSinkDispatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Called before the first testfunction is executed
+    void initTestCase();
+    // Called after the last testfunction was executed
+    void cleanupTestCase();
+    // Called before each testfunction is executed
+    void init();
+    // Called after every testfunction
+    void cleanup();
+
+    // Test that immediate sinks are called right away in the order they were added and deferred sinks on flush
+    void testImmediateSinksAreCalledBeforeDeferredSinks();
+    // Test that the sinks are called only for the changes they are subscribed to
+    void testSinksGetOnlySubscribedChanges();
+    // Test that alert sinks get the alerts and the removals but not the updates
+    void testAlertSinksGetAlertsAndRemovals();
+    // Test that deferred changes to the same notification or group are coalesced
+    void testDeferredChangesAreCoalesced();
+    // Test that consecutive deferred changes are delivered at once
+    void testConsecutiveDeferredChangesAreDeliveredAtOnce();
+    // Test that the restored notifications are delivered at once to both latency classes
+    void testRestoredNotificationsAreDeliveredAtOnce();
+    // Test that nothing is deferred when there are no deferred sinks
+    void testNothingIsDeferredWithoutDeferredSinks();
+    // Test that the latency of the notification updates is measured for each sink
+    void testLatencyIsMeasured();
+    // Test that destroyed and removed sinks are not called
+    void testRemovedSinksAreNotCalled();
+    // Test that sinks removed or destroyed by another sink during a delivery are not called
+    void testSinksRemovedDuringDeliveryAreNotCalled();
+
+signals:
+    void notificationUpdated(const Notification &notification);
+    void notificationsUpdated(const QList<Notification> &notifications);
+    void notificationRemoved(uint notificationId);
+    void notificationsRemoved(const QList<uint> &notificationIds);
+    void groupUpdated(uint groupId, const NotificationParameters &parameters);
+    void groupRemoved(uint groupId);
+    void notificationsRestored(const QList<Notification> &notifications);
+    void notificationAlerted(const Notification &notification);
+
+private:
+    // The object being tested
+    NotificationSinkDispatcher *dispatcher;
+};
+
+#endif
@@ -0,0 +1,24 @@
+include(../coverage.pri)
+include(../common_top.pri)
+TARGET = ut_notificationsinkdispatcher
+INCLUDEPATH += $$NOTIFICATIONSRCDIR $$LIBNOTIFICATIONSRCDIR
+
+# unit test and unit
+SOURCES += \
+    ut_notificationsinkdispatcher.cpp \
+    $$NOTIFICATIONSRCDIR/notificationsinkdispatcher.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationsink.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notification.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.cpp
+
+# unit test and unit
+HEADERS += \
+    ut_notificationsinkdispatcher.h \
+    $$NOTIFICATIONSRCDIR/notificationsinkdispatcher.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationsink.h \
+    $$LIBNOTIFICATIONSRCDIR/notification.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.h
+
+include(../common_bot.pri)
@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include "ut_notificationsinkfilter.h"
+#include "notificationsinkfilter.h"
+#include "notification.h"
+#include "genericnotificationparameterfactory.h"
+
+static Notification createNotification(uint userId, const QString &eventType, Notification::NotificationType type = Notification::ApplicationEvent)
+{
+    NotificationParameters parameters;
+    if (!eventType.isEmpty()) {
+        parameters.add(GenericNotificationParameterFactory::eventTypeKey(), eventType);
+    }
+    return Notification(1, 0, userId, parameters, type, 0);
+}
+
+void Ut_NotificationSinkFilter::initTestCase()
+{
+}
+
+void Ut_NotificationSinkFilter::cleanupTestCase()
+{
+}
+
+void Ut_NotificationSinkFilter::init()
+{
+}
+
+void Ut_NotificationSinkFilter::cleanup()
+{
+}
+
+void Ut_NotificationSinkFilter::testDefaultFilterMatchesEverything()
+{
+    NotificationSinkFilter filter;
+    QVERIFY(filter.matchesAllNotifications());
+    QVERIFY(filter.acceptsGroups());
+    QVERIFY(filter.matches(createNotification(1, "x-nokia.message.received", Notification::SystemEvent)));
+    QVERIFY(filter.matches(Notification()));
+
+    NotificationSinkFilter emptyFilter(QStringList(), 0, QString(), true);
+    QVERIFY(emptyFilter.matchesAllNotifications());
+}
+
+void Ut_NotificationSinkFilter::testEventTypes_data()
+{
+    QTest::addColumn<QStringList>("eventTypes");
+    QTest::addColumn<QString>("eventType");
+    QTest::addColumn<bool>("matches");
+
+    QStringList eventTypes = QStringList() << "x-nokia.message.received" << "x-nokia.call.*" << "email.arriv?d";
+    QTest::newRow("Exact name") << eventTypes << "x-nokia.message.received" << true;
+    QTest::newRow("Other name") << eventTypes << "x-nokia.message.sent" << false;
+    QTest::newRow("Star pattern") << eventTypes << "x-nokia.call.missed" << true;
+    QTest::newRow("Star pattern, wrong prefix") << eventTypes << "x-nokia.callx" << false;
+    QTest::newRow("Question mark pattern") << eventTypes << "email.arrived" << true;
+    QTest::newRow("Question mark pattern, too long") << eventTypes << "email.arrivved" << false;
+    QTest::newRow("No event type") << eventTypes << "" << false;
+}
+
+void Ut_NotificationSinkFilter::testEventTypes()
+{
+    QFETCH(QStringList, eventTypes);
+    QFETCH(QString, eventType);
+    QFETCH(bool, matches);
+
+    NotificationSinkFilter filter(eventTypes, 0, QString(), true);
+    QVERIFY(!filter.matchesAllNotifications());
+    QCOMPARE(filter.matches(createNotification(1, eventType)), matches);
+}
+
+void Ut_NotificationSinkFilter::testUserId()
+{
+    NotificationSinkFilter filter(QStringList(), 2, QString(), true);
+    QVERIFY(!filter.matchesAllNotifications());
+    QVERIFY(filter.matches(createNotification(2, "email")));
+    QVERIFY(!filter.matches(createNotification(3, "email")));
+}
+
+void Ut_NotificationSinkFilter::testClass()
+{
+    NotificationSinkFilter applicationFilter(QStringList(), 0, "application", true);
+    QVERIFY(!applicationFilter.matchesAllNotifications());
+    QVERIFY(applicationFilter.matches(createNotification(1, "email")));
+    QVERIFY(!applicationFilter.matches(createNotification(1, "email", Notification::SystemEvent)));
+
+    NotificationSinkFilter systemFilter(QStringList(), 0, "system", true);
+    QVERIFY(!systemFilter.matches(createNotification(1, "email")));
+    QVERIFY(systemFilter.matches(createNotification(1, "email", Notification::SystemEvent)));
+
+    // The class parameter is not looked at again, the type of the notification decides
+    NotificationParameters parameters;
+    parameters.add(GenericNotificationParameterFactory::classKey(), "system");
+    QVERIFY(applicationFilter.matches(Notification(1, 0, 1, parameters, Notification::ApplicationEvent, 0)));
+    QVERIFY(!systemFilter.matches(Notification(1, 0, 1, parameters, Notification::ApplicationEvent, 0)));
+}
+
+void Ut_NotificationSinkFilter::testGroups()
+{
+    QVERIFY(NotificationSinkFilter(QStringList() << "email", 0, QString(), true).acceptsGroups());
+    QVERIFY(!NotificationSinkFilter(QStringList() << "email", 0, QString(), false).acceptsGroups());
+}
+
+QTEST_MAIN(Ut_NotificationSinkFilter)
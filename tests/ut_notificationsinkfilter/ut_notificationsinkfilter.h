@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef UT_NOTIFICATIONSINKFILTER_H
+#define UT_NOTIFICATIONSINKFILTER_H
+
+#include <QObject>
+
+class Ut_NotificationSinkFilter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Called before the first testfunction is executed
+    void initTestCase();
+    // Called after the last testfunction was executed
+    void cleanupTestCase();
+    // Called before each testfunction is executed
+    void init();
+    // Called after every testfunction
+    void cleanup();
+
+    // Test that the default filter matches everything
+    void testDefaultFilterMatchesEverything();
+    // Test that plain event type names and wildcard patterns are matched
+    void testEventTypes_data();
+    void testEventTypes();
+    // Test that only the notifications of the given user ID are matched
+    void testUserId();
+    // Test that the class is matched and a missing class is treated as application
+    void testClass();
+    // Test that groups are accepted only when wanted
+    void testGroups();
+};
+
+#endif
@@ -0,0 +1,212 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QFile>
+#include <QDir>
+#include <QDataStream>
+#include "ut_notificationsnapshot.h"
+#include "notificationsnapshot.h"
+#include "notification.h"
+#include "notificationparameters.h"
+
+void Ut_NotificationSnapshot::initTestCase()
+{
+    snapshotFileName = QDir::tempPath() + "/ut_notificationsnapshot.data";
+}
+
+void Ut_NotificationSnapshot::cleanupTestCase()
+{
+}
+
+void Ut_NotificationSnapshot::init()
+{
+    QFile::remove(snapshotFileName);
+}
+
+void Ut_NotificationSnapshot::cleanup()
+{
+    QFile::remove(snapshotFileName);
+}
+
+void Ut_NotificationSnapshot::testEmptySnapshot()
+{
+    NotificationSnapshot snapshot;
+    QCOMPARE(snapshot.count(), 0);
+
+    QVERIFY(snapshot.load(NotificationSnapshot::serialize(QList<Notification>())));
+    QCOMPARE(snapshot.count(), 0);
+}
+
+void Ut_NotificationSnapshot::testSerializingAndReadingNotifications()
+{
+    NotificationParameters parameters0;
+    parameters0.add("eventType", "email");
+    parameters0.add("summary", "summary0");
+    parameters0.add("count", 5);
+    NotificationParameters parameters1;
+    parameters1.add("body", "body1");
+    parameters1.add("persistent", true);
+
+    QList<Notification> notifications;
+    notifications << Notification(7, 2, 3, parameters0, Notification::ApplicationEvent, 1000);
+    notifications << Notification(4, 0, 5, parameters1, Notification::SystemEvent, 0);
+
+    NotificationSnapshot snapshot;
+    QVERIFY(snapshot.load(NotificationSnapshot::serialize(notifications)));
+    QCOMPARE(snapshot.count(), 2);
+
+    Notification notification = snapshot.notification(0);
+    QCOMPARE(notification.notificationId(), (uint)4);
+    QCOMPARE(notification.groupId(), (uint)0);
+    QCOMPARE(notification.userId(), (uint)5);
+    QCOMPARE(notification.type(), Notification::SystemEvent);
+    QCOMPARE(notification.timeout(), 0);
+    QCOMPARE(notification.parameters().count(), 2);
+    QCOMPARE(notification.parameters().value("body"), QVariant("body1"));
+    QCOMPARE(notification.parameters().value("persistent"), QVariant(true));
+
+    notification = snapshot.notification(1);
+    QCOMPARE(notification.notificationId(), (uint)7);
+    QCOMPARE(notification.groupId(), (uint)2);
+    QCOMPARE(notification.userId(), (uint)3);
+    QCOMPARE(notification.type(), Notification::ApplicationEvent);
+    QCOMPARE(notification.timeout(), 1000);
+    QCOMPARE(notification.parameters().count(), 3);
+    QCOMPARE(notification.parameters().value("eventType"), QVariant("email"));
+    QCOMPARE(notification.parameters().value("summary"), QVariant("summary0"));
+    QCOMPARE(notification.parameters().value("count"), QVariant(5));
+}
+
+void Ut_NotificationSnapshot::testOpeningSnapshotFile()
+{
+    NotificationParameters parameters;
+    parameters.add("summary", "summary");
+    QFile file(snapshotFileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(NotificationSnapshot::serialize(QList<Notification>() << Notification(1, 2, 3, parameters, Notification::ApplicationEvent, 0)));
+    file.close();
+
+    NotificationSnapshot snapshot;
+    QVERIFY(snapshot.open(snapshotFileName));
+    QCOMPARE(snapshot.count(), 1);
+    QCOMPARE(snapshot.notificationId(0), (uint)1);
+    QCOMPARE(snapshot.notification(0).parameters().value("summary"), QVariant("summary"));
+
+    snapshot.close();
+    QCOMPARE(snapshot.count(), 0);
+}
+
+void Ut_NotificationSnapshot::testOpeningMissingFile()
+{
+    NotificationSnapshot snapshot;
+    QVERIFY(!snapshot.open(snapshotFileName));
+    QCOMPARE(snapshot.count(), 0);
+}
+
+void Ut_NotificationSnapshot::testReadingHeadersDoesNotDecodeParameters()
+{
+    NotificationParameters parameters0;
+    parameters0.add("eventType", "email");
+    parameters0.add("persistent", false);
+    parameters0.add("body", "body");
+    NotificationParameters parameters1;
+    parameters1.add("body", "body");
+
+    QList<Notification> notifications;
+    notifications << Notification(1, 2, 3, parameters0, Notification::ApplicationEvent, 0);
+    notifications << Notification(2, 4, 3, parameters1, Notification::ApplicationEvent, 0);
+
+    NotificationSnapshot snapshot;
+    QVERIFY(snapshot.load(NotificationSnapshot::serialize(notifications)));
+    QCOMPARE(snapshot.notificationId(0), (uint)1);
+    QCOMPARE(snapshot.groupId(0), (uint)2);
+    QCOMPARE(snapshot.eventType(0), QString("email"));
+    QCOMPARE(snapshot.persistent(0), QVariant(false));
+    QCOMPARE(snapshot.notificationId(1), (uint)2);
+    QCOMPARE(snapshot.groupId(1), (uint)4);
+    QCOMPARE(snapshot.eventType(1), QString());
+    QVERIFY(!snapshot.persistent(1).isValid());
+
+    // Only the event type should have been decoded
+    QCOMPARE(snapshot.decodedStrings.count(true), 1);
+}
+
+void Ut_NotificationSnapshot::testStringsAreStoredOnceAndShared()
+{
+    NotificationParameters parameters;
+    parameters.add("body", "shared body");
+
+    QList<Notification> notifications;
+    notifications << Notification(1, 0, 3, parameters, Notification::ApplicationEvent, 0);
+    notifications << Notification(2, 0, 3, parameters, Notification::ApplicationEvent, 0);
+
+    QByteArray data = NotificationSnapshot::serialize(notifications);
+    QCOMPARE(data.count("shared body"), 1);
+    QCOMPARE(data.count("body"), 2);
+
+    NotificationSnapshot snapshot;
+    QVERIFY(snapshot.load(data));
+    QString body0 = snapshot.notification(0).parameters().value("body").toString();
+    QString body1 = snapshot.notification(1).parameters().value("body").toString();
+    QCOMPARE(body0, QString("shared body"));
+    QVERIFY(body0.constData() == body1.constData());
+}
+
+void Ut_NotificationSnapshot::testReadingLegacySnapshot()
+{
+    NotificationParameters parameters;
+    parameters.add("eventType", "email");
+    parameters.add("persistent", true);
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << Notification(5, 1, 2, parameters, Notification::ApplicationEvent, 0);
+    stream << Notification(3, 1, 2, NotificationParameters(), Notification::SystemEvent, 1000);
+
+    NotificationSnapshot snapshot;
+    QVERIFY(snapshot.load(data));
+    QCOMPARE(snapshot.count(), 2);
+    QCOMPARE(snapshot.notificationId(0), (uint)3);
+    QCOMPARE(snapshot.notification(0).type(), Notification::SystemEvent);
+    QCOMPARE(snapshot.notificationId(1), (uint)5);
+    QCOMPARE(snapshot.groupId(1), (uint)1);
+    QCOMPARE(snapshot.eventType(1), QString("email"));
+    QCOMPARE(snapshot.persistent(1), QVariant(true));
+    QCOMPARE(snapshot.notification(1).userId(), (uint)2);
+}
+
+void Ut_NotificationSnapshot::testReadingTruncatedSnapshot()
+{
+    NotificationParameters parameters;
+    parameters.add("summary", "summary");
+    QByteArray data = NotificationSnapshot::serialize(QList<Notification>() << Notification(1, 2, 3, parameters, Notification::ApplicationEvent, 0));
+
+    NotificationSnapshot snapshot;
+    QVERIFY(!snapshot.load(data.left(10)));
+    QCOMPARE(snapshot.count(), 0);
+
+    // A notification with a truncated payload is read without its parameters
+    QVERIFY(snapshot.load(data.left(data.size() - 1)));
+    QCOMPARE(snapshot.count(), 1);
+    QCOMPARE(snapshot.notification(0).notificationId(), (uint)1);
+    QCOMPARE(snapshot.notification(0).parameters().count(), 0);
+}
+
+QTEST_MAIN(Ut_NotificationSnapshot)
@@ -0,0 +1,61 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef UT_NOTIFICATIONSNAPSHOT_H
+#define UT_NOTIFICATIONSNAPSHOT_H
+
+#include <QObject>
+#include <QString>
+
+class Ut_NotificationSnapshot : public QObject
+{
+    Q_OBJECT
+
+private:
+    QString snapshotFileName;
+
+private slots:
+    // Called before the first testfunction is executed
+    void initTestCase();
+    // Called after the last testfunction was executed
+    void cleanupTestCase();
+    // Called before each testfunction is executed
+    void init();
+    // Called after every testfunction
+    void cleanup();
+
+    // Test that an empty snapshot contains no notifications
+    void testEmptySnapshot();
+    // Test that serialized notifications are read back sorted by ID
+    void testSerializingAndReadingNotifications();
+    // Test that a snapshot file can be opened
+    void testOpeningSnapshotFile();
+    // Test that opening a missing file fails
+    void testOpeningMissingFile();
+    // Test that the notification headers are read without decoding the parameters
+    void testReadingHeadersDoesNotDecodeParameters();
+    // Test that strings are stored only once and shared by the decoded notifications
+    void testStringsAreStoredOnceAndShared();
+    // Test that snapshots written by earlier versions are read
+    void testReadingLegacySnapshot();
+    // Test that truncated snapshots are rejected
+    void testReadingTruncatedSnapshot();
+};
+
+#endif
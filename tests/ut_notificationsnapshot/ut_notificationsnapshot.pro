@@ -0,0 +1,22 @@
+include(../coverage.pri)
+include(../common_top.pri)
+TARGET = ut_notificationsnapshot
+INCLUDEPATH += $$NOTIFICATIONSRCDIR $$LIBNOTIFICATIONSRCDIR
+
+# unit test and unit
+SOURCES += \
+    ut_notificationsnapshot.cpp \
+    $$NOTIFICATIONSRCDIR/notificationsnapshot.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notification.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.cpp
+
+# unit test and unit
+HEADERS += \
+    ut_notificationsnapshot.h \
+    $$NOTIFICATIONSRCDIR/notificationsnapshot.h \
+    $$LIBNOTIFICATIONSRCDIR/notification.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.h
+
+include(../common_bot.pri)
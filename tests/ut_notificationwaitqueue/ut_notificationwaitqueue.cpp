@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include "ut_notificationwaitqueue.h"
+#include "notificationwaitqueue.h"
+#include "notification.h"
+#include "notificationparameters.h"
+
+static Notification createNotification(uint notificationId)
+{
+    return Notification(notificationId, 0, 0, NotificationParameters(), Notification::ApplicationEvent, 0);
+}
+
+void Ut_NotificationWaitQueue::initTestCase()
+{
+}
+
+void Ut_NotificationWaitQueue::cleanupTestCase()
+{
+}
+
+void Ut_NotificationWaitQueue::init()
+{
+    queue = new NotificationWaitQueue;
+}
+
+void Ut_NotificationWaitQueue::cleanup()
+{
+    delete queue;
+}
+
+void Ut_NotificationWaitQueue::testSamePriorityIsFirstInFirstOut()
+{
+    queue->enqueue(createNotification(3), 1);
+    queue->enqueue(createNotification(1), 1);
+    queue->enqueue(createNotification(2), 1);
+
+    QCOMPARE(queue->size(), 3);
+    QCOMPARE(queue->dequeue().notificationId(), (uint)3);
+    QCOMPARE(queue->dequeue().notificationId(), (uint)1);
+    QCOMPARE(queue->dequeue().notificationId(), (uint)2);
+    QVERIFY(queue->isEmpty());
+}
+
+void Ut_NotificationWaitQueue::testHigherPriorityIsDequeuedFirst()
+{
+    queue->enqueue(createNotification(1), 2);
+    queue->enqueue(createNotification(2), 1);
+    queue->enqueue(createNotification(3), 0);
+    queue->enqueue(createNotification(4), 1);
+    queue->enqueue(createNotification(5), 0);
+
+    QCOMPARE(queue->dequeue().notificationId(), (uint)3);
+    QCOMPARE(queue->dequeue().notificationId(), (uint)5);
+    QCOMPARE(queue->dequeue().notificationId(), (uint)2);
+    QCOMPARE(queue->dequeue().notificationId(), (uint)4);
+    QCOMPARE(queue->dequeue().notificationId(), (uint)1);
+}
+
+void Ut_NotificationWaitQueue::testUpdatingKeepsPosition()
+{
+    queue->enqueue(createNotification(1), 1);
+    queue->enqueue(createNotification(2), 1);
+
+    NotificationParameters parameters;
+    parameters.add("body", "body1");
+    QVERIFY(queue->updateParameters(1, parameters));
+
+    Notification notification = queue->dequeue();
+    QCOMPARE(notification.notificationId(), (uint)1);
+    QCOMPARE(notification.parameters().value("body").toString(), QString("body1"));
+}
+
+void Ut_NotificationWaitQueue::testUpdatingNonexistingNotification()
+{
+    queue->enqueue(createNotification(1), 1);
+    QVERIFY(!queue->updateParameters(2, NotificationParameters()));
+}
+
+void Ut_NotificationWaitQueue::testRemoving()
+{
+    queue->enqueue(createNotification(1), 1);
+    queue->enqueue(createNotification(2), 1);
+    queue->enqueue(createNotification(3), 1);
+
+    QVERIFY(queue->remove(2));
+    QVERIFY(!queue->remove(2));
+    QVERIFY(!queue->contains(2));
+    QCOMPARE(queue->size(), 2);
+    QCOMPARE(queue->dequeue().notificationId(), (uint)1);
+    QCOMPARE(queue->dequeue().notificationId(), (uint)3);
+}
+
+void Ut_NotificationWaitQueue::testEnqueueingQueuedNotificationReplacesIt()
+{
+    queue->enqueue(createNotification(1), 1);
+    queue->enqueue(createNotification(2), 1);
+    queue->enqueue(createNotification(1), 1);
+
+    QCOMPARE(queue->size(), 2);
+    QCOMPARE(queue->dequeue().notificationId(), (uint)2);
+    QCOMPARE(queue->dequeue().notificationId(), (uint)1);
+}
+
+QTEST_MAIN(Ut_NotificationWaitQueue)
@@ -0,0 +1,58 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (directui@nokia.com)
+**
+** This file is part of systemui.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at directui@nokia.com.
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation
+** and appearing in the file LICENSE.LGPL included in the packaging
+** of this file.
+**
+****************************************************************************/
+
+#ifndef UT_NOTIFICATIONWAITQUEUE_H
+#define UT_NOTIFICATIONWAITQUEUE_H
+
+#include <QObject>
+
+class NotificationWaitQueue;
+
+class Ut_NotificationWaitQueue : public QObject
+{
+    Q_OBJECT
+
+private:
+    NotificationWaitQueue *queue;
+
+private slots:
+    // Called before the first testfunction is executed
+    void initTestCase();
+    // Called after the last testfunction was executed
+    void cleanupTestCase();
+    // Called before each testfunction is executed
+    void init();
+    // Called after every testfunction
+    void cleanup();
+
+    // Test that notifications with the same priority are dequeued in arrival order
+    void testSamePriorityIsFirstInFirstOut();
+    // Test that notifications are dequeued in priority order
+    void testHigherPriorityIsDequeuedFirst();
+    // Test that updating a queued notification keeps its position
+    void testUpdatingKeepsPosition();
+    // Test that updating a notification not in the queue fails
+    void testUpdatingNonexistingNotification();
+    // Test that removed notifications are not dequeued
+    void testRemoving();
+    // Test that enqueueing a queued notification again moves it
+    void testEnqueueingQueuedNotificationReplacesIt();
+};
+
+#endif
@@ -0,0 +1,22 @@
+include(../coverage.pri)
+include(../common_top.pri)
+TARGET = ut_notificationwaitqueue
+INCLUDEPATH += $$NOTIFICATIONSRCDIR $$LIBNOTIFICATIONSRCDIR
+
+# unit test and unit
+SOURCES += \
+    ut_notificationwaitqueue.cpp \
+    $$NOTIFICATIONSRCDIR/notificationwaitqueue.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notification.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.cpp \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.cpp
+
+# unit test and unit
+HEADERS += \
+    ut_notificationwaitqueue.h \
+    $$NOTIFICATIONSRCDIR/notificationwaitqueue.h \
+    $$LIBNOTIFICATIONSRCDIR/notification.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameter.h \
+    $$LIBNOTIFICATIONSRCDIR/notificationparameters.h
+
+include(../common_bot.pri)
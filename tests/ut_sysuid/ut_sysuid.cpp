@@ -46,6 +46,7 @@
 #include "unlockmissedevents_stub.h"
 #include "unlocknotificationsinkstub.h"
 #include "notificationstatusindicatorsink_stub.h"
+#include "notificationsinkdispatcher_stub.h"
 #include "shutdownui_stub.h"
 #include "usbui_stub.h"
 #include "lockscreenwindow_stub.h"
@@ -186,6 +187,7 @@ void Ut_Sysuid::init()
 {
     gInstalledTranslationCatalogs.clear();
     gDefaultLocale = NULL;
+    gNotificationSinkDispatcherStub->stubReset();
     sysuid = new Sysuid(NULL);
     Ut_SysuidCompositorNotificationState = false;
     Ut_SysuidFeedbackNotificationState = false;
@@ -208,15 +210,7 @@ void Ut_Sysuid::testInitialization()
 void Ut_Sysuid::testSignalConnections()
 {
     QVERIFY(disconnect(sysuid->statusIndicatorMenuBusinessLogic, SIGNAL(statusIndicatorMenuVisibilityChanged(bool)), sysuid, SLOT(updateCompositorNotificationSinkEnabledStatus())));
-    QVERIFY(disconnect(sysuid->notificationManager, SIGNAL(notificationUpdated (const Notification &)), sysuid->mCompositorNotificationSink, SLOT(addNotification (const Notification &))));
-    QVERIFY(disconnect(sysuid->notificationManager, SIGNAL(notificationRemoved(uint)), sysuid->mCompositorNotificationSink, SLOT(removeNotification(uint))));
     QVERIFY(disconnect(sysuid->mCompositorNotificationSink, SIGNAL(notificationRemovalRequested(uint)), sysuid->notificationManager, SLOT(removeNotification(uint))));
-    QVERIFY(disconnect(sysuid->notificationManager, SIGNAL(notificationUpdated (const Notification &)), sysuid->ngfNotificationSink, SLOT(addNotification (const Notification &))));
-    QVERIFY(disconnect(sysuid->notificationManager, SIGNAL(notificationRemoved(uint)), sysuid->ngfNotificationSink, SLOT(removeNotification(uint))));
-    QVERIFY(disconnect(sysuid->notificationManager, SIGNAL(notificationUpdated(const Notification &)), sysuid->notificationStatusIndicatorSink_, SLOT(addNotification(const Notification &))));
-    QVERIFY(disconnect(sysuid->notificationManager, SIGNAL(notificationRemoved(uint)), sysuid->notificationStatusIndicatorSink_, SLOT(removeNotification(uint))));
-    QVERIFY(disconnect(sysuid->notificationManager, SIGNAL(notificationRestored(const Notification &)), sysuid->notificationStatusIndicatorSink_, SLOT(addNotification(const Notification &))));
-    QVERIFY(disconnect(sysuid->notificationManager, SIGNAL(groupUpdated(uint, const NotificationParameters &)), sysuid->notificationStatusIndicatorSink_, SLOT(addGroup(uint, const NotificationParameters &))));
     QVERIFY(disconnect(sysuid->screenLockBusinessLogic, SIGNAL(screenIsLocked(bool)), sysuid, SLOT(updateCompositorNotificationSinkEnabledStatus())));
     QVERIFY(disconnect(sysuid->screenLockBusinessLogic, SIGNAL(screenIsLocked(bool)), sysuid->mCompositorNotificationSink, SLOT(setTouchScreenLockActive(bool))));
     QVERIFY(disconnect(sysuid->screenLockBusinessLogic, SIGNAL(screenIsLocked(bool)), sysuid->batteryBusinessLogic, SLOT(setTouchScreenLockActive(bool))));
@@ -227,6 +221,25 @@ void Ut_Sysuid::testSignalConnections()
 #endif
 }
 
+void Ut_Sysuid::testNotificationSinksAreAddedToDispatcher()
+{
+    QCOMPARE(gNotificationSinkDispatcherStub->stubLastCallTo("NotificationSinkDispatcherConstructor").parameter<QObject *>(0), (QObject *)sysuid->notificationManager);
+
+    QList<MethodCall *> calls = gNotificationSinkDispatcherStub->stubCallsTo("addSink");
+    QCOMPARE(calls.count(), 3);
+
+    // The feedback and the status indicator are updated before the banners
+    QCOMPARE(calls.at(0)->parameter<NotificationSink *>(0), (NotificationSink *)sysuid->ngfNotificationSink);
+    QCOMPARE(calls.at(0)->parameter<NotificationSinkDispatcher::LatencyClass>(1), NotificationSinkDispatcher::Immediate);
+    QCOMPARE(calls.at(0)->parameter<NotificationSinkDispatcher::Subscriptions>(2), NotificationSinkDispatcher::Subscriptions(NotificationSinkDispatcher::NotificationAlerts));
+    QCOMPARE(calls.at(1)->parameter<NotificationSink *>(0), (NotificationSink *)sysuid->notificationStatusIndicatorSink_);
+    QCOMPARE(calls.at(1)->parameter<NotificationSinkDispatcher::LatencyClass>(1), NotificationSinkDispatcher::Immediate);
+    QCOMPARE(calls.at(1)->parameter<NotificationSinkDispatcher::Subscriptions>(2), NotificationSinkDispatcher::Subscriptions(NotificationSinkDispatcher::AllChanges));
+    QCOMPARE(calls.at(2)->parameter<NotificationSink *>(0), (NotificationSink *)sysuid->mCompositorNotificationSink);
+    QCOMPARE(calls.at(2)->parameter<NotificationSinkDispatcher::LatencyClass>(1), NotificationSinkDispatcher::Deferred);
+    QCOMPARE(calls.at(2)->parameter<NotificationSinkDispatcher::Subscriptions>(2), NotificationSinkDispatcher::Subscriptions(NotificationSinkDispatcher::NotificationAlerts));
+}
+
 void Ut_Sysuid::testUseMode()
 {
     testContextItem->setValue("");
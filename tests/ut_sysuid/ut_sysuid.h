@@ -45,6 +45,7 @@ private slots:
     // Test cases
     void testInitialization();
     void testSignalConnections();
+    void testNotificationSinksAreAddedToDispatcher();
     void testUseMode();
     void testLocaleContainsNotificationCatalog();
     void testWhenLockStateOrStatusIndicatorMenuVisibilityChangesThenCompositorSinkIsDisabled_data();
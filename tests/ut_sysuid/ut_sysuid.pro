@@ -11,7 +11,8 @@ STYLE_HEADERS += $$SRCDIR/screenlock/screenlockwindowstyle.h
 # unit test and unit classes
 SOURCES += \
     ut_sysuid.cpp \
-    $$SRCDIR/sysuid.cpp
+    $$SRCDIR/sysuid.cpp \
+    $$NOTIFICATIONSRCDIR/eventtypetable.cpp
 
 # service classes
 SOURCES += \
@@ -35,11 +36,13 @@ HEADERS += \
     $$SRCDIR/sysuid.h \
     $$SRCDIR/contextframeworkcontext.h \
     $$NOTIFICATIONSRCDIR/eventtypestore.h \
+    $$NOTIFICATIONSRCDIR/eventtypetable.h \
     $$LIBNOTIFICATIONSRCDIR/notificationsink.h \
     $$NOTIFICATIONSRCDIR/widgetnotificationsink.h \
     $$NOTIFICATIONSRCDIR/mcompositornotificationsink.h \
     $$NOTIFICATIONSRCDIR/ngfnotificationsink.h \
     $$NOTIFICATIONSRCDIR/notificationstatusindicatorsink.h \
+    $$NOTIFICATIONSRCDIR/notificationsinkdispatcher.h \
     $$NOTIFICATIONSRCDIR/notificationmanager.h \
     $$ROOTSRCDIR/extensions/screenlock/unlockarea.h \
     $$ROOTSRCDIR/extensions/screenlock/unlocknotifications.h \